@@ -32,6 +32,7 @@
 #include <boost/mpi/communicator.hpp>
 #include <boost/optional.hpp>
 
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -92,6 +93,13 @@ public:
     return id_to_cell(p.identity());
   }
 
+  /** The local cell holds particles from the whole box. */
+  std::pair<Utils::Vector3d, Utils::Vector3d>
+  local_cell_bounds(int) const override {
+    auto const inf = std::numeric_limits<double>::infinity();
+    return {Utils::Vector3d::broadcast(-inf), Utils::Vector3d::broadcast(inf)};
+  }
+
   Utils::Vector3d max_range() const override;
   /* Return true if minimum image convention is
    * needed for distance calculation. */
@@ -22,7 +22,7 @@
 #include <utils/Span.hpp>
 
 #include <boost/algorithm/cxx11/any_of.hpp>
-#include <boost/container/vector.hpp>
+#include <boost/container/small_vector.hpp>
 #include <boost/iterator/iterator_facade.hpp>
 #include <boost/range/algorithm/copy.hpp>
 #include <boost/serialization/access.hpp>
@@ -78,10 +78,18 @@ public:
  * bonds only thru iterators that restore the semantic meanings
  * of the entries, and know how to proceed to the next bond.
  *
+ * The first @ref inline_capacity entries are stored within the
+ * list itself, so that the bonds of most particles (e.g. two pair
+ * bonds, or a pair and an angle bond) need no heap allocation. This
+ * avoids allocations when particles are created, e.g. for the ghosts
+ * and the communication buffers, and keeps the bonds in the same
+ * memory as the rest of the particle.
  */
 class BondList {
 public:
-  using storage_type = boost::container::vector<int>;
+  /** Number of entries stored without heap allocation. */
+  static constexpr std::size_t inline_capacity = 6;
+  using storage_type = boost::container::small_vector<int, inline_capacity>;
 
 private:
   using storage_iterator = storage_type::const_iterator;
@@ -87,6 +87,8 @@ void CellStructure::remove_particle(int id) {
     }
   };
 
+  m_storage_generation++;
+
   for (auto c : decomposition().local_cells()) {
     auto &parts = c->particles();
 
@@ -106,6 +108,7 @@ void CellStructure::remove_particle(int id) {
 Particle *CellStructure::add_local_particle(Particle &&p) {
   auto const sort_cell = particle_to_cell(p);
   if (sort_cell) {
+    m_storage_generation++;
 
     return std::addressof(
         append_indexed_particle(sort_cell->particles(), std::move(p)));
@@ -123,6 +126,7 @@ Particle *CellStructure::add_particle(Particle &&p) {
   /* If the particle isn't local a global resort may be
    * needed, otherwise a local resort if sufficient. */
   set_resort_particles(sort_cell ? Cells::RESORT_LOCAL : Cells::RESORT_GLOBAL);
+  m_storage_generation++;
 
   return std::addressof(
       append_indexed_particle(cell->particles(), std::move(p)));
@@ -136,6 +140,8 @@ int CellStructure::get_max_local_particle_id() const {
 }
 
 void CellStructure::remove_all_particles() {
+  m_storage_generation++;
+
   for (auto c : decomposition().local_cells()) {
     c->particles().clear();
   }
@@ -152,6 +158,7 @@ static unsigned map_data_parts(unsigned data_parts) {
   return GHOSTTRANS_NONE
          | ((DATA_PART_PROPERTIES & data_parts) ? GHOSTTRANS_PROPRTS : 0u)
          | ((DATA_PART_POSITION & data_parts) ? GHOSTTRANS_POSITION : 0u)
+         | ((DATA_PART_CHARGE & data_parts) ? GHOSTTRANS_CHARGE : 0u)
          | ((DATA_PART_MOMENTUM & data_parts) ? GHOSTTRANS_MOMENTUM : 0u)
          | ((DATA_PART_FORCE & data_parts) ? GHOSTTRANS_FORCE : 0u)
          | ((DATA_PART_BONDS & data_parts) ? GHOSTTRANS_BONDS : 0u);
@@ -214,6 +221,7 @@ void CellStructure::resort_particles(int global_flag) {
   }
 
   m_rebuild_verlet_list = true;
+  m_storage_generation++;
 
 #ifdef ADDITIONAL_CHECKS
   check_particle_index();
@@ -229,8 +237,10 @@ void CellStructure::set_atom_decomposition(boost::mpi::communicator const &comm,
 
 void CellStructure::set_domain_decomposition(
     boost::mpi::communicator const &comm, double range, BoxGeometry const &box,
-    LocalBox<double> const &local_geo) {
-  set_particle_decomposition(
-      std::make_unique<DomainDecomposition>(comm, range, box, local_geo));
+    LocalBox<double> const &local_geo, bool variable_local_box,
+    int subdivision, bool sfc_order) {
+  set_particle_decomposition(std::make_unique<DomainDecomposition>(
+      comm, range, box, local_geo, variable_local_box, subdivision,
+      sfc_order));
   m_type = CELL_STRUCTURE_DOMDEC;
 }
@@ -40,6 +40,7 @@
 #include <boost/range/algorithm/find_if.hpp>
 #include <boost/range/algorithm/transform.hpp>
 
+#include <cstddef>
 #include <vector>
 
 /** Cell Structure */
@@ -64,6 +65,7 @@ enum DataPart : unsigned {
   DATA_PART_NONE = 0u,       /**< Nothing */
   DATA_PART_PROPERTIES = 1u, /**< Particle::p */
   DATA_PART_POSITION = 2u,   /**< Particle::r */
+  DATA_PART_CHARGE = 4u,     /**< Particle::p::q only */
   DATA_PART_MOMENTUM = 8u,   /**< Particle::m */
   DATA_PART_FORCE = 16u,     /**< Particle::f */
   DATA_PART_BONDS = 32u      /**< Particle::bonds */
@@ -127,6 +129,9 @@ private:
   /** One of @ref Cells::Resort, announces the level of resort needed.
    */
   unsigned m_resort_particles = Cells::RESORT_NONE;
+  /** Number of changes of the particle storage so far, see
+   *  @ref storage_generation. */
+  std::size_t m_storage_generation = 0;
 
 public:
   bool use_verlet_list = true;
@@ -250,6 +255,23 @@ public:
   ParticleRange local_particles();
   ParticleRange ghost_particles();
 
+  /** Number of local cells. */
+  int n_local_cells() { return static_cast<int>(local_cells().size()); }
+
+  /**
+   * @brief Run a kernel on the particles of every local cell.
+   *
+   * @param kernel Called as <tt>kernel(index, particles)</tt>, with the
+   *        position of the cell in the local cells, as used by
+   *        @ref ParticleDecomposition::local_cell_bounds.
+   */
+  template <class Kernel> void local_cells_loop(Kernel kernel) {
+    auto const cells = local_cells();
+    for (int i = 0; i < static_cast<int>(cells.size()); i++) {
+      kernel(i, cells[i]->particles());
+    }
+  }
+
 private:
   /** Cell system dependent function to find the right cell for a
    *  particle.
@@ -351,6 +373,16 @@ public:
    */
   void clear_resort_particles() { m_resort_particles = Cells::RESORT_NONE; }
 
+  /**
+   * @brief Number of changes of the particle storage so far.
+   *
+   * Pointers to local and ghost particles stay valid as long as this
+   * number does not change. It is increased by every resort, every
+   * change of the particle decomposition and every addition or removal
+   * of particles, so it can differ between the nodes.
+   */
+  std::size_t storage_generation() const { return m_storage_generation; }
+
   /**
    * @brief Update ghost particles.
    *
@@ -444,6 +476,7 @@ private:
   void set_particle_decomposition(
       std::unique_ptr<ParticleDecomposition> &&decomposition) {
     clear_particle_index();
+    m_storage_generation++;
 
     auto local_parts = local_particles();
     std::vector<Particle> particles(local_parts.begin(), local_parts.end());
@@ -473,10 +506,17 @@ public:
    *        @param comm Cartesian communicator to use.
    *        @param box Box Geometry
    *        @param local_geo Geometry of the local box.
+   *        @param variable_local_box The local boxes of the nodes
+   *               differ in size.
+   *        @param subdivision Number of cells per interaction range.
+   *        @param sfc_order Order cells and particles along a
+   *               space-filling curve.
    */
   void set_domain_decomposition(boost::mpi::communicator const &comm,
                                 double range, BoxGeometry const &box,
-                                LocalBox<double> const &local_geo);
+                                LocalBox<double> const &local_geo,
+                                bool variable_local_box = false,
+                                int subdivision = 1, bool sfc_order = false);
 
 public:
   template <class BondKernel> void bond_loop(BondKernel const &bond_kernel) {
@@ -26,10 +26,12 @@
 
 #include <utils/Vector.hpp>
 #include <utils/index.hpp>
+#include <utils/math/sqr.hpp>
 #include <utils/mpi/cart_comm.hpp>
 #include <utils/mpi/sendrecv.hpp>
 
 #include <boost/mpi/collectives.hpp>
+#include <boost/mpi/operations.hpp>
 #include <boost/range/algorithm/reverse.hpp>
 #include <boost/range/numeric.hpp>
 
@@ -37,9 +39,12 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <utility>
+#include <vector>
 
 /** Returns pointer to the cell which corresponds to the position if the
  *  position is in the nodes spatial domain otherwise a nullptr pointer.
@@ -48,24 +53,25 @@ Cell *DomainDecomposition::position_to_cell(const Utils::Vector3d &pos) {
   Utils::Vector3i cpos;
 
   for (int i = 0; i < 3; i++) {
-    cpos[i] = static_cast<int>(std::floor(pos[i] * inv_cell_size[i])) + 1 -
-              cell_offset[i];
+    cpos[i] = static_cast<int>(std::floor(
+                  (pos[i] - m_local_box.my_left()[i]) * inv_cell_size[i])) +
+              m_subdivision;
 
     /* particles outside our box. Still take them if
        nonperiodic boundary. We also accept the particle if we are at
        the box boundary, and the particle is within the box. In this case
        the particle belongs here and could otherwise potentially be dismissed
        due to rounding errors. */
-    if (cpos[i] < 1) {
+    if (cpos[i] < m_subdivision) {
       if ((!m_box.periodic(i) or (pos[i] >= m_box.length()[i])) &&
           m_local_box.boundary()[2 * i])
-        cpos[i] = 1;
+        cpos[i] = m_subdivision;
       else
         return nullptr;
-    } else if (cpos[i] > cell_grid[i]) {
+    } else if (cpos[i] >= cell_grid[i] + m_subdivision) {
       if ((!m_box.periodic(i) or (pos[i] < m_box.length()[i])) &&
           m_local_box.boundary()[2 * i + 1])
-        cpos[i] = cell_grid[i];
+        cpos[i] = cell_grid[i] + m_subdivision - 1;
       else
         return nullptr;
     }
@@ -96,17 +102,30 @@ void DomainDecomposition::move_left_or_right(ParticleList &src,
                                              ParticleList &left,
                                              ParticleList &right,
                                              int dir) const {
+  auto const my_left = m_local_box.my_left()[dir];
+  auto const my_right = m_local_box.my_right()[dir];
+  auto const box_l = m_box.length()[dir];
+  auto const periodic = m_box.periodic(dir);
+
   for (auto it = src.begin(); it != src.end();) {
-    if ((get_mi_coord(it->r.p[dir], m_local_box.my_left()[dir],
-                      m_box.length()[dir], m_box.periodic(dir)) < 0.0) and
-        (m_box.periodic(dir) || (m_local_box.boundary()[2 * dir] == 0))) {
+    auto const pos = it->r.p[dir];
+    bool to_left = (pos - my_left < 0.0);
+    bool to_right = not to_left and (pos - my_right >= 0.0);
+
+    if (periodic and (to_left or to_right)) {
+      /* The positions are folded. Send the particle the shorter way
+       * around, which also holds if the local box is larger than half
+       * the box. */
+      to_left = get_mi_coord(pos, 0.5 * (my_left + my_right), box_l,
+                             periodic) < 0.0;
+      to_right = not to_left;
+    }
+
+    if (to_left and (periodic or (m_local_box.boundary()[2 * dir] == 0))) {
       left.insert(std::move(*it));
       it = src.erase(it);
-    } else if ((get_mi_coord(it->r.p[dir], m_local_box.my_right()[dir],
-                             m_box.length()[dir],
-                             m_box.periodic(dir)) >= 0.0) and
-               (m_box.periodic(dir) ||
-                (m_local_box.boundary()[2 * dir + 1] == 0))) {
+    } else if (to_right and
+               (periodic or (m_local_box.boundary()[2 * dir + 1] == 0))) {
       right.insert(std::move(*it));
       it = src.erase(it);
     } else {
@@ -233,10 +252,66 @@ void DomainDecomposition::resort(bool global,
       diff.emplace_back(ModifiedList{sort_cell->particles()});
     }
   }
+
+  if (m_sfc_order) {
+    sort_cell_particles(diff);
+  }
+}
+
+void DomainDecomposition::sort_cell_particles(
+    std::vector<ParticleChange> &diff) {
+  /* Positions are resolved to 1/8 of the cell size. */
+  constexpr int resolution = 8;
+  auto const key = [this](Utils::Vector3d const &pos) {
+    Utils::Vector3i ind;
+    for (int i = 0; i < 3; i++) {
+      auto const u =
+          (pos[i] - m_local_box.my_left()[i]) * inv_cell_size[i] * resolution;
+      /* Particles outside of a non-periodic box belong to the
+       * boundary cells, see position_to_cell(). */
+      ind[i] = std::min(std::max(static_cast<int>(u), 0),
+                        resolution * cell_grid[i] - 1);
+    }
+    return Utils::morton_index(ind);
+  };
+
+  std::vector<std::pair<uint64_t, std::size_t>> keys;
+  std::vector<Particle> sorted;
+
+  for (auto &c : local_cells()) {
+    auto &parts = c->particles();
+    if (parts.size() < 2)
+      continue;
+
+    keys.clear();
+    for (std::size_t i = 0; i < parts.size(); i++) {
+      keys.emplace_back(key(parts.begin()[i].r.p), i);
+    }
+    if (std::is_sorted(keys.begin(), keys.end()))
+      continue;
+
+    std::sort(keys.begin(), keys.end());
+    sorted.clear();
+    for (auto const &k : keys) {
+      sorted.emplace_back(std::move(parts.begin()[k.second]));
+    }
+    std::move(sorted.begin(), sorted.end(), parts.begin());
+    diff.emplace_back(ModifiedList{parts});
+  }
 }
 
 void DomainDecomposition::mark_cells() {
+  auto const is_local = [this](Utils::Vector3i const &cpos) {
+    for (int i = 0; i < 3; i++) {
+      if (cpos[i] < m_subdivision or
+          cpos[i] >= ghost_cell_grid[i] - m_subdivision)
+        return false;
+    }
+    return true;
+  };
+
   int cnt_c = 0;
+  std::vector<std::pair<uint64_t, Cell *>> sfc_cells;
 
   m_local_cells.clear();
   m_ghost_cells.clear();
@@ -244,12 +319,21 @@ void DomainDecomposition::mark_cells() {
   for (int o = 0; o < ghost_cell_grid[2]; o++)
     for (int n = 0; n < ghost_cell_grid[1]; n++)
       for (int m = 0; m < ghost_cell_grid[0]; m++) {
-        if ((m > 0 && m < ghost_cell_grid[0] - 1 && n > 0 &&
-             n < ghost_cell_grid[1] - 1 && o > 0 && o < ghost_cell_grid[2] - 1))
+        if (is_local({m, n, o})) {
+          sfc_cells.emplace_back(Utils::morton_index({m, n, o}),
+                                 &cells.at(cnt_c));
           m_local_cells.push_back(&cells.at(cnt_c++));
-        else
+        } else {
           m_ghost_cells.push_back(&cells.at(cnt_c++));
+        }
       }
+
+  if (m_sfc_order) {
+    std::sort(sfc_cells.begin(), sfc_cells.end());
+    for (std::size_t i = 0; i < sfc_cells.size(); i++) {
+      m_local_cells[i] = sfc_cells[i].second;
+    }
+  }
 }
 void DomainDecomposition::fill_comm_cell_lists(ParticleList **part_lists,
                                                const Utils::Vector3i &lc,
@@ -262,9 +346,37 @@ void DomainDecomposition::fill_comm_cell_lists(ParticleList **part_lists,
         *part_lists++ = &(cells.at(i).particles());
       }
 }
+std::pair<Utils::Vector3d, Utils::Vector3d>
+DomainDecomposition::local_cell_bounds(int index) const {
+  /* The order of the local cells depends on m_sfc_order, see
+   * mark_cells(), so the position follows from the storage index. */
+  auto const ind = static_cast<int>(m_local_cells.at(index) - cells.data());
+  Utils::Vector3i const grid_pos = {
+      ind % ghost_cell_grid[0] - m_subdivision,
+      (ind / ghost_cell_grid[0]) % ghost_cell_grid[1] - m_subdivision,
+      ind / (ghost_cell_grid[0] * ghost_cell_grid[1]) - m_subdivision};
+  auto const inf = std::numeric_limits<double>::infinity();
+
+  Utils::Vector3d lower, upper;
+  for (int i = 0; i < 3; i++) {
+    lower[i] = m_local_box.my_left()[i] + grid_pos[i] * cell_size[i];
+    upper[i] = lower[i] + cell_size[i];
+    /* The boundary cells also take the particles outside of a
+     * non-periodic box, see position_to_cell(). */
+    if (not m_box.periodic(i)) {
+      if (grid_pos[i] == 0 and m_local_box.boundary()[2 * i])
+        lower[i] = -inf;
+      if (grid_pos[i] == cell_grid[i] - 1 and
+          m_local_box.boundary()[2 * i + 1])
+        upper[i] = inf;
+    }
+  }
+  return {lower, upper};
+}
+
 Utils::Vector3d DomainDecomposition::max_range() const {
   auto dir_max_range = [this](int i) {
-    return std::min(0.5 * m_box.length()[i], m_local_box.length()[i]);
+    return std::min(0.5 * m_box.length()[i], m_min_local_length[i]);
   };
 
   return {dir_max_range(0), dir_max_range(1), dir_max_range(2)};
@@ -274,16 +386,16 @@ int DomainDecomposition::calc_processor_min_num_cells() const {
      serving a direction,
      since this also ensures that the cell size is at most half the box
      length. However, if there is only one processor for a direction, there
-     have to be at least two cells for this direction. */
+     have to be at least two cells (per subdivision) for this direction. */
+  auto const min_cells_per_dir = 2 * m_subdivision;
   return boost::accumulate(Utils::Mpi::cart_get<3>(m_comm).dims, 1,
-                           [](int n_cells, int grid) {
-                             return (grid == 1) ? 2 * n_cells : n_cells;
+                           [min_cells_per_dir](int n_cells, int grid) {
+                             return (grid == 1) ? min_cells_per_dir * n_cells
+                                                : n_cells;
                            });
 }
 
 void DomainDecomposition::create_cell_grid(double range) {
-  auto const cart_info = Utils::Mpi::cart_get<3>(m_comm);
-
   int i, n_local_cells, new_cells;
   double cell_range[3];
 
@@ -295,14 +407,40 @@ void DomainDecomposition::create_cell_grid(double range) {
 
   if (range <= 0.) {
     /* this is the non-interacting case */
-    auto const cells_per_dir =
-        static_cast<int>(std::ceil(std::pow(min_num_cells, 1. / 3.)));
+    auto const cells_per_dir = std::max(
+        static_cast<int>(std::ceil(std::pow(min_num_cells, 1. / 3.))),
+        m_subdivision);
 
     cell_grid[0] = cells_per_dir;
     cell_grid[1] = cells_per_dir;
     cell_grid[2] = cells_per_dir;
 
     n_local_cells = cell_grid[0] * cell_grid[1] * cell_grid[2];
+  } else if (m_variable_local_box) {
+    /* The cell grid of a direction may only depend on the slab width,
+     * which is shared by all nodes of the slab. */
+    auto const max_cells_per_dir =
+        static_cast<int>(std::cbrt(DomainDecomposition::max_num_cells));
+    for (i = 0; i < 3; i++) {
+      cell_grid[i] = std::min(
+          static_cast<int>(std::floor(m_local_box.length()[i] / range)),
+          max_cells_per_dir);
+      if (cell_grid[i] < 1) {
+        runtimeErrorMsg() << "interaction range " << range << " in direction "
+                          << i << " is larger than the local box size "
+                          << m_local_box.length()[i];
+        cell_grid[i] = 1;
+      }
+    }
+
+    n_local_cells = cell_grid[0] * cell_grid[1] * cell_grid[2];
+
+    if (n_local_cells < min_num_cells) {
+      runtimeErrorMsg()
+          << "number of cells " << n_local_cells << " is smaller than minimum "
+          << min_num_cells
+          << " (interaction range too large or min_num_cells too large)";
+    }
   } else {
     /* Calculate initial cell grid */
     double volume = m_local_box.length()[0];
@@ -367,16 +505,25 @@ void DomainDecomposition::create_cell_grid(double range) {
     runtimeErrorMsg() << "no suitable cell grid found ";
   }
 
-  auto const node_pos = cart_info.coords;
+  /* the ghost layers of the neighbors are filled from the outermost
+   * m_subdivision cell layers */
+  for (i = 0; i < 3; i++) {
+    if (cell_grid[i] < m_subdivision) {
+      runtimeErrorMsg() << "local box size " << m_local_box.length()[i]
+                        << " in direction " << i << " holds less than "
+                        << m_subdivision << " cells of size " << range;
+      cell_grid[i] = m_subdivision;
+    }
+  }
+  n_local_cells = cell_grid[0] * cell_grid[1] * cell_grid[2];
 
   /* now set all dependent variables */
   new_cells = 1;
   for (i = 0; i < 3; i++) {
-    ghost_cell_grid[i] = cell_grid[i] + 2;
+    ghost_cell_grid[i] = cell_grid[i] + 2 * m_subdivision;
     new_cells *= ghost_cell_grid[i];
     cell_size[i] = m_local_box.length()[i] / (double)cell_grid[i];
     inv_cell_size[i] = 1.0 / cell_size[i];
-    cell_offset[i] = node_pos[i] * cell_grid[i];
   }
 
   /* allocate cell array and cell pointer arrays */
@@ -387,10 +534,21 @@ void DomainDecomposition::create_cell_grid(double range) {
 }
 
 void DomainDecomposition::init_cell_interactions() {
+  auto const k = m_subdivision;
+
+  /* Cells are at least range / k wide, so cells which are separated by
+   * more than k cells of them are out of range. */
+  auto const in_range = [k](int dx, int dy, int dz) {
+    auto const gap2 = [](int d) {
+      return Utils::sqr(std::max(std::abs(d) - 1, 0));
+    };
+    return gap2(dx) + gap2(dy) + gap2(dz) <= k * k;
+  };
+
   /* loop all local cells */
-  for (int o = 1; o < cell_grid[2] + 1; o++)
-    for (int n = 1; n < cell_grid[1] + 1; n++)
-      for (int m = 1; m < cell_grid[0] + 1; m++) {
+  for (int o = k; o < cell_grid[2] + k; o++)
+    for (int n = k; n < cell_grid[1] + k; n++)
+      for (int m = k; m < cell_grid[0] + k; m++) {
 
         auto const ind1 = get_linear_index(m, n, o, ghost_cell_grid);
 
@@ -398,13 +556,13 @@ void DomainDecomposition::init_cell_interactions() {
         std::vector<Cell *> black_neighbors;
 
         /* loop all neighbor cells */
-        int lower_index[3] = {m - 1, n - 1, o - 1};
-        int upper_index[3] = {m + 1, n + 1, o + 1};
-
-        for (int p = lower_index[2]; p <= upper_index[2]; p++)
-          for (int q = lower_index[1]; q <= upper_index[1]; q++)
-            for (int r = lower_index[0]; r <= upper_index[0]; r++) {
-              auto const ind2 = get_linear_index(r, q, p, ghost_cell_grid);
+        for (int p = -k; p <= k; p++)
+          for (int q = -k; q <= k; q++)
+            for (int r = -k; r <= k; r++) {
+              if (not in_range(r, q, p))
+                continue;
+              auto const ind2 =
+                  get_linear_index(m + r, n + q, o + p, ghost_cell_grid);
               if (ind2 > ind1) {
                 red_neighbors.push_back(&cells.at(ind2));
               } else {
@@ -487,18 +645,23 @@ GhostCommunicator DomainDecomposition::prepare_comm() {
   /* prepare communicator */
   auto ghost_comm = GhostCommunicator{m_comm, num};
 
+  /* number of ghost layers */
+  auto const k = m_subdivision;
+
   /* number of cells to communicate in a direction */
-  n_comm_cells[0] = cell_grid[1] * cell_grid[2];
-  n_comm_cells[1] = cell_grid[2] * ghost_cell_grid[0];
-  n_comm_cells[2] = ghost_cell_grid[0] * ghost_cell_grid[1];
+  n_comm_cells[0] = k * cell_grid[1] * cell_grid[2];
+  n_comm_cells[1] = k * cell_grid[2] * ghost_cell_grid[0];
+  n_comm_cells[2] = k * ghost_cell_grid[0] * ghost_cell_grid[1];
 
   cnt = 0;
   /* direction loop: x, y, z */
   for (dir = 0; dir < 3; dir++) {
-    lc[(dir + 1) % 3] = 1 - done[(dir + 1) % 3];
-    lc[(dir + 2) % 3] = 1 - done[(dir + 2) % 3];
-    hc[(dir + 1) % 3] = cell_grid[(dir + 1) % 3] + done[(dir + 1) % 3];
-    hc[(dir + 2) % 3] = cell_grid[(dir + 2) % 3] + done[(dir + 2) % 3];
+    lc[(dir + 1) % 3] = k * (1 - done[(dir + 1) % 3]);
+    lc[(dir + 2) % 3] = k * (1 - done[(dir + 2) % 3]);
+    hc[(dir + 1) % 3] =
+        cell_grid[(dir + 1) % 3] + k * (1 + done[(dir + 1) % 3]) - 1;
+    hc[(dir + 2) % 3] =
+        cell_grid[(dir + 2) % 3] + k * (1 + done[(dir + 2) % 3]) - 1;
     /* lr loop: left right */
     /* here we could in principle build in a one sided ghost
        communication, simply by taking the lr loop only over one
@@ -516,13 +679,15 @@ GhostCommunicator DomainDecomposition::prepare_comm() {
             shift(m_box, m_local_box, dir, lr);
 
         /* fill send ghost_comm cells */
-        lc[dir] = hc[dir] = 1 + lr * (cell_grid[dir] - 1);
+        lc[dir] = k + lr * (cell_grid[dir] - k);
+        hc[dir] = lc[dir] + k - 1;
 
         fill_comm_cell_lists(ghost_comm.communications[cnt].part_lists.data(),
                              lc, hc);
 
         /* fill recv ghost_comm cells */
-        lc[dir] = hc[dir] = 0 + (1 - lr) * (cell_grid[dir] + 1);
+        lc[dir] = (1 - lr) * (cell_grid[dir] + k);
+        hc[dir] = lc[dir] + k - 1;
 
         /* place receive cells after send cells */
         fill_comm_cell_lists(
@@ -541,7 +706,8 @@ GhostCommunicator DomainDecomposition::prepare_comm() {
             ghost_comm.communications[cnt].shift =
                 shift(m_box, m_local_box, dir, lr);
 
-            lc[dir] = hc[dir] = 1 + lr * (cell_grid[dir] - 1);
+            lc[dir] = k + lr * (cell_grid[dir] - k);
+            hc[dir] = lc[dir] + k - 1;
 
             fill_comm_cell_lists(
                 ghost_comm.communications[cnt].part_lists.data(), lc, hc);
@@ -553,7 +719,8 @@ GhostCommunicator DomainDecomposition::prepare_comm() {
                 node_neighbors[2 * dir + (1 - lr)];
             ghost_comm.communications[cnt].part_lists.resize(n_comm_cells[dir]);
 
-            lc[dir] = hc[dir] = (1 - lr) * (cell_grid[dir] + 1);
+            lc[dir] = (1 - lr) * (cell_grid[dir] + k);
+            hc[dir] = lc[dir] + k - 1;
 
             fill_comm_cell_lists(
                 ghost_comm.communications[cnt].part_lists.data(), lc, hc);
@@ -571,10 +738,18 @@ GhostCommunicator DomainDecomposition::prepare_comm() {
 DomainDecomposition::DomainDecomposition(boost::mpi::communicator comm,
                                          double range,
                                          const BoxGeometry &box_geo,
-                                         const LocalBox<double> &local_geo)
-    : m_comm(std::move(comm)), m_box(box_geo), m_local_box(local_geo) {
+                                         const LocalBox<double> &local_geo,
+                                         bool variable_local_box,
+                                         int subdivision, bool sfc_order)
+    : m_comm(std::move(comm)), m_box(box_geo), m_local_box(local_geo),
+      m_variable_local_box(variable_local_box), m_subdivision(subdivision),
+      m_sfc_order(sfc_order) {
+  boost::mpi::all_reduce(m_comm, m_local_box.length().data(), 3,
+                         m_min_local_length.data(),
+                         boost::mpi::minimum<double>());
+
   /* set up new domain decomposition cell structure */
-  create_cell_grid(range);
+  create_cell_grid(range / m_subdivision);
 
   /* setup cell neighbors */
   init_cell_interactions();
@@ -37,6 +37,7 @@
 
 #include <boost/optional.hpp>
 
+#include <utility>
 #include <vector>
 
 /** @brief Structure containing the information about the cell grid used for
@@ -45,10 +46,11 @@
  *  The domain of a node is split into a 3D cell grid with dimension
  *  cell_grid. Together with one ghost cell
  *  layer on each side the overall dimension of the ghost cell grid is
- *  ghost_cell_grid. The domain
- *  decomposition enables one the use of the linked cell algorithm
- *  which is in turn used for setting up the Verlet list for the
- *  system. You can see a 2D graphical representation of the linked
+ *  ghost_cell_grid. If the cells are a fraction of the interaction
+ *  range, there are as many ghost cell layers as cells per interaction
+ *  range. The domain decomposition enables one the use of the linked
+ *  cell algorithm which is in turn used for setting up the Verlet list
+ *  for the system. You can see a 2D graphical representation of the linked
  *  cell grid below.
  *
  *  \image html  linked_cells.gif "Linked cells structure"
@@ -72,8 +74,6 @@ struct DomainDecomposition : public ParticleDecomposition {
   Utils::Vector3d cell_size = {};
 
 private:
-  /** Offset in global grid */
-  Utils::Vector3i cell_offset = {};
   /** linked cell grid with ghost frame. */
   Utils::Vector3i ghost_cell_grid = {};
   /** inverse cell size = \see DomainDecomposition::cell_size ^ -1. */
@@ -82,6 +82,16 @@ private:
   boost::mpi::communicator m_comm;
   BoxGeometry m_box;
   LocalBox<double> m_local_box;
+  /** The local boxes of the nodes differ in size. */
+  bool m_variable_local_box;
+  /** Smallest local box length of all nodes. */
+  Utils::Vector3d m_min_local_length;
+  /** Number of cells per interaction range, which is also the number of
+   *  ghost cell layers. */
+  int m_subdivision;
+  /** Order the local cells and the particles within the cells along a
+   *  space-filling curve. */
+  bool m_sfc_order;
   std::vector<Cell> cells;
   std::vector<Cell *> m_local_cells;
   std::vector<Cell *> m_ghost_cells;
@@ -89,9 +99,30 @@ private:
   GhostCommunicator m_collect_ghost_force_comm;
 
 public:
+  /**
+   * @param comm Cartesian communicator of the nodes.
+   * @param range Required interacting range.
+   * @param box_geo Geometry of the simulation box.
+   * @param local_geo Geometry of the local box.
+   * @param variable_local_box The local boxes are the slabs of a tensor
+   *        product decomposition with different widths (see
+   *        @ref LoadBalancing). The cell grid in each direction then only
+   *        depends on the slab width, so that neighboring nodes agree
+   *        on the cells of their common faces.
+   * @param subdivision Number of cells per interaction range. Smaller
+   *        cells approximate the cutoff sphere better and reduce the
+   *        number of distances to check, at the cost of a neighbor stencil
+   *        of up to (2 * subdivision + 1)^3 cells and as many ghost layers.
+   * @param sfc_order Traverse the local cells along the Morton curve
+   *        instead of lexicographically, and sort the particles within
+   *        the cells along the same curve on every resort, so that
+   *        particles which are close in space are close in memory.
+   */
   DomainDecomposition(boost::mpi::communicator comm, double range,
                       const BoxGeometry &box_geo,
-                      const LocalBox<double> &local_geo);
+                      const LocalBox<double> &local_geo,
+                      bool variable_local_box = false, int subdivision = 1,
+                      bool sfc_order = false);
 
   GhostCommunicator const &exchange_ghosts_comm() const override {
     return m_exchange_ghosts_comm;
@@ -112,6 +143,8 @@ public:
   }
 
   void resort(bool global, std::vector<ParticleChange> &diff) override;
+  std::pair<Utils::Vector3d, Utils::Vector3d>
+  local_cell_bounds(int index) const override;
   Utils::Vector3d max_range() const override;
 
   boost::optional<BoxGeometry> minimum_image_distance() const override {
@@ -120,10 +153,17 @@ public:
 
 private:
   /** Fill local_cells list and ghost_cells list for use with domain
-   *  decomposition.
+   *  decomposition. The local cells are in lexicographic order, or in
+   *  Morton order if @ref m_sfc_order is set.
    */
   void mark_cells();
 
+  /** Sort the particles of the local cells along the Morton curve of
+   *  a grid that is 8 times finer than the cell grid.
+   *  @param diff Modified particle lists.
+   */
+  void sort_cell_particles(std::vector<ParticleChange> &diff);
+
   /** Fill a communication cell pointer list. Fill the cell pointers of
    *  all cells which are inside a rectangular subgrid of the 3D cell
    *  grid starting from the
@@ -186,7 +226,12 @@ private:
    *  Calculates the cell grid, based on the local box size and the range.
    *  If the number of cells is larger than max_num_cells,
    *  it increases max_range until the number of cells is
-   *  smaller or equal max_num_cells. It sets:
+   *  smaller or equal max_num_cells. For variable local boxes, every
+   *  direction gets as many cells as fit into the slab width, but at most
+   *  the cube root of max_num_cells. The cells are a fraction
+   *  1 / m_subdivision of the range, and every direction needs at
+   *  least m_subdivision cells to fill the ghost layers of the
+   *  neighbors. It sets:
    *  cell_grid,
    *  ghost_cell_grid,
    *  cell_size, and
@@ -200,7 +245,9 @@ private:
   /** Init cell interactions for cell system domain decomposition.
    *  Initializes the interacting neighbor cell list of a cell.
    *  This list of interacting neighbor cells is used by the Verlet
-   * algorithm.
+   * algorithm. The neighbors are all cells up to m_subdivision cells
+   * away, except for those which are further than the interaction
+   * range in every case.
    */
   void init_cell_interactions();
 
@@ -36,6 +36,17 @@ void PartCfg::update() {
   m_parts.clear();
 
   auto const ids = get_particle_ids();
+
+  if (m_fields != FIELD_ALL) {
+    m_parts = mpi_get_particle_fields(ids, m_fields);
+    for (auto &p : m_parts) {
+      p.r.p += image_shift(p.l.i, box_geo.length());
+      p.l.i = {};
+    }
+    m_valid = true;
+    return;
+  }
+
   auto const chunk_size = fetch_cache_max_size();
 
   for (size_t offset = 0; offset < ids.size();) {
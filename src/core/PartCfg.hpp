@@ -20,6 +20,7 @@
 #define CORE_PART_CFG_HPP
 
 #include "Particle.hpp"
+#include "particle_data.hpp"
 
 #include <cstddef>
 #include <vector>
@@ -41,10 +42,18 @@ class PartCfg {
   std::vector<Particle> m_parts;
   /** State */
   bool m_valid;
+  /** Fetched particle properties, cf. @ref ParticleField */
+  unsigned m_fields;
 
 public:
   using value_type = Particle;
-  PartCfg() : m_valid(false) {}
+  /**
+   * @param fields Particle properties to fetch. With anything else than
+   *               @ref FIELD_ALL, only the selected properties are
+   *               transferred, all other members are default-initialized.
+   */
+  explicit PartCfg(unsigned fields = FIELD_ALL)
+      : m_valid(false), m_fields(fields) {}
 
   /**
    * @brief Iterator pointing to the particle with the lowest
@@ -30,6 +30,7 @@
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
+#include <utility>
 #include <vector>
 
 struct RemovedParticle {
@@ -112,6 +113,18 @@ public:
    */
   virtual Cell *particle_to_cell(Particle const &p) = 0;
 
+  /**
+   * @brief Spatial extent of a local cell.
+   *
+   * All particles in the cell were inside of this box when they were
+   * last sorted into the cell.
+   *
+   * @param index Position of the cell in @ref local_cells.
+   * @return Lower and upper corner of the box.
+   */
+  virtual std::pair<Utils::Vector3d, Utils::Vector3d>
+  local_cell_bounds(int index) const = 0;
+
   /**
    * @brief Maximum supported cutoff.
    */
@@ -20,6 +20,7 @@
 #define CORE_ACCUMULATORS_ACCUMULATORBASE
 
 #include <cstddef>
+#include <string>
 #include <vector>
 
 namespace Accumulators {
@@ -33,6 +34,9 @@ public:
   virtual void update() = 0;
   /** Dimensions needed to reshape the flat array returned by the accumulator */
   virtual std::vector<size_t> shape() const = 0;
+  /** Serialized accumulated data, e.g. for checkpointing. */
+  virtual std::string get_internal_state() const = 0;
+  virtual void set_internal_state(std::string const &) = 0;
 
 private:
   // Number of timesteps between automatic updates.
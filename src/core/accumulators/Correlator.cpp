@@ -20,6 +20,7 @@
 
 #include "integrate.hpp"
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 #include <utils/math/sqr.hpp>
 #include <utils/serialization/multi_array.hpp>
@@ -48,122 +49,84 @@ int min(int i, unsigned int j) { return std::min(i, static_cast<int>(j)); }
 
 namespace Accumulators {
 /** Compress computing arithmetic mean: A_compressed=(A1+A2)/2 */
-std::vector<double> compress_linear(std::vector<double> const &A1,
-                                    std::vector<double> const &A2) {
+void compress_linear(Utils::Span<const double> A1,
+                     Utils::Span<const double> A2,
+                     Utils::Span<double> A_compressed) {
   assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A1.size());
-
   std::transform(A1.begin(), A1.end(), A2.begin(), A_compressed.begin(),
                  [](double a, double b) -> double { return 0.5 * (a + b); });
-
-  return A_compressed;
 }
 
 /** Compress discarding the 1st argument and return the 2nd */
-std::vector<double> compress_discard1(std::vector<double> const &A1,
-                                      std::vector<double> const &A2) {
+void compress_discard1(Utils::Span<const double> A1,
+                       Utils::Span<const double> A2,
+                       Utils::Span<double> A_compressed) {
   assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A2);
-  return A_compressed;
+  std::copy(A2.begin(), A2.end(), A_compressed.begin());
 }
 
 /** Compress discarding the 2nd argument and return the 1st */
-std::vector<double> compress_discard2(std::vector<double> const &A1,
-                                      std::vector<double> const &A2) {
+void compress_discard2(Utils::Span<const double> A1,
+                       Utils::Span<const double> A2,
+                       Utils::Span<double> A_compressed) {
   assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A1);
-  return A_compressed;
+  std::copy(A1.begin(), A1.end(), A_compressed.begin());
 }
 
-std::vector<double> scalar_product(std::vector<double> const &A,
-                                   std::vector<double> const &B,
-                                   Utils::Vector3d const &) {
-  if (A.size() != B.size()) {
-    throw std::runtime_error(
-        "Error in scalar product: The vector sizes do not match");
-  }
+/* The correlation operations add their value to the result row C,
+ * the sizes of the arguments are checked once in initialize(). */
 
-  return std::vector<double>(
-      1, std::inner_product(A.begin(), A.end(), B.begin(), 0.0));
+void scalar_product(Utils::Span<const double> A, Utils::Span<const double> B,
+                    Utils::Vector3d const &, Utils::Span<double> C) {
+  C[0] += std::inner_product(A.begin(), A.end(), B.begin(), 0.0);
 }
 
-std::vector<double> componentwise_product(std::vector<double> const &A,
-                                          std::vector<double> const &B,
-                                          Utils::Vector3d const &) {
-  std::vector<double> C(A.size());
-  if (A.size() != B.size()) {
-    throw std::runtime_error(
-        "Error in componentwise product: The vector sizes do not match");
+void componentwise_product(Utils::Span<const double> A,
+                           Utils::Span<const double> B,
+                           Utils::Vector3d const &, Utils::Span<double> C) {
+  auto const a = A.data();
+  auto const b = B.data();
+  auto const c = C.data();
+  for (size_t k = 0; k < C.size(); k++) {
+    c[k] += a[k] * b[k];
   }
-
-  std::transform(A.begin(), A.end(), B.begin(), C.begin(), std::multiplies<>());
-
-  return C;
 }
 
-std::vector<double> tensor_product(std::vector<double> const &A,
-                                   std::vector<double> const &B,
-                                   Utils::Vector3d const &) {
-  std::vector<double> C(A.size() * B.size());
-  auto C_it = C.begin();
-
+void tensor_product(Utils::Span<const double> A, Utils::Span<const double> B,
+                    Utils::Vector3d const &, Utils::Span<double> C) {
+  auto const b = B.data();
+  auto c = C.data();
   for (double a : A) {
-    for (double b : B) {
-      *(C_it++) = a * b;
+    for (size_t k = 0; k < B.size(); k++) {
+      c[k] += a * b[k];
     }
+    c += B.size();
   }
-
-  return C;
 }
 
-std::vector<double> square_distance_componentwise(std::vector<double> const &A,
-                                                  std::vector<double> const &B,
-                                                  Utils::Vector3d const &) {
-  if (A.size() != B.size()) {
-    throw std::runtime_error(
-        "Error in square distance componentwise: The vector sizes do not "
-        "match.");
+void square_distance_componentwise(Utils::Span<const double> A,
+                                   Utils::Span<const double> B,
+                                   Utils::Vector3d const &,
+                                   Utils::Span<double> C) {
+  auto const a = A.data();
+  auto const b = B.data();
+  auto const c = C.data();
+  for (size_t k = 0; k < C.size(); k++) {
+    c[k] += Utils::sqr(a[k] - b[k]);
   }
-
-  std::vector<double> C(A.size());
-
-  std::transform(
-      A.begin(), A.end(), B.begin(), C.begin(),
-      [](double a, double b) -> double { return Utils::sqr(a - b); });
-
-  return C;
 }
 
 // note: the argument name wsquare denotes that its value is w^2 while the user
 // sets w
-std::vector<double> fcs_acf(std::vector<double> const &A,
-                            std::vector<double> const &B,
-                            Utils::Vector3d const &wsquare) {
-  if (A.size() != B.size()) {
-    throw std::runtime_error(
-        "Error in fcs_acf: The vector sizes do not match.");
-  }
-
-  auto const C_size = A.size() / 3;
-  if (3 * C_size != A.size()) {
-    throw std::runtime_error("Invalid dimensions.");
-  }
-
-  std::vector<double> C(C_size, 0);
-
-  for (size_t i = 0; i < C_size; i++) {
+void fcs_acf(Utils::Span<const double> A, Utils::Span<const double> B,
+             Utils::Vector3d const &wsquare, Utils::Span<double> C) {
+  for (size_t i = 0; i < C.size(); i++) {
+    double c = 0.;
     for (int j = 0; j < 3; j++) {
-      auto const &a = A[3 * i + j];
-      auto const &b = B[3 * i + j];
-
-      C[i] -= Utils::sqr(a - b) / wsquare[j];
+      c -= Utils::sqr(A[3 * i + j] - B[3 * i + j]) / wsquare[j];
     }
+    C[i] += std::exp(c);
   }
-
-  std::transform(C.begin(), C.end(), C.begin(),
-                 [](double c) -> double { return std::exp(c); });
-
-  return C;
 }
 
 void Correlator::initialize() {
@@ -215,6 +178,10 @@ void Correlator::initialize() {
     throw std::runtime_error(
         "no proper function for correlation operation given");
   }
+  if (corr_operation_name != "tensor_product" and dim_A != dim_B) {
+    throw std::runtime_error("Error in " + corr_operation_name +
+                             ": The vector sizes do not match");
+  }
   if (corr_operation_name == "componentwise_product") {
     m_dim_corr = dim_A;
     m_shape = A_obs->shape();
@@ -287,10 +254,12 @@ void Correlator::initialize() {
         "no proper function for compression of second observable given");
   }
 
-  A.resize(std::array<int, 2>{{m_hierarchy_depth, m_tau_lin + 1}});
-  std::fill_n(A.data(), A.num_elements(), std::vector<double>(dim_A, 0));
-  B.resize(std::array<int, 2>{{m_hierarchy_depth, m_tau_lin + 1}});
-  std::fill_n(B.data(), B.num_elements(), std::vector<double>(dim_B, 0));
+  A.resize(std::array<size_t, 3>{
+      {static_cast<size_t>(m_hierarchy_depth), m_tau_lin + 1ul, dim_A}});
+  std::fill_n(A.data(), A.num_elements(), 0.);
+  B.resize(std::array<size_t, 3>{
+      {static_cast<size_t>(m_hierarchy_depth), m_tau_lin + 1ul, dim_B}});
+  std::fill_n(B.data(), B.num_elements(), 0.);
 
   n_data = 0;
   A_accumulated_average = std::vector<double>(dim_A, 0);
@@ -329,6 +298,21 @@ void Correlator::update() {
     throw std::runtime_error(
         "No data can be added after finalize() was called.");
   }
+  // The observables are evaluated before the hierarchy is modified, so
+  // that it stays consistent if their sizes changed
+  auto const A_val = A_obs->operator()();
+  if (A_val.size() != dim_A) {
+    throw std::runtime_error(
+        "Error in correlator update: The size of the first observable "
+        "changed.");
+  }
+  auto const B_val = (A_obs != B_obs) ? B_obs->operator()() : A_val;
+  if (B_val.size() != dim_B) {
+    throw std::runtime_error(
+        "Error in correlator update: The size of the second observable "
+        "changed.");
+  }
+
   // We must now go through the hierarchy and make sure there is space for the
   // new datapoint. For every hierarchy level we have to decide if it is
   // necessary to move something
@@ -359,69 +343,66 @@ void Correlator::update() {
     // folding)
     newest[i + 1] = (newest[i + 1] + 1) % (m_tau_lin + 1);
     n_vals[i + 1] += 1;
-    A[i + 1][newest[i + 1]] =
-        (*compressA)(A[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     A[i][(newest[i] + 2) % (m_tau_lin + 1)]);
-    B[i + 1][newest[i + 1]] =
-        (*compressB)(B[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     B[i][(newest[i] + 2) % (m_tau_lin + 1)]);
+    compress(i);
   }
 
   newest[0] = (newest[0] + 1) % (m_tau_lin + 1);
   n_vals[0]++;
 
-  A[0][newest[0]] = A_obs->operator()();
-  if (A_obs != B_obs) {
-    B[0][newest[0]] = B_obs->operator()();
-  } else {
-    B[0][newest[0]] = A[0][newest[0]];
-  }
+  auto const A_new = entry(A, 0, newest[0]);
+  auto const B_new = entry(B, 0, newest[0]);
+  std::copy(A_val.begin(), A_val.end(), A_new.begin());
+  std::copy(B_val.begin(), B_val.end(), B_new.begin());
 
   // Now we update the cumulated averages and variances of A and B
   n_data++;
-  for (size_t k = 0; k < dim_A; k++) {
-    A_accumulated_average[k] += A[0][newest[0]][k];
-  }
-
-  for (size_t k = 0; k < dim_B; k++) {
-    B_accumulated_average[k] += B[0][newest[0]][k];
-  }
+  std::transform(A_accumulated_average.begin(), A_accumulated_average.end(),
+                 A_new.begin(), A_accumulated_average.begin(),
+                 std::plus<double>());
+  std::transform(B_accumulated_average.begin(), B_accumulated_average.end(),
+                 B_new.begin(), B_accumulated_average.begin(),
+                 std::plus<double>());
 
   // Now update the lowest level correlation estimates
   for (unsigned j = 0; j < min(m_tau_lin + 1, n_vals[0]); j++) {
-    auto const index_new = newest[0];
     auto const index_old = (newest[0] - j + m_tau_lin + 1) % (m_tau_lin + 1);
-    auto const temp =
-        (corr_operation)(A[0][index_old], B[0][index_new], m_correlation_args);
-    assert(temp.size() == m_dim_corr);
-
-    n_sweeps[j]++;
-    for (size_t k = 0; k < m_dim_corr; k++) {
-      result[j][k] += temp[k];
-    }
+    correlate(0, index_old, j);
   }
   // Now for the higher ones
   for (int i = 1; i < highest_level_to_compress + 2; i++) {
-    for (unsigned j = (m_tau_lin + 1) / 2 + 1;
-         j < min(m_tau_lin + 1, n_vals[i]); j++) {
-      auto const index_new = newest[i];
-      auto const index_old = (newest[i] - j + m_tau_lin + 1) % (m_tau_lin + 1);
-      auto const index_res =
-          m_tau_lin + (i - 1) * m_tau_lin / 2 + (j - m_tau_lin / 2 + 1) - 1;
-      auto const temp = (corr_operation)(A[i][index_old], B[i][index_new],
-                                         m_correlation_args);
-      assert(temp.size() == m_dim_corr);
-
-      n_sweeps[index_res]++;
-      for (size_t k = 0; k < m_dim_corr; k++) {
-        result[index_res][k] += temp[k];
-      }
-    }
+    correlate_level(i);
   }
 
   m_last_update = sim_time;
 }
 
+void Correlator::compress(int level) {
+  auto const first = (newest[level] + 1) % (m_tau_lin + 1);
+  auto const second = (newest[level] + 2) % (m_tau_lin + 1);
+  (*compressA)(entry(A, level, first), entry(A, level, second),
+               entry(A, level + 1, newest[level + 1]));
+  (*compressB)(entry(B, level, first), entry(B, level, second),
+               entry(B, level + 1, newest[level + 1]));
+}
+
+void Correlator::correlate(int level, size_t index_old, size_t index_res) {
+  n_sweeps[index_res]++;
+  (*corr_operation)(entry(A, level, index_old), entry(B, level, newest[level]),
+                    m_correlation_args,
+                    Utils::Span<double>(result[index_res].origin(), m_dim_corr));
+}
+
+void Correlator::correlate_level(int level) {
+  for (unsigned j = (m_tau_lin + 1) / 2 + 1;
+       j < min(m_tau_lin + 1, n_vals[level]); j++) {
+    auto const index_old =
+        (newest[level] - j + m_tau_lin + 1) % (m_tau_lin + 1);
+    auto const index_res =
+        m_tau_lin + (level - 1) * m_tau_lin / 2 + (j - m_tau_lin / 2 + 1) - 1;
+    correlate(level, index_old, index_res);
+  }
+}
+
 int Correlator::finalize() {
   if (finalized) {
     throw std::runtime_error("Correlator::finalize() can only be called once.");
@@ -473,33 +454,13 @@ int Correlator::finalize() {
         // folding)
         newest[i + 1] = (newest[i + 1] + 1) % (m_tau_lin + 1);
         n_vals[i + 1] += 1;
-
-        (*compressA)(A[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     A[i][(newest[i] + 2) % (m_tau_lin + 1)]);
-        (*compressB)(B[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     B[i][(newest[i] + 2) % (m_tau_lin + 1)]);
+        compress(i);
       }
       newest[ll] = (newest[ll] + 1) % (m_tau_lin + 1);
 
       // We only need to update correlation estimates for the higher levels
       for (int i = ll + 1; i < highest_level_to_compress + 2; i++) {
-        for (int j = (m_tau_lin + 1) / 2 + 1; j < min(m_tau_lin + 1, n_vals[i]);
-             j++) {
-          auto const index_new = newest[i];
-          auto const index_old =
-              (newest[i] - j + m_tau_lin + 1) % (m_tau_lin + 1);
-          auto const index_res =
-              m_tau_lin + (i - 1) * m_tau_lin / 2 + (j - m_tau_lin / 2 + 1) - 1;
-
-          auto const temp = (corr_operation)(A[i][index_old], B[i][index_new],
-                                             m_correlation_args);
-          assert(temp.size() == m_dim_corr);
-
-          n_sweeps[index_res]++;
-          for (size_t k = 0; k < m_dim_corr; k++) {
-            result[index_res][k] += temp[k];
-          }
-        }
+        correlate_level(i);
       }
     }
   }
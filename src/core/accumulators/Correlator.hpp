@@ -104,6 +104,7 @@
 #include "integrate.hpp"
 #include "observables/Observable.hpp"
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 
 #include <boost/multi_array.hpp>
@@ -125,6 +126,11 @@ namespace Accumulators {
  *  <tt>newest[i]</tt> always indicates the latest entry of the hierarchic
  *  "past" For every new entry in is incremented and if @c tau_lin is reached,
  *  it starts again from the beginning.
+ *
+ *  The ring buffers of all levels are stored contiguously, and the
+ *  compression and correlation operations work in place on them, so
+ *  that an update does not allocate memory besides the evaluation of
+ *  the observables.
  */
 class Correlator : public AccumulatorBase {
   using obs_ptr = std::shared_ptr<Observables::Observable>;
@@ -166,6 +172,20 @@ public:
 private:
   void initialize();
 
+  /** Entry @p index on hierarchy level @p level of a ring buffer. */
+  static Utils::Span<double> entry(boost::multi_array<double, 3> &buf,
+                                   int level, size_t index) {
+    return {buf[level][index].origin(), buf.shape()[2]};
+  }
+  /** Compress the two oldest entries of level @p level into the newest
+   *  entry of the next level. */
+  void compress(int level);
+  /** Add the correlation of the entry @p index_old with the newest
+   *  entry on level @p level to the result at @p index_res. */
+  void correlate(int level, size_t index_old, size_t index_res);
+  /** Update the correlation estimates of a compressed level. */
+  void correlate_level(int level);
+
 public:
   /** The function to process a new datapoint of A and B
    *
@@ -217,8 +237,8 @@ public:
 
   /** Partial serialization of state that is not accessible via the interface.
    */
-  std::string get_internal_state() const;
-  void set_internal_state(std::string const &);
+  std::string get_internal_state() const override;
+  void set_internal_state(std::string const &) override;
 
 private:
   bool finalized; ///< whether the correlation is finalized
@@ -243,8 +263,8 @@ private:
   std::shared_ptr<Observables::Observable> B_obs;
 
   std::vector<int> tau; ///< time differences
-  boost::multi_array<std::vector<double>, 2> A;
-  boost::multi_array<std::vector<double>, 2> B;
+  boost::multi_array<double, 3> A; ///< level, ring index, component
+  boost::multi_array<double, 3> B; ///< level, ring index, component
 
   boost::multi_array<double, 2> result; ///< output quantity
 
@@ -265,14 +285,18 @@ private:
   size_t dim_B;                ///< dimensionality of B
   std::vector<size_t> m_shape; ///< dimensionality of the correlation
 
-  using correlation_operation_type = std::vector<double> (*)(
-      std::vector<double> const &, std::vector<double> const &,
-      Utils::Vector3d const &);
+  /** Adds the correlation of two values to the result. */
+  using correlation_operation_type = void (*)(Utils::Span<const double>,
+                                              Utils::Span<const double>,
+                                              Utils::Vector3d const &,
+                                              Utils::Span<double>);
 
   correlation_operation_type corr_operation;
 
-  using compression_function = std::vector<double> (*)(
-      std::vector<double> const &A1, std::vector<double> const &A2);
+  /** Writes the compression of two values to the third argument. */
+  using compression_function = void (*)(Utils::Span<const double> A1,
+                                        Utils::Span<const double> A2,
+                                        Utils::Span<double> A_compressed);
 
   // compressing functions
   compression_function compressA;
@@ -44,8 +44,8 @@ public:
   std::vector<double> std_error();
   /* Partial serialization of state that is not accessible
      via the interface. */
-  std::string get_internal_state() const;
-  void set_internal_state(std::string const &);
+  std::string get_internal_state() const override;
+  void set_internal_state(std::string const &) override;
   std::vector<size_t> shape() const override { return m_obs->shape(); }
 
 private:
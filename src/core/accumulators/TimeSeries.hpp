@@ -44,8 +44,8 @@ public:
       : AccumulatorBase(delta_N), m_obs(std::move(obs)) {}
 
   void update() override;
-  std::string get_internal_state() const;
-  void set_internal_state(std::string const &);
+  std::string get_internal_state() const override;
+  void set_internal_state(std::string const &) override;
 
   const std::vector<std::vector<double>> &time_series() const { return m_data; }
   std::vector<size_t> shape() const override {
@@ -30,6 +30,7 @@
 #include "event.hpp"
 #include "grid.hpp"
 #include "integrate.hpp"
+#include "load_balancing.hpp"
 #include "particle_data.hpp"
 
 #include "DomainDecomposition.hpp"
@@ -47,6 +48,12 @@
 /** Type of cell structure in use */
 CellStructure cell_structure;
 
+/** Number of cells per interaction range of the domain decomposition */
+static int dd_cell_subdivision = 1;
+
+/** Order the domain decomposition along a space-filling curve */
+static bool dd_sfc_order = false;
+
 /**
  * @brief Get pairs closer than distance from the cells.
  *
@@ -130,10 +137,14 @@ std::vector<int> mpi_resort_particles(int global_flag) {
 
 void cells_re_init(int new_cs) {
   switch (new_cs) {
-  case CELL_STRUCTURE_DOMDEC:
-    cell_structure.set_domain_decomposition(comm_cart, interaction_range(),
-                                            box_geo, local_geo);
+  case CELL_STRUCTURE_DOMDEC: {
+    auto const range = interaction_range();
+    auto const balanced_geo = LoadBalancing::local_box(range);
+    cell_structure.set_domain_decomposition(
+        comm_cart, range, box_geo, balanced_geo ? *balanced_geo : local_geo,
+        static_cast<bool>(balanced_geo), dd_cell_subdivision, dd_sfc_order);
     break;
+  }
   case CELL_STRUCTURE_NSQUARE:
     cell_structure.set_atom_decomposition(comm_cart, box_geo);
     break;
@@ -214,3 +225,25 @@ REGISTER_CALLBACK(mpi_set_use_verlet_lists_local)
 void mpi_set_use_verlet_lists(bool use_verlet_lists) {
   mpi_call_all(mpi_set_use_verlet_lists_local, use_verlet_lists);
 }
+
+void mpi_set_cell_subdivision_local(int subdivision) {
+  dd_cell_subdivision = subdivision;
+}
+
+REGISTER_CALLBACK(mpi_set_cell_subdivision_local)
+
+void mpi_set_cell_subdivision(int subdivision) {
+  mpi_call_all(mpi_set_cell_subdivision_local, subdivision);
+}
+
+int cell_subdivision() { return dd_cell_subdivision; }
+
+void mpi_set_sfc_order_local(bool sfc_order) { dd_sfc_order = sfc_order; }
+
+REGISTER_CALLBACK(mpi_set_sfc_order_local)
+
+void mpi_set_sfc_order(bool sfc_order) {
+  mpi_call_all(mpi_set_sfc_order_local, sfc_order);
+}
+
+bool sfc_order() { return dd_sfc_order; }
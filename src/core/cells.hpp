@@ -76,6 +76,34 @@ void mpi_bcast_cell_structure(int cs);
  */
 void mpi_set_use_verlet_lists(bool use_verlet_lists);
 
+/**
+ * @brief Set the number of cells per interaction range of the domain
+ * decomposition. Takes effect at the next reinitialization of the cell
+ * system.
+ *
+ * @param subdivision Cells per interaction range, at least 1.
+ */
+void mpi_set_cell_subdivision(int subdivision);
+
+/** Get the number of cells per interaction range of the domain
+ *  decomposition.
+ */
+int cell_subdivision();
+
+/**
+ * @brief Order the local cells and the particles within the cells of the
+ * domain decomposition along a space-filling curve. Takes effect at the
+ * next reinitialization of the cell system.
+ *
+ * @param sfc_order Use the Morton order instead of the lexicographic one.
+ */
+void mpi_set_sfc_order(bool sfc_order);
+
+/** Whether the domain decomposition is ordered along a space-filling
+ *  curve.
+ */
+bool sfc_order();
+
 /** Update ghost information. If needed,
  *  the particles are also resorted.
  */
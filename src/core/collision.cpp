@@ -34,17 +34,23 @@
 #include <utils/Vector.hpp>
 #include <utils/constants.hpp>
 #include <utils/math/sqr.hpp>
-#include <utils/mpi/all_compare.hpp>
-#include <utils/mpi/gather_buffer.hpp>
+#include <utils/mpi/cart_comm.hpp>
+#include <utils/mpi/sendrecv.hpp>
 
 #include <boost/algorithm/clamp.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/mpi/collectives.hpp>
+#include <boost/mpi/nonblocking.hpp>
+#include <boost/range/algorithm/sort.hpp>
+#include <boost/range/algorithm/unique.hpp>
 #include <boost/serialization/serialization.hpp>
+#include <boost/serialization/vector.hpp>
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <numeric>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -54,6 +60,8 @@
 typedef struct {
   int pp1; // 1st particle id
   int pp2; // 2nd particle id
+  int vs1; // id of the virtual site related to the 1st particle
+  int vs2; // id of the virtual site related to the 2nd particle
 } collision_struct;
 
 namespace boost {
@@ -62,6 +70,8 @@ template <typename Archive>
 void serialize(Archive &ar, collision_struct &c, const unsigned int) {
   ar &c.pp1;
   ar &c.pp2;
+  ar &c.vs1;
+  ar &c.vs2;
 }
 } // namespace serialization
 } // namespace boost
@@ -85,6 +95,36 @@ Particle &get_part(int id) {
 
   return *p;
 }
+
+#ifdef VIRTUAL_SITES_RELATIVE
+/** Number of consecutive particle ids in a block of reserved ids. */
+constexpr int vs_id_block_size = 64;
+/** First particle id of the reserved blocks. */
+int vs_id_base = 0;
+/** Number of blocks this node has started. */
+int n_vs_id_blocks = 0;
+/** Next free id in the current block of this node. */
+int next_vs_id = 0;
+/** End of the current block of this node. */
+int vs_id_block_end = 0;
+
+/** @brief Get an unused particle id for a new virtual site.
+ *
+ *  The ids above @ref vs_id_base are split into blocks of
+ *  @ref vs_id_block_size ids, which are dealt out round-robin to the
+ *  nodes, so that every node can create particles with unique ids
+ *  without communication.
+ */
+int reserve_vs_id() {
+  if (next_vs_id == vs_id_block_end) {
+    auto const block = n_vs_id_blocks++ * comm_cart.size() + this_node;
+    next_vs_id = vs_id_base + block * vs_id_block_size;
+    vs_id_block_end = next_vs_id + vs_id_block_size;
+  }
+
+  return next_vs_id++;
+}
+#endif
 } // namespace
 
 /** @brief Return true if a bond between the centers of the colliding
@@ -251,10 +291,26 @@ bool validate_collision_parameters() {
   return true;
 }
 
+void collision_detection_on_integration_start() {
+#ifdef VIRTUAL_SITES_RELATIVE
+  if (not((collision_params.mode & COLLISION_MODE_VS) ||
+          (collision_params.mode & COLLISION_MODE_GLUE_TO_SURF)))
+    return;
+
+  // Particles may have been added since the last integration
+  vs_id_base = boost::mpi::all_reduce(
+                   comm_cart, cell_structure.get_max_local_particle_id(),
+                   boost::mpi::maximum<int>()) +
+               1;
+  n_vs_id_blocks = 0;
+  next_vs_id = vs_id_block_end = 0;
+#endif
+}
+
 void prepare_local_collision_queue() { local_collision_queue.clear(); }
 
 void queue_collision(const int part1, const int part2) {
-  local_collision_queue.push_back({part1, part2});
+  local_collision_queue.push_back({part1, part2, -1, -1});
 }
 
 /** @brief Calculate position of vs for GLUE_TO_SURFACE mode.
@@ -375,56 +431,179 @@ void place_vs_and_relate_to_particle(const int current_vs_pid,
   p_vs->p.type = collision_params.vs_particle_type;
 }
 
-void bind_at_poc_create_bond_between_vs(const int current_vs_pid,
-                                        const collision_struct &c) {
+void bind_at_poc_create_bond_between_vs(const collision_struct &c) {
   switch (bonded_ia_params[collision_params.bond_vs].num) {
   case 1: {
     // Create bond between the virtual particles
-    const int bondG[] = {current_vs_pid - 2};
+    const int bondG[] = {c.vs1};
     // Only add bond if vs was created on this node
-    if (cell_structure.get_local_particle(current_vs_pid - 1))
-      get_part(current_vs_pid - 1)
-          .bonds()
-          .insert({collision_params.bond_vs, bondG});
+    if (cell_structure.get_local_particle(c.vs2))
+      get_part(c.vs2).bonds().insert({collision_params.bond_vs, bondG});
     break;
   }
   case 2: {
     // Create 1st bond between the virtual particles
     const int bondG[] = {c.pp1, c.pp2};
     // Only add bond if vs was created on this node
-    if (cell_structure.get_local_particle(current_vs_pid - 1))
-      get_part(current_vs_pid - 1)
-          .bonds()
-          .insert({collision_params.bond_vs, bondG});
-    if (cell_structure.get_local_particle(current_vs_pid - 2))
-      get_part(current_vs_pid - 2)
-          .bonds()
-          .insert({collision_params.bond_vs, bondG});
+    if (cell_structure.get_local_particle(c.vs2))
+      get_part(c.vs2).bonds().insert({collision_params.bond_vs, bondG});
+    if (cell_structure.get_local_particle(c.vs1))
+      get_part(c.vs1).bonds().insert({collision_params.bond_vs, bondG});
     break;
   }
   }
 }
 
-void glue_to_surface_bind_part_to_vs(const Particle *const p1,
-                                     const Particle *const p2,
-                                     const int vs_pid_plus_one,
-                                     const collision_struct &c) {
-  // Create bond between the virtual particles
-  const int bondG[] = {vs_pid_plus_one - 1};
+/** @brief Place the virtual sites of a collision in the bind at point of
+ *  collision mode. Each node handles the particles it owns, the ids of the
+ *  virtual sites are assigned by the node that detected the collision.
+ */
+void bind_at_point_of_collision(const collision_struct &c) {
+  Particle *p1 = cell_structure.get_local_particle(c.pp1);
+  Particle *p2 = cell_structure.get_local_particle(c.pp2);
+
+  // Only nodes take part in particle creation and binding
+  // that see both particles and have at least one of them as non-ghost
+  if (!p1 or !p2 or (p1->l.ghost and p2->l.ghost))
+    return;
 
-  if (p1->p.type == collision_params.part_type_after_glueing) {
-    get_part(p1->p.identity).bonds().insert({collision_params.bond_vs, bondG});
-  } else {
-    get_part(p2->p.identity).bonds().insert({collision_params.bond_vs, bondG});
+  // Positions of the virtual sites
+  Utils::Vector3d pos1, pos2;
+  bind_at_point_of_collision_calc_vs_pos(p1, p2, pos1, pos2);
+
+  // place virtual sites on the node where the base particle is not a
+  // ghost
+  auto handle_particle = [](Particle *p, int vs_id,
+                            Utils::Vector3d const &pos) {
+    if (not p->l.ghost) {
+      // Enable rotation on the particle to which the vs will be attached
+      p->p.rotation = ROTATION_X | ROTATION_Y | ROTATION_Z;
+      place_vs_and_relate_to_particle(vs_id, pos, p->identity());
+    }
+  };
+
+  handle_particle(p1, c.vs1, pos1);
+  // Particle storage locations may have changed due to added particle
+  p2 = cell_structure.get_local_particle(c.pp2);
+  handle_particle(p2, c.vs2, pos2);
+
+  // Create bonds between the vs.
+  bind_at_poc_create_bond_between_vs(c);
+}
+
+/** @brief Glue a particle to the surface it collided with.
+ *
+ *  The collision is handled by the node owning the particle to be glued,
+ *  so that a particle can only be glued once, even if it is queued
+ *  several times in a single time step on different nodes. The particle
+ *  the virtual site is related to may be a ghost on that node.
+ */
+void glue_to_surface(const collision_struct &c) {
+  Particle *p1 = cell_structure.get_local_particle(c.pp1);
+  Particle *p2 = cell_structure.get_local_particle(c.pp2);
+
+  if (!p1 or !p2 or (p1->l.ghost and p2->l.ghost))
+    return;
+
+  // If particles are made inert by a type change on collision:
+  // We skip the pair if one of the particles has already reacted
+  if (collision_params.part_type_after_glueing !=
+      collision_params.part_type_to_be_glued) {
+    if ((p1->p.type == collision_params.part_type_after_glueing) ||
+        (p2->p.type == collision_params.part_type_after_glueing)) {
+      return;
+    }
   }
+
+  Utils::Vector3d pos;
+  const Particle &attach_vs_to = glue_to_surface_calc_vs_pos(*p1, *p2, pos);
+  Particle &glued = (&attach_vs_to == p1) ? *p2 : *p1;
+
+  if (glued.l.ghost)
+    return;
+
+  auto const glued_id = glued.identity();
+  auto const attach_vs_to_id = attach_vs_to.identity();
+
+  // Add a bond between the centers of the colliding particles
+  const int bondG[] = {attach_vs_to_id};
+  glued.bonds().insert({collision_params.bond_centers, bondG});
+
+  // Change type of particle being attached, to make it inert
+  glued.p.type = collision_params.part_type_after_glueing;
+
+  // Particle storage locations may change due to the added particle
+  auto const vs_id = reserve_vs_id();
+  place_vs_and_relate_to_particle(vs_id, pos, attach_vs_to_id);
+
+  // Create bond between the glued particle and the virtual site
+  const int bondVs[] = {vs_id};
+  get_part(glued_id).bonds().insert({collision_params.bond_vs, bondVs});
 }
 
 #endif
 
-std::vector<collision_struct> gather_global_collision_queue() {
-  std::vector<collision_struct> res = local_collision_queue;
-  Utils::Mpi::gather_buffer(res, comm_cart);
-  boost::mpi::broadcast(comm_cart, res, 0);
+/** @brief Ranks of the nodes that can have local particles of this node
+ *  as ghosts, and whose local particles can be ghosts on this node.
+ */
+std::vector<int> ghost_neighbor_ranks() {
+  std::vector<int> ret;
+
+  if (cell_structure.decomposition_type() == CELL_STRUCTURE_DOMDEC) {
+    auto const cart_info = Utils::Mpi::cart_get<3>(comm_cart);
+    Utils::Vector3i offset;
+    for (offset[0] = -1; offset[0] <= 1; offset[0]++) {
+      for (offset[1] = -1; offset[1] <= 1; offset[1]++) {
+        for (offset[2] = -1; offset[2] <= 1; offset[2]++) {
+          Utils::Vector3i pos;
+          for (int i = 0; i < 3; i++) {
+            pos[i] = (cart_info.coords[i] + offset[i] + cart_info.dims[i]) %
+                     cart_info.dims[i];
+          }
+          ret.push_back(Utils::Mpi::cart_rank(comm_cart, pos));
+        }
+      }
+    }
+  } else {
+    ret.resize(comm_cart.size());
+    std::iota(ret.begin(), ret.end(), 0);
+  }
+
+  ret.erase(std::remove(ret.begin(), ret.end(), this_node), ret.end());
+  ret.erase(boost::unique(boost::sort(ret)).end(), ret.end());
+
+  return ret;
+}
+
+/** @brief Exchange collisions with the nodes that see the particles
+ *  involved.
+ *
+ *  A collision between a local particle and a ghost is only in the queue
+ *  of one node, but the node owning the ghost may still have to change
+ *  its non-ghost particle. The particles of a collision are at most one
+ *  interaction range apart, so only the neighbors in the ghost
+ *  communication need to know about it.
+ *
+ *  @param queue Collisions to send to all neighbors.
+ *  @return Collisions received from the neighbors.
+ */
+std::vector<collision_struct>
+exchange_collision_queue(std::vector<collision_struct> const &queue) {
+  auto const neighbors = ghost_neighbor_ranks();
+  std::vector<std::vector<collision_struct>> recv_queues(neighbors.size());
+  std::vector<boost::mpi::request> requests;
+
+  for (std::size_t i = 0; i < neighbors.size(); i++) {
+    auto const reqs = Utils::Mpi::isendrecv(comm_cart, neighbors[i], 0, queue,
+                                            neighbors[i], 0, recv_queues[i]);
+    requests.insert(requests.end(), reqs.begin(), reqs.end());
+  }
+  boost::mpi::wait_all(requests.begin(), requests.end());
+
+  std::vector<collision_struct> res;
+  for (auto const &q : recv_queues) {
+    res.insert(res.end(), q.begin(), q.end());
+  }
 
   return res;
 }
@@ -470,9 +649,9 @@ static void three_particle_binding_do_search(Cell *basecell, Particle &p1,
 // looks for a third particle by using the domain decomposition
 // cell system. If found, it performs three particle binding
 void three_particle_binding_domain_decomposition(
-    const std::vector<collision_struct> &gathered_queue) {
+    const std::vector<collision_struct> &queue) {
 
-  for (auto &c : gathered_queue) {
+  for (auto &c : queue) {
     // If we have both particles, at least as ghosts, Get the corresponding cell
     // indices
     if (cell_structure.get_local_particle(c.pp1) &&
@@ -519,162 +698,66 @@ void handle_collisions() {
     }
   }
 
-// Virtual sites based collision schemes
-#ifdef VIRTUAL_SITES_RELATIVE
-  if ((collision_params.mode & COLLISION_MODE_VS) ||
-      (collision_params.mode & COLLISION_MODE_GLUE_TO_SURF)) {
-    // Gather the global collision queue, because only one node has a collision
-    // across node boundaries in its queue.
-    // The other node might still have to change particle properties on its
-    // non-ghost particle
-    auto gathered_queue = gather_global_collision_queue();
-
-    // Sync max_seen_part
-    auto const global_max_seen_particle = boost::mpi::all_reduce(
-        comm_cart, cell_structure.get_max_local_particle_id(),
-        boost::mpi::maximum<int>());
-
-    int current_vs_pid = global_max_seen_particle + 1;
-
-    // Iterate over global collision queue
-    for (auto &c : gathered_queue) {
-
-      // Get particle pointers
-      Particle *p1 = cell_structure.get_local_particle(c.pp1);
-      Particle *p2 = cell_structure.get_local_particle(c.pp2);
-
-      // Only nodes take part in particle creation and binding
-      // that see both particles
-
-      // If we cannot access both particles, both are ghosts,
-      // or one is ghost and one is not accessible
-      // we only increase the counter for the ext id to use based on the
-      // number of particles created by other nodes
-      if (((!p1 or p1->l.ghost) and (!p2 or p2->l.ghost)) or !p1 or !p2) {
-        // Increase local counters
-        if (collision_params.mode & COLLISION_MODE_VS) {
-          current_vs_pid++;
-        }
-        // For glue to surface, we have only one vs
-        current_vs_pid++;
-        if (collision_params.mode == COLLISION_MODE_GLUE_TO_SURF) {
-          if (p1)
-            if (p1->p.type == collision_params.part_type_to_be_glued) {
-              p1->p.type = collision_params.part_type_after_glueing;
-            }
-          if (p2)
-            if (p2->p.type == collision_params.part_type_to_be_glued) {
-              p2->p.type = collision_params.part_type_after_glueing;
-            }
-        } // mode glue to surface
-
-      } else { // We consider the pair because one particle
-               // is local to the node and the other is local or ghost
-        // If we are in the two vs mode
-        // Virtual site related to first particle in the collision
-        if (collision_params.mode & COLLISION_MODE_VS) {
-          Utils::Vector3d pos1, pos2;
-
-          // Enable rotation on the particles to which vs will be attached
-          p1->p.rotation = ROTATION_X | ROTATION_Y | ROTATION_Z;
-          p2->p.rotation = ROTATION_X | ROTATION_Y | ROTATION_Z;
-
-          // Positions of the virtual sites
-          bind_at_point_of_collision_calc_vs_pos(p1, p2, pos1, pos2);
-
-          auto handle_particle = [&](Particle *p, Utils::Vector3d const &pos) {
-            if (not p->l.ghost) {
-              place_vs_and_relate_to_particle(current_vs_pid, pos,
-                                              p->identity());
-              // Particle storage locations may have changed due to
-              // added particle
-              p1 = cell_structure.get_local_particle(c.pp1);
-              p2 = cell_structure.get_local_particle(c.pp2);
-            }
-          };
-
-          // place virtual sites on the node where the base particle is not a
-          // ghost
-          handle_particle(p1, pos1);
-          // Increment counter
-          current_vs_pid++;
-
-          handle_particle(p2, pos2);
-          // Increment counter
-          current_vs_pid++;
-          // Create bonds between the vs.
-
-          bind_at_poc_create_bond_between_vs(current_vs_pid, c);
-        } // mode VS
-
-        if (collision_params.mode & COLLISION_MODE_GLUE_TO_SURF) {
-          // If particles are made inert by a type change on collision:
-          // We skip the pair if one of the particles has already reacted
-          // but we still increase the particle counters, as other nodes
-          // can not always know whether or not a vs is placed
-          if (collision_params.part_type_after_glueing !=
-              collision_params.part_type_to_be_glued) {
-            if ((p1->p.type == collision_params.part_type_after_glueing) ||
-                (p2->p.type == collision_params.part_type_after_glueing)) {
-              current_vs_pid++;
-              continue;
-            }
-          }
-
-          Utils::Vector3d pos;
-          const Particle &attach_vs_to =
-              glue_to_surface_calc_vs_pos(*p1, *p2, pos);
+  auto const vs_based = (collision_params.mode & COLLISION_MODE_VS) ||
+                        (collision_params.mode & COLLISION_MODE_GLUE_TO_SURF);
+  auto const three_particle_binding =
+      collision_params.mode & COLLISION_MODE_BIND_THREE_PARTICLES;
 
-          // Add a bond between the centers of the colliding particles
-          // The bond is placed on the node that has p1
-          if (!p1->l.ghost) {
-            const int bondG[] = {c.pp2};
-            get_part(c.pp1).bonds().insert(
-                {collision_params.bond_centers, bondG});
-          }
-
-          // Change type of particle being attached, to make it inert
-          if (p1->p.type == collision_params.part_type_to_be_glued) {
-            p1->p.type = collision_params.part_type_after_glueing;
-          }
-          if (p2->p.type == collision_params.part_type_to_be_glued) {
-            p2->p.type = collision_params.part_type_after_glueing;
-          }
+  if (not(vs_based or three_particle_binding)) {
+    local_collision_queue.clear();
+    return;
+  }
 
-          // Vs placement happens on the node that has p1
-          if (!attach_vs_to.l.ghost) {
-            place_vs_and_relate_to_particle(current_vs_pid, pos,
-                                            attach_vs_to.identity());
-            // Particle storage locations may have changed due to
-            // added particle
-            p1 = cell_structure.get_local_particle(c.pp1);
-            p2 = cell_structure.get_local_particle(c.pp2);
-            current_vs_pid++;
-          } else { // Just update the books
-            current_vs_pid++;
-          }
-          glue_to_surface_bind_part_to_vs(p1, p2, current_vs_pid, c);
-        }
-      } // we considered the pair
-    }   // Loop over all collisions in the queue
-#ifdef ADDITIONAL_CHECKS
-    if (!Utils::Mpi::all_compare(comm_cart, current_vs_pid)) {
-      throw std::runtime_error("Nodes disagree about current_vs_pid");
+#ifdef VIRTUAL_SITES_RELATIVE
+  // The node that detected the collision assigns the ids of both virtual
+  // sites, so that the nodes owning the particles agree on them
+  if (collision_params.mode & COLLISION_MODE_VS) {
+    for (auto &c : local_collision_queue) {
+      c.vs1 = reserve_vs_id();
+      c.vs2 = reserve_vs_id();
     }
+  }
 #endif
 
-    // If any node had a collision, all nodes need to resort
-    if (!gathered_queue.empty()) {
-      cell_structure.set_resort_particles(Cells::RESORT_GLOBAL);
-      cells_update_ghosts(Cells::DATA_PART_PROPERTIES | Cells::DATA_PART_BONDS);
+  // The third particle can be a local particle of any node that sees
+  // both colliding particles, for the other modes only collisions
+  // with a ghost concern the neighbors
+  std::vector<collision_struct> send_queue;
+  std::copy_if(local_collision_queue.begin(), local_collision_queue.end(),
+               std::back_inserter(send_queue),
+               [three_particle_binding](collision_struct const &c) {
+                 return three_particle_binding or
+                        cell_structure.get_local_particle(c.pp1)->l.ghost or
+                        cell_structure.get_local_particle(c.pp2)->l.ghost;
+               });
+
+  auto queue = exchange_collision_queue(send_queue);
+  queue.insert(queue.begin(), local_collision_queue.begin(),
+               local_collision_queue.end());
+
+// Virtual sites based collision schemes
+#ifdef VIRTUAL_SITES_RELATIVE
+  if (vs_based) {
+    for (auto const &c : queue) {
+      if (collision_params.mode & COLLISION_MODE_VS) {
+        bind_at_point_of_collision(c);
+      }
+      if (collision_params.mode & COLLISION_MODE_GLUE_TO_SURF) {
+        glue_to_surface(c);
+      }
     }
+
+    // Adding a virtual site marks the particles for resorting. The new
+    // virtual sites need ghosts before their positions are updated, so
+    // all nodes resort now if any node added particles. Otherwise, this
+    // only reduces the resort flag.
+    cells_update_ghosts(Cells::DATA_PART_PROPERTIES | Cells::DATA_PART_BONDS);
   }    // are we in one of the vs_based methods
 #endif // defined VIRTUAL_SITES_RELATIVE
 
   // three-particle-binding part
-  if (collision_params.mode & (COLLISION_MODE_BIND_THREE_PARTICLES)) {
-    auto gathered_queue = gather_global_collision_queue();
-    three_particle_binding_domain_decomposition(gathered_queue);
+  if (three_particle_binding) {
+    three_particle_binding_domain_decomposition(queue);
   } // if TPB
 
   local_collision_queue.clear();
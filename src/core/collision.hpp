@@ -97,6 +97,13 @@ extern Collision_parameters collision_params;
 
 #ifdef COLLISION_DETECTION
 
+/** @brief Reserve the particle ids for the virtual sites created during
+ *  the integration. Every node gets its own blocks of ids, so that the
+ *  collisions can be handled without global communication.
+ *  Has to be called on all nodes.
+ */
+void collision_detection_on_integration_start();
+
 void prepare_local_collision_queue();
 
 /// Handle the collisions recorded in the queue
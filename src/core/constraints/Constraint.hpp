@@ -23,6 +23,11 @@
 #include "Particle.hpp"
 #include "energy.hpp"
 
+#include <utils/Vector.hpp>
+
+#include <limits>
+#include <utility>
+
 namespace Constraints {
 class Constraint {
 public:
@@ -53,6 +58,20 @@ public:
    */
   virtual bool fits_in_box(Utils::Vector3d const &box) const = 0;
 
+  /**
+   * @brief Region in which the constraint can act on particles.
+   *
+   * Particles with a folded position outside of this axis-aligned box
+   * are skipped by @ref Constraints::add_forces and
+   * @ref Constraints::add_energy. By default the region is unbounded.
+   *
+   * @return Lower and upper corner of the box.
+   */
+  virtual std::pair<Utils::Vector3d, Utils::Vector3d> bounding_box() const {
+    auto const inf = std::numeric_limits<double>::infinity();
+    return {Utils::Vector3d::broadcast(-inf), Utils::Vector3d::broadcast(inf)};
+  }
+
   virtual void reset_force(){};
 
   virtual ~Constraint() = default;
@@ -19,11 +19,18 @@
 #ifndef CORE_CONSTRAINTS_CONSTRAINTS_HPP
 #define CORE_CONSTRAINTS_CONSTRAINTS_HPP
 
+#include "CellStructure.hpp"
 #include "Observable_stat.hpp"
 #include "grid.hpp"
+#include "integrate.hpp"
 #include "statistics.hpp"
 
+#include <utils/Vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <utility>
 #include <vector>
 
 void on_constraint_change();
@@ -46,6 +53,96 @@ private:
 
   container_type m_constraints;
 
+  using box_type = std::pair<Utils::Vector3d, Utils::Vector3d>;
+  /** Interaction regions of the constraints, in container order. */
+  std::vector<box_type> m_bounds;
+  /** Indices of the constraints which can act on the particles of
+   *  each local cell.
+   */
+  std::vector<std::vector<std::size_t>> m_cell_constraints;
+  bool m_cell_constraints_valid = false;
+
+  static bool contains(box_type const &box, Utils::Vector3d const &pos) {
+    for (int i = 0; i < 3; i++) {
+      if (pos[i] < box.first[i] or pos[i] > box.second[i])
+        return false;
+    }
+    return true;
+  }
+
+  /** Check if a constraint region can contain the folded position of a
+   *  particle from a cell. The particles may have moved by up to half
+   *  the skin since they were sorted into the cell, and are folded
+   *  back into the box in periodic directions.
+   */
+  static bool overlaps(box_type const &constraint, box_type const &cell) {
+    auto const margin = std::max(skin, 0.);
+    for (int i = 0; i < 3; i++) {
+      auto const lower = cell.first[i] - margin;
+      auto const upper = cell.second[i] + margin;
+      auto const overlaps_image = [&](double shift) {
+        return constraint.first[i] <= upper + shift and
+               lower + shift <= constraint.second[i];
+      };
+      auto const l = box_geo.length()[i];
+      if (not(overlaps_image(0.) or
+              (box_geo.periodic(i) and
+               (overlaps_image(-l) or overlaps_image(l)))))
+        return false;
+    }
+    return true;
+  }
+
+  /** Update the interaction regions and, if they or the cells changed,
+   *  the per-cell constraint lists.
+   */
+  void update_cell_constraints(CellStructure &cs) {
+    std::vector<box_type> bounds;
+    bounds.reserve(m_constraints.size());
+    for (auto const &c : *this) {
+      bounds.emplace_back(c->bounding_box());
+    }
+
+    auto const n_cells = static_cast<std::size_t>(cs.n_local_cells());
+    if (m_cell_constraints_valid and bounds == m_bounds and
+        m_cell_constraints.size() == n_cells)
+      return;
+
+    m_bounds = std::move(bounds);
+    m_cell_constraints.assign(n_cells, {});
+    for (std::size_t i = 0; i < n_cells; i++) {
+      auto const cell_box =
+          cs.decomposition().local_cell_bounds(static_cast<int>(i));
+      for (std::size_t j = 0; j < m_constraints.size(); j++) {
+        if (overlaps(m_bounds[j], cell_box)) {
+          m_cell_constraints[i].push_back(j);
+        }
+      }
+    }
+    m_cell_constraints_valid = true;
+  }
+
+  /** Call @p f for every particle of @p cs and every constraint whose
+   *  interaction region contains the folded particle position.
+   */
+  template <class F> void for_each_interacting(CellStructure &cs, F f) {
+    update_cell_constraints(cs);
+
+    cs.local_cells_loop([this, &f](int i, ParticleList &particles) {
+      auto const &constraints = m_cell_constraints[i];
+      if (constraints.empty())
+        return;
+
+      for (auto &p : particles) {
+        auto const pos = folded_position(p.r.p, box_geo);
+        for (auto const j : constraints) {
+          if (contains(m_bounds[j], pos))
+            f(p, pos, *m_constraints[j]);
+        }
+      }
+    });
+  }
+
 public:
   void add(std::shared_ptr<Constraint> const &c) {
     if (not c->fits_in_box(box_geo.length())) {
@@ -53,12 +150,14 @@ public:
     }
 
     m_constraints.emplace_back(c);
+    m_cell_constraints_valid = false;
     on_constraint_change();
   }
   void remove(std::shared_ptr<Constraint> const &c) {
     m_constraints.erase(
         std::remove(m_constraints.begin(), m_constraints.end(), c),
         m_constraints.end());
+    m_cell_constraints_valid = false;
     on_constraint_change();
   }
 
@@ -67,34 +166,34 @@ public:
   const_iterator begin() const { return m_constraints.begin(); }
   const_iterator end() const { return m_constraints.end(); }
 
-  void add_forces(ParticleRange &particles, double t) const {
+  /** Add the constraint forces to the local particles of @p cs. */
+  void add_forces(CellStructure &cs, double t) {
     if (m_constraints.empty())
       return;
 
     reset_forces();
 
-    for (auto &p : particles) {
-      auto const pos = folded_position(p.r.p, box_geo);
-      ParticleForce force{};
-      for (auto const &c : *this) {
-        force += c->force(p, pos, t);
-      }
-
-      p.f += force;
-    }
+    for_each_interacting(
+        cs, [t](Particle &p, Utils::Vector3d const &pos, Constraint &c) {
+          p.f += c.force(p, pos, t);
+        });
   }
 
-  void add_energy(const ParticleRange &particles, double t,
-                  Observable_stat &energy) const {
-    for (auto &p : particles) {
-      auto const pos = folded_position(p.r.p, box_geo);
+  /** Add the constraint energies of the local particles of @p cs. */
+  void add_energy(CellStructure &cs, double t, Observable_stat &energy) {
+    if (m_constraints.empty())
+      return;
 
-      for (auto const &c : *this) {
-        c->add_energy(p, pos, t, energy);
-      }
-    }
+    for_each_interacting(cs, [t, &energy](Particle const &p,
+                                          Utils::Vector3d const &pos,
+                                          Constraint const &c) {
+      c.add_energy(p, pos, t, energy);
+    });
   }
 
+  /** Invalidate the per-cell constraint lists. */
+  void on_cell_structure_change() { m_cell_constraints_valid = false; }
+
   void on_boxl_change() const {
     if (not this->empty()) {
       throw std::runtime_error("The box size can not be changed because there "
@@ -38,6 +38,7 @@
 #include <functional>
 #include <limits>
 #include <numeric>
+#include <utility>
 
 namespace Constraints {
 Utils::Vector3d ShapeBasedConstraint::total_force() const {
@@ -70,6 +71,25 @@ double ShapeBasedConstraint::min_dist(const ParticleRange &particles) {
   return global_mindist;
 }
 
+std::pair<Utils::Vector3d, Utils::Vector3d>
+ShapeBasedConstraint::bounding_box() const {
+#ifdef DPD
+  /* The DPD noise consumes random numbers for every evaluated pair,
+   * so the particles cannot be skipped. */
+  if (thermo_switch & THERMO_DPD)
+    return Constraint::bounding_box();
+#endif
+  double max_cut = 0.;
+  for (int type = 0; type < max_seen_particle_type; type++) {
+    max_cut = std::max(max_cut, get_ia_param(type, part_rep.p.type)->max_cut);
+  }
+
+  auto box = m_shape->bounding_box();
+  box.first -= Utils::Vector3d::broadcast(max_cut);
+  box.second += Utils::Vector3d::broadcast(max_cut);
+  return box;
+}
+
 ParticleForce ShapeBasedConstraint::force(Particle const &p,
                                           Utils::Vector3d const &folded_pos,
                                           double t) {
@@ -31,6 +31,7 @@
 #include <utils/Vector.hpp>
 
 #include <memory>
+#include <utility>
 
 namespace Constraints {
 
@@ -50,6 +51,11 @@ public:
 
   bool fits_in_box(Utils::Vector3d const &) const override { return true; }
 
+  /** Bounding box of the shape, enlarged by the largest interaction
+   *  range of the constraint type.
+   */
+  std::pair<Utils::Vector3d, Utils::Vector3d> bounding_box() const override;
+
   /* finds the minimum distance to all particles */
   double min_dist(const ParticleRange &particles);
 
@@ -50,6 +50,7 @@
 #include <cassert>
 #include <cstdio>
 #include <limits>
+#include <utility>
 
 Coulomb_parameters coulomb;
 
@@ -247,6 +248,17 @@ void init() {
   }
 }
 
+namespace {
+/** Add fields from EK if enabled */
+void add_ek_coupling() {
+#ifdef ELECTROKINETICS
+  if (this_node == 0) {
+    ek_calculate_electrostatic_coupling();
+  }
+#endif
+}
+} // namespace
+
 void calc_long_range_force(const ParticleRange &particles) {
   switch (coulomb.method) {
 #ifdef P3M
@@ -298,12 +310,7 @@ void calc_long_range_force(const ParticleRange &particles) {
     break;
   }
 
-  /* Add fields from EK if enabled */
-#ifdef ELECTROKINETICS
-  if (this_node == 0) {
-    ek_calculate_electrostatic_coupling();
-  }
-#endif
+  add_ek_coupling();
 }
 
 double calc_energy_long_range(const ParticleRange &particles) {
@@ -359,6 +366,31 @@ double calc_energy_long_range(const ParticleRange &particles) {
   return energy;
 }
 
+std::pair<double, Utils::Vector9d>
+calc_long_range_force_energy_pressure(const ParticleRange &particles,
+                                      bool energy_flag, bool pressure_flag) {
+#ifdef P3M
+  if (coulomb.method == COULOMB_P3M) {
+    Utils::Vector9d pressure{};
+    p3m_charge_assign(particles);
+    auto const energy = p3m_calc_kspace_forces(
+        true, true, particles, pressure_flag ? &pressure : nullptr);
+#ifdef NPT
+    if (integ_switch == INTEG_METHOD_NPT_ISO)
+      nptiso.p_vir[0] += energy;
+#endif
+    add_ek_coupling();
+    return {energy, pressure};
+  }
+#endif
+
+  calc_long_range_force(particles);
+  auto const energy = energy_flag ? calc_energy_long_range(particles) : 0.;
+  if (pressure_flag)
+    return {energy, calc_pressure_long_range(particles)};
+  return {energy, {}};
+}
+
 int iccp3m_sanity_check() {
   switch (coulomb.method) {
 #ifdef P3M
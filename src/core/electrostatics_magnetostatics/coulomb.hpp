@@ -22,6 +22,7 @@
 #include "config.hpp"
 
 #include <cstddef>
+#include <utility>
 
 #ifdef ELECTROSTATICS
 
@@ -75,6 +76,22 @@ void calc_long_range_force(const ParticleRange &particles);
 
 double calc_energy_long_range(const ParticleRange &particles);
 
+/** @brief Calculate the long-range forces together with the long-range
+ *  energy and/or pressure tensor.
+ *
+ *  P3M obtains all of them from a single forward FFT of the charge mesh,
+ *  the other methods evaluate them one after the other.
+ *
+ *  @param particles      The local particles.
+ *  @param energy_flag    Whether to calculate the energy.
+ *  @param pressure_flag  Whether to calculate the pressure tensor.
+ *  @return The energy (on the head node) and the pressure tensor
+ *  (of this node).
+ */
+std::pair<double, Utils::Vector9d>
+calc_long_range_force_energy_pressure(const ParticleRange &particles,
+                                      bool energy_flag, bool pressure_flag);
+
 int iccp3m_sanity_check();
 
 int elc_sanity_check();
@@ -191,6 +191,9 @@ void calc_long_range_force(const ParticleRange &particles) {
   case DIPOLAR_DS:
     magnetic_dipolar_direct_sum_calculations(true, false, particles);
     break;
+  case DIPOLAR_BH_CPU:
+    bh_cpu_calculations(true, false, particles);
+    break;
   case DIPOLAR_DS_GPU: // NOLINT(bugprone-branch-clone)
     // do nothing: it's an actor
     break;
@@ -238,6 +241,9 @@ double calc_energy_long_range(const ParticleRange &particles) {
   case DIPOLAR_DS:
     energy = magnetic_dipolar_direct_sum_calculations(false, true, particles);
     break;
+  case DIPOLAR_BH_CPU:
+    energy = bh_cpu_calculations(false, true, particles);
+    break;
   case DIPOLAR_DS_GPU: // NOLINT(bugprone-branch-clone)
     // do nothing: it's an actor
     break;
@@ -289,7 +295,16 @@ void bcast_params(const boost::mpi::communicator &comm) {
   case DIPOLAR_P3M:
     mpi::broadcast(comm, dp3m.params, 0);
     break;
+  case DIPOLAR_MDLC_DS:
+    mpi::broadcast(comm, dlc_params, 0);
+    // fall through
 #endif
+  case DIPOLAR_DS:
+    mpi::broadcast(comm, Ncut_off_magnetic_dipolar_direct_sum, 0);
+    break;
+  case DIPOLAR_BH_CPU:
+    mpi::broadcast(comm, bh_cpu_theta, 0);
+    break;
   default:
     break;
   }
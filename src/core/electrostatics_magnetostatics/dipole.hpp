@@ -54,7 +54,9 @@ enum DipolarInteraction {
   DIPOLAR_BH_GPU,
 #endif
   /** Dipolar method is ScaFaCoS. */
-  DIPOLAR_SCAFACOS
+  DIPOLAR_SCAFACOS,
+  /** Dipolar method is the Barnes-Hut algorithm on CPU. */
+  DIPOLAR_BH_CPU
 };
 
 /** Interaction parameters for the %dipole interaction. */
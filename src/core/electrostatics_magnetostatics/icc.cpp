@@ -43,12 +43,15 @@
 
 #include <utils/Vector.hpp>
 #include <utils/constants.hpp>
+#include <utils/math/anderson_mixing.hpp>
 
 #include <mpi.h>
 
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
 #include <tuple>
+#include <vector>
 
 iccp3m_struct iccp3m_cfg;
 
@@ -104,6 +107,28 @@ int iccp3m_iteration(const ParticleRange &particles,
   auto const pref = 1.0 / (coulomb.prefactor * 2 * Utils::pi());
   iccp3m_cfg.citeration = 0;
 
+  /* The particles do not move during the iteration, so the local
+   * induced charges can be collected once. Their current charges
+   * (from the previous time step) are the initial guess. */
+  std::vector<Particle *> icc_particles;
+  for (auto &p : particles) {
+    if (p.p.identity < iccp3m_cfg.n_ic + iccp3m_cfg.first_id &&
+        p.p.identity >= iccp3m_cfg.first_id) {
+      icc_particles.push_back(&p);
+    }
+  }
+
+  /* Surface charge densities: current iterate and fixed-point map */
+  std::vector<double> sigma_old(icc_particles.size());
+  std::vector<double> sigma_new(icc_particles.size());
+  std::vector<double> sigma_target(icc_particles.size());
+
+  Utils::AndersonMixing mixer(iccp3m_cfg.mixing_depth, iccp3m_cfg.relax);
+  auto const sum_all = [](std::vector<double> &buf) {
+    MPI_Allreduce(MPI_IN_PLACE, buf.data(), static_cast<int>(buf.size()),
+                  MPI_DOUBLE, MPI_SUM, comm_cart);
+  };
+
   double globalmax = 1e100;
 
   for (int j = 0; j < iccp3m_cfg.num_iteration; j++) {
@@ -115,64 +140,74 @@ int iccp3m_iteration(const ParticleRange &particles,
 
     double diff = 0;
 
-    for (auto &p : particles) {
-      if (p.p.identity < iccp3m_cfg.n_ic + iccp3m_cfg.first_id &&
-          p.p.identity >= iccp3m_cfg.first_id) {
-        auto const id = p.p.identity - iccp3m_cfg.first_id;
-        /* the dielectric-related prefactor: */
-        auto const del_eps = (iccp3m_cfg.ein[id] - iccp3m_cfg.eout) /
-                             (iccp3m_cfg.ein[id] + iccp3m_cfg.eout);
-        /* calculate the electric field at the certain position */
-        auto const E = p.f.f / p.p.q + iccp3m_cfg.ext_field;
-
-        if (E[0] == 0 && E[1] == 0 && E[2] == 0) {
-          runtimeErrorMsg()
-              << "ICCP3M found zero electric field on a charge. This must "
-                 "never happen";
-        }
-
-        /* recalculate the old charge density */
-        auto const hold = p.p.q / iccp3m_cfg.areas[id];
-        /* determine if it is higher than the previously highest charge
-         * density */
-        hmax = std::max(hmax, std::abs(hold));
-
-        auto const f1 = del_eps * pref * (E * iccp3m_cfg.normals[id]);
-        auto const f2 = (not iccp3m_cfg.sigma.empty())
-                            ? (2 * iccp3m_cfg.eout) /
-                                  (iccp3m_cfg.eout + iccp3m_cfg.ein[id]) *
-                                  (iccp3m_cfg.sigma[id])
-                            : 0.;
-        /* relative variation: never use an estimator which can be negative
-         * here */
-        auto const hnew =
-            (1. - iccp3m_cfg.relax) * hold + (iccp3m_cfg.relax) * (f1 + f2);
-
-        /* Take the largest error to check for convergence */
-        auto const relative_difference =
-            std::abs(1 * (hnew - hold) / (hmax + std::abs(hnew + hold)));
-
-        diff = std::max(diff, relative_difference);
-
-        p.p.q = hnew * iccp3m_cfg.areas[id];
-
-        /* check if the charge now is more than 1e6, to determine if ICC still
-         * leads to reasonable results */
-        /* this is kind of an arbitrary measure but does a good job spotting
-         * divergence! */
-        if (std::abs(p.p.q) > 1e6) {
-          runtimeErrorMsg()
-              << "too big charge assignment in iccp3m! q >1e6 , assigned "
-                 "charge= "
-              << p.p.q;
-
-          diff = 1e90; /* A very high value is used as error code */
-          break;
-        }
+    for (size_t i = 0; i < icc_particles.size(); i++) {
+      auto const &p = *icc_particles[i];
+      auto const id = p.p.identity - iccp3m_cfg.first_id;
+      /* the dielectric-related prefactor: */
+      auto const del_eps = (iccp3m_cfg.ein[id] - iccp3m_cfg.eout) /
+                           (iccp3m_cfg.ein[id] + iccp3m_cfg.eout);
+      /* calculate the electric field at the certain position */
+      auto const E = p.f.f / p.p.q + iccp3m_cfg.ext_field;
+
+      if (E[0] == 0 && E[1] == 0 && E[2] == 0) {
+        runtimeErrorMsg()
+            << "ICCP3M found zero electric field on a charge. This must "
+               "never happen";
+      }
+
+      /* recalculate the old charge density */
+      auto const hold = p.p.q / iccp3m_cfg.areas[id];
+      /* determine if it is higher than the previously highest charge
+       * density */
+      hmax = std::max(hmax, std::abs(hold));
+
+      auto const f1 = del_eps * pref * (E * iccp3m_cfg.normals[id]);
+      auto const f2 = (not iccp3m_cfg.sigma.empty())
+                          ? (2 * iccp3m_cfg.eout) /
+                                (iccp3m_cfg.eout + iccp3m_cfg.ein[id]) *
+                                (iccp3m_cfg.sigma[id])
+                          : 0.;
+
+      sigma_old[i] = hold;
+      sigma_target[i] = f1 + f2;
+    }
+
+    /* Relaxed (or Anderson-accelerated) update of the charge densities.
+     * The mixing involves a global reduction and is therefore
+     * executed on all nodes, even without local induced charges. */
+    sigma_new = sigma_old;
+    mixer.update(sigma_new, sigma_target, sum_all);
+
+    for (size_t i = 0; i < icc_particles.size(); i++) {
+      auto &p = *icc_particles[i];
+      auto const id = p.p.identity - iccp3m_cfg.first_id;
+      auto const hold = sigma_old[i];
+      auto const hnew = sigma_new[i];
+
+      /* Take the largest error to check for convergence */
+      auto const relative_difference =
+          std::abs(1 * (hnew - hold) / (hmax + std::abs(hnew + hold)));
+
+      diff = std::max(diff, relative_difference);
+
+      p.p.q = hnew * iccp3m_cfg.areas[id];
+
+      /* check if the charge now is more than 1e6, to determine if ICC still
+       * leads to reasonable results */
+      /* this is kind of an arbitrary measure but does a good job spotting
+       * divergence! */
+      if (std::abs(p.p.q) > 1e6) {
+        runtimeErrorMsg()
+            << "too big charge assignment in iccp3m! q >1e6 , assigned "
+               "charge= "
+            << p.p.q;
+
+        diff = 1e90; /* A very high value is used as error code */
+        break;
       }
     } /* cell particles */
     /* Update charges on ghosts. */
-    cell_structure.ghosts_update(Cells::DATA_PART_PROPERTIES);
+    cell_structure.ghosts_update(Cells::DATA_PART_CHARGE);
 
     iccp3m_cfg.citeration++;
 
@@ -71,6 +71,9 @@ struct iccp3m_struct {
   std::vector<Utils::Vector3d> normals;  /**< Surface normal vectors */
   Utils::Vector3d ext_field = {0, 0, 0}; /**< External field */
   double relax = 0.7; /**< relaxation parameter for iteration */
+  /** Number of previous iterates used for Anderson mixing
+   *  (0: plain relaxed iteration) */
+  int mixing_depth = 0;
   int citeration = 0; /**< current number of iterations */
   int first_id = 0; /**< id of the first particle in the dielectric boundary */
 
@@ -82,6 +85,7 @@ struct iccp3m_struct {
     ar &convergence;
     ar &eout;
     ar &relax;
+    ar &mixing_depth;
     ar &areas;
     ar &ein;
     ar &normals;
@@ -93,7 +97,10 @@ struct iccp3m_struct {
 extern iccp3m_struct iccp3m_cfg; /**< Global state of the ICCP3M solver */
 
 /** The main iterative scheme, where the surface element charges are calculated
- *  self-consistently.
+ *  self-consistently. The charges of the previous call serve as initial
+ *  guess. With a non-zero @ref iccp3m_struct::mixing_depth "mixing depth",
+ *  the relaxed iteration is accelerated by Anderson mixing of the last
+ *  iterates.
  */
 int iccp3m_iteration(const ParticleRange &particles,
                      const ParticleRange &ghost_particles);
@@ -33,59 +33,124 @@
 #include "errorhandling.hpp"
 #include "grid.hpp"
 
+#include <utils/Vector.hpp>
 #include <utils/constants.hpp>
+#include <utils/mpi/all_gatherv.hpp>
+
+#include <boost/mpi/collectives/all_gather.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace {
+/** Dipole-dipole interaction of dipole @p m1 with dipole @p m2, without
+ *  the prefactor.
+ *
+ *  @param dr          Distance vector from @p m2 to @p m1.
+ *  @param m1          First dipole moment.
+ *  @param m2          Second dipole moment.
+ *  @param force_flag  Whether to calculate force and torques.
+ */
+struct DipolePair {
+  DipolePair(Utils::Vector3d const &dr, Utils::Vector3d const &m1,
+             Utils::Vector3d const &m2, bool force_flag) {
+    auto const r2 = dr.norm2();
+    auto const r = std::sqrt(r2);
+    auto const r3 = r2 * r;
+    auto const r5 = r3 * r2;
+    auto const r7 = r5 * r2;
+
+    auto const pe1 = m1 * m2;
+    auto const pe2 = m1 * dr;
+    auto const pe3 = m2 * dr;
+    auto const pe4 = 3.0 / r5;
+
+    energy = pe1 / r3 - pe4 * pe2 * pe3;
+
+    if (force_flag) {
+      auto const ab = pe4 * pe1 - 15.0 * pe2 * pe3 / r7;
+      auto const cc = pe4 * pe3;
+      auto const dd = pe4 * pe2;
+
+      force = ab * dr + cc * m1 + dd * m2;
+
+      auto const aa = vector_product(m1, m2);
+      torque1 = -aa / r3 + vector_product(m1, dr) * cc;
+      torque2 = aa / r3 + vector_product(m2, dr) * dd;
+    }
+  }
 
-double calc_dipole_dipole_ia(Particle &p1, Utils::Vector3d const &dip1,
-                             Particle &p2, bool force_flag) {
-
-  // Cache dipole moment
-  auto const dip2 = p2.calc_dip();
-
-  // Distance between particles
-  auto const dr = get_mi_vector(p1.r.p, p2.r.p, box_geo);
-
-  // Powers of distance
-  auto const r2 = dr.norm2();
-  auto const r = sqrt(r2);
-  auto const r3 = r2 * r;
-  auto const r5 = r3 * r2;
-  auto const r7 = r5 * r2;
-
-  // Dot products
-  auto const pe1 = dip1 * dip2;
-  auto const pe2 = dip1 * dr;
-  auto const pe3 = dip2 * dr;
-  auto const pe4 = 3.0 / r5;
-
-  // Energy
-  auto const u = dipole.prefactor * (pe1 / r3 - pe4 * pe2 * pe3);
-
-  // Forces, if requested
-  if (force_flag) {
-    auto const a = pe4 * pe1;
-    auto const b = -15.0 * pe2 * pe3 / r7;
-    auto const ab = a + b;
-    auto const cc = pe4 * pe3;
-    auto const dd = pe4 * pe2;
-
-    // Forces
-    auto const ff = ab * dr + cc * dip1 + dd * dip2;
-    p1.f.f += dipole.prefactor * ff;
-    p2.f.f -= dipole.prefactor * ff;
-
+  /** Interaction energy. */
+  double energy;
+  /** Force on @c m1, the force on @c m2 is the opposite. */
+  Utils::Vector3d force = {};
+  /** Torque on @c m1. */
+  Utils::Vector3d torque1 = {};
+  /** Torque on @c m2. */
+  Utils::Vector3d torque2 = {};
+};
+
+void add_force_and_torque(Particle &p, Utils::Vector3d const &force,
+                          Utils::Vector3d const &torque) {
+  p.f.f += dipole.prefactor * force;
 #ifdef ROTATION
-    // Torques
-    auto const aa = vector_product(dip1, dip2);
-    auto const b1 = vector_product(dip1, dr);
-    auto const b2 = vector_product(dip2, dr);
-    p1.f.torque += dipole.prefactor * (-aa / r3 + b1 * cc);
-    p2.f.torque += dipole.prefactor * (aa / r3 + b2 * dd);
+  p.f.torque += dipole.prefactor * torque;
 #endif
+}
+
+/** Positions and dipole moments of the dipolar particles of all nodes.
+ *  The particles of each node are stored contiguously in rank order,
+ *  the ones of this node start at @c first_local.
+ */
+struct DipolarParticles {
+  std::vector<Utils::Vector3d> pos;
+  std::vector<Utils::Vector3d> dip;
+  std::vector<Particle *> local;
+  std::size_t first_local;
+
+  /** Collect the dipolar particles from all nodes.
+   *
+   *  @param particles  The local particles.
+   *  @param fold       Whether to fold the positions into the primary box.
+   */
+  DipolarParticles(ParticleRange const &particles, bool fold) {
+    std::vector<double> local_data;
+    for (auto &p : particles) {
+      if (p.p.dipm == 0.0)
+        continue;
+      local.push_back(&p);
+      auto const ppos = fold ? folded_position(p.r.p, box_geo) : p.r.p;
+      auto const pdip = p.calc_dip();
+      local_data.insert(local_data.end(), ppos.begin(), ppos.end());
+      local_data.insert(local_data.end(), pdip.begin(), pdip.end());
+    }
+
+    std::vector<int> sizes;
+    boost::mpi::all_gather(comm_cart, static_cast<int>(local_data.size()),
+                           sizes);
+    std::vector<double> data(std::accumulate(sizes.begin(), sizes.end(), 0));
+    Utils::Mpi::all_gatherv(comm_cart, local_data.data(),
+                            static_cast<int>(local_data.size()), data.data(),
+                            sizes.data());
+
+    first_local = static_cast<std::size_t>(std::accumulate(
+                      sizes.begin(), sizes.begin() + comm_cart.rank(), 0)) /
+                  6;
+    for (auto it = data.begin(); it != data.end(); it += 6) {
+      pos.emplace_back(Utils::Vector3d{it[0], it[1], it[2]});
+      dip.emplace_back(Utils::Vector3d{it[3], it[4], it[5]});
+    }
   }
 
-  // Return energy
-  return u;
-}
+  std::size_t size() const { return pos.size(); }
+};
+} // namespace
 
 /* =============================================================================
                   DAWAANR => DIPOLAR ALL WITH ALL AND NO REPLICA
@@ -94,43 +159,50 @@ double calc_dipole_dipole_ia(Particle &p1, Utils::Vector3d const &dip1,
 
 double dawaanr_calculations(bool force_flag, bool energy_flag,
                             const ParticleRange &particles) {
-
-  if (n_nodes != 1) {
-    fprintf(stderr, "error: DAWAANR is just for one cpu...\n");
-    errexit();
-  }
   if (!(force_flag) && !(energy_flag)) {
     fprintf(stderr, "I don't know why you call dawaanr_calculations() "
                     "with all flags zero.\n");
     return 0;
   }
 
+  DipolarParticles const parts(particles, false);
+  auto const n_local = parts.local.size();
+  auto const first = parts.first_local;
+  auto const last = first + n_local;
+
   // Variable to sum up the energy
   double u = 0;
 
-  auto parts = particles;
-
-  // Iterate over all cells
-  for (auto it = parts.begin(), end = parts.end(); it != end; ++it) {
-    // If the particle has no dipole moment, ignore it
-    if (it->p.dipm == 0.0)
-      continue;
-
-    const Utils::Vector3d dip1 = it->calc_dip();
-    auto jt = it;
-    /* Skip diagonal */
-    ++jt;
-    for (; jt != end; ++jt) {
-      // If the particle has no dipole moment, ignore it
-      if (jt->p.dipm == 0.0)
+  for (std::size_t i = first; i < last; ++i) {
+    auto &p1 = *parts.local[i - first];
+    Utils::Vector3d force{}, torque{};
+
+    for (std::size_t j = 0; j < parts.size(); ++j) {
+      /* Pairs of local particles are evaluated once, the others from
+       * both sides, contributing half of the energy each. */
+      if (j >= first and j <= i)
         continue;
-      // Calculate energy and/or force between the particles
-      u += calc_dipole_dipole_ia(*it, dip1, *jt, force_flag);
+      auto const dr = get_mi_vector(parts.pos[i], parts.pos[j], box_geo);
+      DipolePair const pair(dr, parts.dip[i], parts.dip[j], force_flag);
+
+      if (j >= first and j < last) {
+        u += pair.energy;
+        if (force_flag) {
+          add_force_and_torque(*parts.local[j - first], -pair.force,
+                               pair.torque2);
+        }
+      } else {
+        u += 0.5 * pair.energy;
+      }
+      force += pair.force;
+      torque += pair.torque1;
     }
+
+    if (force_flag)
+      add_force_and_torque(p1, force, torque);
   }
 
-  // Return energy
-  return u;
+  return dipole.prefactor * u;
 }
 
 /* =============================================================================
@@ -149,221 +221,301 @@ int magnetic_dipolar_direct_sum_sanity_checks() {
 double
 magnetic_dipolar_direct_sum_calculations(bool force_flag, bool energy_flag,
                                          ParticleRange const &particles) {
-  std::vector<double> x, y, z;
-  std::vector<double> mx, my, mz;
-  std::vector<double> fx, fy, fz;
-#ifdef ROTATION
-  std::vector<double> tx, ty, tz;
-#endif
-  double u;
-
-  if (n_nodes != 1) {
-    fprintf(stderr, "error: magnetic Direct Sum is just for one cpu...\n");
-    errexit();
-  }
   if (!(force_flag) && !(energy_flag)) {
     fprintf(stderr, "I don't know why you call magnetic_dipolar_direct_sum_"
                     "calculations() with all flags zero\n");
     return 0;
   }
 
-  auto const n_part = particles.size();
+  /* here we wish the coordinates to be folded into the primary box */
+  DipolarParticles const parts(particles, true);
 
-  x.resize(n_part);
-  y.resize(n_part);
-  z.resize(n_part);
+  int NCUT[3];
+  for (int i = 0; i < 3; i++) {
+    NCUT[i] = Ncut_off_magnetic_dipolar_direct_sum;
+    if (box_geo.periodic(i) == 0) {
+      NCUT[i] = 0;
+    }
+  }
+  auto const NCUT2 = Ncut_off_magnetic_dipolar_direct_sum *
+                     Ncut_off_magnetic_dipolar_direct_sum;
 
-  mx.resize(n_part);
-  my.resize(n_part);
-  mz.resize(n_part);
+  double u = 0;
 
-  if (force_flag) {
-    fx.resize(n_part);
-    fy.resize(n_part);
-    fz.resize(n_part);
+  for (std::size_t k = 0; k < parts.local.size(); ++k) {
+    auto const i = parts.first_local + k;
+    Utils::Vector3d force{}, torque{};
+
+    for (std::size_t j = 0; j < parts.size(); ++j) {
+      auto const r = parts.pos[i] - parts.pos[j];
+
+      for (int nx = -NCUT[0]; nx <= NCUT[0]; nx++) {
+        for (int ny = -NCUT[1]; ny <= NCUT[1]; ny++) {
+          for (int nz = -NCUT[2]; nz <= NCUT[2]; nz++) {
+            if (i == j && nx == 0 && ny == 0 && nz == 0)
+              continue;
+            if (nx * nx + ny * ny + nz * nz > NCUT2)
+              continue;
+            auto const rn =
+                r + Utils::hadamard_product(Utils::Vector3d{1. * nx, 1. * ny,
+                                                            1. * nz},
+                                            box_geo.length());
+            DipolePair const pair(rn, parts.dip[i], parts.dip[j], force_flag);
+            u += pair.energy;
+            force += pair.force;
+            torque += pair.torque1;
+          }
+        }
+      }
+    }
 
-#ifdef ROTATION
-    tx.resize(n_part);
-    ty.resize(n_part);
-    tz.resize(n_part);
-#endif
+    /* set the forces, and torques of the particles within ESPResSo */
+    if (force_flag)
+      add_force_and_torque(*parts.local[k], force, torque);
   }
 
-  int dip_particles = 0;
-  for (auto const &p : particles) {
-    if (p.p.dipm != 0.0) {
-      const Utils::Vector3d dip = p.calc_dip();
+  return 0.5 * dipole.prefactor * u;
+}
 
-      mx[dip_particles] = dip[0];
-      my[dip_particles] = dip[1];
-      mz[dip_particles] = dip[2];
+int dawaanr_set_params() {
+  if (dipole.method != DIPOLAR_ALL_WITH_ALL_AND_NO_REPLICA) {
+    Dipole::set_method_local(DIPOLAR_ALL_WITH_ALL_AND_NO_REPLICA);
+  }
+  // also necessary on 1 CPU, does more than just broadcasting
+  mpi_bcast_coulomb_params();
 
-      /* here we wish the coordinates to be folded into the primary box */
-      auto const ppos = folded_position(p.r.p, box_geo);
-      x[dip_particles] = ppos[0];
-      y[dip_particles] = ppos[1];
-      z[dip_particles] = ppos[2];
+  return ES_OK;
+}
 
-      if (force_flag) {
-        fx[dip_particles] = 0;
-        fy[dip_particles] = 0;
-        fz[dip_particles] = 0;
+int mdds_set_params(int n_cut) {
+  Ncut_off_magnetic_dipolar_direct_sum = n_cut;
 
-#ifdef ROTATION
-        tx[dip_particles] = 0;
-        ty[dip_particles] = 0;
-        tz[dip_particles] = 0;
-#endif
-      }
+  if (Ncut_off_magnetic_dipolar_direct_sum == 0) {
+    fprintf(stderr, "Careful: the number of extra replicas to take into "
+                    "account during the direct sum calculation is zero\n");
+  }
 
-      dip_particles++;
-    }
+  if (dipole.method != DIPOLAR_DS && dipole.method != DIPOLAR_MDLC_DS) {
+    Dipole::set_method_local(DIPOLAR_DS);
   }
 
-  /*now we do the calculations */
+  // also necessary on 1 CPU, does more than just broadcasting
+  mpi_bcast_coulomb_params();
+  return ES_OK;
+}
 
-  { /* beginning of the area of calculation */
-    int NCUT[3], NCUT2;
+/* =============================================================================
+                  BARNES-HUT OCTREE SUM ON CPU
+   =============================================================================
+*/
+
+double bh_cpu_theta = 0.5;
+
+namespace {
+/** Maximal number of particles in a leaf of the octree. */
+constexpr std::size_t bh_leaf_size = 8;
+/** Maximal depth of the octree, limits the refinement of coincident
+ *  particles.
+ */
+constexpr int bh_max_depth = 32;
 
-    for (int i = 0; i < 3; i++) {
-      NCUT[i] = Ncut_off_magnetic_dipolar_direct_sum;
-      if (box_geo.periodic(i) == 0) {
-        NCUT[i] = 0;
+/** Octree of dipoles. Every cell stores the sum of the dipole moments
+ *  of its particles, located at the mean of their positions weighted by
+ *  the magnitudes of the moments.
+ */
+class DipoleOctree {
+public:
+  DipoleOctree(std::vector<Utils::Vector3d> const &pos,
+               std::vector<Utils::Vector3d> const &dip)
+      : m_pos(pos), m_dip(dip), m_order(pos.size()) {
+    std::iota(m_order.begin(), m_order.end(), 0);
+    if (pos.empty())
+      return;
+
+    Utils::Vector3d lower = pos.front(), upper = pos.front();
+    for (auto const &x : pos) {
+      for (int d = 0; d < 3; ++d) {
+        lower[d] = std::min(lower[d], x[d]);
+        upper[d] = std::max(upper[d], x[d]);
       }
     }
-    NCUT2 = Ncut_off_magnetic_dipolar_direct_sum *
-            Ncut_off_magnetic_dipolar_direct_sum;
-
-    u = 0;
-
-    for (int i = 0; i < dip_particles; i++) {
-      for (int j = 0; j < dip_particles; j++) {
-        auto const pe1 = mx[i] * mx[j] + my[i] * my[j] + mz[i] * mz[j];
-        auto const rx = x[i] - x[j];
-        auto const ry = y[i] - y[j];
-        auto const rz = z[i] - z[j];
-
-        for (int nx = -NCUT[0]; nx <= NCUT[0]; nx++) {
-          auto const rnx = rx + nx * box_geo.length()[0];
-          auto const rnx2 = rnx * rnx;
-          for (int ny = -NCUT[1]; ny <= NCUT[1]; ny++) {
-            auto const rny = ry + ny * box_geo.length()[1];
-            auto const rny2 = rny * rny;
-            for (int nz = -NCUT[2]; nz <= NCUT[2]; nz++) {
-              if (!(i == j && nx == 0 && ny == 0 && nz == 0)) {
-                if (nx * nx + ny * ny + nz * nz <= NCUT2) {
-                  auto const rnz = rz + nz * box_geo.length()[2];
-                  auto const r2 = rnx2 + rny2 + rnz * rnz;
-                  auto const r = sqrt(r2);
-                  auto const r3 = r2 * r;
-                  auto const r5 = r3 * r2;
-                  auto const r7 = r5 * r2;
-
-                  auto const pe2 = mx[i] * rnx + my[i] * rny + mz[i] * rnz;
-                  auto const pe3 = mx[j] * rnx + my[j] * rny + mz[j] * rnz;
-
-                  // Energy ............................
-
-                  u += pe1 / r3 - 3.0 * pe2 * pe3 / r5;
-
-                  if (force_flag) {
-                    double a, b, c, d;
-                    // force ............................
-                    a = mx[i] * mx[j] + my[i] * my[j] + mz[i] * mz[j];
-                    a = 3.0 * a / r5;
-                    b = -15.0 * pe2 * pe3 / r7;
-                    c = 3.0 * pe3 / r5;
-                    d = 3.0 * pe2 / r5;
-
-                    fx[i] += (a + b) * rnx + c * mx[i] + d * mx[j];
-                    fy[i] += (a + b) * rny + c * my[i] + d * my[j];
-                    fz[i] += (a + b) * rnz + c * mz[i] + d * mz[j];
+    auto const extent = upper - lower;
+    auto const half =
+        0.5 * std::max({extent[0], extent[1], extent[2],
+                        std::numeric_limits<double>::min()});
+    build(0, pos.size(), 0.5 * (lower + upper), half, 0);
+  }
 
-#ifdef ROTATION
-                    // torque ............................
-                    c = 3.0 / r5 * pe3;
-                    auto const ax = my[i] * mz[j] - my[j] * mz[i];
-                    auto const ay = mx[j] * mz[i] - mx[i] * mz[j];
-                    auto const az = mx[i] * my[j] - mx[j] * my[i];
-
-                    auto const bx = my[i] * rnz - rny * mz[i];
-                    auto const by = rnx * mz[i] - mx[i] * rnz;
-                    auto const bz = mx[i] * rny - rnx * my[i];
-
-                    tx[i] += -ax / r3 + bx * c;
-                    ty[i] += -ay / r3 + by * c;
-                    tz[i] += -az / r3 + bz * c;
-#endif
-                  } /* of force_flag  */
-                }
-              } /* of nx*nx+ny*ny +nz*nz< NCUT*NCUT   and   !(i==j && nx==0 &&
-                   ny==0 && nz==0) */
-            }   /* of  for nz */
-          }     /* of  for ny  */
-        }       /* of  for nx  */
+  /** Call @p f with the position and dipole moment of every particle or
+   *  cell interacting with particle @p i.
+   *
+   *  A cell is used as a whole if the particle is outside of the cell
+   *  and the ratio of the cell size to the distance from the particle
+   *  is below the opening angle @p theta.
+   */
+  template <class F>
+  void for_each_interaction(std::size_t i, double theta, F f) const {
+    if (m_cells.empty())
+      return;
+    auto const &x = m_pos[i];
+    auto const theta2 = theta * theta;
+
+    std::vector<int> stack = {0};
+    while (not stack.empty()) {
+      auto const &cell = m_cells[stack.back()];
+      stack.pop_back();
+
+      if (cell.leaf) {
+        for (auto k = cell.begin; k < cell.end; ++k) {
+          if (m_order[k] != i)
+            f(m_pos[m_order[k]], m_dip[m_order[k]]);
+        }
+        continue;
       }
-    } /* of  j and i  */
-  }   /* end of the area of calculation */
-
-  /* set the forces, and torques of the particles within ESPResSo */
-  if (force_flag) {
-
-    int dip_particles2 = 0;
 
-    for (auto &p : particles) {
-      if (p.p.dipm != 0.0) {
+      auto const d = x - cell.center;
+      auto const inside = std::abs(d[0]) <= cell.half and
+                          std::abs(d[1]) <= cell.half and
+                          std::abs(d[2]) <= cell.half;
+      if (not inside and cell.weight > 0. and
+          4. * cell.half * cell.half < theta2 * (x - cell.pos).norm2()) {
+        f(cell.pos, cell.dip);
+        continue;
+      }
 
-        p.f.f[0] += dipole.prefactor * fx[dip_particles2];
-        p.f.f[1] += dipole.prefactor * fy[dip_particles2];
-        p.f.f[2] += dipole.prefactor * fz[dip_particles2];
+      for (auto const c : cell.children) {
+        if (c >= 0)
+          stack.push_back(c);
+      }
+    }
+  }
 
-#ifdef ROTATION
-        p.f.torque[0] += dipole.prefactor * tx[dip_particles2];
-        p.f.torque[1] += dipole.prefactor * ty[dip_particles2];
-        p.f.torque[2] += dipole.prefactor * tz[dip_particles2];
-#endif
-        dip_particles2++;
+private:
+  struct Cell {
+    Utils::Vector3d center;
+    double half;
+    /** Sum of the dipole moments */
+    Utils::Vector3d dip = {};
+    /** Weighted mean position */
+    Utils::Vector3d pos = {};
+    /** Sum of the magnitudes of the dipole moments */
+    double weight = 0.;
+    /** Range of the particles in @c m_order */
+    std::size_t begin, end;
+    bool leaf;
+    std::array<int, 8> children;
+  };
+
+  int build(std::size_t begin, std::size_t end, Utils::Vector3d const &center,
+            double half, int depth) {
+    auto const index = static_cast<int>(m_cells.size());
+    m_cells.emplace_back();
+    {
+      auto &cell = m_cells.back();
+      cell.center = center;
+      cell.half = half;
+      cell.begin = begin;
+      cell.end = end;
+      cell.leaf = (end - begin <= bh_leaf_size) or (depth >= bh_max_depth);
+      cell.children.fill(-1);
+      for (auto k = begin; k < end; ++k) {
+        auto const &m = m_dip[m_order[k]];
+        auto const w = m.norm();
+        cell.dip += m;
+        cell.pos += w * m_pos[m_order[k]];
+        cell.weight += w;
+      }
+      if (cell.weight > 0.)
+        cell.pos /= cell.weight;
+    }
+    if (m_cells[index].leaf)
+      return index;
+
+    /* Sort the particles by octant */
+    auto octant = [this, &center](std::size_t k) {
+      auto const &x = m_pos[k];
+      return (x[0] > center[0] ? 1 : 0) + (x[1] > center[1] ? 2 : 0) +
+             (x[2] > center[2] ? 4 : 0);
+    };
+    auto const first = m_order.begin() + static_cast<std::ptrdiff_t>(begin);
+    auto const last = m_order.begin() + static_cast<std::ptrdiff_t>(end);
+    std::sort(first, last, [&octant](std::size_t a, std::size_t b) {
+      return octant(a) < octant(b);
+    });
+
+    auto child_begin = begin;
+    for (int o = 0; o < 8; ++o) {
+      auto child_end = child_begin;
+      while (child_end < end and octant(m_order[child_end]) == o)
+        ++child_end;
+      if (child_end > child_begin) {
+        auto const offset = Utils::Vector3d{(o & 1) ? 1. : -1.,
+                                            (o & 2) ? 1. : -1.,
+                                            (o & 4) ? 1. : -1.};
+        auto const child = build(child_begin, child_end,
+                                 center + 0.5 * half * offset, 0.5 * half,
+                                 depth + 1);
+        m_cells[index].children[o] = child;
       }
+      child_begin = child_end;
     }
-  } /*of if force_flag */
+    return index;
+  }
 
-  return 0.5 * dipole.prefactor * u;
-}
+  std::vector<Utils::Vector3d> const &m_pos;
+  std::vector<Utils::Vector3d> const &m_dip;
+  std::vector<std::size_t> m_order;
+  std::vector<Cell> m_cells;
+};
+} // namespace
 
-int dawaanr_set_params() {
-  if (n_nodes > 1) {
-    runtimeErrorMsg() << "MPI parallelization not supported by "
-                      << "DipolarDirectSumCpu.";
-    return ES_ERROR;
+double bh_cpu_calculations(bool force_flag, bool energy_flag,
+                           ParticleRange const &particles) {
+  if (!(force_flag) && !(energy_flag)) {
+    return 0;
   }
-  if (dipole.method != DIPOLAR_ALL_WITH_ALL_AND_NO_REPLICA) {
-    Dipole::set_method_local(DIPOLAR_ALL_WITH_ALL_AND_NO_REPLICA);
+  if (box_geo.periodic(0) or box_geo.periodic(1) or box_geo.periodic(2)) {
+    runtimeErrorMsg() << "DipolarBarnesHutCpu requires an open system";
+    return 0;
   }
-  // also necessary on 1 CPU, does more than just broadcasting
-  mpi_bcast_coulomb_params();
 
-  return ES_OK;
-}
+  DipolarParticles const parts(particles, false);
+  DipoleOctree const tree(parts.pos, parts.dip);
 
-int mdds_set_params(int n_cut) {
-  if (n_nodes > 1) {
-    runtimeErrorMsg() << "MPI parallelization not supported by "
-                      << "DipolarDirectSumWithReplicaCpu.";
-    return ES_ERROR;
+  double u = 0;
+  for (std::size_t k = 0; k < parts.local.size(); ++k) {
+    auto const i = parts.first_local + k;
+    Utils::Vector3d force{}, torque{};
+
+    tree.for_each_interaction(
+        i, bh_cpu_theta,
+        [&](Utils::Vector3d const &pos, Utils::Vector3d const &dip) {
+          DipolePair const pair(parts.pos[i] - pos, parts.dip[i], dip,
+                                force_flag);
+          u += pair.energy;
+          force += pair.force;
+          torque += pair.torque1;
+        });
+
+    if (force_flag)
+      add_force_and_torque(*parts.local[k], force, torque);
   }
 
-  Ncut_off_magnetic_dipolar_direct_sum = n_cut;
+  return 0.5 * dipole.prefactor * u;
+}
 
-  if (Ncut_off_magnetic_dipolar_direct_sum == 0) {
-    fprintf(stderr, "Careful: the number of extra replicas to take into "
-                    "account during the direct sum calculation is zero\n");
+int bh_cpu_set_params(double theta) {
+  if (theta < 0.) {
+    runtimeErrorMsg() << "Barnes-Hut opening angle has to be >= 0";
+    return ES_ERROR;
   }
 
-  if (dipole.method != DIPOLAR_DS && dipole.method != DIPOLAR_MDLC_DS) {
-    Dipole::set_method_local(DIPOLAR_DS);
+  bh_cpu_theta = theta;
+
+  if (dipole.method != DIPOLAR_BH_CPU) {
+    Dipole::set_method_local(DIPOLAR_BH_CPU);
   }
 
-  // also necessary on 1 CPU, does more than just broadcasting
   mpi_bcast_coulomb_params();
   return ES_OK;
 }
@@ -34,6 +34,13 @@
  *   the system.
  *   Uses spherical summation order.
  *
+ *  BHCPU => Barnes-Hut octree sum on CPU
+ *   Approximate the dipole-dipole interaction of an open system by
+ *   replacing distant groups of dipoles by their total dipole moment.
+ *
+ *  All methods are MPI parallel: the positions and dipole moments of all
+ *  dipolar particles are replicated on every node, and every node computes
+ *  the forces and torques on its own particles.
  */
 #include "config.hpp"
 
@@ -42,9 +49,6 @@
 #include "Particle.hpp"
 #include "ParticleRange.hpp"
 
-/** Calculate dipolar energy and/or force between two particles */
-double calc_dipole_dipole_ia(Particle &p1, Particle &p2, bool force_flag);
-
 /* =============================================================================
                   DAWAANR => DIPOLAR ALL WITH ALL AND NO REPLICA
    =============================================================================
@@ -84,5 +88,27 @@ int mdds_set_params(int n_cut);
 
 extern int Ncut_off_magnetic_dipolar_direct_sum;
 
+/* =============================================================================
+                  BARNES-HUT OCTREE SUM ON CPU
+   =============================================================================
+*/
+
+/** Compute the magnetic forces, torques and the energy with the
+ *  Barnes-Hut approximation. Only for non-periodic systems.
+ */
+double bh_cpu_calculations(bool force_flag, bool energy_flag,
+                           ParticleRange const &particles);
+
+/** Switch on Barnes-Hut magnetostatics on the CPU.
+ *  @param theta Opening angle: a cell of size @c s at distance @c d from
+ *               a particle is used as a whole if <tt>s / d < theta</tt>.
+ *               With @c theta = 0, the method is the exact direct sum.
+ *  @return ES_ERROR, if @p theta is negative
+ */
+int bh_cpu_set_params(double theta);
+
+/** Opening angle of the Barnes-Hut method on the CPU. */
+extern double bh_cpu_theta;
+
 #endif /*of ifdef DIPOLES  */
 #endif /* of ifndef  MAG_NON_P3M_H */
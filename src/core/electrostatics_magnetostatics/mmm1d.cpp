@@ -47,7 +47,9 @@
 #include <utils/strcat_alloc.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdio>
 #include <limits>
 #include <tuple>
@@ -66,6 +68,11 @@ using Utils::strcat_alloc;
 /** Minimal radius for the far formula in multiples of box_l[2] */
 #define MIN_RAD 0.01
 
+/** Largest number of nodes of an interpolation table of the series. If
+ *  the error bound needs more, the series are summed for every pair.
+ */
+#define MAX_TABLE_NODES (1 << 18)
+
 /* if you define this, the Bessel functions are calculated up
  * to machine precision, otherwise 10^-14, which should be
  * definitely enough for daily life. */
@@ -81,11 +88,234 @@ using Utils::strcat_alloc;
 static double uz, L2, uz2, prefuz2, prefL3_i;
 /**@}*/
 
-MMM1D_struct mmm1d_params = {0.05, 1e-5, 0};
+MMM1D_struct mmm1d_params = {0.05, 1e-5, 0, true};
 /** From which distance a certain Bessel cutoff is valid. Can't be part of the
     params since these get broadcasted. */
 static std::vector<double> bessel_radii;
 
+namespace {
+/** @brief Interpolation table of three series in the reduced coordinates
+ *  of a pair.
+ *
+ *  The series are tabulated on a regular grid over [x0, x1] x [0, 1/2],
+ *  where x is the reduced radial coordinate (or its square) and t the
+ *  absolute value of the reduced axial distance, and are interpolated
+ *  with cubic polynomials in both directions. The grid is refined until
+ *  the interpolation error in the middle between the nodes is below a
+ *  tolerance for each series.
+ *
+ *  All series are separable, $ f(x, t) = \sum_k a_k(x) c_k(t) $, so
+ *  that the expensive special functions are only evaluated once per
+ *  grid line.
+ */
+class SeriesTable {
+public:
+  /** Terms @f$ a_k @f$ or @f$ c_k @f$ of the three series. */
+  using Terms = std::vector<Utils::Vector3d>;
+
+  SeriesTable() = default;
+
+  /**
+   * @param x0, x1 Range of the radial coordinate.
+   * @param radial Function returning the radial terms of the series.
+   * @param axial Function returning the axial terms of the series.
+   * @param tolerance Maximal interpolation error of the three series.
+   *
+   * If the tolerance needs more than @ref MAX_TABLE_NODES nodes,
+   * the table is left empty.
+   */
+  template <class RadialTerms, class AxialTerms>
+  SeriesTable(double x0, double x1, RadialTerms radial, AxialTerms axial,
+              Utils::Vector3d const &tolerance)
+      : m_x0(x0) {
+    m_nx = 16;
+    m_nt = 16;
+    /* the radial ghost nodes have to stay above 0 for the Bessel
+     * functions */
+    if (x0 > 0.)
+      m_nx = std::max(m_nx, static_cast<int>(std::ceil(2. * (x1 - x0) / x0)));
+
+    for (;;) {
+      if ((m_nx + 3) * (m_nt + 3) > MAX_TABLE_NODES) {
+        m_data.clear();
+        return;
+      }
+
+      auto const hx = (x1 - x0) / m_nx;
+      auto const ht = 0.5 / m_nt;
+      m_hx_i = 1. / hx;
+      m_ht_i = 1. / ht;
+
+      std::vector<Terms> radial_nodes(m_nx + 3), axial_nodes(m_nt + 3);
+      for (int i = -1; i <= m_nx + 1; i++) {
+        radial_nodes[i + 1] = radial(x0 + i * hx);
+      }
+      for (int j = -1; j <= m_nt + 1; j++) {
+        axial_nodes[j + 1] = axial(j * ht);
+      }
+
+      m_data.resize((m_nx + 3) * (m_nt + 3));
+      for (int i = 0; i < m_nx + 3; i++) {
+        for (int j = 0; j < m_nt + 3; j++) {
+          m_data[i * (m_nt + 3) + j] = sum(radial_nodes[i], axial_nodes[j]);
+        }
+      }
+
+      auto const error = [&tolerance](Utils::Vector3d const &a,
+                                      Utils::Vector3d const &b) {
+        double ret = 0.;
+        for (int c = 0; c < 3; c++) {
+          ret = std::max(ret, std::abs(a[c] - b[c]) / tolerance[c]);
+        }
+        return ret;
+      };
+
+      /* interpolation error between the radial nodes */
+      double error_x = 0.;
+      for (int i = 0; i < m_nx; i++) {
+        auto const x = x0 + (i + 0.5) * hx;
+        auto const terms = radial(x);
+        for (int j = 0; j <= m_nt; j++) {
+          error_x = std::max(error_x, error((*this)(x, j * ht),
+                                            sum(terms, axial_nodes[j + 1])));
+        }
+      }
+
+      /* interpolation error between the axial nodes */
+      double error_t = 0.;
+      for (int j = 0; j < m_nt; j++) {
+        auto const t = (j + 0.5) * ht;
+        auto const terms = axial(t);
+        for (int i = 0; i <= m_nx; i++) {
+          error_t = std::max(error_t, error((*this)(x0 + i * hx, t),
+                                            sum(radial_nodes[i + 1], terms)));
+        }
+      }
+
+      if (error_x <= 1. and error_t <= 1.)
+        return;
+
+      if (error_x > 1.)
+        m_nx *= 2;
+      if (error_t > 1.)
+        m_nt *= 2;
+    }
+  }
+
+  bool empty() const { return m_data.empty(); }
+
+  /** Interpolated values of the three series. */
+  Utils::Vector3d operator()(double x, double t) const {
+    auto const u = (x - m_x0) * m_hx_i;
+    auto const v = t * m_ht_i;
+    auto const i = std::min(std::max(static_cast<int>(u), 0), m_nx - 1);
+    auto const j = std::min(std::max(static_cast<int>(v), 0), m_nt - 1);
+    auto const wx = weights(u - i);
+    auto const wt = weights(v - j);
+
+    Utils::Vector3d ret{};
+    for (int a = 0; a < 4; a++) {
+      auto const row = m_data.data() + (i + a) * (m_nt + 3) + j;
+      ret += wx[a] * (wt[0] * row[0] + wt[1] * row[1] + wt[2] * row[2] +
+                      wt[3] * row[3]);
+    }
+    return ret;
+  }
+
+private:
+  double m_x0 = 0.;
+  double m_hx_i = 0.;
+  double m_ht_i = 0.;
+  int m_nx = 0;
+  int m_nt = 0;
+  /** Values at the nodes, including one ghost node on the lower and
+   *  two on the upper end of each direction, t runs fastest. */
+  std::vector<Utils::Vector3d> m_data;
+
+  static Utils::Vector3d sum(Terms const &a, Terms const &c) {
+    Utils::Vector3d ret{};
+    for (std::size_t k = 0; k < a.size(); k++) {
+      ret += Utils::hadamard_product(a[k], c[k]);
+    }
+    return ret;
+  }
+
+  /** Weights of the cubic Lagrange interpolation between the nodes 0
+   *  and 1 of the nodes -1, 0, 1, 2.
+   */
+  static std::array<double, 4> weights(double u) {
+    return {{-u * (u - 1.) * (u - 2.) / 6., (u + 1.) * (u - 1.) * (u - 2.) / 2.,
+             -(u + 1.) * u * (u - 2.) / 2., (u + 1.) * u * (u - 1.) / 6.}};
+  }
+};
+
+/** Polygamma series of the near formula over the squared reduced radius:
+ *  radial force, axial force and energy.
+ */
+SeriesTable near_table;
+/** Bessel series of the far formula over the reduced radius:
+ *  radial force, axial force and energy.
+ */
+SeriesTable far_table;
+
+void tabulate_polygamma_series(double maxPWerror, double maxrad2) {
+  auto const n_modPsi = static_cast<int>(modPsi.size() >> 1);
+
+  auto const radial = [n_modPsi](double rxy2_d) {
+    SeriesTable::Terms ret(n_modPsi);
+    double r2nm1 = 0.0;
+    double r2n = 1.0;
+    for (int n = 0; n < n_modPsi; n++) {
+      ret[n] = {2. * n * r2nm1, r2n, r2n};
+      r2nm1 = r2n;
+      r2n *= rxy2_d;
+    }
+    return ret;
+  };
+  auto const axial = [n_modPsi](double z_d) {
+    SeriesTable::Terms ret(n_modPsi);
+    for (int n = 0; n < n_modPsi; n++) {
+      auto const mpe = mod_psi_even(n, z_d);
+      ret[n] = {mpe, mod_psi_odd(n, z_d), mpe};
+    }
+    return ret;
+  };
+
+  auto const tolerance = 0.1 * maxPWerror;
+  near_table = SeriesTable(0., maxrad2 * uz2, radial, axial,
+                           {tolerance / uz2, tolerance / uz2, tolerance / uz});
+}
+
+void tabulate_bessel_series(double maxPWerror, double minrad) {
+  constexpr double c_2pi = 2 * Utils::pi();
+
+  auto const radial = [](double rxy_d) {
+    SeriesTable::Terms ret(MAXIMAL_B_CUT - 1);
+    for (int bp = 1; bp < MAXIMAL_B_CUT; bp++) {
+      double k0, k1;
+      std::tie(k0, k1) = LPK01(c_2pi * bp * rxy_d);
+      ret[bp - 1] = {bp * k1, bp * k0, k0};
+    }
+    return ret;
+  };
+  auto const axial = [](double z_d) {
+    SeriesTable::Terms ret(MAXIMAL_B_CUT - 1);
+    for (int bp = 1; bp < MAXIMAL_B_CUT; bp++) {
+      auto const c = cos(c_2pi * bp * z_d);
+      ret[bp - 1] = {c, sin(c_2pi * bp * z_d), c};
+    }
+    return ret;
+  };
+
+  auto const tolerance = 0.1 * maxPWerror;
+  auto const force_tolerance = tolerance / (4 * c_2pi * uz2);
+  auto const energy_tolerance = tolerance / (4 * uz);
+  far_table =
+      SeriesTable(minrad * uz, bessel_radii[0] * uz, radial, axial,
+                  {force_tolerance, force_tolerance, energy_tolerance});
+}
+} // namespace
+
 static double far_error(int P, double minrad) {
   // this uses an upper bound to all force components and the potential
   auto const rhores = 2 * Utils::pi() * uz * minrad;
@@ -186,8 +416,22 @@ void MMM1D_init() {
   determine_bessel_radii(mmm1d_params.maxPWerror, MAXIMAL_B_CUT);
   prepare_polygamma_series(mmm1d_params.maxPWerror,
                            mmm1d_params.far_switch_radius_2);
+
+  near_table = {};
+  far_table = {};
+  if (mmm1d_params.tabulate_series and mmm1d_params.far_switch_radius_2 > 0) {
+    auto const switch_rad = sqrt(mmm1d_params.far_switch_radius_2);
+    tabulate_polygamma_series(mmm1d_params.maxPWerror,
+                              mmm1d_params.far_switch_radius_2);
+    if (bessel_radii[0] > switch_rad)
+      tabulate_bessel_series(mmm1d_params.maxPWerror, switch_rad);
+  }
 }
 
+bool mmm1d_near_series_tabulated() { return not near_table.empty(); }
+
+bool mmm1d_far_series_tabulated() { return not far_table.empty(); }
+
 void add_mmm1d_coulomb_pair_force(double chpref, Utils::Vector3d const &d,
                                   double r, Utils::Vector3d &force) {
   constexpr double c_2pi = 2 * Utils::pi();
@@ -198,23 +442,30 @@ void add_mmm1d_coulomb_pair_force(double chpref, Utils::Vector3d const &d,
   Utils::Vector3d F;
 
   if (rxy2 <= mmm1d_params.far_switch_radius_2) {
-    /* polygamma summation */
     double sr = 0;
-    double sz = mod_psi_odd(0, z_d);
-    double r2nm1 = 1.0;
-    for (int n = 1; n < n_modPsi; n++) {
-      auto const deriv = static_cast<double>(2 * n);
-      auto const mpe = mod_psi_even(n, z_d);
-      auto const mpo = mod_psi_odd(n, z_d);
-      auto const r2n = r2nm1 * rxy2_d;
-
-      sz += r2n * mpo;
-      sr += deriv * r2nm1 * mpe;
-
-      if (fabs(deriv * r2nm1 * mpe) < mmm1d_params.maxPWerror)
-        break;
-
-      r2nm1 = r2n;
+    double sz;
+    if (not near_table.empty() and std::abs(z_d) <= 0.5) {
+      auto const series = near_table(rxy2_d, std::abs(z_d));
+      sr = series[0];
+      sz = (z_d < 0.) ? -series[1] : series[1];
+    } else {
+      /* polygamma summation */
+      sz = mod_psi_odd(0, z_d);
+      double r2nm1 = 1.0;
+      for (int n = 1; n < n_modPsi; n++) {
+        auto const deriv = static_cast<double>(2 * n);
+        auto const mpe = mod_psi_even(n, z_d);
+        auto const mpo = mod_psi_odd(n, z_d);
+        auto const r2n = r2nm1 * rxy2_d;
+
+        sz += r2n * mpo;
+        sr += deriv * r2nm1 * mpe;
+
+        if (fabs(deriv * r2nm1 * mpe) < mmm1d_params.maxPWerror)
+          break;
+
+        r2nm1 = r2n;
+      }
     }
 
     double Fx = prefL3_i * sr * d[0];
@@ -253,20 +504,28 @@ void add_mmm1d_coulomb_pair_force(double chpref, Utils::Vector3d const &d,
     auto const rxy_d = rxy * uz;
     double sr = 0, sz = 0;
 
-    for (int bp = 1; bp < MAXIMAL_B_CUT; bp++) {
-      if (bessel_radii[bp - 1] < rxy)
-        break;
+    if (not far_table.empty() and std::abs(z_d) <= 0.5) {
+      if (rxy <= bessel_radii[0]) {
+        auto const series = far_table(rxy_d, std::abs(z_d));
+        sr = series[0];
+        sz = (z_d < 0.) ? -series[1] : series[1];
+      }
+    } else {
+      for (int bp = 1; bp < MAXIMAL_B_CUT; bp++) {
+        if (bessel_radii[bp - 1] < rxy)
+          break;
 
-      auto const fq = c_2pi * bp;
-      double k0, k1;
+        auto const fq = c_2pi * bp;
+        double k0, k1;
 #ifdef BESSEL_MACHINE_PREC
-      k0 = K0(fq * rxy_d);
-      k1 = K1(fq * rxy_d);
+        k0 = K0(fq * rxy_d);
+        k1 = K1(fq * rxy_d);
 #else
-      std::tie(k0, k1) = LPK01(fq * rxy_d);
+        std::tie(k0, k1) = LPK01(fq * rxy_d);
 #endif
-      sr += bp * k1 * cos(fq * z_d);
-      sz += bp * k0 * sin(fq * z_d);
+        sr += bp * k1 * cos(fq * z_d);
+        sz += bp * k0 * sin(fq * z_d);
+      }
     }
     sr *= uz2 * 4 * c_2pi;
     sz *= uz2 * 4 * c_2pi;
@@ -295,16 +554,20 @@ double mmm1d_coulomb_pair_energy(double const chpref, Utils::Vector3d const &d,
     /* near range formula */
     E = -2 * Utils::gamma();
 
-    /* polygamma summation */
-    double r2n = 1.0;
-    for (int n = 0; n < n_modPsi; n++) {
-      auto const add = mod_psi_even(n, z_d) * r2n;
-      E -= add;
+    if (not near_table.empty() and std::abs(z_d) <= 0.5) {
+      E -= near_table(rxy2_d, std::abs(z_d))[2];
+    } else {
+      /* polygamma summation */
+      double r2n = 1.0;
+      for (int n = 0; n < n_modPsi; n++) {
+        auto const add = mod_psi_even(n, z_d) * r2n;
+        E -= add;
 
-      if (fabs(add) < mmm1d_params.maxPWerror)
-        break;
+        if (fabs(add) < mmm1d_params.maxPWerror)
+          break;
 
-      r2n *= rxy2_d;
+        r2n *= rxy2_d;
+      }
     }
     E *= uz;
 
@@ -328,12 +591,17 @@ double mmm1d_coulomb_pair_energy(double const chpref, Utils::Vector3d const &d,
     /* The first Bessel term will compensate a little bit the
        log term, so add them close together */
     E = -0.25 * log(rxy2_d) + 0.5 * (Utils::ln_2() - Utils::gamma());
-    for (int bp = 1; bp < MAXIMAL_B_CUT; bp++) {
-      if (bessel_radii[bp - 1] < rxy)
-        break;
+    if (not far_table.empty() and std::abs(z_d) <= 0.5) {
+      if (rxy <= bessel_radii[0])
+        E += far_table(rxy_d, std::abs(z_d))[2];
+    } else {
+      for (int bp = 1; bp < MAXIMAL_B_CUT; bp++) {
+        if (bessel_radii[bp - 1] < rxy)
+          break;
 
-      auto const fq = c_2pi * bp;
-      E += K0(fq * rxy_d) * cos(fq * z_d);
+        auto const fq = c_2pi * bp;
+        E += K0(fq * rxy_d) * cos(fq * z_d);
+      }
     }
     E *= 4 * uz;
   }
@@ -351,6 +619,9 @@ int mmm1d_tune(char **log) {
   double switch_radius;
 
   if (mmm1d_params.far_switch_radius_2 < 0) {
+    /* the tables depend on the switching radius, so they are only built
+     * for the final one */
+    mmm1d_params.tabulate_series = false;
     /* determine besselcutoff and optimal switching radius. Should be around
      * 0.33 */
     for (switch_radius = 0.2 * maxrad; switch_radius < 0.4 * maxrad;
@@ -371,8 +642,10 @@ int mmm1d_tune(char **log) {
       double int_time = time_force_calc(TEST_INTEGRATIONS);
 
       /* exit on errors */
-      if (int_time < 0)
+      if (int_time < 0) {
+        mmm1d_params.tabulate_series = true;
         return ES_ERROR;
+      }
 
       sprintf(buffer, "r= %f t= %f ms\n", switch_radius, int_time);
       *log = strcat_alloc(*log, buffer);
@@ -387,6 +660,7 @@ int mmm1d_tune(char **log) {
     }
     switch_radius = min_rad;
     mmm1d_params.far_switch_radius_2 = Utils::sqr(switch_radius);
+    mmm1d_params.tabulate_series = true;
   } else {
     if (mmm1d_params.far_switch_radius_2 <=
         Utils::sqr(bessel_radii[MAXIMAL_B_CUT - 1])) {
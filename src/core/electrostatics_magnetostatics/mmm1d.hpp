@@ -25,7 +25,10 @@
  *  method see MMM in general. The MMM1D method works only with the nsquared,
  *  since neither the near nor far formula can be decomposed. However, this
  *  implementation is reasonably fast, so that one can use up to 200 charges
- *  easily in a simulation.
+ *  easily in a simulation. The series of the near and far formula are
+ *  tabulated over the reduced radial and axial distance at initialization
+ *  and interpolated for every pair, unless the error bound requires too
+ *  large tables.
  */
 #ifndef MMM1D_H
 #define MMM1D_H
@@ -46,6 +49,10 @@ typedef struct {
   double maxPWerror;
   /** cutoff of the Bessel sum. Only used by the GPU implementation */
   int bessel_cutoff;
+  /** whether to tabulate the series at initialization. Disabled while
+   *  the switching radius is tuned.
+   */
+  bool tabulate_series;
 } MMM1D_struct;
 extern MMM1D_struct mmm1d_params;
 
@@ -65,6 +72,17 @@ int MMM1D_sanity_checks();
 /// initialize the MMM1D constants
 void MMM1D_init();
 
+/** Whether the series of the near formula are interpolated from a table.
+ *  Otherwise they are summed directly, e.g. if the error bound requires too
+ *  large tables.
+ */
+bool mmm1d_near_series_tabulated();
+
+/** Whether the series of the far formula are interpolated from a table.
+ *  @copydetails mmm1d_near_series_tabulated
+ */
+bool mmm1d_far_series_tabulated();
+
 void add_mmm1d_coulomb_pair_force(double chpref, Utils::Vector3d const &d,
                                   double r, Utils::Vector3d &force);
 
@@ -411,6 +411,64 @@ double dipole_correction_energy(Utils::Vector3d const &box_dipole) {
 
   return pref * box_dipole.norm2();
 }
+
+/** Long range electrostatics part of the pressure tensor of this node,
+ *  evaluated on the charge mesh after the forward FFT.
+ */
+Utils::Vector9d kspace_pressure_tensor() {
+  using namespace detail::FFT_indexing;
+
+  Utils::Vector9d node_k_space_pressure_tensor{};
+
+  double diagonal = 0;
+  int ind = 0;
+  int j[3];
+  auto const half_alpha_inv_sq = Utils::sqr(1.0 / 2.0 / p3m.params.alpha);
+  for (j[0] = 0; j[0] < p3m.fft.plan[3].new_mesh[RX]; j[0]++) {
+    for (j[1] = 0; j[1] < p3m.fft.plan[3].new_mesh[RY]; j[1]++) {
+      for (j[2] = 0; j[2] < p3m.fft.plan[3].new_mesh[RZ]; j[2]++) {
+        auto const kx = 2.0 * Utils::pi() *
+                        p3m.d_op[RX][j[KX] + p3m.fft.plan[3].start[KX]] /
+                        box_geo.length()[RX];
+        auto const ky = 2.0 * Utils::pi() *
+                        p3m.d_op[RY][j[KY] + p3m.fft.plan[3].start[KY]] /
+                        box_geo.length()[RY];
+        auto const kz = 2.0 * Utils::pi() *
+                        p3m.d_op[RZ][j[KZ] + p3m.fft.plan[3].start[KZ]] /
+                        box_geo.length()[RZ];
+        auto const sqk = Utils::sqr(kx) + Utils::sqr(ky) + Utils::sqr(kz);
+
+        auto const node_k_space_energy =
+            (sqk == 0)
+                ? 0.0
+                : p3m.g_energy[ind] * (Utils::sqr(p3m.rs_mesh[2 * ind]) +
+                                       Utils::sqr(p3m.rs_mesh[2 * ind + 1]));
+        ind++;
+
+        auto const vterm =
+            (sqk == 0) ? 0. : -2.0 * (1 / sqk + half_alpha_inv_sq);
+
+        diagonal += node_k_space_energy;
+        auto const prefactor = node_k_space_energy * vterm;
+        node_k_space_pressure_tensor[0] += prefactor * kx * kx; /* sigma_xx */
+        node_k_space_pressure_tensor[1] += prefactor * kx * ky; /* sigma_xy */
+        node_k_space_pressure_tensor[2] += prefactor * kx * kz; /* sigma_xz */
+        node_k_space_pressure_tensor[3] += prefactor * ky * kx; /* sigma_yx */
+        node_k_space_pressure_tensor[4] += prefactor * ky * ky; /* sigma_yy */
+        node_k_space_pressure_tensor[5] += prefactor * ky * kz; /* sigma_yz */
+        node_k_space_pressure_tensor[6] += prefactor * kz * kx; /* sigma_zx */
+        node_k_space_pressure_tensor[7] += prefactor * kz * ky; /* sigma_zy */
+        node_k_space_pressure_tensor[8] += prefactor * kz * kz; /* sigma_zz */
+      }
+    }
+  }
+  node_k_space_pressure_tensor[0] += diagonal;
+  node_k_space_pressure_tensor[4] += diagonal;
+  node_k_space_pressure_tensor[8] += diagonal;
+
+  auto const force_prefac = coulomb.prefactor / (2.0 * box_geo.volume());
+  return force_prefac * node_k_space_pressure_tensor;
+}
 } // namespace
 
 /** @details Calculate the long range electrostatics part of the pressure
@@ -419,67 +477,18 @@ double dipole_correction_energy(Utils::Vector3d const &box_dipole) {
  *  eq. (2.8) is not present here since M is the empty set in our simulations.
  */
 Utils::Vector9d p3m_calc_kspace_pressure_tensor() {
-  using namespace detail::FFT_indexing;
-
-  Utils::Vector9d node_k_space_pressure_tensor{};
-
   if (p3m.sum_q2 > 0) {
     p3m.sm.gather_grid(p3m.rs_mesh.data(), comm_cart, p3m.local_mesh.dim);
     fft_perform_forw(p3m.rs_mesh.data(), p3m.fft, comm_cart);
-
-    double diagonal = 0;
-    int ind = 0;
-    int j[3];
-    auto const half_alpha_inv_sq = Utils::sqr(1.0 / 2.0 / p3m.params.alpha);
-    for (j[0] = 0; j[0] < p3m.fft.plan[3].new_mesh[RX]; j[0]++) {
-      for (j[1] = 0; j[1] < p3m.fft.plan[3].new_mesh[RY]; j[1]++) {
-        for (j[2] = 0; j[2] < p3m.fft.plan[3].new_mesh[RZ]; j[2]++) {
-          auto const kx = 2.0 * Utils::pi() *
-                          p3m.d_op[RX][j[KX] + p3m.fft.plan[3].start[KX]] /
-                          box_geo.length()[RX];
-          auto const ky = 2.0 * Utils::pi() *
-                          p3m.d_op[RY][j[KY] + p3m.fft.plan[3].start[KY]] /
-                          box_geo.length()[RY];
-          auto const kz = 2.0 * Utils::pi() *
-                          p3m.d_op[RZ][j[KZ] + p3m.fft.plan[3].start[KZ]] /
-                          box_geo.length()[RZ];
-          auto const sqk = Utils::sqr(kx) + Utils::sqr(ky) + Utils::sqr(kz);
-
-          auto const node_k_space_energy =
-              (sqk == 0)
-                  ? 0.0
-                  : p3m.g_energy[ind] * (Utils::sqr(p3m.rs_mesh[2 * ind]) +
-                                         Utils::sqr(p3m.rs_mesh[2 * ind + 1]));
-          ind++;
-
-          auto const vterm =
-              (sqk == 0) ? 0. : -2.0 * (1 / sqk + half_alpha_inv_sq);
-
-          diagonal += node_k_space_energy;
-          auto const prefactor = node_k_space_energy * vterm;
-          node_k_space_pressure_tensor[0] += prefactor * kx * kx; /* sigma_xx */
-          node_k_space_pressure_tensor[1] += prefactor * kx * ky; /* sigma_xy */
-          node_k_space_pressure_tensor[2] += prefactor * kx * kz; /* sigma_xz */
-          node_k_space_pressure_tensor[3] += prefactor * ky * kx; /* sigma_yx */
-          node_k_space_pressure_tensor[4] += prefactor * ky * ky; /* sigma_yy */
-          node_k_space_pressure_tensor[5] += prefactor * ky * kz; /* sigma_yz */
-          node_k_space_pressure_tensor[6] += prefactor * kz * kx; /* sigma_zx */
-          node_k_space_pressure_tensor[7] += prefactor * kz * ky; /* sigma_zy */
-          node_k_space_pressure_tensor[8] += prefactor * kz * kz; /* sigma_zz */
-        }
-      }
-    }
-    node_k_space_pressure_tensor[0] += diagonal;
-    node_k_space_pressure_tensor[4] += diagonal;
-    node_k_space_pressure_tensor[8] += diagonal;
+    return kspace_pressure_tensor();
   }
 
-  auto const force_prefac = coulomb.prefactor / (2.0 * box_geo.volume());
-  return force_prefac * node_k_space_pressure_tensor;
+  return {};
 }
 
 double p3m_calc_kspace_forces(bool force_flag, bool energy_flag,
-                              const ParticleRange &particles) {
+                              const ParticleRange &particles,
+                              Utils::Vector9d *pressure_tensor) {
   /* Gather information for FFT grid inside the nodes domain (inner local mesh)
    * and perform forward 3D FFT (Charge Assignment Mesh). */
   p3m.sm.gather_grid(p3m.rs_mesh.data(), comm_cart, p3m.local_mesh.dim);
@@ -547,6 +556,12 @@ double p3m_calc_kspace_forces(bool force_flag, bool energy_flag,
     }
   } /* if(force_flag) */
 
+  /* === k-space pressure tensor from the same charge mesh === */
+  if (pressure_tensor) {
+    *pressure_tensor =
+        (p3m.sum_q2 > 0) ? kspace_pressure_tensor() : Utils::Vector9d{};
+  }
+
   /* === k-space energy calculation  === */
   if (energy_flag) {
     double node_k_space_energy = 0.;
@@ -136,9 +136,18 @@ void p3m_scaleby_box_l();
 
 /** Compute the k-space part of forces and energies for the charge-charge
  *  interaction
+ *
+ *  @param[in]  force_flag       Whether to calculate the forces.
+ *  @param[in]  energy_flag      Whether to calculate the energy.
+ *  @param[in]  particles        The local particles.
+ *  @param[out] pressure_tensor  If not null, the k-space part of the
+ *                               pressure tensor of this node, computed from
+ *                               the same forward FFT.
+ *  @return The k-space energy on the head node.
  */
 double p3m_calc_kspace_forces(bool force_flag, bool energy_flag,
-                              const ParticleRange &particles);
+                              const ParticleRange &particles,
+                              Utils::Vector9d *pressure_tensor = nullptr);
 
 /** Compute the k-space part of the pressure tensor */
 Utils::Vector9d p3m_calc_kspace_pressure_tensor();
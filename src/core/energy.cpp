@@ -45,6 +45,11 @@ ActorList energyActors;
 /** Energy of the system */
 Observable_stat obs_energy{1};
 
+/** Whether @ref obs_energy was accumulated by the last @ref force_calc and
+ *  describes the current state.
+ */
+static bool obs_energy_fused = false;
+
 Observable_stat const &get_obs_energy() { return obs_energy; }
 
 void energy_calc(const double time) {
@@ -87,8 +92,7 @@ void energy_calc(const double time) {
 
   calc_long_range_energies(cell_structure.local_particles());
 
-  auto local_parts = cell_structure.local_particles();
-  Constraints::constraints.add_energy(local_parts, time, obs_energy);
+  Constraints::constraints.add_energy(cell_structure, time, obs_energy);
 
 #ifdef CUDA
   auto const energy_host = copy_energy_from_GPU();
@@ -105,6 +109,38 @@ void energy_calc(const double time) {
   }
 }
 
+Observable_stat *energy_fused_begin() {
+  obs_energy = Observable_stat{1};
+
+#ifdef CUDA
+  clear_energy_on_GPU();
+#endif
+
+  return &obs_energy;
+}
+
+void energy_fused_end() {
+  for (auto const &p : cell_structure.local_particles()) {
+    obs_energy.kinetic[0] += calc_kinetic_energy(p);
+  }
+
+#ifdef CUDA
+  auto const energy_host = copy_energy_from_GPU();
+  if (!obs_energy.coulomb.empty())
+    obs_energy.coulomb[1] += energy_host.coulomb;
+  if (!obs_energy.dipolar.empty())
+    obs_energy.dipolar[1] += energy_host.dipolar;
+#endif
+
+  auto obs_energy_res = reduce(comm_cart, obs_energy);
+  if (obs_energy_res) {
+    std::swap(obs_energy, *obs_energy_res);
+  }
+  obs_energy_fused = true;
+}
+
+void energy_fused_invalidate() { obs_energy_fused = false; }
+
 void update_energy_local(int, int) { energy_calc(sim_time); }
 
 REGISTER_CALLBACK(update_energy_local)
@@ -129,6 +165,7 @@ double calculate_current_potential_energy_of_system() {
 }
 
 double observable_compute_energy() {
-  update_energy();
+  if (!obs_energy_fused)
+    update_energy();
   return obs_energy.accumulate(0);
 }
@@ -39,6 +39,21 @@ void energy_calc(double time);
 /** Run @ref energy_calc in parallel. */
 void update_energy();
 
+/** Reset the energy observable to accumulate it in @ref force_calc.
+ *  @return The energy observable.
+ */
+Observable_stat *energy_fused_begin();
+
+/** Complete the energy accumulated in @ref force_calc with the kinetic
+ *  energy and collect it on the head node. It is returned by
+ *  @ref observable_compute_energy until @ref energy_fused_invalidate
+ *  is called.
+ */
+void energy_fused_end();
+
+/** Recalculate the energy in the next @ref observable_compute_energy. */
+void energy_fused_invalidate();
+
 /** Return the energy observable. */
 Observable_stat const &get_obs_energy();
 
@@ -30,6 +30,7 @@
 #include "collision.hpp"
 #include "communication.hpp"
 #include "config.hpp"
+#include "constraints.hpp"
 #include "cuda_init.hpp"
 #include "cuda_interface.hpp"
 #include "electrostatics_magnetostatics/coulomb.hpp"
@@ -42,6 +43,7 @@
 #include "grid_based_algorithms/lb_interface.hpp"
 #include "immersed_boundaries.hpp"
 #include "integrate.hpp"
+#include "load_balancing.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "npt.hpp"
 #include "partCfg_global.hpp"
@@ -128,7 +130,12 @@ void on_integration_start() {
   npt_ensemble_init(box_geo);
 #endif
 
+#ifdef COLLISION_DETECTION
+  collision_detection_on_integration_start();
+#endif
+
   partCfg().invalidate();
+  partCfgKinematics().invalidate();
   invalidate_fetch_cache();
 
 #ifdef ADDITIONAL_CHECKS
@@ -184,6 +191,7 @@ void on_particle_charge_change() {
 
   /* the particle information is no longer valid */
   partCfg().invalidate();
+  partCfgKinematics().invalidate();
 }
 
 void on_particle_change() {
@@ -194,6 +202,7 @@ void on_particle_change() {
 
   /* the particle information is no longer valid */
   partCfg().invalidate();
+  partCfgKinematics().invalidate();
 
   /* the particle information is no longer valid */
   invalidate_fetch_cache();
@@ -256,6 +265,7 @@ void on_boxl_change() {
 
 void on_cell_structure_change() {
   clear_particle_node();
+  Constraints::constraints.on_cell_structure_change();
 
 /* Now give methods a chance to react to the change in cell
    structure. Most ES methods need to reinitialize, as they depend
@@ -325,8 +335,10 @@ void on_parameter_change(int field) {
     /* If the force cap changed, forces are invalid */
     recalc_forces = true;
     break;
-  case FIELD_THERMO_SWITCH:
   case FIELD_LATTICE_SWITCH:
+    LoadBalancing::on_lattice_switch_change();
+    break;
+  case FIELD_THERMO_SWITCH:
   case FIELD_RIGIDBONDS:
   case FIELD_THERMALIZEDBONDS:
     break;
@@ -31,23 +31,32 @@
 #include "comfixed_global.hpp"
 #include "communication.hpp"
 #include "constraints.hpp"
+#include "electrostatics_magnetostatics/coulomb.hpp"
 #include "electrostatics_magnetostatics/dipole.hpp"
 #include "electrostatics_magnetostatics/icc.hpp"
 #include "electrostatics_magnetostatics/p3m_gpu.hpp"
 #include "forcecap.hpp"
+#include "energy.hpp"
+#include "energy_inline.hpp"
 #include "forces_inline.hpp"
 #include "grid_based_algorithms/electrokinetics.hpp"
 #include "grid_based_algorithms/lb_interface.hpp"
 #include "grid_based_algorithms/lb_particle_coupling.hpp"
 #include "immersed_boundaries.hpp"
 #include "integrate.hpp"
+#include "load_balancing.hpp"
 #include "nonbonded_interactions/VerletCriterion.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "pressure_inline.hpp"
 #include "short_range_loop.hpp"
 #include "virtual_sites.hpp"
 
 #include <profiler/profiler.hpp>
 
+#include <boost/range/algorithm/copy.hpp>
+
+#include <mpi.h>
+
 #include <cassert>
 
 ActorList forceActors;
@@ -83,7 +92,61 @@ void init_forces_ghosts(const ParticleRange &particles) {
   }
 }
 
-void force_calc(CellStructure &cell_structure, double time_step) {
+namespace {
+/** Calculate long range forces, and in the same pass the long range
+ *  energies and virials.
+ */
+void calc_long_range_forces(const ParticleRange &particles,
+                            ForceCalcObservables const &observables) {
+#ifdef ELECTROSTATICS
+  auto const coulomb_kspace = Coulomb::calc_long_range_force_energy_pressure(
+      particles, observables.energy != nullptr,
+      observables.pressure != nullptr);
+  if (observables.energy)
+    observables.energy->coulomb[1] = coulomb_kspace.first;
+  if (observables.pressure)
+    boost::copy(coulomb_kspace.second,
+                observables.pressure->coulomb.begin() + 9);
+#endif
+
+#ifdef DIPOLES
+  Dipole::calc_long_range_force(particles);
+  if (observables.energy)
+    observables.energy->dipolar[1] = Dipole::calc_energy_long_range(particles);
+  if (observables.pressure)
+    Dipole::calc_pressure_long_range();
+#endif
+}
+
+/** Add the energy and virial of a bond to the sampled observables.
+ *  @retval true if the bond is broken
+ */
+bool add_bonded_observables(ForceCalcObservables const &observables,
+                            Particle &p1, int bond_id,
+                            Utils::Span<Particle *> partners) {
+  auto const &iaparams = bonded_ia_params[bond_id];
+  if (observables.energy) {
+    auto const result = calc_bonded_energy(iaparams, p1, partners);
+    if (!result)
+      return true;
+    observables.energy->bonded_contribution(bond_id)[0] += result.get();
+  }
+  if (observables.pressure) {
+    auto const result = calc_bonded_pressure_tensor(iaparams, p1, partners);
+    if (!result)
+      return true;
+    auto const &tensor = result.get();
+    for (int k = 0; k < 3; k++)
+      for (int l = 0; l < 3; l++)
+        observables.pressure->bonded_contribution(bond_id)[k * 3 + l] +=
+            tensor[k][l];
+  }
+  return false;
+}
+} // namespace
+
+void force_calc(CellStructure &cell_structure, double time_step,
+                ForceCalcObservables *observables, unsigned force_groups) {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
 
   espressoSystemInterface.update();
@@ -94,19 +157,43 @@ void force_calc(CellStructure &cell_structure, double time_step) {
 
   auto particles = cell_structure.local_particles();
   auto ghost_particles = cell_structure.ghost_particles();
+  auto const other = (force_groups & FORCE_GROUP_OTHER) != 0u;
+  auto const bonded = (force_groups & FORCE_GROUP_BONDED) != 0u;
+  auto const short_range = (force_groups & FORCE_GROUP_SHORT_RANGE) != 0u;
+  auto const long_range = (force_groups & FORCE_GROUP_LONG_RANGE) != 0u;
+
 #ifdef ELECTROSTATICS
-  iccp3m_iteration(particles, cell_structure.ghost_particles());
+  if (long_range)
+    iccp3m_iteration(particles, cell_structure.ghost_particles());
 #endif
-  init_forces(particles, time_step);
+  if (other) {
+    init_forces(particles, time_step);
+  } else {
+    for (auto &p : particles) {
+      p.f = {};
+    }
+    init_forces_ghosts(ghost_particles);
+  }
 
-  for (auto &forceActor : forceActors) {
-    forceActor->computeForces(espressoSystemInterface);
+  if (other) {
+    for (auto &forceActor : forceActors) {
+      forceActor->computeForces(espressoSystemInterface);
 #ifdef ROTATION
-    forceActor->computeTorques(espressoSystemInterface);
+      forceActor->computeTorques(espressoSystemInterface);
 #endif
+    }
   }
 
-  calc_long_range_forces(particles);
+  if (observables) {
+    if (observables->energy and other) {
+      for (auto &energyActor : energyActors)
+        energyActor->computeEnergy(espressoSystemInterface);
+    }
+    if (long_range)
+      calc_long_range_forces(particles, *observables);
+  } else if (long_range) {
+    calc_long_range_forces(particles);
+  }
 
 #ifdef ELECTROSTATICS
   auto const coulomb_cutoff = Coulomb::cutoff(box_geo.length());
@@ -120,22 +207,47 @@ void force_calc(CellStructure &cell_structure, double time_step) {
   auto const dipole_cutoff = INACTIVE_CUTOFF;
 #endif
 
+  auto const short_range_start = MPI_Wtime();
   short_range_loop(
-      add_bonded_force,
-      [](Particle &p1, Particle &p2, Distance const &d) {
-        add_non_bonded_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2);
+      [observables, bonded](Particle &p1, int bond_id,
+                            Utils::Span<Particle *> partners) {
+        if (not bonded)
+          return false;
+        if (add_bonded_force(p1, bond_id, partners))
+          return true;
+        return observables and
+               add_bonded_observables(*observables, p1, bond_id, partners);
+      },
+      [observables](Particle &p1, Particle &p2, Distance const &d) {
+        auto const dist = sqrt(d.dist2);
+        add_non_bonded_pair_force(p1, p2, d.vec21, dist, d.dist2);
+        if (observables and observables->energy) {
+          add_non_bonded_pair_energy(p1, p2, d.vec21, dist, d.dist2,
+                                     *observables->energy);
+        }
+        if (observables and observables->pressure) {
+          add_non_bonded_pair_virials(p1, p2, d.vec21, dist,
+                                      *observables->pressure);
+        }
 #ifdef COLLISION_DETECTION
         if (collision_params.mode != COLLISION_MODE_OFF)
           detect_collision(p1, p2, d.dist2);
 #endif
       },
-      maximal_cutoff(),
+      short_range ? maximal_cutoff() : INACTIVE_CUTOFF,
       VerletCriterion{skin, interaction_range(), coulomb_cutoff, dipole_cutoff,
                       collision_detection_cutoff()});
+  LoadBalancing::add_force_time(MPI_Wtime() - short_range_start);
 
-  Constraints::constraints.add_forces(particles, sim_time);
+  if (other) {
+    Constraints::constraints.add_forces(cell_structure, sim_time);
+    if (observables and observables->energy) {
+      Constraints::constraints.add_energy(cell_structure, sim_time,
+                                          *observables->energy);
+    }
+  }
 
-  if (max_oif_objects) {
+  if (other and max_oif_objects) {
     // There are two global quantities that need to be evaluated:
     // object's surface and object's volume. One can add another
     // quantity.
@@ -150,15 +262,17 @@ void force_calc(CellStructure &cell_structure, double time_step) {
     }
   }
 
-  // Must be done here. Forces need to be ghost-communicated
-  immersed_boundaries.volume_conservation(cell_structure);
+  if (other) {
+    // Must be done here. Forces need to be ghost-communicated
+    immersed_boundaries.volume_conservation(cell_structure);
 
-  lb_lbcoupling_calc_particle_lattice_ia(thermo_virtual, particles,
-                                         ghost_particles);
+    lb_lbcoupling_calc_particle_lattice_ia(thermo_virtual, particles,
+                                           ghost_particles);
 
 #ifdef CUDA
-  copy_forces_from_GPU(particles);
+    copy_forces_from_GPU(particles);
 #endif
+  }
 
 // VIRTUAL_SITES distribute forces
 #ifdef VIRTUAL_SITES
@@ -168,6 +282,10 @@ void force_calc(CellStructure &cell_structure, double time_step) {
   // Communication Step: ghost forces
   cell_structure.ghosts_reduce_forces();
 
+#ifdef VIRTUAL_SITES
+  virtual_sites()->back_transfer_reduced_forces_and_torques();
+#endif
+
   // should be pretty late, since it needs to zero out the total force
   comfixed.apply(comm_cart, particles);
 
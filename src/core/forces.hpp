@@ -30,6 +30,7 @@
  *  Implementation in forces.cpp.
  */
 
+#include "Observable_stat.hpp"
 #include "actor/Actor.hpp"
 #include "actor/ActorList.hpp"
 #include "bonded_interactions/bonded_interaction_data.hpp"
@@ -45,6 +46,34 @@ void init_forces(const ParticleRange &particles, double time_step);
 /** Set forces of all ghosts to zero */
 void init_forces_ghosts(const ParticleRange &particles);
 
+/** Observables accumulated alongside the forces on sampling steps.
+ *  Null pointers are skipped.
+ */
+struct ForceCalcObservables {
+  /** Energy, without the kinetic energy. */
+  Observable_stat *energy;
+  /** Pressure tensor, without the kinetic part and not rescaled by the
+   *  volume. */
+  Observable_stat *pressure;
+};
+
+/** \name Groups of force contributions that can be calculated separately */
+/**@{*/
+/** Bonded interactions. */
+#define FORCE_GROUP_BONDED 1u
+/** Non-bonded short range interactions, including the real-space parts
+ *  of the long range methods. */
+#define FORCE_GROUP_SHORT_RANGE 2u
+/** k-space parts of the long range methods. */
+#define FORCE_GROUP_LONG_RANGE 4u
+/** Everything else: thermostats, external forces, constraints,
+ *  lattice-Boltzmann coupling, ... */
+#define FORCE_GROUP_OTHER 8u
+#define FORCE_GROUP_ALL                                                        \
+  (FORCE_GROUP_BONDED | FORCE_GROUP_SHORT_RANGE | FORCE_GROUP_LONG_RANGE |     \
+   FORCE_GROUP_OTHER)
+/**@}*/
+
 /** Calculate forces.
  *
  *  A short list, what the function is doing:
@@ -54,8 +83,20 @@ void init_forces_ghosts(const ParticleRange &particles);
  *  <li> Calculate non-bonded short range interaction forces
  *  <li> Calculate long range interaction forces
  *  </ol>
+ *
+ *  @param cell_structure  The cell structure.
+ *  @param time_step       The time step.
+ *  @param observables     If not null, the potential energy and/or the
+ *                         virials are accumulated in the same pass.
+ *  @param force_groups    Bitmask of FORCE_GROUP_* flags for the
+ *                         contributions to calculate. Without
+ *                         @ref FORCE_GROUP_OTHER, the forces start from
+ *                         zero. The observables are only complete if all
+ *                         groups are calculated.
  */
-void force_calc(CellStructure &cell_structure, double time_step);
+void force_calc(CellStructure &cell_structure, double time_step,
+                ForceCalcObservables *observables = nullptr,
+                unsigned force_groups = FORCE_GROUP_ALL);
 
 /** Calculate long range forces (P3M, ...). */
 void calc_long_range_forces(const ParticleRange &particles);
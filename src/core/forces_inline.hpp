@@ -135,86 +135,163 @@ inline ParticleForce init_local_particle_force(Particle const &part,
   return thermostat_force(part, time_step) + external_force(part);
 }
 
+/** Calculate the non-bonded pair force.
+ *  Only the potentials in @ref IA_parameters::active_potentials are
+ *  evaluated, in a fixed order. The most common single-potential cases
+ *  take a fast path without the dispatch.
+ */
 inline ParticleForce calc_non_bonded_pair_force(Particle const &p1,
                                                 Particle const &p2,
                                                 IA_parameters const &ia_params,
                                                 Utils::Vector3d const &d,
                                                 double const dist) {
+  auto const active = ia_params.active_potentials;
+
+#ifdef WCA
+  if (active == NB_WCA) {
+    return {wca_pair_force_factor(ia_params, dist) * d};
+  }
+#endif
+#ifdef LENNARD_JONES
+  if (active == NB_LENNARD_JONES) {
+    return {lj_pair_force_factor(ia_params, dist) * d};
+  }
+#endif
 
   ParticleForce pf{};
   double force_factor = 0;
+  /* Loop over the set bits, from the lowest to the highest. */
+  for (auto remaining = active; remaining; remaining &= remaining - 1u) {
+    switch (remaining & (~remaining + 1u)) {
 /* Lennard-Jones */
 #ifdef LENNARD_JONES
-  force_factor += lj_pair_force_factor(ia_params, dist);
+    case NB_LENNARD_JONES:
+      force_factor += lj_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* WCA */
 #ifdef WCA
-  force_factor += wca_pair_force_factor(ia_params, dist);
+    case NB_WCA:
+      force_factor += wca_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* Lennard-Jones generic */
 #ifdef LENNARD_JONES_GENERIC
-  force_factor += ljgen_pair_force_factor(ia_params, dist);
+    case NB_LENNARD_JONES_GENERIC:
+      force_factor += ljgen_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* smooth step */
 #ifdef SMOOTH_STEP
-  force_factor += SmSt_pair_force_factor(ia_params, dist);
+    case NB_SMOOTH_STEP:
+      force_factor += SmSt_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* Hertzian force */
 #ifdef HERTZIAN
-  force_factor += hertzian_pair_force_factor(ia_params, dist);
+    case NB_HERTZIAN:
+      force_factor += hertzian_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* Gaussian force */
 #ifdef GAUSSIAN
-  force_factor += gaussian_pair_force_factor(ia_params, dist);
+    case NB_GAUSSIAN:
+      force_factor += gaussian_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* BMHTF NaCl */
 #ifdef BMHTF_NACL
-  force_factor += BMHTF_pair_force_factor(ia_params, dist);
+    case NB_BMHTF_NACL:
+      force_factor += BMHTF_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* Buckingham*/
 #ifdef BUCKINGHAM
-  force_factor += buck_pair_force_factor(ia_params, dist);
+    case NB_BUCKINGHAM:
+      force_factor += buck_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* Morse*/
 #ifdef MORSE
-  force_factor += morse_pair_force_factor(ia_params, dist);
+    case NB_MORSE:
+      force_factor += morse_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /*soft-sphere potential*/
 #ifdef SOFT_SPHERE
-  force_factor += soft_pair_force_factor(ia_params, dist);
+    case NB_SOFT_SPHERE:
+      force_factor += soft_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /*hat potential*/
 #ifdef HAT
-  force_factor += hat_pair_force_factor(ia_params, dist);
+    case NB_HAT:
+      force_factor += hat_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* Lennard-Jones cosine */
 #ifdef LJCOS
-  force_factor += ljcos_pair_force_factor(ia_params, dist);
+    case NB_LJCOS:
+      force_factor += ljcos_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* Lennard-Jones cosine */
 #ifdef LJCOS2
-  force_factor += ljcos2_pair_force_factor(ia_params, dist);
+    case NB_LJCOS2:
+      force_factor += ljcos2_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* Thole damping */
 #ifdef THOLE
-  pf.f += thole_pair_force(p1, p2, ia_params, d, dist);
+    case NB_THOLE:
+      pf.f += thole_pair_force(p1, p2, ia_params, d, dist);
+      break;
 #endif
 /* tabulated */
 #ifdef TABULATED
-  force_factor += tabulated_pair_force_factor(ia_params, dist);
+    case NB_TABULATED:
+      force_factor += tabulated_pair_force_factor(ia_params, dist);
+      break;
 #endif
 /* Gay-Berne */
 #ifdef GAY_BERNE
-  // The gb force function isn't inlined, probably due to its size
-  if (dist < ia_params.gay_berne.cut) {
-    pf += gb_pair_force(p1.r.calc_director(), p2.r.calc_director(), ia_params,
-                        d, dist);
+    case NB_GAY_BERNE:
+      // The gb force function isn't inlined, probably due to its size
+      if (dist < ia_params.gay_berne.cut) {
+        pf += gb_pair_force(p1.r.calc_director(), p2.r.calc_director(),
+                            ia_params, d, dist);
+      }
+      break;
+#endif
+    default:
+      break;
+    }
   }
-#endif
   pf.f += force_factor * d;
   return pf;
 }
 
+/** Calculate the non-bonded pair force from the compact parameters.
+ *  The full parameters are only looked up for the less common potentials.
+ */
+inline ParticleForce
+calc_non_bonded_pair_force(Particle const &p1, Particle const &p2,
+                           IA_parameters_hot const &ia_params,
+                           Utils::Vector3d const &d, double const dist) {
+#ifdef WCA
+  if (ia_params.active_potentials == NB_WCA) {
+    return {wca_pair_force_factor(ia_params.wca, dist) * d};
+  }
+#endif
+#ifdef LENNARD_JONES
+  if (ia_params.active_potentials == NB_LENNARD_JONES) {
+    return {lj_pair_force_factor(ia_params.lj, dist) * d};
+  }
+#endif
+  return calc_non_bonded_pair_force(
+      p1, p2, *get_ia_param(p1.p.type, p2.p.type), d, dist);
+}
+
 inline ParticleForce calc_opposing_force(ParticleForce const &pf,
                                          Utils::Vector3d const &d) {
   ParticleForce out{-pf.f};
@@ -240,7 +317,7 @@ inline ParticleForce calc_opposing_force(ParticleForce const &pf,
 inline void add_non_bonded_pair_force(Particle &p1, Particle &p2,
                                       Utils::Vector3d const &d, double dist,
                                       double dist2) {
-  IA_parameters const &ia_params = *get_ia_param(p1.p.type, p2.p.type);
+  auto const &ia_params = get_ia_param_hot(p1.p.type, p2.p.type);
   ParticleForce pf{};
 
   /***********************************************/
@@ -285,7 +362,8 @@ inline void add_non_bonded_pair_force(Particle &p1, Particle &p2,
   /* The inter dpd force should not be part of the virial */
 #ifdef DPD
   if (thermo_switch & THERMO_DPD) {
-    auto const force = dpd_pair_force(p1, p2, ia_params, d, dist, dist2);
+    auto const force = dpd_pair_force(
+        p1, p2, *get_ia_param(p1.p.type, p2.p.type), d, dist, dist2);
     p1.f.f += force;
     p2.f.f -= force;
   }
@@ -28,6 +28,8 @@
  * - a "GhostCommunicator" is always named "gcr",
  * - a "GhostCommunication" is always named "ghost_comm".
  */
+#include "config.hpp"
+
 #include "ghosts.hpp"
 #include "Particle.hpp"
 
@@ -90,6 +92,10 @@ static size_t calc_transmit_size(unsigned data_parts) {
   }
   if (data_parts & GHOSTTRANS_POSITION)
     size += Utils::MemcpyOArchive::packing_size<ParticlePosition>();
+#ifdef ELECTROSTATICS
+  if (data_parts & GHOSTTRANS_CHARGE)
+    size += Utils::MemcpyOArchive::packing_size<double>();
+#endif
   if (data_parts & GHOSTTRANS_MOMENTUM)
     size += Utils::MemcpyOArchive::packing_size<ParticleMomentum>();
   if (data_parts & GHOSTTRANS_FORCE)
@@ -141,6 +147,11 @@ static void prepare_send_buffer(CommBuf &send_buffer,
           pp.p += ghost_comm.shift;
           archiver << pp;
         }
+#ifdef ELECTROSTATICS
+        if (data_parts & GHOSTTRANS_CHARGE) {
+          archiver << part.p.q;
+        }
+#endif
         if (data_parts & GHOSTTRANS_MOMENTUM) {
           archiver << part.m;
         }
@@ -197,6 +208,11 @@ static void put_recv_buffer(CommBuf &recv_buffer,
         if (data_parts & GHOSTTRANS_POSITION) {
           archiver >> part.r;
         }
+#ifdef ELECTROSTATICS
+        if (data_parts & GHOSTTRANS_CHARGE) {
+          archiver >> part.p.q;
+        }
+#endif
         if (data_parts & GHOSTTRANS_MOMENTUM) {
           archiver >> part.m;
         }
@@ -267,6 +283,11 @@ static void cell_cell_transfer(const GhostCommunication &ghost_comm,
           part2.r = part1.r;
           part2.r.p += ghost_comm.shift;
         }
+#ifdef ELECTROSTATICS
+        if (data_parts & GHOSTTRANS_CHARGE) {
+          part2.p.q = part1.p.q;
+        }
+#endif
         if (data_parts & GHOSTTRANS_MOMENTUM) {
           part2.m = part1.m;
         }
@@ -123,6 +123,8 @@ enum : unsigned {
   GHOSTTRANS_PROPRTS = 1u,
   /// transfer \ref ParticlePosition
   GHOSTTRANS_POSITION = 2u,
+  /// transfer only the charge, a subset of \ref ParticleProperties
+  GHOSTTRANS_CHARGE = 4u,
   /// transfer \ref ParticleMomentum
   GHOSTTRANS_MOMENTUM = 8u,
   /// transfer \ref ParticleForce
@@ -0,0 +1,768 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *  Electrokinetics on the lattice of the CPU lattice-Boltzmann fluid.
+ *
+ *  The fields are stored like the fluid, with one halo layer that is
+ *  updated after every change. Each rank computes the fluxes of all links
+ *  of its nodes, including the links to halo nodes, whose flux the
+ *  neighbor rank computes from the same data with the opposite sign. So
+ *  no fluxes have to be communicated, and the species are conserved.
+ *
+ *  The corresponding header file is electrokinetics_cpu.hpp.
+ */
+
+#include "grid_based_algorithms/electrokinetics_cpu.hpp"
+
+#include "MpiCallbacks.hpp"
+#include "communication.hpp"
+#include "config.hpp"
+#include "errorhandling.hpp"
+#include "grid.hpp"
+#include "grid_based_algorithms/halo.hpp"
+#include "grid_based_algorithms/lattice.hpp"
+#include "grid_based_algorithms/lb.hpp"
+#include "grid_based_algorithms/lb_boundaries.hpp"
+#include "grid_based_algorithms/lb_interface.hpp"
+
+#if defined(P3M) || defined(DP3M)
+#include "electrostatics_magnetostatics/fft.hpp"
+#include "electrostatics_magnetostatics/p3m-common.hpp"
+#endif
+
+#include <utils/Vector.hpp>
+#include <utils/constants.hpp>
+#include <utils/index.hpp>
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using Utils::get_linear_index;
+
+bool ek_cpu_initialized = false;
+
+namespace {
+EKCPUParameters ek_cpu_params;
+
+/** Face and edge links of a node, in units of the lattice constant. */
+std::array<Utils::Vector3i, 18> const links = {{{1, 0, 0},
+                                                {-1, 0, 0},
+                                                {0, 1, 0},
+                                                {0, -1, 0},
+                                                {0, 0, 1},
+                                                {0, 0, -1},
+                                                {1, 1, 0},
+                                                {-1, -1, 0},
+                                                {1, -1, 0},
+                                                {-1, 1, 0},
+                                                {1, 0, 1},
+                                                {-1, 0, -1},
+                                                {1, 0, -1},
+                                                {-1, 0, 1},
+                                                {0, 1, 1},
+                                                {0, -1, -1},
+                                                {0, 1, -1},
+                                                {0, -1, 1}}};
+/** Number of face links at the beginning of @ref links. */
+constexpr std::size_t n_face_links = 6;
+
+/** Number densities of the species, in ions per node. */
+std::vector<std::vector<double>> rho;
+/** Densities of the species after the current step. */
+std::vector<double> rho_next;
+/** Charge density of the species and the boundaries. */
+std::vector<double> charge_density;
+/** Electrostatic potential. */
+std::vector<double> potential;
+/** Displacement of the fluid in one LB time step, in lattice units. */
+std::array<std::vector<double>, 3> displacement;
+/** Whether @ref potential belongs to the current densities. */
+bool potential_valid = false;
+
+/** Halo communication of a field with one double per node. */
+HaloCommunicator halo_comm(0);
+
+/** Local and global extent and lattice constant of the lattice the
+ *  fields were set up for. */
+struct LatticeKey {
+  Utils::Vector3i grid = {};
+  Utils::Vector3i global_grid = {};
+  Utils::Vector3i local_index_offset = {};
+  double agrid = 0.;
+
+  bool operator==(LatticeKey const &rhs) const {
+    return grid == rhs.grid and global_grid == rhs.global_grid and
+           local_index_offset == rhs.local_index_offset and
+           agrid == rhs.agrid;
+  }
+};
+LatticeKey fields_lattice;
+
+LatticeKey lattice_key(Lattice const &lattice) {
+  return {lattice.grid, lattice.global_grid, lattice.local_index_offset,
+          lattice.agrid};
+}
+
+bool is_boundary(Lattice::index_t index) {
+#ifdef LB_BOUNDARIES
+  return lbfields[index].boundary != 0;
+#else
+  return false;
+#endif
+}
+
+/** Call @p kernel with the linear index and the position in the lattice
+ *  with halo of all local nodes.
+ */
+template <class Kernel> void for_each_local_node(Kernel &&kernel) {
+  Lattice::index_t index = lblattice.halo_offset;
+  for (int z = 1; z <= lblattice.grid[2]; z++) {
+    for (int y = 1; y <= lblattice.grid[1]; y++) {
+      for (int x = 1; x <= lblattice.grid[0]; x++) {
+        kernel(index, Utils::Vector3i{x, y, z});
+        ++index;
+      }
+      index += 2; /* skip halo region */
+    }
+    index += 2 * lblattice.halo_grid[0]; /* skip halo region */
+  }
+}
+
+bool is_local_node(Utils::Vector3i const &pos) {
+  for (int i = 0; i < 3; i++) {
+    if (pos[i] < 1 or pos[i] > lblattice.grid[i])
+      return false;
+  }
+  return true;
+}
+
+/** Offset of the linear index of the neighbor at @p c. */
+Lattice::index_t neighbor_offset(Utils::Vector3i const &c) {
+  auto const &halo_grid = lblattice.halo_grid;
+  return c[0] + halo_grid[0] * (c[1] + halo_grid[1] * c[2]);
+}
+
+void halo_update(std::vector<double> &field) {
+  halo_communication(&halo_comm, reinterpret_cast<char *>(field.data()));
+}
+
+double local_sum(std::vector<double> const &field) {
+  double sum = 0.;
+  for_each_local_node([&](auto index, auto const &) { sum += field[index]; });
+  return sum;
+}
+
+double global_dot(std::vector<double> const &a, std::vector<double> const &b) {
+  double dot = 0.;
+  for_each_local_node(
+      [&](auto index, auto const &) { dot += a[index] * b[index]; });
+  return boost::mpi::all_reduce(comm_cart, dot, std::plus<>());
+}
+
+double global_number_of_nodes() {
+  auto const &grid = lblattice.global_grid;
+  return static_cast<double>(grid[0]) * grid[1] * grid[2];
+}
+
+#if defined(P3M) || defined(DP3M)
+fft_data_struct fft;
+/** Charge density and potential in the mesh layout of the FFT. */
+fft_vector<double> fft_mesh;
+/** Inverse of the lattice Laplacian in Fourier space, without the
+ *  electrostatic prefactor. */
+std::vector<double> greens_function;
+
+void init_poisson_solver() {
+  using namespace detail::FFT_indexing;
+  int const margin[6] = {1, 1, 1, 1, 1, 1};
+  double const mesh_off[3] = {lblattice.offset, lblattice.offset,
+                              lblattice.offset};
+  int ks_pnum;
+  auto const mesh_size =
+      fft_init(lblattice.halo_grid, margin, lblattice.global_grid.data(),
+               mesh_off, ks_pnum, fft, node_grid, comm_cart);
+  fft_mesh.resize(mesh_size);
+
+  auto const start = Utils::Vector3i{fft.plan[3].start};
+  auto const size = Utils::Vector3i{fft.plan[3].new_mesh};
+  auto const &grid = lblattice.global_grid;
+  auto const agrid = lblattice.agrid;
+  greens_function.resize(static_cast<std::size_t>(size[0]) * size[1] *
+                         size[2]);
+
+  Utils::Vector3i n{};
+  for (n[0] = start[0]; n[0] < start[0] + size[0]; n[0]++) {
+    for (n[1] = start[1]; n[1] < start[1] + size[1]; n[1]++) {
+      for (n[2] = start[2]; n[2] < start[2] + size[2]; n[2]++) {
+        auto const ind = get_linear_index(n - start, size,
+                                          Utils::MemoryOrder::ROW_MAJOR);
+        auto const k = Utils::Vector3i{n[KX], n[KY], n[KZ]};
+        if (k == Utils::Vector3i{}) {
+          // setting the 0th Fourier mode to 0 enforces charge neutrality
+          greens_function[ind] = 0.;
+          continue;
+        }
+        auto cos_sum = 0.;
+        for (int i = 0; i < 3; i++) {
+          cos_sum += std::cos(2. * Utils::pi() * k[i] / grid[i]);
+        }
+        greens_function[ind] = -4. * Utils::pi() * agrid * agrid * 0.5 /
+                               (cos_sum - 3.) / global_number_of_nodes();
+      }
+    }
+  }
+}
+
+void solve_poisson() {
+  auto const &halo_grid = lblattice.halo_grid;
+  for_each_local_node([&](auto index, auto const &pos) {
+    fft_mesh[get_linear_index(pos, halo_grid, Utils::MemoryOrder::ROW_MAJOR)] =
+        charge_density[index];
+  });
+
+  fft_perform_forw(fft_mesh.data(), fft, comm_cart);
+  auto const prefactor = ek_cpu_params.prefactor;
+  for (std::size_t i = 0; i < greens_function.size(); i++) {
+    fft_mesh[2 * i] *= prefactor * greens_function[i];
+    fft_mesh[2 * i + 1] *= prefactor * greens_function[i];
+  }
+  fft_perform_back(fft_mesh.data(), false, fft, comm_cart);
+
+  for_each_local_node([&](auto index, auto const &pos) {
+    potential[index] = fft_mesh[get_linear_index(
+        pos, halo_grid, Utils::MemoryOrder::ROW_MAJOR)];
+  });
+}
+#else
+/** Residual, search direction and its image of the conjugate gradient
+ *  method. */
+std::vector<double> cg_r, cg_p, cg_q;
+
+void init_poisson_solver() {
+  auto const volume = static_cast<std::size_t>(lblattice.halo_grid_volume);
+  cg_r.assign(volume, 0.);
+  cg_p.assign(volume, 0.);
+  cg_q.assign(volume, 0.);
+}
+
+/** Negative 7-point lattice Laplacian of @p in on the local nodes. */
+void apply_laplacian(std::vector<double> const &in, std::vector<double> &out) {
+  auto const agrid2_inv = 1. / (lblattice.agrid * lblattice.agrid);
+  Lattice::index_t const offsets[3] = {
+      neighbor_offset({1, 0, 0}), neighbor_offset({0, 1, 0}),
+      neighbor_offset({0, 0, 1})};
+  for_each_local_node([&](auto index, auto const &) {
+    auto laplacian = 6. * in[index];
+    for (auto const offset : offsets) {
+      laplacian -= in[index + offset] + in[index - offset];
+    }
+    out[index] = laplacian * agrid2_inv;
+  });
+}
+
+/** Solve the Poisson equation with the conjugate gradient method,
+ *  starting from the previous potential.
+ */
+void solve_poisson() {
+  /* the mean charge is removed like the 0th Fourier mode in the
+   * solution with the FFT, which enforces charge neutrality */
+  auto const mean_charge = boost::mpi::all_reduce(
+                               comm_cart, local_sum(charge_density),
+                               std::plus<>()) /
+                           global_number_of_nodes();
+  auto const source = 4. * Utils::pi() * ek_cpu_params.prefactor;
+  for_each_local_node([&](auto index, auto const &) {
+    cg_r[index] = source * (charge_density[index] - mean_charge);
+  });
+  auto const tolerance2 = 1e-20 * global_dot(cg_r, cg_r);
+
+  halo_update(potential);
+  apply_laplacian(potential, cg_q);
+  for_each_local_node([&](auto index, auto const &) {
+    cg_r[index] -= cg_q[index];
+    cg_p[index] = cg_r[index];
+  });
+  auto r2 = global_dot(cg_r, cg_r);
+
+  auto const max_iterations = static_cast<int>(global_number_of_nodes());
+  for (int i = 0; r2 > tolerance2; i++) {
+    if (i == max_iterations) {
+      runtimeErrorMsg() << "Electrokinetics: the Poisson solver did not "
+                           "converge";
+      break;
+    }
+    halo_update(cg_p);
+    apply_laplacian(cg_p, cg_q);
+    auto const alpha = r2 / global_dot(cg_p, cg_q);
+    for_each_local_node([&](auto index, auto const &) {
+      potential[index] += alpha * cg_p[index];
+      cg_r[index] -= alpha * cg_q[index];
+    });
+    auto const r2_next = global_dot(cg_r, cg_r);
+    auto const beta = r2_next / r2;
+    r2 = r2_next;
+    for_each_local_node([&](auto index, auto const &) {
+      cg_p[index] = cg_r[index] + beta * cg_p[index];
+    });
+  }
+
+  /* the potential is only defined up to a constant */
+  auto const mean_potential =
+      boost::mpi::all_reduce(comm_cart, local_sum(potential), std::plus<>()) /
+      global_number_of_nodes();
+  for_each_local_node(
+      [&](auto index, auto const &) { potential[index] -= mean_potential; });
+}
+#endif
+
+/** Remove the ions from the boundary nodes and represent the charge of
+ *  the boundaries by the first charged species.
+ */
+void set_boundary_densities() {
+#ifdef LB_BOUNDARIES
+  using LBBoundaries::lbboundaries;
+  auto const &species = ek_cpu_params.species;
+  auto const wallcharge_species = std::distance(
+      species.begin(),
+      std::find_if(species.begin(), species.end(),
+                   [](auto const &s) { return s.valency != 0.; }));
+  auto const cell_volume = std::pow(lblattice.agrid, 3);
+
+  auto const node_charge = [&](Lattice::index_t index) {
+    return lbboundaries[lbfields[index].boundary - 1]->charge_density() *
+           cell_volume;
+  };
+
+  for (Lattice::index_t index = 0; index < lblattice.halo_grid_volume;
+       index++) {
+    if (not is_boundary(index))
+      continue;
+    for (auto &r : rho) {
+      r[index] = 0.;
+    }
+    auto const charge = node_charge(index);
+    if (charge != 0.) {
+      if (wallcharge_species == species.size()) {
+        runtimeErrorMsg() << "no charged species available to create wall "
+                             "charge";
+        return;
+      }
+      rho[wallcharge_species][index] =
+          charge / species[wallcharge_species].valency;
+    }
+  }
+
+  std::vector<double> local_net_charge(lbboundaries.size(), 0.);
+  for_each_local_node([&](auto index, auto const &) {
+    if (is_boundary(index)) {
+      local_net_charge[lbfields[index].boundary - 1] += node_charge(index);
+    }
+  });
+  std::vector<double> net_charge(lbboundaries.size());
+  boost::mpi::all_reduce(comm_cart, local_net_charge.data(),
+                         static_cast<int>(local_net_charge.size()),
+                         net_charge.data(), std::plus<>());
+  for (std::size_t i = 0; i < lbboundaries.size(); i++) {
+    lbboundaries[i]->set_net_charge(net_charge[i]);
+  }
+#endif
+}
+
+/** Set up the fields on the current lattice, with the bulk densities. */
+void init_fields() {
+  auto const volume = static_cast<std::size_t>(lblattice.halo_grid_volume);
+  auto const cell_volume = std::pow(lblattice.agrid, 3);
+  rho.resize(ek_cpu_params.species.size());
+  for (std::size_t i = 0; i < rho.size(); i++) {
+    rho[i].assign(volume, ek_cpu_params.species[i].density * cell_volume);
+  }
+  rho_next.assign(volume, 0.);
+  charge_density.assign(volume, 0.);
+  potential.assign(volume, 0.);
+  for (auto &d : displacement) {
+    d.assign(volume, 0.);
+  }
+  potential_valid = false;
+
+  prepare_halo_communication(&halo_comm, &lblattice, FIELDTYPE_DOUBLE,
+                             MPI_DOUBLE, node_grid);
+  init_poisson_solver();
+  fields_lattice = lattice_key(lblattice);
+
+  set_boundary_densities();
+}
+
+/** Set up the fields again if the lattice has changed. */
+void update_fields() {
+  if (not(lattice_key(lblattice) == fields_lattice)) {
+    init_fields();
+  }
+}
+
+void update_potential() {
+  if (potential_valid)
+    return;
+
+  auto const cell_volume = std::pow(lblattice.agrid, 3);
+  for_each_local_node([&](auto index, auto const &) {
+    auto charge = 0.;
+    for (std::size_t i = 0; i < rho.size(); i++) {
+      charge += ek_cpu_params.species[i].valency * rho[i][index];
+    }
+    charge_density[index] = charge / cell_volume;
+  });
+  solve_poisson();
+  halo_update(potential);
+  potential_valid = true;
+}
+
+/** Displacement of the fluid from its velocity, including half of the
+ *  force of the current step. */
+void update_displacement() {
+  for_each_local_node([&](auto index, auto const &) {
+    Utils::Vector3d dx{};
+    if (not is_boundary(index)) {
+      auto const modes = lb_calc_modes(index, lbfluid);
+      auto const density = lb_calc_density(modes, lbpar);
+      dx = lb_calc_momentum_density(modes, lbfields[index].force_density) /
+           density;
+    }
+    for (int i = 0; i < 3; i++) {
+      displacement[i][index] = dx[i];
+    }
+  });
+  for (auto &d : displacement) {
+    halo_update(d);
+  }
+}
+
+/** Diffusive and migrative fluxes of one species out of the local nodes
+ *  along the links, with the resulting force on the fluid.
+ */
+void propagate_diffusion(EKCPUSpecies const &species,
+                         std::vector<double> const &rho_s) {
+  auto const &params = ek_cpu_params;
+  auto const agrid = lblattice.agrid;
+  auto const tau = lbpar.tau;
+  auto const force_conv = tau * tau / agrid;
+  /* the link-centered stencil distributes the diffusion over the face
+   * and the edge links */
+  auto const d = species.D / (1. + 2. * Utils::sqrt_2());
+  auto const friction = params.T * agrid / species.D * force_conv;
+
+  std::array<Lattice::index_t, links.size()> offsets;
+  std::transform(links.begin(), links.end(), offsets.begin(),
+                 neighbor_offset);
+
+  for_each_local_node([&](auto index, auto const &) {
+    if (is_boundary(index))
+      return;
+    Utils::Vector3d force{};
+    for (std::size_t l = 0; l < links.size(); l++) {
+      auto const neighbor = index + offsets[l];
+      if (is_boundary(neighbor))
+        continue;
+      auto const length = (l < n_face_links) ? 1. : Utils::sqrt_2();
+      auto const c = Utils::Vector3d(links[l]);
+      auto const link_force =
+          species.valency * (potential[index] - potential[neighbor]) /
+              (length * agrid) +
+          (c * species.ext_force_density) / length;
+      auto const flux =
+          ((rho_s[index] - rho_s[neighbor]) / (length * agrid) +
+           link_force * (rho_s[index] + rho_s[neighbor]) / (2. * params.T)) *
+          d / agrid;
+      rho_next[index] -= flux * tau;
+      if (params.fluidcoupling_ideal_contribution) {
+        force += 0.5 * flux * friction * c;
+      }
+    }
+    lbfields[index].force_density += force;
+  });
+}
+
+/** Electrostatic and external force of one species on the fluid. */
+void add_electrostatic_force(EKCPUSpecies const &species,
+                             std::vector<double> const &rho_s) {
+  auto const agrid = lblattice.agrid;
+  auto const force_conv = lbpar.tau * lbpar.tau / agrid;
+  Lattice::index_t const offsets[3] = {
+      neighbor_offset({1, 0, 0}), neighbor_offset({0, 1, 0}),
+      neighbor_offset({0, 0, 1})};
+
+  for_each_local_node([&](auto index, auto const &) {
+    if (is_boundary(index))
+      return;
+    Utils::Vector3d force = species.ext_force_density;
+    for (int i = 0; i < 3; i++) {
+      force[i] -= species.valency *
+                  (potential[index + offsets[i]] -
+                   potential[index - offsets[i]]) /
+                  (2. * agrid);
+    }
+    lbfields[index].force_density += rho_s[index] * force_conv * force;
+  });
+}
+
+/** Advective fluxes of one species with the volume-of-fluid scheme.
+ *
+ *  The ions of a node move with the fluid by the displacement and are
+ *  distributed to the eight nodes around their new position. The ions
+ *  moving from the halo into the local domain are computed with the
+ *  displacement of the halo nodes.
+ */
+void propagate_advection(std::vector<double> const &rho_s) {
+  auto const &halo_grid = lblattice.halo_grid;
+  Utils::Vector3i pos;
+  for (pos[2] = 0; pos[2] < halo_grid[2]; pos[2]++) {
+    for (pos[1] = 0; pos[1] < halo_grid[1]; pos[1]++) {
+      for (pos[0] = 0; pos[0] < halo_grid[0]; pos[0]++) {
+        auto const index = get_linear_index(pos, halo_grid);
+        if (rho_s[index] == 0. or is_boundary(index))
+          continue;
+        auto const source_local = is_local_node(pos);
+        Utils::Vector3d const dx = {displacement[0][index],
+                                    displacement[1][index],
+                                    displacement[2][index]};
+
+        for (int corner = 1; corner < 8; corner++) {
+          auto target = pos;
+          auto amount = rho_s[index];
+          for (int i = 0; i < 3; i++) {
+            if (corner & (1 << i)) {
+              target[i] += (dx[i] < 0.) ? -1 : 1;
+              amount *= std::abs(dx[i]);
+            } else {
+              amount *= 1. - std::abs(dx[i]);
+            }
+          }
+          if (amount == 0. or not(target >= Utils::Vector3i{}) or
+              not(target < halo_grid))
+            continue;
+          auto const target_local = is_local_node(target);
+          if (not(source_local or target_local))
+            continue;
+          auto const target_index = get_linear_index(target, halo_grid);
+          if (is_boundary(target_index))
+            continue;
+          if (source_local)
+            rho_next[index] -= amount;
+          if (target_local)
+            rho_next[target_index] += amount;
+        }
+      }
+    }
+  }
+}
+
+void check_parameters(EKCPUParameters const &params) {
+  if (params.T <= 0.)
+    throw std::invalid_argument("T has to be > 0.");
+  if (params.prefactor < 0.)
+    throw std::invalid_argument("prefactor has to be >= 0.");
+  for (auto const &species : params.species) {
+    if (species.density < 0.)
+      throw std::invalid_argument("Species density has to be >= 0.");
+    if (species.D < 0.)
+      throw std::invalid_argument("Species D has to be >= 0.");
+  }
+}
+
+void check_node_access(int species, Utils::Vector3i const &ind) {
+  if (not ek_cpu_initialized)
+    throw std::runtime_error("CPU electrokinetics is not active.");
+  if (species < 0 or species >= ek_cpu_params.species.size())
+    throw std::out_of_range("Invalid species.");
+  if (not(ind >= Utils::Vector3i{}) or not(ind < lblattice.global_grid))
+    throw std::out_of_range("Index error");
+}
+} // namespace
+
+void ek_cpu_integrate() {
+  update_fields();
+  update_potential();
+  if (ek_cpu_params.advection) {
+    update_displacement();
+  }
+
+  for (std::size_t i = 0; i < rho.size(); i++) {
+    auto const &species = ek_cpu_params.species[i];
+    rho_next = rho[i];
+    if (species.D > 0.) {
+      propagate_diffusion(species, rho[i]);
+    }
+    if (not ek_cpu_params.fluidcoupling_ideal_contribution) {
+      add_electrostatic_force(species, rho[i]);
+    }
+    if (ek_cpu_params.advection) {
+      propagate_advection(rho[i]);
+    }
+    std::swap(rho[i], rho_next);
+    halo_update(rho[i]);
+  }
+  potential_valid = false;
+}
+
+void ek_cpu_init_boundaries() {
+  update_fields();
+  set_boundary_densities();
+  potential_valid = false;
+}
+
+void ek_cpu_sanity_checks() {
+  if (lattice_switch != ActiveLB::CPU) {
+    runtimeErrorMsg() << "CPU electrokinetics requires the CPU LB";
+    return;
+  }
+  for (int i = 0; i < 3; i++) {
+    if (not box_geo.periodic(i)) {
+      runtimeErrorMsg() << "CPU electrokinetics requires periodic boundaries";
+      return;
+    }
+  }
+  /* fraction of the ions of a node that leave it by diffusion in one step,
+   * which has to stay below one */
+  auto const dt = lbpar.tau / (lbpar.agrid * lbpar.agrid);
+  for (auto const &species : ek_cpu_params.species) {
+    auto const d = species.D / (1. + 2. * Utils::sqrt_2());
+    if (d * dt * (6. + 12. / Utils::sqrt_2()) > 1.) {
+      runtimeErrorMsg() << "Electrokinetics: the diffusion of a species is "
+                           "unstable, D * tau / agrid^2 is too large";
+    }
+  }
+}
+
+void mpi_ek_cpu_init_local(EKCPUParameters const &params) {
+  ek_cpu_params = params;
+  ek_cpu_initialized = true;
+  init_fields();
+}
+
+REGISTER_CALLBACK(mpi_ek_cpu_init_local)
+
+void mpi_ek_cpu_set_parameters_local(EKCPUParameters const &params) {
+  ek_cpu_params = params;
+  update_fields();
+  set_boundary_densities();
+  potential_valid = false;
+}
+
+REGISTER_CALLBACK(mpi_ek_cpu_set_parameters_local)
+
+void mpi_ek_cpu_deactivate_local() {
+  ek_cpu_initialized = false;
+  rho.clear();
+  fields_lattice = LatticeKey{};
+}
+
+REGISTER_CALLBACK(mpi_ek_cpu_deactivate_local)
+
+void mpi_ek_cpu_update_local() {
+  update_fields();
+  update_potential();
+}
+
+REGISTER_CALLBACK(mpi_ek_cpu_update_local)
+
+boost::optional<double> mpi_ek_cpu_get_node_density(int species,
+                                                    Utils::Vector3i const &ind) {
+  if (not lblattice.is_local(ind))
+    return {};
+  auto const index =
+      get_linear_index(lblattice.local_index(ind), lblattice.halo_grid);
+  return rho[species][index] / std::pow(lblattice.agrid, 3);
+}
+
+REGISTER_CALLBACK_ONE_RANK(mpi_ek_cpu_get_node_density)
+
+boost::optional<double>
+mpi_ek_cpu_get_node_potential(Utils::Vector3i const &ind) {
+  if (not lblattice.is_local(ind))
+    return {};
+  return potential[get_linear_index(lblattice.local_index(ind),
+                                    lblattice.halo_grid)];
+}
+
+REGISTER_CALLBACK_ONE_RANK(mpi_ek_cpu_get_node_potential)
+
+void mpi_ek_cpu_set_node_density(int species, Utils::Vector3i const &ind,
+                                 double density) {
+  update_fields();
+  if (lblattice.is_local(ind)) {
+    auto const index =
+        get_linear_index(lblattice.local_index(ind), lblattice.halo_grid);
+    rho[species][index] = density * std::pow(lblattice.agrid, 3);
+  }
+  halo_update(rho[species]);
+  potential_valid = false;
+}
+
+REGISTER_CALLBACK(mpi_ek_cpu_set_node_density)
+
+void ek_cpu_init(EKCPUParameters const &params) {
+  if (lattice_switch != ActiveLB::CPU)
+    throw std::runtime_error("CPU electrokinetics requires the CPU LB.");
+  check_parameters(params);
+  mpi_call_all(mpi_ek_cpu_init_local, params);
+}
+
+void ek_cpu_set_parameters(EKCPUParameters const &params) {
+  if (not ek_cpu_initialized)
+    throw std::runtime_error("CPU electrokinetics is not active.");
+  if (params.species.size() != ek_cpu_params.species.size())
+    throw std::invalid_argument("The number of species cannot change.");
+  check_parameters(params);
+  mpi_call_all(mpi_ek_cpu_set_parameters_local, params);
+}
+
+EKCPUParameters const &ek_cpu_get_parameters() { return ek_cpu_params; }
+
+void ek_cpu_deactivate() { mpi_call_all(mpi_ek_cpu_deactivate_local); }
+
+double ek_cpu_get_node_density(int species, Utils::Vector3i const &ind) {
+  check_node_access(species, ind);
+  mpi_call_all(mpi_ek_cpu_update_local);
+  return ::Communication::mpiCallbacks().call(
+      ::Communication::Result::one_rank, mpi_ek_cpu_get_node_density, species,
+      ind);
+}
+
+void ek_cpu_set_node_density(int species, Utils::Vector3i const &ind,
+                             double density) {
+  check_node_access(species, ind);
+  if (density < 0.)
+    throw std::invalid_argument("Species density has to be >= 0.");
+  mpi_call_all(mpi_ek_cpu_set_node_density, species, ind, density);
+}
+
+double ek_cpu_get_node_potential(Utils::Vector3i const &ind) {
+  check_node_access(0, ind);
+  mpi_call_all(mpi_ek_cpu_update_local);
+  return ::Communication::mpiCallbacks().call(
+      ::Communication::Result::one_rank, mpi_ek_cpu_get_node_potential, ind);
+}
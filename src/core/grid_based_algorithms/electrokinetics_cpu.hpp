@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_GRID_BASED_ALGORITHMS_ELECTROKINETICS_CPU_HPP
+#define CORE_GRID_BASED_ALGORITHMS_ELECTROKINETICS_CPU_HPP
+
+/** \file
+ *  Electrokinetics on the lattice of the CPU lattice-Boltzmann fluid.
+ *
+ *  The number densities of the ionic species live on the nodes of
+ *  @ref lblattice and are distributed over the MPI ranks like the fluid.
+ *  They are propagated with the link-centered stencil of the GPU
+ *  implementation: diffusive and migrative fluxes along the 18 face and
+ *  edge links of each node, plus an advective volume-of-fluid flux with
+ *  the fluid velocity. Links touching a boundary node carry no flux.
+ *  The species act on the fluid either with the friction force of their
+ *  fluxes or with the electrostatic force density, and the electrostatic
+ *  potential is the solution of the Poisson equation of the species
+ *  charges and of the wall charges on the 7-point lattice Laplacian.
+ *  With FFTW, it is computed with the parallel FFT of P3M, otherwise
+ *  with the conjugate gradient method.
+ *
+ *  Implementation in electrokinetics_cpu.cpp.
+ */
+
+#include <utils/Vector.hpp>
+
+#include <boost/serialization/vector.hpp>
+
+#include <vector>
+
+/** Parameters of one ionic species. */
+struct EKCPUSpecies {
+  /** Bulk number density the species is initialized with. */
+  double density = 0.;
+  /** Diffusion coefficient. */
+  double D = 0.;
+  /** Charge of one ion of the species. */
+  double valency = 0.;
+  /** External force on one ion of the species. */
+  Utils::Vector3d ext_force_density = {};
+
+  template <class Archive> void serialize(Archive &ar, long int) {
+    ar &density &D &valency &ext_force_density;
+  }
+};
+
+/** Parameters of the CPU electrokinetics, in MD units. */
+struct EKCPUParameters {
+  /** Thermal energy of the ions. */
+  double T = -1.;
+  /** Electrostatic prefactor, i.e. Bjerrum length times @ref T. */
+  double prefactor = -1.;
+  /** Whether the species are advected with the fluid. */
+  bool advection = true;
+  /** Whether the species act on the fluid with the friction force of
+   *  their fluxes, or else with the electrostatic force density. */
+  bool fluidcoupling_ideal_contribution = true;
+  std::vector<EKCPUSpecies> species;
+
+  template <class Archive> void serialize(Archive &ar, long int) {
+    ar &T &prefactor &advection &fluidcoupling_ideal_contribution &species;
+  }
+};
+
+/** Whether the CPU electrokinetics is active. */
+extern bool ek_cpu_initialized;
+
+/** @brief Activate the electrokinetics.
+ *
+ *  The species are initialized with their bulk densities. Requires
+ *  the CPU LB. Has to be called on the head node.
+ */
+void ek_cpu_init(EKCPUParameters const &params);
+
+/** @brief Change the parameters of the active electrokinetics.
+ *
+ *  The densities are kept, so the number of species cannot change.
+ *  Has to be called on the head node.
+ */
+void ek_cpu_set_parameters(EKCPUParameters const &params);
+
+EKCPUParameters const &ek_cpu_get_parameters();
+
+/** @brief Deactivate the electrokinetics. Has to be called on the head node.
+ */
+void ek_cpu_deactivate();
+
+/** @brief Propagate the species by one LB time step.
+ *
+ *  Adds the coupling forces of the species to the force density of the
+ *  fluid, so it has to be called before the collision. Has to be called
+ *  on all nodes.
+ */
+void ek_cpu_integrate();
+
+/** @brief Set the densities of the boundary nodes.
+ *
+ *  Boundary nodes hold no ions, except for the charge of the boundary,
+ *  which is represented by the first charged species. Called on all
+ *  nodes when the boundaries of the CPU LB change.
+ */
+void ek_cpu_init_boundaries();
+
+/** @brief Check the parameters against the LB and the box. */
+void ek_cpu_sanity_checks();
+
+/** @name Access to single nodes, to be called on the head node. */
+/**@{*/
+double ek_cpu_get_node_density(int species, Utils::Vector3i const &ind);
+void ek_cpu_set_node_density(int species, Utils::Vector3i const &ind,
+                             double density);
+double ek_cpu_get_node_potential(Utils::Vector3i const &ind);
+/**@}*/
+
+#endif
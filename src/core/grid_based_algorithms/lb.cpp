@@ -33,6 +33,7 @@
 #include "communication.hpp"
 #include "errorhandling.hpp"
 #include "grid.hpp"
+#include "grid_based_algorithms/electrokinetics_cpu.hpp"
 #include "grid_based_algorithms/lb_boundaries.hpp"
 #include "halo.hpp"
 #include "integrate.hpp"
@@ -990,6 +991,9 @@ void lattice_boltzmann_update() {
   if (fluidstep >= factor) {
     fluidstep = 0;
 
+    if (ek_cpu_initialized) {
+      ek_cpu_integrate();
+    }
     lb_collide_stream();
   }
 }
@@ -32,6 +32,7 @@
 #include "event.hpp"
 #include "grid.hpp"
 #include "grid_based_algorithms/electrokinetics.hpp"
+#include "grid_based_algorithms/electrokinetics_cpu.hpp"
 #include "grid_based_algorithms/lattice.hpp"
 #include "grid_based_algorithms/lb.hpp"
 #include "grid_based_algorithms/lb_interface.hpp"
@@ -41,14 +42,20 @@
 #include <utils/Vector.hpp>
 #include <utils/index.hpp>
 
-#include <boost/range/adaptor/reversed.hpp>
+#include <boost/mpi/collectives/broadcast.hpp>
+#include <boost/mpi/collectives/gather.hpp>
 #include <boost/range/algorithm.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <fstream>
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 using Utils::get_linear_index;
@@ -58,8 +65,97 @@ namespace LBBoundaries {
 std::vector<std::shared_ptr<LBBoundary>> lbboundaries;
 #if defined(LB_BOUNDARIES) || defined(LB_BOUNDARIES_GPU)
 
+namespace {
+/** Boundary flag field loaded by @ref load_boundary_flags, with the
+ *  halo on the CPU and for the whole lattice on the GPU.
+ */
+std::vector<int> loaded_flags;
+/** Size of @ref loaded_flags per direction. */
+Utils::Vector3i loaded_flags_size{};
+
+/**
+ * @brief Rasterize the boundaries on a regular grid of nodes.
+ *
+ * Each boundary is only evaluated on the nodes inside of the bounding
+ * box of its shape. Later boundaries take precedence over earlier ones.
+ *
+ * @param offset    Position of the first node in units of the spacing.
+ * @param agrid     Node spacing.
+ * @param grid_size Number of nodes per direction.
+ * @return Per node, the index of the boundary plus one, or 0 for fluid
+ *         nodes, in the order of @ref Utils::get_linear_index.
+ */
+std::vector<int> voxelize(Utils::Vector3d const &offset, double agrid,
+                          Utils::Vector3i const &grid_size) {
+  std::vector<int> flags(
+      static_cast<std::size_t>(grid_size[0]) * grid_size[1] * grid_size[2], 0);
+
+  for (std::size_t n = 0; n < lbboundaries.size(); n++) {
+    auto const &shape = lbboundaries[n]->shape();
+    auto const box = shape.bounding_box();
+
+    /* Node range covering the box, with one node of margin against
+     * rounding errors. */
+    Utils::Vector3i lower, upper;
+    for (int i = 0; i < 3; i++) {
+      auto const clamp = [&grid_size, i](double x) {
+        return static_cast<int>(
+            std::min(std::max(x, 0.), static_cast<double>(grid_size[i])));
+      };
+      lower[i] = clamp(std::floor(box.first[i] / agrid - offset[i]) - 1.);
+      upper[i] = clamp(std::ceil(box.second[i] / agrid - offset[i]) + 2.);
+    }
+
+    for (int z = lower[2]; z < upper[2]; z++) {
+      for (int y = lower[1]; y < upper[1]; y++) {
+        for (int x = lower[0]; x < upper[0]; x++) {
+          auto const pos =
+              (offset + Utils::Vector3d{1. * x, 1. * y, 1. * z}) * agrid;
+          if (not shape.is_inside(pos)) {
+            flags[get_linear_index(x, y, z, grid_size)] =
+                static_cast<int>(n) + 1;
+          }
+        }
+      }
+    }
+  }
+
+  return flags;
+}
+
+#if defined(LB_BOUNDARIES)
+/** Boundary flags of the local lattice nodes including the halo. */
+std::vector<int> boundary_flags_cpu(Lattice const &lattice) {
+  if (not loaded_flags.empty() and loaded_flags_size == lattice.halo_grid) {
+    return loaded_flags;
+  }
+
+  auto const node_pos = calc_node_pos(comm_cart);
+  auto const offset = Utils::hadamard_product(node_pos, lattice.grid);
+  return voxelize(offset - Utils::Vector3d::broadcast(0.5), lattice.agrid,
+                  lattice.halo_grid);
+}
+#endif
+
+#if defined(CUDA) && defined(LB_BOUNDARIES_GPU)
+/** Boundary flags of all lattice nodes. */
+std::vector<int> boundary_flags_gpu() {
+  auto const grid_size = Utils::Vector3i{static_cast<int>(lbpar_gpu.dim_x),
+                                         static_cast<int>(lbpar_gpu.dim_y),
+                                         static_cast<int>(lbpar_gpu.dim_z)};
+  if (not loaded_flags.empty() and loaded_flags_size == grid_size) {
+    return loaded_flags;
+  }
+
+  return voxelize(Utils::Vector3d::broadcast(0.5),
+                  static_cast<double>(lbpar_gpu.agrid), grid_size);
+}
+#endif
+} // namespace
+
 void add(const std::shared_ptr<LBBoundary> &b) {
   lbboundaries.emplace_back(b);
+  loaded_flags.clear();
 
   on_lbboundary_change();
 }
@@ -67,6 +163,7 @@ void add(const std::shared_ptr<LBBoundary> &b) {
 void remove(const std::shared_ptr<LBBoundary> &b) {
   lbboundaries.erase(std::remove(lbboundaries.begin(), lbboundaries.end(), b),
                      lbboundaries.end());
+  loaded_flags.clear();
 
   on_lbboundary_change();
 }
@@ -161,39 +258,18 @@ void lb_init_boundaries() {
       return;
     }
     ek_init_boundaries();
-    int number_of_boundnodes = 0;
     std::vector<int> host_boundary_node_list;
     std::vector<int> host_boundary_index_list;
-    size_t size_of_index;
-
-    for (int z = 0; z < int(lbpar_gpu.dim_z); z++) {
-      for (int y = 0; y < int(lbpar_gpu.dim_y); y++) {
-        for (int x = 0; x < int(lbpar_gpu.dim_x); x++) {
-          auto const pos = static_cast<double>(lbpar_gpu.agrid) *
-                           (Utils::Vector3d{1. * x, 1. * y, 1. * z} +
-                            Utils::Vector3d::broadcast(0.5));
 
-          // take last boundary containing the node
-          auto const boundary = boost::find_if(
-              lbboundaries | boost::adaptors::reversed, [&pos](auto const lbb) {
-                return not lbb->shape().is_inside(pos);
-              });
-
-          if (boundary != boost::rend(lbboundaries)) {
-            size_of_index = (number_of_boundnodes + 1) * sizeof(int);
-            host_boundary_node_list.resize(size_of_index);
-            host_boundary_index_list.resize(size_of_index);
-            host_boundary_node_list[number_of_boundnodes] =
-                x + lbpar_gpu.dim_x * y + lbpar_gpu.dim_x * lbpar_gpu.dim_y * z;
-            auto const boundary_number =
-                std::distance(lbboundaries.begin(), boundary.base()) - 1;
-            host_boundary_index_list[number_of_boundnodes] =
-                boundary_number + 1;
-            number_of_boundnodes++;
-          }
-        }
+    auto const flags = boundary_flags_gpu();
+    for (int i = 0; i < static_cast<int>(flags.size()); i++) {
+      if (flags[i]) {
+        host_boundary_node_list.push_back(i);
+        host_boundary_index_list.push_back(flags[i]);
       }
     }
+    auto const number_of_boundnodes =
+        static_cast<int>(host_boundary_node_list.size());
     lbpar_gpu.number_of_boundnodes = number_of_boundnodes;
     /* call of cuda fkt */
     std::vector<float> boundary_velocity(3 * (lbboundaries.size() + 1));
@@ -221,38 +297,180 @@ void lb_init_boundaries() {
 
     boost::for_each(lbfields, [](auto &f) { f.boundary = 0; });
 
-    auto const node_pos = calc_node_pos(comm_cart);
-    auto const offset = Utils::hadamard_product(node_pos, lblattice.grid);
+    auto const flags = boundary_flags_cpu(lblattice);
+    for (std::size_t index = 0; index < flags.size(); index++) {
+      auto &node = lbfields[index];
+      node.boundary = flags[index];
+      if (flags[index]) {
+        node.slip_velocity = lbboundaries[flags[index] - 1]->velocity() *
+                             (lb_lbfluid_get_tau() / lb_lbfluid_get_agrid());
+      }
+    }
 
-    for (int z = 0; z < lblattice.grid[2] + 2; z++) {
-      for (int y = 0; y < lblattice.grid[1] + 2; y++) {
-        for (int x = 0; x < lblattice.grid[0] + 2; x++) {
-          auto const pos =
-              (offset + Utils::Vector3d{x - 0.5, y - 0.5, z - 0.5}) *
-              lblattice.agrid;
-
-          auto const boundary = boost::find_if(
-              lbboundaries | boost::adaptors::reversed, [&pos](auto const lbb) {
-                return not lbb->shape().is_inside(pos);
-              });
-          if (boundary != boost::rend(lbboundaries)) {
-            auto const index = get_linear_index(x, y, z, lblattice.halo_grid);
-            auto const boundary_number =
-                std::distance(lbboundaries.begin(), boundary.base()) - 1;
-            auto &node = lbfields[index];
-            node.boundary = static_cast<int>(boundary_number) + 1;
-            node.slip_velocity =
-                (*boundary)->velocity() *
-                (lb_lbfluid_get_tau() / lb_lbfluid_get_agrid());
-          } else {
-            lbfields[get_linear_index(x, y, z, lblattice.halo_grid)].boundary =
-                0;
-          }
+    if (ek_cpu_initialized) {
+      ek_cpu_init_boundaries();
+    }
+#endif
+  }
+}
+
+void save_boundary_flags(std::string const &filename) {
+  if (lattice_switch == ActiveLB::NONE)
+    throw std::runtime_error("LB is not active.");
+
+  Utils::Vector3i global_size{};
+  std::vector<int> global_flags;
+
+  if (lattice_switch == ActiveLB::GPU) {
+#if defined(CUDA) && defined(LB_BOUNDARIES_GPU)
+    if (this_node == 0) {
+      global_size = {static_cast<int>(lbpar_gpu.dim_x),
+                     static_cast<int>(lbpar_gpu.dim_y),
+                     static_cast<int>(lbpar_gpu.dim_z)};
+      global_flags = boundary_flags_gpu();
+    }
+#endif
+  } else if (lattice_switch == ActiveLB::CPU) {
+#if defined(LB_BOUNDARIES)
+    auto const &lattice = lb_lbfluid_get_lattice();
+    auto const &grid = lattice.grid;
+
+    std::vector<int> local_flags;
+    local_flags.reserve(static_cast<std::size_t>(grid[0]) * grid[1] * grid[2]);
+    for (int z = 1; z <= grid[2]; z++)
+      for (int y = 1; y <= grid[1]; y++)
+        for (int x = 1; x <= grid[0]; x++)
+          local_flags.push_back(
+              lbfields[get_linear_index(x, y, z, lattice.halo_grid)].boundary);
+
+    auto const offset =
+        Utils::hadamard_product(calc_node_pos(comm_cart), grid);
+    std::vector<std::vector<int>> flags;
+    std::vector<Utils::Vector3i> offsets;
+    boost::mpi::gather(comm_cart, local_flags, flags, 0);
+    boost::mpi::gather(comm_cart, offset, offsets, 0);
+
+    if (this_node == 0) {
+      global_size = lattice.global_grid;
+      global_flags.resize(static_cast<std::size_t>(global_size[0]) *
+                          global_size[1] * global_size[2]);
+      for (std::size_t rank = 0; rank < flags.size(); rank++) {
+        auto it = flags[rank].begin();
+        for (int z = 0; z < grid[2]; z++)
+          for (int y = 0; y < grid[1]; y++)
+            for (int x = 0; x < grid[0]; x++)
+              global_flags[get_linear_index(offsets[rank][0] + x,
+                                            offsets[rank][1] + y,
+                                            offsets[rank][2] + z,
+                                            global_size)] = *it++;
+      }
+    }
+#endif
+  }
+
+  if (this_node == 0) {
+    std::ofstream file(filename);
+    if (not file)
+      throw std::runtime_error("Could not open '" + filename + "'.");
+    file << global_size[0] << " " << global_size[1] << " " << global_size[2]
+         << "\n";
+    for (auto const flag : global_flags) {
+      file << flag << "\n";
+    }
+  }
+}
+
+void load_boundary_flags(std::string const &filename) {
+  if (lattice_switch == ActiveLB::NONE)
+    throw std::runtime_error("LB is not active.");
+
+  Utils::Vector3i global_size{};
+  std::vector<int> global_flags;
+  std::string error;
+
+  Utils::Vector3i expected_size{};
+  if (lattice_switch == ActiveLB::GPU) {
+#if defined(CUDA) && defined(LB_BOUNDARIES_GPU)
+    expected_size = {static_cast<int>(lbpar_gpu.dim_x),
+                     static_cast<int>(lbpar_gpu.dim_y),
+                     static_cast<int>(lbpar_gpu.dim_z)};
+#endif
+  } else if (lattice_switch == ActiveLB::CPU) {
+    expected_size = lb_lbfluid_get_lattice().global_grid;
+  }
+
+  if (this_node == 0) {
+    std::ifstream file(filename);
+    if (not(file >> global_size[0] >> global_size[1] >> global_size[2])) {
+      error = "could not read '" + filename + "'";
+    } else if (global_size != expected_size) {
+      error = "the lattice size does not match";
+    } else {
+      global_flags.resize(static_cast<std::size_t>(global_size[0]) *
+                          global_size[1] * global_size[2]);
+      for (auto &flag : global_flags) {
+        if (not(file >> flag)) {
+          error = "unexpected end of file";
+          break;
+        }
+        if (flag < 0 or flag > static_cast<int>(lbboundaries.size())) {
+          error = "the flags do not match the boundaries";
+          break;
         }
       }
     }
+  }
+  boost::mpi::broadcast(comm_cart, error, 0);
+  if (not error.empty()) {
+    throw std::runtime_error("Error while reading LB boundary flags: " +
+                             error);
+  }
+
+  if (lattice_switch == ActiveLB::GPU) {
+#if defined(CUDA) && defined(LB_BOUNDARIES_GPU)
+    if (this_node == 0) {
+      loaded_flags = std::move(global_flags);
+      loaded_flags_size = global_size;
+    }
+#endif
+  } else if (lattice_switch == ActiveLB::CPU) {
+#if defined(LB_BOUNDARIES)
+    auto const &lattice = lb_lbfluid_get_lattice();
+    auto const offset =
+        Utils::hadamard_product(calc_node_pos(comm_cart), lattice.grid);
+    std::vector<Utils::Vector3i> offsets;
+    boost::mpi::gather(comm_cart, offset, offsets, 0);
+
+    /* Every rank gets its part of the lattice, including the halo
+     * from the periodic images. */
+    auto const local_flags = [&](Utils::Vector3i const &local_offset) {
+      std::vector<int> flags;
+      flags.reserve(lattice.halo_grid_volume);
+      for (int z = 0; z < lattice.halo_grid[2]; z++)
+        for (int y = 0; y < lattice.halo_grid[1]; y++)
+          for (int x = 0; x < lattice.halo_grid[0]; x++) {
+            Utils::Vector3i node = local_offset + Utils::Vector3i{x, y, z};
+            for (int i = 0; i < 3; i++) {
+              node[i] = (node[i] - 1 + global_size[i]) % global_size[i];
+            }
+            flags.push_back(global_flags[get_linear_index(node, global_size)]);
+          }
+      return flags;
+    };
+
+    if (this_node == 0) {
+      for (int rank = 1; rank < comm_cart.size(); rank++) {
+        comm_cart.send(rank, 0, local_flags(offsets[rank]));
+      }
+      loaded_flags = local_flags(offset);
+    } else {
+      comm_cart.recv(0, 0, loaded_flags);
+    }
+    loaded_flags_size = lattice.halo_grid;
 #endif
   }
+
+  on_lbboundary_change();
 }
 
 #if defined(LB_BOUNDARIES)
@@ -46,6 +46,7 @@
 
 #include <array>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace LBBoundaries {
@@ -63,6 +64,21 @@ void lb_init_boundaries();
 void add(const std::shared_ptr<LBBoundary> &);
 void remove(const std::shared_ptr<LBBoundary> &);
 
+/** @brief Write the boundary flags of all lattice nodes to a file.
+ *
+ *  The flag of a node is the index of its boundary plus one, or zero
+ *  for fluid nodes. Has to be called on all nodes.
+ */
+void save_boundary_flags(std::string const &filename);
+
+/** @brief Read boundary flags written by @ref save_boundary_flags.
+ *
+ *  The flags have to refer to the current boundaries. They are used
+ *  instead of the shapes of the boundaries until a boundary is added
+ *  or removed, or the lattice changes. Has to be called on all nodes.
+ */
+void load_boundary_flags(std::string const &filename);
+
 #endif // (LB_BOUNDARIES) || (LB_BOUNDARIES_GPU)
 } // namespace LBBoundaries
 #endif /* LB_BOUNDARIES_H */
@@ -22,6 +22,7 @@
 #include "communication.hpp"
 #include "config.hpp"
 #include "electrokinetics.hpp"
+#include "electrokinetics_cpu.hpp"
 #include "errorhandling.hpp"
 #include "global.hpp"
 #include "grid.hpp"
@@ -119,6 +120,9 @@ void lb_lbfluid_sanity_checks() {
     if (time_step > 0.)
       check_tau_time_step_consistency(lb_lbfluid_get_tau(), time_step);
   }
+  if (ek_cpu_initialized) {
+    ek_cpu_sanity_checks();
+  }
 }
 
 void lb_lbfluid_on_integration_start() {
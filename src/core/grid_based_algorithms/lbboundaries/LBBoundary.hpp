@@ -40,7 +40,7 @@ public:
       : m_shape(std::make_shared<Shapes::NoWhere>()),
         m_velocity(Utils::Vector3d{0, 0, 0}),
         m_force(Utils::Vector3d{0, 0, 0}) {
-#ifdef EK_BOUNDARIES
+#if defined(EK_BOUNDARIES) || defined(LB_BOUNDARIES)
     m_charge_density = 0.0;
     m_net_charge = 0.0;
 #endif
@@ -75,9 +75,10 @@ public:
 #endif
   }
 
-#ifdef EK_BOUNDARIES // TODO: ugly. Better would be a class EKBoundaries,
-                     // deriving from LBBoundaries, but that requires completely
-                     // different initialization infrastructure.
+// TODO: ugly. Better would be a class EKBoundaries, deriving from
+// LBBoundaries, but that requires completely different initialization
+// infrastructure.
+#if defined(EK_BOUNDARIES) || defined(LB_BOUNDARIES)
   void set_charge_density(double charge_density) {
     m_charge_density = static_cast<float>(charge_density);
   }
@@ -95,9 +96,10 @@ private:
   Utils::Vector3d m_velocity;
   Utils::Vector3d m_force;
 
-#ifdef EK_BOUNDARIES // TODO: ugly. Better would be a class EKBoundaries,
-                     // deriving from LBBoundaries, but that requires completely
-                     // different initialization infrastructure.
+// TODO: ugly. Better would be a class EKBoundaries, deriving from
+// LBBoundaries, but that requires completely different initialization
+// infrastructure.
+#if defined(EK_BOUNDARIES) || defined(LB_BOUNDARIES)
   float m_charge_density;
   float m_net_charge;
 #endif
@@ -32,6 +32,7 @@
 #include "integrators/stokesian_dynamics_inline.hpp"
 #include "integrators/velocity_verlet_inline.hpp"
 #include "integrators/velocity_verlet_npt.hpp"
+#include "integrators/velocity_verlet_respa.hpp"
 
 #include "ParticleRange.hpp"
 #include "accumulators.hpp"
@@ -40,6 +41,7 @@
 #include "communication.hpp"
 #include "electrostatics_magnetostatics/coulomb.hpp"
 #include "electrostatics_magnetostatics/dipole.hpp"
+#include "energy.hpp"
 #include "errorhandling.hpp"
 #include "event.hpp"
 #include "forces.hpp"
@@ -47,8 +49,10 @@
 #include "grid.hpp"
 #include "grid_based_algorithms/lb_interface.hpp"
 #include "grid_based_algorithms/lb_particle_coupling.hpp"
+#include "load_balancing.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "npt.hpp"
+#include "pressure.hpp"
 #include "rattle.hpp"
 #include "rotation.hpp"
 #include "signalhandling.hpp"
@@ -110,6 +114,9 @@ void integrator_sanity_checks() {
     if (thermo_switch != THERMO_BROWNIAN)
       runtimeErrorMsg() << "The BD integrator requires the BD thermostat";
     break;
+  case INTEG_METHOD_RESPA:
+    velocity_verlet_respa_sanity_checks();
+    break;
 #ifdef STOKESIAN_DYNAMICS
   case INTEG_METHOD_SD:
     if (thermo_switch != THERMO_OFF and thermo_switch != THERMO_SD)
@@ -142,6 +149,9 @@ bool integrator_step_1(ParticleRange &particles) {
     // the Ermak-McCammon's Brownian Dynamics requires a single step
     // so, just skip here
     break;
+  case INTEG_METHOD_RESPA:
+    velocity_verlet_respa_step_1(particles);
+    break;
 #ifdef STOKESIAN_DYNAMICS
   case INTEG_METHOD_SD:
     stokesian_dynamics_step_1(particles);
@@ -153,8 +163,11 @@ bool integrator_step_1(ParticleRange &particles) {
   return false;
 }
 
-/** Calls the hook of the propagation kernels after force calculation */
-void integrator_step_2(ParticleRange &particles) {
+/** Calls the hook of the propagation kernels after force calculation
+ *  @param particles  The local particles.
+ *  @param last_step  Whether this is the last step of the integration.
+ */
+void integrator_step_2(ParticleRange &particles, bool last_step) {
   switch (integ_switch) {
   case INTEG_METHOD_STEEPEST_DESCENT:
     // Nothing
@@ -171,6 +184,9 @@ void integrator_step_2(ParticleRange &particles) {
     // the Ermak-McCammon's Brownian Dynamics requires a single step
     brownian_dynamics_propagator(brownian, particles);
     break;
+  case INTEG_METHOD_RESPA:
+    velocity_verlet_respa_step_2(particles, last_step);
+    break;
 #ifdef STOKESIAN_DYNAMICS
   case INTEG_METHOD_SD:
     stokesian_dynamics_step_2(particles);
@@ -181,7 +197,14 @@ void integrator_step_2(ParticleRange &particles) {
   }
 }
 
-int integrate(int n_steps, int reuse_forces) {
+/** Force groups of the force calculation after the propagation */
+static unsigned integrator_force_groups() {
+  if (integ_switch == INTEG_METHOD_RESPA)
+    return velocity_verlet_respa_outer_force_groups();
+  return FORCE_GROUP_ALL;
+}
+
+int integrate(int n_steps, int reuse_forces, int fused_observables) {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
 
   /* Prepare the integrator */
@@ -193,10 +216,20 @@ int integrate(int n_steps, int reuse_forces) {
 
   /* Verlet list criterion */
 
+  /* The RESPA integrator can only reuse the forces if it knows their split
+   * into the two levels. */
+  auto const respa = integ_switch == INTEG_METHOD_RESPA;
+  if (!respa)
+    velocity_verlet_respa_invalidate_forces();
+  auto const respa_forces_valid =
+      respa &&
+      velocity_verlet_respa_forces_valid(cell_structure.local_particles());
+
   /* Integration Step: Preparation for first integration step:
    * Calculate forces F(t) as function of positions x(t) (and velocities v(t))
    */
-  if (reuse_forces == -1 || (recalc_forces && reuse_forces != 1)) {
+  if (reuse_forces == -1 || (recalc_forces && reuse_forces != 1) ||
+      (respa && !respa_forces_valid)) {
     ESPRESSO_PROFILER_MARK_BEGIN("Initial Force Calculation");
     lb_lbcoupling_deactivate();
 
@@ -207,7 +240,11 @@ int integrate(int n_steps, int reuse_forces) {
     // Communication step: distribute ghost positions
     cells_update_ghosts(global_ghost_flags());
 
-    force_calc(cell_structure, time_step);
+    force_calc(cell_structure, time_step, nullptr, integrator_force_groups());
+    if (respa) {
+      velocity_verlet_respa_init_forces(cell_structure.local_particles(),
+                                        n_steps == 0);
+    }
 
     if (integ_switch != INTEG_METHOD_STEEPEST_DESCENT) {
 #ifdef ROTATION
@@ -216,16 +253,25 @@ int integrate(int n_steps, int reuse_forces) {
     }
 
     ESPRESSO_PROFILER_MARK_END("Initial Force Calculation");
+  } else if (respa) {
+    velocity_verlet_respa_set_forces(cell_structure.local_particles(),
+                                     n_steps == 0);
   }
 
   lb_lbcoupling_activate();
 
-  if (check_runtime_errors(comm_cart))
+  if (check_runtime_errors(comm_cart)) {
+    if (respa)
+      velocity_verlet_respa_set_forces(cell_structure.local_particles(), true);
     return 0;
+  }
 
   /* incremented if a Verlet update is done, aka particle resorting. */
   int n_verlet_updates = 0;
 
+  /* set if the observables were accumulated in the last force calculation */
+  bool observables_sampled = false;
+
 #ifdef VALGRIND_INSTRUMENTATION
   CALLGRIND_START_INSTRUMENTATION;
 #endif
@@ -258,7 +304,7 @@ int integrate(int n_steps, int reuse_forces) {
 #endif
 
 #ifdef VIRTUAL_SITES
-    virtual_sites()->update();
+    virtual_sites()->update_after_propagation();
 #endif
 
     if (cell_structure.get_resort_particles() >= Cells::RESORT_LOCAL)
@@ -267,14 +313,30 @@ int integrate(int n_steps, int reuse_forces) {
     // Communication step: distribute ghost positions
     cells_update_ghosts(global_ghost_flags());
 
+#ifdef VIRTUAL_SITES
+    virtual_sites()->update_after_ghosts_update();
+#endif
+
     particles = cell_structure.local_particles();
 
-    force_calc(cell_structure, time_step);
+    if (fused_observables and step == n_steps - 1) {
+      ForceCalcObservables observables{
+          (fused_observables & FUSED_OBSERVABLES_ENERGY) ? energy_fused_begin()
+                                                         : nullptr,
+          (fused_observables & FUSED_OBSERVABLES_PRESSURE)
+              ? pressure_fused_begin()
+              : nullptr};
+      force_calc(cell_structure, time_step, &observables);
+      observables_sampled = true;
+    } else {
+      force_calc(cell_structure, time_step, nullptr,
+                 integrator_force_groups());
+    }
 
 #ifdef VIRTUAL_SITES
     virtual_sites()->after_force_calc();
 #endif
-    integrator_step_2(particles);
+    integrator_step_2(particles, step == n_steps - 1);
 #ifdef BOND_CONSTRAINT
     // SHAKE velocity updates
     if (n_rigidbonds) {
@@ -301,6 +363,8 @@ int integrate(int n_steps, int reuse_forces) {
     if (check_runtime_errors(comm_cart))
       break;
 
+    LoadBalancing::on_integration_step();
+
     // Check if SIGINT has been caught.
     if (ctrl_C == 1) {
       notify_sig_int();
@@ -314,10 +378,23 @@ int integrate(int n_steps, int reuse_forces) {
   CALLGRIND_STOP_INSTRUMENTATION;
 #endif
 
+  /* after an early exit, the RESPA forces are the kick forces */
+  if (respa && integrated_steps != n_steps) {
+    velocity_verlet_respa_set_forces(cell_structure.local_particles(), true);
+  }
+
 #ifdef VIRTUAL_SITES
   virtual_sites()->update();
 #endif
 
+  /* complete the sampled observables with the final velocities */
+  if (observables_sampled) {
+    if (fused_observables & FUSED_OBSERVABLES_ENERGY)
+      energy_fused_end();
+    if (fused_observables & FUSED_OBSERVABLES_PRESSURE)
+      pressure_fused_end();
+  }
+
   /* verlet list statistics */
   if (n_verlet_updates > 0)
     verlet_reuse = n_steps / (double)n_verlet_updates;
@@ -332,7 +409,8 @@ int integrate(int n_steps, int reuse_forces) {
   return integrated_steps;
 }
 
-int python_integrate(int n_steps, bool recalc_forces, bool reuse_forces_par) {
+int python_integrate(int n_steps, bool recalc_forces, bool reuse_forces_par,
+                     int fused_observables) {
   // Override the signal handler so that the integrator obeys Ctrl+C
   SignalHandler sa(SIGINT, [](int) { ctrl_C = 1; });
 
@@ -369,16 +447,36 @@ int python_integrate(int n_steps, bool recalc_forces, bool reuse_forces_par) {
   using Accumulators::auto_update;
   using Accumulators::auto_update_next_update;
 
+#ifdef COLLISION_DETECTION
+  /* collisions change the bonds after the force calculation */
+  if (collision_params.mode != COLLISION_MODE_OFF)
+    fused_observables = 0;
+#endif
+  /* only the velocity Verlet variants end a step with the force calculation
+   * of the final positions */
+  if (integ_switch != INTEG_METHOD_NVT && integ_switch != INTEG_METHOD_NPT_ISO)
+    fused_observables = 0;
+
   for (int i = 0; i < n_steps;) {
     /* Integrate to either the next accumulator update, or the
      * end, depending on what comes first. */
-    auto const steps = std::min((n_steps - i), auto_update_next_update());
-    if (mpi_integrate(steps, reuse_forces))
-      return ES_ERROR;
+    auto const next_update = auto_update_next_update();
+    auto const steps = std::min((n_steps - i), next_update);
+    /* Accumulate the observables in the last force calculation if the
+     * accumulators sample afterwards. */
+    auto const error = mpi_integrate(steps, reuse_forces,
+                                     (steps == next_update) ? fused_observables
+                                                            : 0);
+    if (!error) {
+      reuse_forces = 1;
+      auto_update(steps);
+    }
 
-    reuse_forces = 1;
+    energy_fused_invalidate();
+    pressure_fused_invalidate();
 
-    auto_update(steps);
+    if (error)
+      return ES_ERROR;
 
     i += steps;
   }
@@ -401,17 +499,19 @@ int mpi_steepest_descent(int steps) {
                   mpi_steepest_descent_local, steps, 0);
 }
 
-static int mpi_integrate_local(int n_steps, int reuse_forces) {
-  integrate(n_steps, reuse_forces);
+static int mpi_integrate_local(int n_steps, int reuse_forces,
+                               int fused_observables) {
+  integrate(n_steps, reuse_forces, fused_observables);
 
   return check_runtime_errors_local();
 }
 
 REGISTER_CALLBACK_REDUCTION(mpi_integrate_local, std::plus<int>())
 
-int mpi_integrate(int n_steps, int reuse_forces) {
+int mpi_integrate(int n_steps, int reuse_forces, int fused_observables) {
   return mpi_call(Communication::Result::reduction, std::plus<int>(),
-                  mpi_integrate_local, n_steps, reuse_forces);
+                  mpi_integrate_local, n_steps, reuse_forces,
+                  fused_observables);
 }
 
 int integrate_set_steepest_descent(const double f_max, const double gamma,
@@ -446,6 +546,25 @@ void integrate_set_bd() {
   mpi_bcast_parameter(FIELD_INTEG_SWITCH);
 }
 
+int integrate_set_respa(int n_inner, unsigned inner_force_groups) {
+  if (n_inner < 1) {
+    runtimeErrorMsg() << "The number of inner steps must be positive.\n";
+    return ES_ERROR;
+  }
+  if (inner_force_groups & ~(FORCE_GROUP_BONDED | FORCE_GROUP_SHORT_RANGE |
+                             FORCE_GROUP_LONG_RANGE)) {
+    runtimeErrorMsg() << "Only the bonded, short range and long range forces "
+                         "can be on the inner level.\n";
+    return ES_ERROR;
+  }
+  velocity_verlet_respa_init(n_inner, inner_force_groups);
+  integ_switch = INTEG_METHOD_RESPA;
+  mpi_bcast_parameter(FIELD_INTEG_SWITCH);
+  // broadcast integrator parameters to all nodes
+  mpi_bcast_velocity_verlet_respa();
+  return ES_OK;
+}
+
 int integrate_set_sd() {
   if (box_geo.periodic(0) || box_geo.periodic(1) || box_geo.periodic(2)) {
     runtimeErrorMsg() << "Stokesian Dynamics requires periodicity 0 0 0\n";
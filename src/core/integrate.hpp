@@ -34,6 +34,13 @@
 #define INTEG_METHOD_STEEPEST_DESCENT 2
 #define INTEG_METHOD_BD 3
 #define INTEG_METHOD_SD 7
+#define INTEG_METHOD_RESPA 8
+/**@}*/
+
+/** \name Observables accumulated during the force calculation */
+/**@{*/
+#define FUSED_OBSERVABLES_ENERGY 1
+#define FUSED_OBSERVABLES_PRESSURE 2
 /**@}*/
 
 /** Switch determining which integrator to use. */
@@ -73,6 +80,11 @@ void integrator_sanity_checks();
  *                         meaning it is probably necessary
  *                       - 1: do not recalculate forces (mostly when reading
  *                         checkpoints with forces)
+ *  @param fused_observables  Bitmask of FUSED_OBSERVABLES_* flags. The
+ *                         selected observables are accumulated in the force
+ *                         calculation of the last step and kept for the
+ *                         next observable evaluation, see
+ *                         @ref energy_fused_end and @ref pressure_fused_end.
  *
  *  @details This function calls two hooks for propagation kernels such as
  *  velocity verlet, velocity verlet + npt box changes, and steepest_descent.
@@ -101,24 +113,30 @@ void integrator_sanity_checks();
  *
  *  @return number of steps that have been integrated
  */
-int integrate(int n_steps, int reuse_forces);
+int integrate(int n_steps, int reuse_forces, int fused_observables = 0);
 
 /** @brief Run the integration loop. Can be interrupted with Ctrl+C.
  *
  *  @param n_steps        Number of integration steps, can be zero
  *  @param recalc_forces  Whether to recalculate forces
  *  @param reuse_forces   Whether to re-use forces
+ *  @param fused_observables  Bitmask of FUSED_OBSERVABLES_* flags for the
+ *                        observables that are accumulated in the force
+ *                        calculation of the steps on which the
+ *                        auto-update accumulators sample
  *  @retval ES_OK on success
  *  @retval ES_ERROR on error
  */
-int python_integrate(int n_steps, bool recalc_forces, bool reuse_forces);
+int python_integrate(int n_steps, bool recalc_forces, bool reuse_forces,
+                     int fused_observables = 0);
 
 /** Start integrator.
  *  @param n_steps       how many steps to do.
  *  @param reuse_forces  whether to trust the old forces for the first half step
+ *  @param fused_observables  observables to accumulate in the last step
  *  @return nonzero on error
  */
-int mpi_integrate(int n_steps, int reuse_forces);
+int mpi_integrate(int n_steps, int reuse_forces, int fused_observables = 0);
 
 /** Steepest descent main integration loop
  *
@@ -144,6 +162,16 @@ void integrate_set_nvt();
 /** @brief Set the Brownian Dynamics integrator. */
 void integrate_set_bd();
 
+/** @brief Set the reversible multiple time step velocity Verlet integrator.
+ *
+ *  @param n_inner             Number of inner steps per time step
+ *  @param inner_force_groups  Bitmask of FORCE_GROUP_* flags of the
+ *                             force groups on the inner level
+ *  @retval ES_OK on success
+ *  @retval ES_ERROR on error
+ */
+int integrate_set_respa(int n_inner, unsigned inner_force_groups);
+
 /** @brief Set the Stokesian Dynamics integrator. */
 int integrate_set_sd();
 
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "integrators/velocity_verlet_respa.hpp"
+
+#include "Particle.hpp"
+#include "ParticleRange.hpp"
+#include "cells.hpp"
+#include "collision.hpp"
+#include "communication.hpp"
+#include "config.hpp"
+#include "errorhandling.hpp"
+#include "event.hpp"
+#include "forcecap.hpp"
+#include "forces.hpp"
+#include "integrate.hpp"
+#include "rattle.hpp"
+#include "thermostat.hpp"
+#include "virtual_sites.hpp"
+
+#include <utils/Vector.hpp>
+#include <utils/math/sqr.hpp>
+
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/collectives/broadcast.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+/** Currently active RESPA parameters */
+static VelocityVerletRespaParameters params{};
+
+namespace {
+/** Inner and outer forces of the local particles in the last force
+ *  calculation of the integrator, in the order of the particles. */
+struct SplitForces {
+  std::vector<int> ids;
+  std::vector<Utils::Vector3d> inner;
+  std::vector<Utils::Vector3d> outer;
+  /** Whether the particle forces were set from these */
+  bool valid = false;
+
+  /** Whether the forces are known for exactly @p particles. */
+  bool matches(const ParticleRange &particles) const {
+    return valid and ids.size() == particles.size() and
+           std::equal(ids.begin(), ids.end(), particles.begin(),
+                      [](int id, Particle const &p) {
+                        return id == p.identity();
+                      });
+  }
+} split_forces;
+
+/** Kick the velocities with the current forces for a time @p dt. */
+void kick(const ParticleRange &particles, double dt) {
+  for (auto &p : particles) {
+    if (p.p.is_virtual)
+      continue;
+    for (int j = 0; j < 3; j++) {
+      if (!(p.p.ext_flag & COORD_FIXED(j))) {
+        p.m.v[j] += dt * p.f.f[j] / p.p.mass;
+      }
+    }
+  }
+}
+
+/** Kick the velocities with the current forces for a time @p dt_kick,
+ *  then propagate the positions for a time @p dt, and check the Verlet
+ *  list criterion. */
+void kick_drift(const ParticleRange &particles, double dt_kick, double dt) {
+  auto const skin2 = Utils::sqr(0.5 * skin);
+  for (auto &p : particles) {
+    if (p.p.is_virtual)
+      continue;
+    for (int j = 0; j < 3; j++) {
+      if (!(p.p.ext_flag & COORD_FIXED(j))) {
+        p.m.v[j] += dt_kick * p.f.f[j] / p.p.mass;
+        p.r.p[j] += dt * p.m.v[j];
+      }
+    }
+
+    if ((p.r.p - p.l.p_old).norm2() > skin2)
+      cell_structure.set_resort_particles(Cells::RESORT_LOCAL);
+  }
+}
+
+/** Calculate the inner forces at the current positions, which have
+ *  changed since the last force calculation. */
+void inner_force_calc(ParticleRange &particles) {
+#ifdef VIRTUAL_SITES
+  virtual_sites()->update_after_propagation();
+#endif
+  cells_update_ghosts(global_ghost_flags());
+#ifdef VIRTUAL_SITES
+  virtual_sites()->update_after_ghosts_update();
+#endif
+  particles = cell_structure.local_particles();
+  force_calc(cell_structure, time_step, nullptr, params.inner_force_groups);
+}
+
+/** Add the inner forces to the outer forces, which are the current
+ *  forces. The positions have not changed since the outer force
+ *  calculation.
+ *
+ *  @param particles  The local particles.
+ *  @param dt_kick    Time for which the velocities are kicked with the
+ *                    inner forces.
+ *  @param outer_weight  Weight of the outer forces in the result.
+ */
+void add_inner_forces(const ParticleRange &particles, double dt_kick,
+                      double outer_weight) {
+  split_forces.ids.clear();
+  split_forces.inner.clear();
+  split_forces.outer.clear();
+  for (auto const &p : particles) {
+    split_forces.ids.push_back(p.identity());
+    split_forces.outer.push_back(p.f.f);
+  }
+
+  force_calc(cell_structure, time_step, nullptr, params.inner_force_groups);
+  kick(particles, dt_kick);
+
+  auto outer_force = split_forces.outer.begin();
+  for (auto &p : particles) {
+    split_forces.inner.push_back(p.f.f);
+    p.f.f += outer_weight * *outer_force++;
+  }
+  split_forces.valid = true;
+}
+} // namespace
+
+void velocity_verlet_respa_init(int n_inner, unsigned inner_force_groups) {
+  params.n_inner = n_inner;
+  params.inner_force_groups = inner_force_groups;
+}
+
+static void mpi_bcast_velocity_verlet_respa_worker(int, int) {
+  boost::mpi::broadcast(comm_cart, params, 0);
+  split_forces.valid = false;
+}
+
+REGISTER_CALLBACK(mpi_bcast_velocity_verlet_respa_worker)
+
+void mpi_bcast_velocity_verlet_respa() {
+  mpi_call_all(mpi_bcast_velocity_verlet_respa_worker, -1, 0);
+}
+
+unsigned velocity_verlet_respa_outer_force_groups() {
+  return FORCE_GROUP_ALL & ~params.inner_force_groups;
+}
+
+void velocity_verlet_respa_sanity_checks() {
+  if (thermo_switch & ~(THERMO_LANGEVIN | THERMO_DPD | THERMO_LB)) {
+    runtimeErrorMsg() << "The RESPA integrator is incompatible with the "
+                         "currently active combination of thermostats";
+  }
+  if ((thermo_switch & THERMO_DPD) and
+      (params.inner_force_groups & FORCE_GROUP_SHORT_RANGE)) {
+    runtimeErrorMsg() << "The DPD thermostat requires the short range forces "
+                         "on the outer level of the RESPA integrator";
+  }
+#ifdef BOND_CONSTRAINT
+  if (n_rigidbonds) {
+    runtimeErrorMsg() << "The RESPA integrator does not support RATTLE";
+  }
+#endif
+#ifdef COLLISION_DETECTION
+  if (collision_params.mode != COLLISION_MODE_OFF) {
+    runtimeErrorMsg()
+        << "The RESPA integrator does not support collision detection";
+  }
+#endif
+  if (forcecap_get() != 0.) {
+    runtimeErrorMsg() << "The RESPA integrator does not support force capping";
+  }
+#ifdef ROTATION
+  for (auto const &p : cell_structure.local_particles()) {
+    if (p.p.rotation) {
+      runtimeErrorMsg() << "The RESPA integrator does not support rotational "
+                           "degrees of freedom";
+      break;
+    }
+  }
+#endif
+}
+
+void velocity_verlet_respa_init_forces(const ParticleRange &particles,
+                                       bool total) {
+  add_inner_forces(particles, 0., total ? 1. : params.n_inner);
+}
+
+bool velocity_verlet_respa_forces_valid(const ParticleRange &particles) {
+  return boost::mpi::all_reduce(comm_cart, split_forces.matches(particles),
+                                std::logical_and<bool>());
+}
+
+void velocity_verlet_respa_invalidate_forces() { split_forces.valid = false; }
+
+void velocity_verlet_respa_set_forces(const ParticleRange &particles,
+                                      bool total) {
+  if (not split_forces.matches(particles))
+    return;
+
+  auto const outer_weight = total ? 1. : params.n_inner;
+  auto inner_force = split_forces.inner.begin();
+  auto outer_force = split_forces.outer.begin();
+  for (auto &p : particles) {
+    p.f.f = *inner_force++;
+    p.f.f += outer_weight * *outer_force++;
+  }
+}
+
+void velocity_verlet_respa_step_1(ParticleRange &particles) {
+  auto const dt = time_step / params.n_inner;
+
+  /* The forces hold the inner forces plus n_inner times the outer
+   * forces, so the outer and the inner half kick are one. */
+  kick_drift(particles, 0.5 * dt, dt);
+  for (int i = 1; i < params.n_inner; i++) {
+    inner_force_calc(particles);
+    kick_drift(particles, dt, dt);
+  }
+
+  sim_time += time_step;
+}
+
+void velocity_verlet_respa_step_2(const ParticleRange &particles,
+                                  bool last_step) {
+  kick(particles, 0.5 * time_step);
+  add_inner_forces(particles, 0.5 * time_step / params.n_inner,
+                   last_step ? 1. : params.n_inner);
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef INTEGRATORS_VELOCITY_VERLET_RESPA_HPP
+#define INTEGRATORS_VELOCITY_VERLET_RESPA_HPP
+
+/** \file
+ *  Reversible multiple time step velocity Verlet integrator (RESPA).
+ *
+ *  The force contributions are split into an inner and an outer level,
+ *  see the FORCE_GROUP_* flags in forces.hpp. One time step \f$\Delta t\f$
+ *  of the integrator is
+ *  \f[ v \leftarrow v + \frac{\Delta t}{2} F_\text{outer}/m, \f]
+ *  followed by @ref VelocityVerletRespaParameters::n_inner "n_inner"
+ *  velocity Verlet steps of \f$\delta t = \Delta t / n_\text{inner}\f$
+ *  with the inner forces, followed by
+ *  \f[ v \leftarrow v + \frac{\Delta t}{2} F_\text{outer}/m. \f]
+ *  Thermostats, external forces, constraints and the lattice-Boltzmann
+ *  coupling are on the outer level, so they see the time step
+ *  \f$\Delta t\f$ as with the plain velocity Verlet integrator.
+ *
+ *  Between two time steps, the particle forces hold
+ *  \f$F_\text{inner} + n_\text{inner} F_\text{outer}\f$, which gives the
+ *  first kicks of the next step in one half step \f$\delta t / 2\f$.
+ *  After the last step of an integration, they hold the total force.
+ *  The two levels of the last force calculation are kept, so the next
+ *  integration can continue from them like the plain velocity Verlet
+ *  integrator continues from the total force. They are dropped when the
+ *  parameters change or another integrator runs.
+ *
+ *  Implementation in velocity_verlet_respa.cpp.
+ */
+
+#include "ParticleRange.hpp"
+
+#include <boost/serialization/access.hpp>
+
+/** Parameters of the RESPA integrator */
+struct VelocityVerletRespaParameters {
+  /** Number of inner steps per time step */
+  int n_inner = 1;
+  /** Bitmask of the FORCE_GROUP_* flags on the inner level */
+  unsigned inner_force_groups = 0u;
+
+private:
+  friend boost::serialization::access;
+  template <class Archive> void serialize(Archive &ar, long int /* version */) {
+    ar &n_inner;
+    ar &inner_force_groups;
+  }
+};
+
+/** RESPA initializer
+ *
+ *  Sets the parameters in @ref VelocityVerletRespaParameters
+ */
+void velocity_verlet_respa_init(int n_inner, unsigned inner_force_groups);
+
+/** Broadcast the RESPA parameters */
+void mpi_bcast_velocity_verlet_respa();
+
+/** Force groups on the outer level */
+unsigned velocity_verlet_respa_outer_force_groups();
+
+/** Check the compatibility of the RESPA integrator with the active
+ *  thermostats and particle properties. */
+void velocity_verlet_respa_sanity_checks();
+
+/** @brief Prepare the forces for the first time step.
+ *
+ *  On entry, the particle forces are the outer forces.
+ *
+ *  @param particles  The local particles.
+ *  @param total      Leave the total force instead of the kick force
+ *                    of the next step.
+ */
+void velocity_verlet_respa_init_forces(const ParticleRange &particles,
+                                       bool total);
+
+/** @brief Whether the forces of the last RESPA force calculation are
+ *  known for the local particles on all nodes.
+ *
+ *  @param particles  The local particles.
+ */
+bool velocity_verlet_respa_forces_valid(const ParticleRange &particles);
+
+/** Drop the forces of the last RESPA force calculation, e.g. because
+ *  another integrator has changed the particle forces. */
+void velocity_verlet_respa_invalidate_forces();
+
+/** @brief Set the particle forces from the last RESPA force calculation.
+ *
+ *  Does nothing if the forces of the local particles are not known.
+ *
+ *  @param particles  The local particles.
+ *  @param total      Set the total force instead of the kick force of
+ *                    the next step.
+ */
+void velocity_verlet_respa_set_forces(const ParticleRange &particles,
+                                      bool total);
+
+/** @brief First part of a RESPA time step.
+ *
+ *  Performs the first outer kick and all inner steps, except for the
+ *  last inner force calculation and the last inner kick. Calculates the
+ *  inner forces in between, so the particles may be resorted.
+ *
+ *  @param[in,out] particles  The local particles.
+ */
+void velocity_verlet_respa_step_1(ParticleRange &particles);
+
+/** @brief Final part of a RESPA time step.
+ *
+ *  On entry, the particle forces are the outer forces at the new
+ *  positions. Performs the last outer kick, calculates the inner forces
+ *  and performs the last inner kick.
+ *
+ *  @param particles  The local particles.
+ *  @param last_step  Leave the total force instead of the kick force
+ *                    of the next step.
+ */
+void velocity_verlet_respa_step_2(const ParticleRange &particles,
+                                  bool last_step);
+
+#endif
@@ -0,0 +1,488 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "checkpoint.hpp"
+
+#include "config.hpp"
+
+#include "Particle.hpp"
+#include "accumulators/AccumulatorBase.hpp"
+#include "cells.hpp"
+#include "communication.hpp"
+#include "event.hpp"
+#include "grid_based_algorithms/lb.hpp"
+#include "grid_based_algorithms/lb_interface.hpp"
+#include "grid_based_algorithms/lb_particle_coupling.hpp"
+#include "integrate.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "particle_data.hpp"
+#include "thermostat.hpp"
+
+#include <utils/Counter.hpp>
+#include <utils/Vector.hpp>
+#include <utils/index.hpp>
+
+#include <boost/archive/archive_exception.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/collectives/broadcast.hpp>
+#include <boost/mpi/collectives/gather.hpp>
+#include <boost/mpi/operations.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Mpiio {
+namespace {
+constexpr unsigned checkpoint_version = 1;
+
+/** Maximal number of bytes per MPI-IO call, to stay within the range
+ *  of the @c int counts of MPI.
+ */
+constexpr std::size_t max_io_bytes = std::size_t{1} << 30;
+
+struct CheckpointHeader {
+  unsigned version = checkpoint_version;
+  double time = 0.;
+  std::map<std::string, std::uint64_t> rng_counters;
+  bool has_lb = false;
+  Utils::Vector3i lb_grid = {};
+  /** Number of bytes of every particle chunk. */
+  std::vector<std::uint64_t> chunk_sizes;
+  std::vector<std::string> accumulators;
+
+  template <class Archive> void serialize(Archive &ar, long int) {
+    ar &version;
+    ar &time;
+    ar &rng_counters;
+    ar &has_lb;
+    ar &lb_grid;
+    ar &chunk_sizes;
+    ar &accumulators;
+  }
+};
+
+/** Throw on all ranks if the operation failed on any rank. */
+void check_all(bool failed, std::string const &what) {
+  if (boost::mpi::all_reduce(comm_cart, failed, std::logical_or<bool>()))
+    throw std::runtime_error("MPI-IO Error: " + what);
+}
+
+MPI_File open_file(std::string const &fn, int amode) {
+  MPI_File f;
+  auto const ret = MPI_File_open(comm_cart, const_cast<char *>(fn.c_str()),
+                                 amode, MPI_INFO_NULL, &f);
+  check_all(ret != MPI_SUCCESS, "Could not open file \"" + fn + "\".");
+  return f;
+}
+
+/** Collectively write @p data at byte @p offset of @p fn, which is
+ *  created or truncated.
+ */
+void write_bytes(std::string const &fn, MPI_Offset offset,
+                 std::vector<char> const &data) {
+  auto f = open_file(fn, MPI_MODE_WRONLY | MPI_MODE_CREATE);
+  auto failed = MPI_File_set_size(f, 0) != MPI_SUCCESS;
+
+  auto const n_pieces = boost::mpi::all_reduce(
+      comm_cart, (data.size() + max_io_bytes - 1) / max_io_bytes,
+      boost::mpi::maximum<std::size_t>());
+  for (std::size_t i = 0; i < n_pieces; ++i) {
+    auto const begin = std::min(i * max_io_bytes, data.size());
+    auto const count = std::min(max_io_bytes, data.size() - begin);
+    failed |= MPI_File_write_at_all(
+                  f, offset + static_cast<MPI_Offset>(begin),
+                  const_cast<char *>(data.data() + begin),
+                  static_cast<int>(count), MPI_BYTE,
+                  MPI_STATUS_IGNORE) != MPI_SUCCESS;
+  }
+  MPI_File_close(&f);
+  check_all(failed, "Could not write file \"" + fn + "\".");
+}
+
+/** Collectively read @p data.size() bytes at byte @p offset of @p fn. */
+void read_bytes(std::string const &fn, MPI_Offset offset,
+                std::vector<char> &data) {
+  auto f = open_file(fn, MPI_MODE_RDONLY);
+  auto failed = false;
+
+  auto const n_pieces = boost::mpi::all_reduce(
+      comm_cart, (data.size() + max_io_bytes - 1) / max_io_bytes,
+      boost::mpi::maximum<std::size_t>());
+  for (std::size_t i = 0; i < n_pieces; ++i) {
+    auto const begin = std::min(i * max_io_bytes, data.size());
+    auto const count = std::min(max_io_bytes, data.size() - begin);
+    failed |= MPI_File_read_at_all(f, offset + static_cast<MPI_Offset>(begin),
+                                   data.data() + begin,
+                                   static_cast<int>(count), MPI_BYTE,
+                                   MPI_STATUS_IGNORE) != MPI_SUCCESS;
+  }
+  MPI_File_close(&f);
+  check_all(failed, "Could not read file \"" + fn + "\".");
+}
+
+/** Serialize the particles in chunks of at most @ref particles_per_chunk
+ *  particles.
+ *
+ *  @param[in]  particles    Particles to serialize.
+ *  @param[out] chunk_sizes  Number of bytes of every chunk.
+ *  @return The concatenated chunks.
+ */
+std::vector<char> serialize_particles(ParticleRange const &particles,
+                                      std::vector<std::uint64_t> &chunk_sizes) {
+  namespace io = boost::iostreams;
+  std::vector<char> data;
+
+  auto it = particles.begin();
+  auto remaining = static_cast<std::size_t>(particles.size());
+  while (remaining > 0) {
+    auto const n = std::min(remaining, particles_per_chunk);
+    auto const begin = data.size();
+    {
+      io::stream_buffer<io::back_insert_device<std::vector<char>>> os{
+          io::back_inserter(data)};
+      boost::archive::binary_oarchive ar{os};
+      ar << n;
+      for (std::size_t i = 0; i < n; ++i, ++it) {
+        ar << *it;
+      }
+    }
+    chunk_sizes.push_back(data.size() - begin);
+    remaining -= n;
+  }
+
+  return data;
+}
+
+std::vector<Particle>
+deserialize_particles(std::vector<char> const &data,
+                      std::vector<std::uint64_t> const &chunk_sizes) {
+  namespace io = boost::iostreams;
+  std::vector<Particle> particles;
+
+  std::size_t begin = 0;
+  for (auto const chunk_size : chunk_sizes) {
+    io::array_source src(data.data() + begin, chunk_size);
+    io::stream<io::array_source> ss(src);
+    boost::archive::binary_iarchive ar(ss);
+
+    std::size_t n;
+    ar >> n;
+    for (std::size_t i = 0; i < n; ++i) {
+      particles.emplace_back();
+      ar >> particles.back();
+    }
+    begin += chunk_size;
+  }
+
+  return particles;
+}
+
+std::map<std::string, std::uint64_t> get_rng_counters() {
+  std::map<std::string, std::uint64_t> counters;
+  counters["langevin"] = langevin.rng_counter();
+  counters["brownian"] = brownian.rng_counter();
+  counters["npt_iso"] = npt_iso.rng_counter();
+  counters["thermalized_bond"] = thermalized_bond.rng_counter();
+#ifdef DPD
+  counters["dpd"] = dpd.rng_counter();
+#endif
+#ifdef STOKESIAN_DYNAMICS
+  counters["stokesian"] = stokesian.rng_counter();
+#endif
+  if (lattice_switch == ActiveLB::CPU) {
+    if (rng_counter_fluid)
+      counters["lb_fluid"] = rng_counter_fluid->value();
+    if (lb_particle_coupling.rng_counter_coupling)
+      counters["lb_coupling"] =
+          lb_particle_coupling.rng_counter_coupling->value();
+  }
+  return counters;
+}
+
+void set_rng_counters(std::map<std::string, std::uint64_t> const &counters) {
+  auto const set = [&counters](std::string const &name,
+                               BaseThermostat &thermostat) {
+    auto const it = counters.find(name);
+    if (it != counters.end())
+      thermostat.set_rng_counter(it->second);
+  };
+  set("langevin", langevin);
+  set("brownian", brownian);
+  set("npt_iso", npt_iso);
+  set("thermalized_bond", thermalized_bond);
+#ifdef DPD
+  set("dpd", dpd);
+#endif
+#ifdef STOKESIAN_DYNAMICS
+  set("stokesian", stokesian);
+#endif
+  if (lattice_switch == ActiveLB::CPU) {
+    auto it = counters.find("lb_fluid");
+    if (it != counters.end())
+      rng_counter_fluid = Utils::Counter<uint64_t>(it->second);
+    it = counters.find("lb_coupling");
+    if (it != counters.end())
+      lb_particle_coupling.rng_counter_coupling =
+          Utils::Counter<uint64_t>(it->second);
+  }
+}
+
+/** Set the file view to the block of the global population array owned
+ *  by this rank.
+ *
+ *  @return The number of local populations.
+ */
+int set_lb_view(MPI_File f) {
+  auto const &lattice = lblattice;
+  int const n_vel = D3Q19::n_vel;
+  int sizes[4] = {lattice.global_grid[0], lattice.global_grid[1],
+                  lattice.global_grid[2], n_vel};
+  int subsizes[4] = {lattice.grid[0], lattice.grid[1], lattice.grid[2],
+                     n_vel};
+  int starts[4] = {lattice.local_index_offset[0],
+                   lattice.local_index_offset[1],
+                   lattice.local_index_offset[2], 0};
+
+  MPI_Datatype block;
+  MPI_Type_create_subarray(4, sizes, subsizes, starts, MPI_ORDER_C,
+                           MPI_DOUBLE, &block);
+  MPI_Type_commit(&block);
+  MPI_File_set_view(f, 0, MPI_DOUBLE, block, const_cast<char *>("native"),
+                    MPI_INFO_NULL);
+  MPI_Type_free(&block);
+
+  return subsizes[0] * subsizes[1] * subsizes[2] * n_vel;
+}
+
+/** Call @p f with the local linear index and the position in the
+ *  packed local block of every interior node of the LB lattice.
+ */
+template <class F> void for_each_lb_node(F &&f) {
+  auto const &lattice = lblattice;
+  auto const h = static_cast<int>(lattice.halo_size);
+  int n = 0;
+  for (int i = 0; i < lattice.grid[0]; ++i)
+    for (int j = 0; j < lattice.grid[1]; ++j)
+      for (int k = 0; k < lattice.grid[2]; ++k) {
+        f(Utils::get_linear_index(i + h, j + h, k + h, lattice.halo_grid),
+          D3Q19::n_vel * n++);
+      }
+}
+
+void write_lb(std::string const &fn) {
+  auto f = open_file(fn, MPI_MODE_WRONLY | MPI_MODE_CREATE);
+  auto failed = MPI_File_set_size(f, 0) != MPI_SUCCESS;
+
+  std::vector<double> pop(set_lb_view(f));
+  for_each_lb_node([&pop](Lattice::index_t index, int pos) {
+    auto const p = lb_get_population(index);
+    std::copy(p.begin(), p.end(), pop.begin() + pos);
+  });
+
+  failed |= MPI_File_write_all(f, pop.data(), static_cast<int>(pop.size()),
+                               MPI_DOUBLE, MPI_STATUS_IGNORE) != MPI_SUCCESS;
+  MPI_File_close(&f);
+  check_all(failed, "Could not write file \"" + fn + "\".");
+}
+
+void read_lb(std::string const &fn) {
+  auto f = open_file(fn, MPI_MODE_RDONLY);
+
+  std::vector<double> pop(set_lb_view(f));
+  auto const failed =
+      MPI_File_read_all(f, pop.data(), static_cast<int>(pop.size()),
+                        MPI_DOUBLE, MPI_STATUS_IGNORE) != MPI_SUCCESS;
+  MPI_File_close(&f);
+  check_all(failed, "Could not read file \"" + fn + "\".");
+
+  for_each_lb_node([&pop](Lattice::index_t index, int pos) {
+    Utils::Vector19d p;
+    std::copy_n(pop.begin() + pos, D3Q19::n_vel, p.begin());
+    lb_set_population(index, p);
+  });
+}
+
+CheckpointHeader read_header(std::string const &fn) {
+  CheckpointHeader header;
+  std::string error;
+  if (this_node == 0) {
+    std::ifstream ifs(fn, std::ios::binary);
+    if (not ifs) {
+      error = "Could not open file \"" + fn + "\".";
+    } else {
+      try {
+        boost::archive::binary_iarchive ar(ifs);
+        ar >> header;
+      } catch (boost::archive::archive_exception const &) {
+        error = "Could not read file \"" + fn + "\".";
+      }
+    }
+  }
+  boost::mpi::broadcast(comm_cart, error, 0);
+  if (not error.empty())
+    throw std::runtime_error("MPI-IO Error: " + error);
+
+  boost::mpi::broadcast(comm_cart, header, 0);
+  return header;
+}
+} // namespace
+
+void mpi_mpiio_checkpoint_write(std::string const &prefix,
+                                AccumulatorList const &accumulators) {
+  if (lattice_switch == ActiveLB::GPU) {
+    throw std::runtime_error(
+        "MPI-IO checkpoints do not support the GPU LB fluid.");
+  }
+
+  std::vector<std::uint64_t> chunk_sizes;
+  auto const data =
+      serialize_particles(cell_structure.local_particles(), chunk_sizes);
+
+  std::vector<std::vector<std::uint64_t>> all_chunk_sizes;
+  boost::mpi::gather(comm_cart, chunk_sizes, all_chunk_sizes, 0);
+
+  auto failed = false;
+  if (this_node == 0) {
+    CheckpointHeader header;
+    header.time = sim_time;
+    header.rng_counters = get_rng_counters();
+    header.has_lb = (lattice_switch == ActiveLB::CPU);
+    if (header.has_lb)
+      header.lb_grid = lblattice.global_grid;
+    for (auto const &sizes : all_chunk_sizes) {
+      header.chunk_sizes.insert(header.chunk_sizes.end(), sizes.begin(),
+                                sizes.end());
+    }
+    for (auto const &acc : accumulators) {
+      header.accumulators.emplace_back(acc->get_internal_state());
+    }
+
+    std::ofstream ofs(prefix + ".chk", std::ios::binary | std::ios::trunc);
+    if (ofs) {
+      boost::archive::binary_oarchive ar(ofs);
+      ar << header;
+    }
+    failed = not ofs;
+  }
+  check_all(failed, "Could not write file \"" + prefix + ".chk\".");
+
+  std::uint64_t const local_size = data.size();
+  std::uint64_t offset = 0;
+  MPI_Exscan(&local_size, &offset, 1, MPI_UINT64_T, MPI_SUM, comm_cart);
+  if (this_node == 0)
+    offset = 0;
+  write_bytes(prefix + ".chk.part", static_cast<MPI_Offset>(offset), data);
+
+  if (lattice_switch == ActiveLB::CPU) {
+    write_lb(prefix + ".chk.lb");
+  }
+}
+
+void mpi_mpiio_checkpoint_read(std::string const &prefix,
+                               AccumulatorList const &accumulators) {
+  auto const header = read_header(prefix + ".chk");
+
+  if (header.version != checkpoint_version) {
+    throw std::runtime_error("MPI-IO Error: Unsupported checkpoint version " +
+                             std::to_string(header.version) + ".");
+  }
+  if (header.accumulators.size() != accumulators.size()) {
+    throw std::runtime_error(
+        "MPI-IO Error: The checkpoint contains " +
+        std::to_string(header.accumulators.size()) + " accumulators, got " +
+        std::to_string(accumulators.size()) + ".");
+  }
+  if (header.has_lb and (lattice_switch != ActiveLB::CPU or
+                         lblattice.global_grid != header.lb_grid)) {
+    throw std::runtime_error("MPI-IO Error: The checkpoint contains a CPU LB "
+                             "fluid with a different grid.");
+  }
+
+  /* Contiguous block of chunks for this rank */
+  auto const n_chunks = header.chunk_sizes.size();
+  auto const n_nodes = static_cast<std::size_t>(comm_cart.size());
+  auto const rank = static_cast<std::size_t>(comm_cart.rank());
+  auto const first = header.chunk_sizes.begin() + (n_chunks * rank) / n_nodes;
+  auto const last =
+      header.chunk_sizes.begin() + (n_chunks * (rank + 1)) / n_nodes;
+  std::vector<std::uint64_t> const chunk_sizes(first, last);
+
+  auto const offset = std::accumulate(header.chunk_sizes.begin(), first,
+                                      std::uint64_t{0});
+  std::vector<char> data(std::accumulate(first, last, std::uint64_t{0}));
+  read_bytes(prefix + ".chk.part", static_cast<MPI_Offset>(offset), data);
+
+  std::vector<Particle> particles;
+  auto failed = false;
+  try {
+    particles = deserialize_particles(data, chunk_sizes);
+  } catch (boost::archive::archive_exception const &) {
+    failed = true;
+  }
+  check_all(failed, "Corrupt file \"" + prefix + ".chk.part\".");
+
+  if (header.has_lb) {
+    read_lb(prefix + ".chk.lb");
+  }
+
+  /* The interaction parameters have to cover the restored types */
+  auto max_type = -1;
+  for (auto const &p : particles) {
+    max_type = std::max(max_type, p.p.type);
+  }
+  max_type = boost::mpi::all_reduce(comm_cart, max_type,
+                                    boost::mpi::maximum<int>());
+  if (max_type >= 0) {
+    make_particle_type_exist_local(max_type);
+  }
+
+  cell_structure.remove_all_particles();
+  for (auto &p : particles) {
+    cell_structure.add_particle(std::move(p));
+  }
+  clear_particle_node();
+  on_particle_change();
+
+  sim_time = header.time;
+  set_rng_counters(header.rng_counters);
+  for (std::size_t i = 0; i < accumulators.size(); ++i) {
+    accumulators[i]->set_internal_state(header.accumulators[i]);
+  }
+}
+
+} // namespace Mpiio
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *  Parallel binary checkpoints of the simulation state using MPI-IO.
+ *
+ *  A checkpoint with prefix @c pref consists of three files:
+ *  - <tt>pref.chk</tt>: header written by the head node, holding the
+ *    simulation time, the RNG counters of the thermostats and of the
+ *    LB fluid, the LB grid, the states of the accumulators and the
+ *    sizes of the particle chunks.
+ *  - <tt>pref.chk.part</tt>: the particles with all their properties,
+ *    including bonds and exclusions, in chunks of at most
+ *    @ref particles_per_chunk particles. Every chunk is an independent
+ *    boost binary archive, the chunks are written collectively by all
+ *    ranks, every rank at the offset given by the exclusive prefix sum
+ *    of the data sizes.
+ *  - <tt>pref.chk.lb</tt> (only with a CPU LB fluid): the 19 populations
+ *    of every node of the global lattice, with the z index running
+ *    fastest. Every rank writes its own block of the lattice.
+ *
+ *  On reading, the chunks are distributed in contiguous blocks over the
+ *  ranks, so the number of ranks can differ from the one at the time of
+ *  writing. The particles are sorted to their cells by the next
+ *  particle exchange. Interactions, box geometry and the parameters of
+ *  the algorithms are not part of the checkpoint and have to be set up
+ *  before reading, e.g. by the Python checkpointing of the
+ *  corresponding objects.
+ */
+
+#ifndef ESPRESSO_IO_MPIIO_CHECKPOINT_HPP
+#define ESPRESSO_IO_MPIIO_CHECKPOINT_HPP
+
+#include "accumulators/AccumulatorBase.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Mpiio {
+
+/** Maximal number of particles per chunk of the particle file, which
+ *  is the granularity of the redistribution on reading.
+ */
+constexpr std::size_t particles_per_chunk = 4096;
+
+using AccumulatorList =
+    std::vector<std::shared_ptr<Accumulators::AccumulatorBase>>;
+
+/** Write a checkpoint of the simulation state. To be called by all MPI
+ *  processes. Existing files are overwritten.
+ *
+ *  @param prefix        File name prefix.
+ *  @param accumulators  Accumulators whose state is stored. The state of
+ *                       the head node instances is used.
+ *
+ *  @throws std::runtime_error if a file cannot be written, or if a GPU
+ *          LB fluid is active.
+ */
+void mpi_mpiio_checkpoint_write(std::string const &prefix,
+                                AccumulatorList const &accumulators);
+
+/** Restore a checkpoint written by @ref mpi_mpiio_checkpoint_write. To be
+ *  called by all MPI processes. All existing particles are removed.
+ *
+ *  @param prefix        File name prefix.
+ *  @param accumulators  Accumulators to restore, in the same order as on
+ *                       writing.
+ *
+ *  @throws std::runtime_error if a file cannot be read or does not match
+ *          the current system, e.g. in the LB grid or the number of
+ *          accumulators.
+ */
+void mpi_mpiio_checkpoint_read(std::string const &prefix,
+                               AccumulatorList const &accumulators);
+
+} // namespace Mpiio
+
+#endif
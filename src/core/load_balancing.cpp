@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *  Implementation of load_balancing.hpp.
+ */
+#include "load_balancing.hpp"
+
+#include "cells.hpp"
+#include "communication.hpp"
+#include "config.hpp"
+#include "electrostatics_magnetostatics/coulomb.hpp"
+#include "electrostatics_magnetostatics/dipole.hpp"
+#include "event.hpp"
+#include "grid.hpp"
+#include "grid_based_algorithms/lb_interface.hpp"
+#include "integrate.hpp"
+
+#include <utils/mpi/cart_comm.hpp>
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/range/algorithm/max_element.hpp>
+#include <boost/range/numeric.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace {
+/** Load imbalance of the slabs of a direction that is tolerated. */
+constexpr double load_tolerance = 0.05;
+/** Fraction of the shift towards equal load that is applied per rebalance,
+ *  to damp the response to noisy time measurements. */
+constexpr double shift_damping = 0.5;
+/** Relative margin of the slab width over the interaction range, so that
+ *  rounding errors do not make a shifted slab too thin. */
+constexpr double width_margin = 1e-6;
+
+int rebalance_interval = 0;
+int steps_since_rebalance = 0;
+double force_time = 0.;
+LoadBalancing::Planes slab_planes;
+
+std::vector<double> regular_slab_planes(double box_l, int n_slabs) {
+  std::vector<double> ret(n_slabs + 1);
+  for (int k = 0; k < n_slabs; k++) {
+    ret[k] = k * (box_l / n_slabs);
+  }
+  ret.back() = box_l;
+
+  return ret;
+}
+
+/** Whether the methods in use distribute their work independently of the
+ *  cell system, see @ref load_balancing.hpp.
+ */
+bool supported() {
+#ifdef ELECTROSTATICS
+  switch (coulomb.method) {
+  case COULOMB_P3M:
+  case COULOMB_P3M_GPU:
+  case COULOMB_ELC_P3M:
+  case COULOMB_SCAFACOS:
+    return false;
+  default:
+    break;
+  }
+#endif
+#ifdef DIPOLES
+  switch (dipole.method) {
+  case DIPOLAR_P3M:
+  case DIPOLAR_MDLC_P3M:
+  case DIPOLAR_SCAFACOS:
+    return false;
+  default:
+    break;
+  }
+#endif
+  return lattice_switch != ActiveLB::CPU;
+}
+
+/** Adapt the slab boundaries to the box and the node grid.
+ *  @return Whether load balancing is active.
+ */
+bool update_planes(double range) {
+  if (rebalance_interval == 0 or not supported()) {
+    slab_planes = {};
+    return false;
+  }
+
+  for (int i = 0; i < 3; i++) {
+    auto &p = slab_planes[i];
+    auto const box_l = box_geo.length()[i];
+
+    if (p.size() != static_cast<std::size_t>(node_grid[i] + 1)) {
+      p = regular_slab_planes(box_l, node_grid[i]);
+      continue;
+    }
+
+    /* follow changes of the box length, e.g. by the barostat */
+    if (p.back() != box_l) {
+      auto const scale = box_l / p.back();
+      for (auto &x : p) {
+        x *= scale;
+      }
+      p.back() = box_l;
+    }
+
+    for (std::size_t k = 1; k < p.size(); k++) {
+      if (p[k] - p[k - 1] < range) {
+        p = regular_slab_planes(box_l, node_grid[i]);
+        break;
+      }
+    }
+  }
+
+  return true;
+}
+
+/** Return to the regular domain decomposition if the slabs were shifted.
+ *  Has to be called on all nodes.
+ *  @return Whether the cell system was re-initialized.
+ */
+bool restore_regular_planes() {
+  auto const shifted = slab_planes != LoadBalancing::Planes{} and
+                       slab_planes != LoadBalancing::regular_planes(
+                                          box_geo, node_grid);
+  slab_planes = {};
+  if (shifted and
+      cell_structure.decomposition_type() == CELL_STRUCTURE_DOMDEC) {
+    cells_re_init(CELL_STRUCTURE_DOMDEC);
+    return true;
+  }
+
+  return false;
+}
+
+void rebalance() {
+  std::vector<double> times;
+  boost::mpi::all_gather(comm_cart, force_time, times);
+  force_time = 0.;
+  steps_since_rebalance = 0;
+
+  if (not supported()) {
+    if (restore_regular_planes()) {
+      /* move the particles to their regular nodes */
+      cells_update_ghosts(global_ghost_flags());
+    }
+    return;
+  }
+
+  auto const range = interaction_range();
+  if (range <= 0. or not update_planes(range))
+    return;
+
+  auto new_planes = slab_planes;
+  bool shifted = false;
+  for (int i = 0; i < 3; i++) {
+    if (node_grid[i] == 1)
+      continue;
+
+    std::vector<double> load(node_grid[i], 0.);
+    for (int rank = 0; rank < comm_cart.size(); rank++) {
+      load[Utils::Mpi::cart_coords<3>(comm_cart, rank)[i]] += times[rank];
+    }
+
+    auto const mean_load = boost::accumulate(load, 0.) / node_grid[i];
+    if (*boost::max_element(load) <= (1. + load_tolerance) * mean_load)
+      continue;
+
+    new_planes[i] = LoadBalancing::shift_planes(
+        slab_planes[i], load, (1. + width_margin) * range, shift_damping);
+    shifted = true;
+  }
+
+  if (shifted) {
+    slab_planes = new_planes;
+    cells_re_init(CELL_STRUCTURE_DOMDEC);
+    /* move the particles to their new nodes and restore the ghosts */
+    cells_update_ghosts(global_ghost_flags());
+  }
+}
+} // namespace
+
+namespace LoadBalancing {
+Planes regular_planes(BoxGeometry const &box,
+                      Utils::Vector3i const &node_grid) {
+  Planes ret;
+  for (int i = 0; i < 3; i++) {
+    ret[i] = regular_slab_planes(box.length()[i], node_grid[i]);
+  }
+
+  return ret;
+}
+
+LocalBox<double> planes_decomposition(Planes const &planes,
+                                      Utils::Vector3i const &node_pos) {
+  Utils::Vector3d local_length;
+  Utils::Vector3d my_left;
+  Utils::Array<int, 6> boundaries;
+
+  for (int i = 0; i < 3; i++) {
+    auto const n_slabs = static_cast<int>(planes[i].size()) - 1;
+    my_left[i] = planes[i][node_pos[i]];
+    local_length[i] = planes[i][node_pos[i] + 1] - my_left[i];
+    boundaries[2 * i] = (node_pos[i] == 0);
+    boundaries[2 * i + 1] = -(node_pos[i] == n_slabs - 1);
+  }
+
+  return {my_left, local_length, boundaries};
+}
+
+std::vector<double> shift_planes(std::vector<double> const &planes,
+                                 std::vector<double> const &load,
+                                 double min_width, double damping) {
+  auto const n_slabs = load.size();
+  auto const total_load = boost::accumulate(load, 0.);
+  auto ret = planes;
+
+  if (total_load <= 0.)
+    return ret;
+
+  /* Invert the piecewise linear cumulative load */
+  std::size_t slab = 0;
+  double load_before = 0.;
+  for (std::size_t k = 1; k < n_slabs; k++) {
+    auto const target = static_cast<double>(k) * total_load / n_slabs;
+    while (slab < n_slabs - 1 and load_before + load[slab] < target) {
+      load_before += load[slab];
+      slab++;
+    }
+
+    auto const fraction =
+        (load[slab] > 0.)
+            ? std::min(1., std::max(0., (target - load_before) / load[slab]))
+            : 0.;
+    auto const balanced =
+        planes[slab] + fraction * (planes[slab + 1] - planes[slab]);
+    ret[k] = planes[k] + damping * (balanced - planes[k]);
+  }
+
+  /* Keep the minimal width */
+  for (std::size_t k = 1; k < n_slabs; k++) {
+    ret[k] = std::max(ret[k], ret[k - 1] + min_width);
+  }
+  for (std::size_t k = n_slabs - 1; k > 0; k--) {
+    ret[k] = std::min(ret[k], ret[k + 1] - min_width);
+  }
+
+  return ret;
+}
+
+boost::optional<LocalBox<double>> local_box(double range) {
+  if (not update_planes(range))
+    return {};
+
+  return planes_decomposition(slab_planes, calc_node_pos(comm_cart));
+}
+
+void add_force_time(double time) { force_time += time; }
+
+void on_lattice_switch_change() {
+  if (not supported()) {
+    restore_regular_planes();
+  }
+}
+
+void on_integration_step() {
+  if (rebalance_interval == 0 or
+      cell_structure.decomposition_type() != CELL_STRUCTURE_DOMDEC)
+    return;
+
+  if (++steps_since_rebalance >= rebalance_interval)
+    rebalance();
+}
+} // namespace LoadBalancing
+
+static void mpi_set_load_balancing_interval_local(int interval) {
+  rebalance_interval = interval;
+  steps_since_rebalance = 0;
+  force_time = 0.;
+  slab_planes = {};
+}
+
+REGISTER_CALLBACK(mpi_set_load_balancing_interval_local)
+
+void mpi_set_load_balancing_interval(int interval) {
+  mpi_call_all(mpi_set_load_balancing_interval_local, interval);
+}
+
+int load_balancing_interval() { return rebalance_interval; }
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ESPRESSO_LOAD_BALANCING_HPP
+#define ESPRESSO_LOAD_BALANCING_HPP
+
+/** \file
+ *  Dynamic load balancing of the domain decomposition.
+ *
+ *  The subdomains of the nodes are the cells of a tensor product of slabs:
+ *  in each direction, the box is cut by node_grid[i] - 1 planes which are
+ *  shared by all nodes, so that every node keeps its neighbors in the
+ *  Cartesian node grid. Periodically, the time each node spends in the
+ *  short-range force calculation is measured, summed over the nodes of each
+ *  slab, and the planes are shifted towards an equal load per slab.
+ *
+ *  The global @ref local_geo stays the regular decomposition, therefore
+ *  methods that distribute their work by it (P3M, ScaFaCoS, CPU
+ *  lattice-Boltzmann) keep the regular decomposition.
+ */
+
+#include "BoxGeometry.hpp"
+#include "LocalBox.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/optional.hpp>
+
+#include <array>
+#include <vector>
+
+namespace LoadBalancing {
+/** Slab boundaries for each direction: node_grid[i] + 1 increasing
+ *  positions from 0 to the box length.
+ */
+using Planes = std::array<std::vector<double>, 3>;
+
+/** Planes of the regular decomposition, see @ref regular_decomposition. */
+Planes regular_planes(BoxGeometry const &box, Utils::Vector3i const &node_grid);
+
+/**
+ * @brief Local box of a node in the tensor product decomposition.
+ *
+ * @param planes Slab boundaries.
+ * @param node_pos Position of the node in the node grid.
+ * @return Geometry for the node
+ */
+LocalBox<double> planes_decomposition(Planes const &planes,
+                                      Utils::Vector3i const &node_pos);
+
+/**
+ * @brief Move the slab boundaries of one direction towards equal load.
+ *
+ * The load is assumed to be uniformly distributed within each slab. The
+ * new boundaries are moved by a fraction @p damping of the way to the
+ * positions which split the load in equal parts, and the slabs are kept
+ * at least @p min_width wide.
+ *
+ * @param planes Current slab boundaries.
+ * @param load Measured load of each slab.
+ * @param min_width Minimal slab width.
+ * @param damping Fraction of the shift to apply, in (0, 1].
+ * @return New slab boundaries.
+ */
+std::vector<double> shift_planes(std::vector<double> const &planes,
+                                 std::vector<double> const &load,
+                                 double min_width, double damping);
+
+/**
+ * @brief Local box of the load-balanced domain decomposition.
+ *
+ * The slab boundaries are rescaled to the current box length and are
+ * reset to the regular decomposition if they do not match the node grid
+ * or if a slab is thinner than @p range.
+ *
+ * @param range Interaction range of the cell system.
+ * @return The local box, or none if load balancing is not active.
+ */
+boost::optional<LocalBox<double>> local_box(double range);
+
+/** Add time spent in the short-range force calculation on this node. */
+void add_force_time(double time);
+
+/** Return to the regular domain decomposition if the new lattice switch
+ *  does not support load balancing. Has to be called on all nodes.
+ */
+void on_lattice_switch_change();
+
+/** Count an integration step and rebalance if the interval has passed.
+ *  Has to be called on all nodes synchronously.
+ */
+void on_integration_step();
+} // namespace LoadBalancing
+
+/**
+ * @brief Set the number of integration steps between two rebalancings of
+ * the domain decomposition.
+ *
+ * Resets the subdomains to the regular decomposition; the new setting is
+ * applied by the next reinitialization of the cell system.
+ *
+ * @param interval Steps between rebalancings, 0 disables load balancing.
+ */
+void mpi_set_load_balancing_interval(int interval);
+
+/** Get the number of integration steps between two rebalancings. */
+int load_balancing_interval();
+
+#endif
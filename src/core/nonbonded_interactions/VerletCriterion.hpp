@@ -73,7 +73,7 @@ public:
 #endif
 
     // Within short-range distance (including dpd and the like)
-    auto const max_cut = get_ia_param(p1.p.type, p2.p.type)->max_cut;
+    auto const max_cut = get_ia_param_hot(p1.p.type, p2.p.type).max_cut;
     return (max_cut != INACTIVE_CUTOFF) &&
            (dist2 <= Utils::sqr(max_cut + m_skin));
   }
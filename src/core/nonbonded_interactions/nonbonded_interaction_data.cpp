@@ -49,6 +49,7 @@
  *****************************************/
 int max_seen_particle_type = 0;
 std::vector<IA_parameters> ia_params;
+std::vector<IA_parameters_hot> ia_params_hot;
 
 double min_global_cut = INACTIVE_CUTOFF;
 
@@ -178,11 +179,86 @@ static double recalc_maximal_cutoff(const IA_parameters &data) {
   return max_cut_current;
 }
 
+/** Bitmask of the potentials which can contribute for some distance. */
+static unsigned recalc_active_potentials(const IA_parameters &data) {
+  unsigned active = 0u;
+  auto const set = [&active](NonBondedPotential potential, double cutoff) {
+    if (cutoff > 0.)
+      active |= potential;
+  };
+
+#ifdef LENNARD_JONES
+  set(NB_LENNARD_JONES, data.lj.cut + data.lj.offset);
+#endif
+#ifdef WCA
+  set(NB_WCA, data.wca.cut);
+#endif
+#ifdef LENNARD_JONES_GENERIC
+  set(NB_LENNARD_JONES_GENERIC, data.ljgen.cut + data.ljgen.offset);
+#endif
+#ifdef SMOOTH_STEP
+  set(NB_SMOOTH_STEP, data.smooth_step.cut);
+#endif
+#ifdef HERTZIAN
+  set(NB_HERTZIAN, data.hertzian.sig);
+#endif
+#ifdef GAUSSIAN
+  set(NB_GAUSSIAN, data.gaussian.cut);
+#endif
+#ifdef BMHTF_NACL
+  set(NB_BMHTF_NACL, data.bmhtf.cut);
+#endif
+#ifdef BUCKINGHAM
+  set(NB_BUCKINGHAM, data.buckingham.cut);
+#endif
+#ifdef MORSE
+  set(NB_MORSE, data.morse.cut);
+#endif
+#ifdef SOFT_SPHERE
+  set(NB_SOFT_SPHERE, data.soft_sphere.cut + data.soft_sphere.offset);
+#endif
+#ifdef HAT
+  set(NB_HAT, data.hat.r);
+#endif
+#ifdef LJCOS
+  set(NB_LJCOS, data.ljcos.cut + data.ljcos.offset);
+#endif
+#ifdef LJCOS2
+  set(NB_LJCOS2, data.ljcos2.cut + data.ljcos2.offset);
+#endif
+#ifdef THOLE
+  if (data.thole.scaling_coeff != 0 and data.thole.q1q2 != 0)
+    active |= NB_THOLE;
+#endif
+#ifdef TABULATED
+  set(NB_TABULATED, data.tab.cutoff());
+#endif
+#ifdef GAY_BERNE
+  set(NB_GAY_BERNE, data.gay_berne.cut);
+#endif
+
+  return active;
+}
+
 double maximal_cutoff_nonbonded() {
   auto max_cut_nonbonded = INACTIVE_CUTOFF;
 
+  ia_params_hot.resize(ia_params.size());
+  auto hot = ia_params_hot.begin();
   for (auto &data : ia_params) {
     data.max_cut = recalc_maximal_cutoff(data);
+    data.active_potentials = recalc_active_potentials(data);
+
+    hot->max_cut = data.max_cut;
+    hot->active_potentials = data.active_potentials;
+#ifdef WCA
+    hot->wca = data.wca;
+#endif
+#ifdef LENNARD_JONES
+    hot->lj = data.lj;
+#endif
+    ++hot;
+
     max_cut_nonbonded = std::max(max_cut_nonbonded, data.max_cut);
   }
 
@@ -222,6 +298,8 @@ void realloc_ia_params(int nsize) {
 
   max_seen_particle_type = nsize;
   std::swap(ia_params, new_params);
+  /* filled in by the next cutoff update */
+  ia_params_hot.assign(ia_params.size(), IA_parameters_hot{});
 }
 
 void reset_ia_params() {
@@ -39,6 +39,28 @@
  */
 constexpr double INACTIVE_CUTOFF = -1.;
 
+/** Short-range pair potentials, as bits of
+ *  \ref IA_parameters::active_potentials.
+ */
+enum NonBondedPotential : unsigned {
+  NB_LENNARD_JONES = 1u << 0,
+  NB_WCA = 1u << 1,
+  NB_LENNARD_JONES_GENERIC = 1u << 2,
+  NB_SMOOTH_STEP = 1u << 3,
+  NB_HERTZIAN = 1u << 4,
+  NB_GAUSSIAN = 1u << 5,
+  NB_BMHTF_NACL = 1u << 6,
+  NB_BUCKINGHAM = 1u << 7,
+  NB_MORSE = 1u << 8,
+  NB_SOFT_SPHERE = 1u << 9,
+  NB_HAT = 1u << 10,
+  NB_LJCOS = 1u << 11,
+  NB_LJCOS2 = 1u << 12,
+  NB_THOLE = 1u << 13,
+  NB_TABULATED = 1u << 14,
+  NB_GAY_BERNE = 1u << 15
+};
+
 /** Lennard-Jones with shift */
 struct LJ_Parameters {
   double eps = 0.0;
@@ -202,6 +224,13 @@ struct IA_parameters {
    */
   double max_cut = INACTIVE_CUTOFF;
 
+  /** The short-range potentials with a non-empty range for this pair
+   *  of particle types, as a bitmask of \ref NonBondedPotential.
+   *  Only these are evaluated in the force calculation.
+   *  Updated together with @ref max_cut.
+   */
+  unsigned active_potentials = 0u;
+
 #ifdef LENNARD_JONES
   LJ_Parameters lj;
 #endif
@@ -277,6 +306,33 @@ struct IA_parameters {
 
 extern std::vector<IA_parameters> ia_params;
 
+/** @brief Compact part of the interaction parameters of a pair of
+ *  particle types.
+ *
+ *  This contains what is needed for most pairs in the inner loops
+ *  (cutoff, active potentials and the parameters of the most common
+ *  potentials), so that the table stays in the cache. The full
+ *  @ref IA_parameters are only accessed for the other potentials.
+ *  Access via <tt>get_ia_param_hot(i, j)</tt>.
+ */
+struct IA_parameters_hot {
+  /** @copydoc IA_parameters::max_cut */
+  double max_cut = INACTIVE_CUTOFF;
+  /** @copydoc IA_parameters::active_potentials */
+  unsigned active_potentials = 0u;
+
+#ifdef WCA
+  WCA_Parameters wca;
+#endif
+
+#ifdef LENNARD_JONES
+  LJ_Parameters lj;
+#endif
+};
+
+/** Compact copy of @ref ia_params, updated with the cutoffs. */
+extern std::vector<IA_parameters_hot> ia_params_hot;
+
 /** Maximal particle type seen so far. */
 extern int max_seen_particle_type;
 
@@ -313,6 +369,17 @@ inline IA_parameters *get_ia_param(int i, int j) {
                                             max_seen_particle_type)];
 }
 
+/** @brief Get the compact interaction parameters between particle types
+ *  i and j, cf. @ref IA_parameters_hot.
+ */
+inline IA_parameters_hot const &get_ia_param_hot(int i, int j) {
+  assert(i >= 0 && i < max_seen_particle_type);
+  assert(j >= 0 && j < max_seen_particle_type);
+
+  return ia_params_hot[Utils::upper_triangular(
+      std::min(i, j), std::max(i, j), max_seen_particle_type)];
+}
+
 /** Get interaction parameters between particle types i and j.
  *  Slower than @ref get_ia_param, but can also be used on not
  *  yet present particle types
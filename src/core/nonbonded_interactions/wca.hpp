@@ -38,15 +38,20 @@
 int wca_set_params(int part_type_a, int part_type_b, double eps, double sig);
 
 /** Calculate WCA force factor */
-inline double wca_pair_force_factor(IA_parameters const &ia_params,
-                                    double dist) {
-  if (dist < ia_params.wca.cut) {
-    auto const frac6 = Utils::int_pow<6>(ia_params.wca.sig / dist);
-    return 48.0 * ia_params.wca.eps * frac6 * (frac6 - 0.5) / (dist * dist);
+inline double wca_pair_force_factor(WCA_Parameters const &wca, double dist) {
+  if (dist < wca.cut) {
+    auto const frac6 = Utils::int_pow<6>(wca.sig / dist);
+    return 48.0 * wca.eps * frac6 * (frac6 - 0.5) / (dist * dist);
   }
   return 0.0;
 }
 
+/** Calculate WCA force factor */
+inline double wca_pair_force_factor(IA_parameters const &ia_params,
+                                    double dist) {
+  return wca_pair_force_factor(ia_params.wca, dist);
+}
+
 /** Calculate WCA force */
 inline Utils::Vector3d wca_pair_force(IA_parameters const &ia_params,
                                       Utils::Vector3d const &d, double dist) {
@@ -68,6 +68,7 @@ public:
     return res;
   }
   std::vector<size_t> shape() const override { return {ids().size() - 2}; }
+  unsigned particle_fields() const override { return FIELD_POSITION; }
 };
 
 } // Namespace Observables
@@ -22,6 +22,7 @@
 #include "CylindricalPidProfileObservable.hpp"
 
 #include "BoxGeometry.hpp"
+#include "distributed_profile.hpp"
 #include "grid.hpp"
 
 #include <utils/Histogram.hpp>
@@ -34,19 +35,36 @@ namespace Observables {
 class CylindricalDensityProfile : public CylindricalPidProfileObservable {
 public:
   using CylindricalPidProfileObservable::CylindricalPidProfileObservable;
-  std::vector<double>
-  evaluate(Utils::Span<std::reference_wrapper<const Particle>> particles,
-           const ParticleObservables::traits<Particle> &traits) const override {
-    Utils::CylindricalHistogram<double, 3> histogram(n_bins, 1, limits);
+  using histogram_type = Utils::CylindricalHistogram<double, 3>;
+
+  /** Unnormalized histogram of the particle positions. */
+  histogram_type
+  histogram(ParticleReferenceRange particles,
+            const ParticleObservables::traits<Particle> &traits) const {
+    histogram_type histogram(n_bins, 1, limits);
 
     for (auto p : particles) {
       histogram.update(Utils::transform_coordinate_cartesian_to_cylinder(
           folded_position(traits.position(p), box_geo) - center, axis));
     }
+    return histogram;
+  }
 
+  static std::vector<double> normalize(histogram_type &histogram) {
     histogram.normalize();
     return histogram.get_histogram();
   }
+
+  std::vector<double>
+  evaluate(ParticleReferenceRange particles,
+           const ParticleObservables::traits<Particle> &traits) const override {
+    auto hist = histogram(particles, traits);
+    return normalize(hist);
+  }
+
+  std::vector<double> operator()() const override {
+    return evaluate_distributed_profile(*this);
+  }
 };
 
 } // Namespace Observables
@@ -21,6 +21,7 @@
 
 #include "BoxGeometry.hpp"
 #include "CylindricalPidProfileObservable.hpp"
+#include "distributed_profile.hpp"
 #include "grid.hpp"
 
 #include <utils/Histogram.hpp>
@@ -36,10 +37,13 @@ class CylindricalFluxDensityProfile : public CylindricalPidProfileObservable {
 public:
   using CylindricalPidProfileObservable::CylindricalPidProfileObservable;
 
-  std::vector<double>
-  evaluate(Utils::Span<std::reference_wrapper<const Particle>> particles,
-           const ParticleObservables::traits<Particle> &traits) const override {
-    Utils::CylindricalHistogram<double, 3> histogram(n_bins, 3, limits);
+  using histogram_type = Utils::CylindricalHistogram<double, 3>;
+
+  /** Unnormalized histogram of the particle velocities. */
+  histogram_type
+  histogram(ParticleReferenceRange particles,
+            const ParticleObservables::traits<Particle> &traits) const {
+    histogram_type histogram(n_bins, 3, limits);
 
     // Write data to the histogram
     for (auto p : particles) {
@@ -49,9 +53,25 @@ public:
           Utils::transform_vector_cartesian_to_cylinder(traits.velocity(p),
                                                         axis, pos));
     }
+    return histogram;
+  }
+
+  static std::vector<double> normalize(histogram_type &histogram) {
     histogram.normalize();
     return histogram.get_histogram();
   }
+
+  std::vector<double>
+  evaluate(ParticleReferenceRange particles,
+           const ParticleObservables::traits<Particle> &traits) const override {
+    auto hist = histogram(particles, traits);
+    return normalize(hist);
+  }
+
+  std::vector<double> operator()() const override {
+    return evaluate_distributed_profile(*this);
+  }
+
   std::vector<size_t> shape() const override {
     return {n_bins[0], n_bins[1], n_bins[2], 3};
   }
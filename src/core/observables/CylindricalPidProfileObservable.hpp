@@ -22,11 +22,21 @@
 #include "CylindricalProfileObservable.hpp"
 #include "PidObservable.hpp"
 
+#include <utils/Vector.hpp>
+#include <utils/constants.hpp>
+
+#include <vector>
+
 namespace Observables {
 
 class CylindricalPidProfileObservable : public PidObservable,
                                         public CylindricalProfileObservable {
 public:
+  /** Empty profile, target of the deserialization. */
+  CylindricalPidProfileObservable()
+      : CylindricalPidProfileObservable({}, {0., 0., 0.}, {0., 0., 1.}, 1, 1,
+                                        1, 0., 1., -Utils::pi(), Utils::pi(),
+                                        0., 1.) {}
   CylindricalPidProfileObservable(std::vector<int> const &ids,
                                   Utils::Vector3d const &center,
                                   Utils::Vector3d const &axis, int n_r_bins,
@@ -37,6 +47,11 @@ public:
         CylindricalProfileObservable(center, axis, n_r_bins, n_phi_bins,
                                      n_z_bins, min_r, max_r, min_phi, max_phi,
                                      min_z, max_z) {}
+
+  template <class Archive> void serialize(Archive &ar, long int version) {
+    PidObservable::serialize(ar, version);
+    CylindricalProfileObservable::serialize(ar, version);
+  }
 };
 
 } // Namespace Observables
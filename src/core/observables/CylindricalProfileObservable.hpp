@@ -45,6 +45,12 @@ public:
         center(center), axis(axis) {}
   Utils::Vector3d center;
   Utils::Vector3d axis;
+
+  template <class Archive> void serialize(Archive &ar, long int version) {
+    ProfileObservable::serialize(ar, version);
+    ar &center;
+    ar &axis;
+  }
 };
 
 } // Namespace Observables
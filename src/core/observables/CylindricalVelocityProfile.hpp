@@ -21,6 +21,7 @@
 
 #include "BoxGeometry.hpp"
 #include "CylindricalPidProfileObservable.hpp"
+#include "distributed_profile.hpp"
 #include "grid.hpp"
 
 #include <utils/Histogram.hpp>
@@ -37,10 +38,13 @@ class CylindricalVelocityProfile : public CylindricalPidProfileObservable {
 public:
   using CylindricalPidProfileObservable::CylindricalPidProfileObservable;
 
-  std::vector<double>
-  evaluate(Utils::Span<std::reference_wrapper<const Particle>> particles,
-           const ParticleObservables::traits<Particle> &traits) const override {
-    Utils::CylindricalHistogram<double, 3> histogram(n_bins, 3, limits);
+  using histogram_type = Utils::CylindricalHistogram<double, 3>;
+
+  /** Histogram of the summed up particle velocities. */
+  histogram_type
+  histogram(ParticleReferenceRange particles,
+            const ParticleObservables::traits<Particle> &traits) const {
+    histogram_type histogram(n_bins, 3, limits);
 
     for (auto p : particles) {
       auto const pos = folded_position(traits.position(p), box_geo) - center;
@@ -49,7 +53,11 @@ public:
           Utils::transform_vector_cartesian_to_cylinder(traits.velocity(p),
                                                         axis, pos));
     }
+    return histogram;
+  }
 
+  /** Average velocity in each bin. */
+  static std::vector<double> normalize(histogram_type const &histogram) {
     auto hist_tmp = histogram.get_histogram();
     auto tot_count = histogram.get_tot_count();
     for (size_t ind = 0; ind < hist_tmp.size(); ++ind) {
@@ -59,6 +67,18 @@ public:
     }
     return hist_tmp;
   }
+
+  std::vector<double>
+  evaluate(ParticleReferenceRange particles,
+           const ParticleObservables::traits<Particle> &traits) const override {
+    auto hist = histogram(particles, traits);
+    return normalize(hist);
+  }
+
+  std::vector<double> operator()() const override {
+    return evaluate_distributed_profile(*this);
+  }
+
   std::vector<size_t> shape() const override {
     return {n_bins[0], n_bins[1], n_bins[2], 3};
   }
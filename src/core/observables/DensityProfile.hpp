@@ -22,6 +22,7 @@
 #include "BoxGeometry.hpp"
 #include "Particle.hpp"
 #include "PidProfileObservable.hpp"
+#include "distributed_profile.hpp"
 #include "grid.hpp"
 
 #include <utils/Histogram.hpp>
@@ -35,17 +36,35 @@ class DensityProfile : public PidProfileObservable {
 public:
   using PidProfileObservable::PidProfileObservable;
 
-  std::vector<double>
-  evaluate(Utils::Span<std::reference_wrapper<const Particle>> particles,
-           const ParticleObservables::traits<Particle> &traits) const override {
-    Utils::Histogram<double, 3> histogram(n_bins, 1, limits);
+  using histogram_type = Utils::Histogram<double, 3>;
+
+  /** Unnormalized histogram of the particle positions. */
+  histogram_type
+  histogram(ParticleReferenceRange particles,
+            const ParticleObservables::traits<Particle> &traits) const {
+    histogram_type histogram(n_bins, 1, limits);
 
     for (auto p : particles) {
       histogram.update(folded_position(traits.position(p), box_geo));
     }
+    return histogram;
+  }
+
+  static std::vector<double> normalize(histogram_type &histogram) {
     histogram.normalize();
     return histogram.get_histogram();
   }
+
+  std::vector<double>
+  evaluate(ParticleReferenceRange particles,
+           const ParticleObservables::traits<Particle> &traits) const override {
+    auto hist = histogram(particles, traits);
+    return normalize(hist);
+  }
+
+  std::vector<double> operator()() const override {
+    return evaluate_distributed_profile(*this);
+  }
 };
 } // Namespace Observables
 
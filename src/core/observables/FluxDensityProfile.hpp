@@ -22,6 +22,7 @@
 #include "BoxGeometry.hpp"
 #include "Particle.hpp"
 #include "PidProfileObservable.hpp"
+#include "distributed_profile.hpp"
 #include "grid.hpp"
 
 #include <utils/Histogram.hpp>
@@ -38,18 +39,36 @@ public:
     return {n_bins[0], n_bins[1], n_bins[2], 3};
   }
 
-  std::vector<double>
-  evaluate(Utils::Span<std::reference_wrapper<const Particle>> particles,
-           const ParticleObservables::traits<Particle> &traits) const override {
-    Utils::Histogram<double, 3> histogram(n_bins, 3, limits);
+  using histogram_type = Utils::Histogram<double, 3>;
+
+  /** Unnormalized histogram of the particle velocities. */
+  histogram_type
+  histogram(ParticleReferenceRange particles,
+            const ParticleObservables::traits<Particle> &traits) const {
+    histogram_type histogram(n_bins, 3, limits);
 
     for (auto p : particles) {
       auto const ppos = folded_position(traits.position(p), box_geo);
       histogram.update(ppos, traits.velocity(p));
     }
+    return histogram;
+  }
+
+  static std::vector<double> normalize(histogram_type &histogram) {
     histogram.normalize();
     return histogram.get_histogram();
   }
+
+  std::vector<double>
+  evaluate(ParticleReferenceRange particles,
+           const ParticleObservables::traits<Particle> &traits) const override {
+    auto hist = histogram(particles, traits);
+    return normalize(hist);
+  }
+
+  std::vector<double> operator()() const override {
+    return evaluate_distributed_profile(*this);
+  }
 };
 
 } // Namespace Observables
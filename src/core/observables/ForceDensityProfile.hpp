@@ -22,6 +22,7 @@
 #include "BoxGeometry.hpp"
 #include "Particle.hpp"
 #include "PidProfileObservable.hpp"
+#include "distributed_profile.hpp"
 #include "grid.hpp"
 
 #include <utils/Histogram.hpp>
@@ -39,16 +40,34 @@ public:
     return {n_bins[0], n_bins[1], n_bins[2], 3};
   }
 
-  std::vector<double>
-  evaluate(ParticleReferenceRange particles,
-           const ParticleObservables::traits<Particle> &traits) const override {
-    Utils::Histogram<double, 3> histogram(n_bins, 3, limits);
+  using histogram_type = Utils::Histogram<double, 3>;
+
+  /** Unnormalized histogram of the particle forces. */
+  histogram_type
+  histogram(ParticleReferenceRange particles,
+            const ParticleObservables::traits<Particle> &traits) const {
+    histogram_type histogram(n_bins, 3, limits);
     for (auto p : particles) {
       histogram.update(folded_position(p.get().r.p, box_geo), p.get().f.f);
     }
+    return histogram;
+  }
+
+  static std::vector<double> normalize(histogram_type &histogram) {
     histogram.normalize();
     return histogram.get_histogram();
   }
+
+  std::vector<double>
+  evaluate(ParticleReferenceRange particles,
+           const ParticleObservables::traits<Particle> &traits) const override {
+    auto hist = histogram(particles, traits);
+    return normalize(hist);
+  }
+
+  std::vector<double> operator()() const override {
+    return evaluate_distributed_profile(*this);
+  }
 };
 
 } // Namespace Observables
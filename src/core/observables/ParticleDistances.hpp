@@ -52,6 +52,7 @@ public:
     return res;
   }
   std::vector<size_t> shape() const override { return {ids().size() - 1}; }
+  unsigned particle_fields() const override { return FIELD_POSITION; }
 };
 
 } // Namespace Observables
@@ -47,6 +47,7 @@ public:
     return res;
   };
   std::vector<size_t> shape() const override { return {ids().size(), 3}; }
+  unsigned particle_fields() const override { return FIELD_FORCE; }
 };
 
 } // Namespace Observables
@@ -26,7 +26,8 @@
 
 namespace Observables {
 std::vector<double> PidObservable::operator()() const {
-  std::vector<Particle> particles = fetch_particles(ids());
+  std::vector<Particle> particles =
+      fetch_particles(ids(), particle_fields());
 
   std::vector<std::reference_wrapper<const Particle>> particle_refs(
       particles.begin(), particles.end());
@@ -25,12 +25,14 @@
 #include "Observable.hpp"
 #include "Particle.hpp"
 #include "ParticleTraits.hpp"
+#include "particle_data.hpp"
 
 #include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 #include <utils/flatten.hpp>
 
 #include <boost/range/algorithm/copy.hpp>
+#include <boost/serialization/vector.hpp>
 
 #include <cstddef>
 #include <functional>
@@ -59,10 +61,19 @@ class PidObservable : virtual public Observable {
 
 public:
   explicit PidObservable(std::vector<int> ids) : m_ids(std::move(ids)) {}
-  std::vector<double> operator()() const final;
+  std::vector<double> operator()() const override;
+
+  /** Particle properties needed by @ref evaluate, cf. @ref ParticleField.
+   *  Only these are sent to the head node.
+   */
+  virtual unsigned particle_fields() const { return FIELD_KINEMATICS; }
 
   std::vector<int> &ids() { return m_ids; }
   std::vector<int> const &ids() const { return m_ids; }
+
+  template <class Archive> void serialize(Archive &ar, long int /* version */) {
+    ar &m_ids;
+  }
 };
 
 namespace detail {
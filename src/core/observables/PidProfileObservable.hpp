@@ -29,12 +29,20 @@ namespace Observables {
 // Observable which acts on a given list of particle ids
 class PidProfileObservable : public PidObservable, public ProfileObservable {
 public:
+  /** Empty profile, target of the deserialization. */
+  PidProfileObservable()
+      : PidProfileObservable({}, 1, 1, 1, 0., 1., 0., 1., 0., 1.) {}
   PidProfileObservable(std::vector<int> const &ids, int n_x_bins, int n_y_bins,
                        int n_z_bins, double min_x, double max_x, double min_y,
                        double max_y, double min_z, double max_z)
       : PidObservable(ids),
         ProfileObservable(n_x_bins, n_y_bins, n_z_bins, min_x, max_x, min_y,
                           max_y, min_z, max_z) {}
+
+  template <class Archive> void serialize(Archive &ar, long int version) {
+    PidObservable::serialize(ar, version);
+    ProfileObservable::serialize(ar, version);
+  }
 };
 
 } // Namespace Observables
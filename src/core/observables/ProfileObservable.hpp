@@ -24,6 +24,8 @@
 #include <utils/math/make_lin_space.hpp>
 
 #include <boost/range/algorithm.hpp>
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/utility.hpp>
 
 #include <array>
 #include <cstddef>
@@ -67,6 +69,11 @@ public:
         profile_edges[2].begin());
     return profile_edges;
   }
+
+  template <class Archive> void serialize(Archive &ar, long int /* version */) {
+    ar &limits;
+    ar &n_bins;
+  }
 };
 
 } // Namespace Observables
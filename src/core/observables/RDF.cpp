@@ -19,8 +19,12 @@
 #include "RDF.hpp"
 
 #include "BoxGeometry.hpp"
+#include "cells.hpp"
+#include "communication.hpp"
+#include "event.hpp"
 #include "fetch_particles.hpp"
 #include "grid.hpp"
+#include "integrate.hpp"
 
 #include <utils/Span.hpp>
 #include <utils/Vector.hpp>
@@ -28,12 +32,116 @@
 #include <utils/for_each_pair.hpp>
 #include <utils/math/int_pow.hpp>
 
+#include <boost/mpi/collectives/reduce.hpp>
 #include <boost/range/algorithm/transform.hpp>
+
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <functional>
 
+namespace {
+/** Number of occurrences of each particle id in @p ids, indexed by id. */
+std::vector<int> id_multiplicities(std::vector<int> const &ids) {
+  std::vector<int> mult;
+  for (auto const id : ids) {
+    if (id >= static_cast<int>(mult.size()))
+      mult.resize(id + 1, 0);
+    mult[id]++;
+  }
+  return mult;
+}
+
+/** Number of pairs of a particle with itself among the pairs of
+ *  @p ids1 and @p ids2. */
+double n_self_pairs(std::vector<int> const &ids1,
+                    std::vector<int> const &ids2) {
+  auto const mult1 = id_multiplicities(ids1);
+  auto const mult2 = id_multiplicities(ids2);
+  auto const n_ids = std::min(mult1.size(), mult2.size());
+  double n_pairs = 0.;
+  for (std::size_t id = 0; id < n_ids; ++id) {
+    n_pairs += mult1[id] * mult2[id];
+  }
+  return n_pairs;
+}
+} // namespace
+
+/** Unnormalized pair distance histogram of the pairs found by the
+ *  link-cell algorithm on this node. All pairs closer than the
+ *  interaction range are found exactly once on one of the nodes.
+ */
+static std::vector<double> rdf_histogram_local(std::vector<int> const &ids1,
+                                               std::vector<int> const &ids2,
+                                               double min_r, double max_r,
+                                               int n_r_bins) {
+  on_observable_calc();
+
+  auto const mult1 = id_multiplicities(ids1);
+  auto const mult2 = id_multiplicities(ids2);
+  auto const multiplicity = [](std::vector<int> const &mult, int id) {
+    return (id < static_cast<int>(mult.size())) ? mult[id] : 0;
+  };
+
+  auto const inv_bin_width = static_cast<double>(n_r_bins) / (max_r - min_r);
+  auto const max_r2 = max_r * max_r;
+  std::vector<double> hist(n_r_bins, 0.);
+
+  cell_structure.non_bonded_loop([&](Particle const &p1, Particle const &p2,
+                                     Distance const &d) {
+    if (d.dist2 >= max_r2)
+      return;
+    auto const id1 = p1.identity();
+    auto const id2 = p2.identity();
+    auto const weight =
+        (ids2.empty())
+            ? multiplicity(mult1, id1) * multiplicity(mult1, id2)
+            : multiplicity(mult1, id1) * multiplicity(mult2, id2) +
+                  multiplicity(mult1, id2) * multiplicity(mult2, id1);
+    if (weight == 0)
+      return;
+    auto const dist = std::sqrt(d.dist2);
+    if (dist > min_r) {
+      auto const ind =
+          static_cast<int>(std::floor((dist - min_r) * inv_bin_width));
+      hist[std::min(ind, n_r_bins - 1)] += weight;
+    }
+  });
+
+  return hist;
+}
+
+static void mpi_rdf_histogram_local(std::vector<int> const &ids1,
+                                    std::vector<int> const &ids2, double min_r,
+                                    double max_r, int n_r_bins) {
+  auto const hist = rdf_histogram_local(ids1, ids2, min_r, max_r, n_r_bins);
+  boost::mpi::reduce(comm_cart, hist.data(), n_r_bins, std::plus<double>(), 0);
+}
+
+REGISTER_CALLBACK(mpi_rdf_histogram_local)
+
 namespace Observables {
 std::vector<double> RDF::operator()() const {
+  /* Pairs up to the interaction range are visited by the cell system,
+   * so the histogram can be computed in parallel without fetching
+   * the particles. */
+  if (max_r <= interaction_range() or
+      cell_structure.decomposition_type() == CELL_STRUCTURE_NSQUARE) {
+    auto const n_bins = static_cast<int>(n_r_bins);
+    mpi_call(mpi_rdf_histogram_local, ids1(), ids2(), min_r, max_r, n_bins);
+    auto const local_hist =
+        rdf_histogram_local(ids1(), ids2(), min_r, max_r, n_bins);
+    std::vector<double> hist(n_r_bins);
+    boost::mpi::reduce(comm_cart, local_hist.data(), n_bins, hist.data(),
+                       std::plus<double>(), 0);
+    auto const n1 = static_cast<double>(ids1().size());
+    auto const n2 = static_cast<double>(ids2().size());
+    auto const n_pairs = (ids2().empty())
+                             ? n1 * (n1 - 1.) / 2.
+                             : n1 * n2 - n_self_pairs(ids1(), ids2());
+    return normalize(hist, n_pairs);
+  }
+
   std::vector<Particle> particles1 = fetch_particles(ids1());
   std::vector<const Particle *> particles_ptrs1(particles1.size());
   boost::transform(particles1, particles_ptrs1.begin(),
@@ -70,12 +178,20 @@ RDF::evaluate(Utils::Span<const Particle *const> particles1,
   if (particles2.empty()) {
     Utils::for_each_pair(particles1, op);
   } else {
-    auto cmp = std::not_equal_to<const Particle *const>();
+    /* the particles are copies, so they are compared by identity */
+    auto cmp = [](const Particle *const p1, const Particle *const p2) {
+      return p1->identity() != p2->identity();
+    };
     Utils::for_each_cartesian_pair_if(particles1, particles2, op, cmp);
   }
-  if (cnt == 0)
-    return res;
-  // normalization
+  return normalize(res, static_cast<double>(cnt));
+}
+
+std::vector<double> RDF::normalize(std::vector<double> hist,
+                                   double n_pairs) const {
+  if (n_pairs == 0.)
+    return hist;
+  auto const bin_width = (max_r - min_r) / static_cast<double>(n_r_bins);
   auto const volume = box_geo.volume();
   for (int i = 0; i < n_r_bins; ++i) {
     auto const r_in = i * bin_width + min_r;
@@ -83,9 +199,9 @@ RDF::evaluate(Utils::Span<const Particle *const> particles1,
     auto const bin_volume =
         (4.0 / 3.0) * Utils::pi() *
         (Utils::int_pow<3>(r_out) - Utils::int_pow<3>(r_in));
-    res[i] *= volume / (bin_volume * static_cast<double>(cnt));
+    hist[i] *= volume / (bin_volume * n_pairs);
   }
 
-  return res;
+  return hist;
 }
 } // namespace Observables
@@ -32,6 +32,11 @@
 namespace Observables {
 
 /** Radial distribution function.
+ *
+ *  If @ref max_r does not exceed the interaction range of the cell
+ *  system, the pair distance histogram is computed in parallel from
+ *  the link cells and only the histogram is reduced on the head node.
+ *  Otherwise, the particles are fetched to the head node.
  */
 class RDF : public Observable {
   /** Identifiers of the reference particles */
@@ -43,6 +48,10 @@ class RDF : public Observable {
   evaluate(Utils::Span<const Particle *const> particles1,
            Utils::Span<const Particle *const> particles2) const;
 
+  /** Normalize a pair distance histogram by the ideal gas distribution. */
+  std::vector<double> normalize(std::vector<double> hist,
+                                double n_pairs) const;
+
 public:
   // Range of the profile.
   double min_r, max_r;
@@ -29,6 +29,9 @@ class TotalForce : public PidObservable {
 public:
   using PidObservable::PidObservable;
   std::vector<size_t> shape() const override { return {3}; }
+  unsigned particle_fields() const override {
+    return FIELD_FORCE | FIELD_MASS;
+  }
 
   std::vector<double>
   evaluate(ParticleReferenceRange particles,
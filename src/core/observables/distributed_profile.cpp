@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2010-2019 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "distributed_profile.hpp"
+
+#include "CylindricalDensityProfile.hpp"
+#include "CylindricalFluxDensityProfile.hpp"
+#include "CylindricalVelocityProfile.hpp"
+#include "DensityProfile.hpp"
+#include "FluxDensityProfile.hpp"
+#include "ForceDensityProfile.hpp"
+
+#include "MpiCallbacks.hpp"
+
+namespace Communication {
+using Observables::mpi_profile_histogram_local;
+
+static RegisterCallback register_density_profile(
+    &mpi_profile_histogram_local<Observables::DensityProfile>);
+static RegisterCallback register_flux_density_profile(
+    &mpi_profile_histogram_local<Observables::FluxDensityProfile>);
+static RegisterCallback register_force_density_profile(
+    &mpi_profile_histogram_local<Observables::ForceDensityProfile>);
+static RegisterCallback register_cylindrical_density_profile(
+    &mpi_profile_histogram_local<Observables::CylindricalDensityProfile>);
+static RegisterCallback register_cylindrical_flux_density_profile(
+    &mpi_profile_histogram_local<Observables::CylindricalFluxDensityProfile>);
+static RegisterCallback register_cylindrical_velocity_profile(
+    &mpi_profile_histogram_local<Observables::CylindricalVelocityProfile>);
+} // namespace Communication
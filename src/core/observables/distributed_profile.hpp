@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OBSERVABLES_DISTRIBUTED_PROFILE_HPP
+#define OBSERVABLES_DISTRIBUTED_PROFILE_HPP
+
+/** @file
+ *  Parallel evaluation of particle profile observables.
+ *
+ *  Instead of fetching the particles to the head node, every node bins
+ *  its own particles into a partial histogram, and only the histograms
+ *  are summed up on the head node. A profile observable @c Obs
+ *  participating in this scheme has to provide
+ *   - <tt>Obs::histogram(particles, traits)</tt>, the unnormalized
+ *     histogram of a set of particles,
+ *   - <tt>Obs::normalize(histogram)</tt>, the observable value from the
+ *     total histogram,
+ *
+ *  be serializable, and the callback
+ *  <tt>mpi_profile_histogram_local<Obs></tt> has to be registered
+ *  (see distributed_profile.cpp).
+ */
+
+#include "Particle.hpp"
+#include "PidObservable.hpp"
+#include "cells.hpp"
+#include "communication.hpp"
+#include "particle_data.hpp"
+
+#include <boost/mpi/collectives/reduce.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace Observables {
+/** Particles with the given ids which are owned by this node. */
+inline std::vector<std::reference_wrapper<const Particle>>
+local_particles(std::vector<int> const &ids) {
+  std::vector<std::reference_wrapper<const Particle>> particles;
+  for (auto const id : ids) {
+    auto const p = cell_structure.get_local_particle(id);
+    if (p and not p->l.ghost) {
+      particles.emplace_back(*p);
+    }
+  }
+  return particles;
+}
+
+/** Partial histogram of the particles of @p obs on this node,
+ *  summed up on the head node.
+ *
+ *  @return The total histogram on the head node, unspecified on
+ *          the other nodes.
+ */
+template <class Obs>
+auto reduce_profile_histogram(Obs const &obs) -> decltype(obs.histogram(
+    ParticleReferenceRange{}, ParticleObservables::traits<Particle>{})) {
+  auto const traits = ParticleObservables::traits<Particle>{};
+  auto particles = local_particles(obs.ids());
+  auto const local = obs.histogram(ParticleReferenceRange(particles), traits);
+
+  auto const hist = local.get_histogram();
+  auto const tot_count = local.get_tot_count();
+
+  if (comm_cart.rank() == 0) {
+    std::vector<double> hist_sum(hist.size());
+    std::vector<std::size_t> tot_count_sum(tot_count.size());
+    boost::mpi::reduce(comm_cart, hist.data(), static_cast<int>(hist.size()),
+                       hist_sum.data(), std::plus<double>(), 0);
+    boost::mpi::reduce(comm_cart, tot_count.data(),
+                       static_cast<int>(tot_count.size()),
+                       tot_count_sum.data(), std::plus<std::size_t>(), 0);
+
+    auto total = obs.histogram(ParticleReferenceRange{}, traits);
+    total.add(hist_sum, tot_count_sum);
+    return total;
+  }
+
+  boost::mpi::reduce(comm_cart, hist.data(), static_cast<int>(hist.size()),
+                     std::plus<double>(), 0);
+  boost::mpi::reduce(comm_cart, tot_count.data(),
+                     static_cast<int>(tot_count.size()),
+                     std::plus<std::size_t>(), 0);
+  return local;
+}
+
+/** Worker part of @ref evaluate_distributed_profile. */
+template <class Obs> void mpi_profile_histogram_local(Obs const &obs) {
+  reduce_profile_histogram(obs);
+}
+
+/** Evaluate a profile observable in parallel.
+ *  Has to be called on the head node.
+ *
+ *  @throws std::runtime_error if a particle id does not exist.
+ */
+template <class Obs>
+std::vector<double> evaluate_distributed_profile(Obs const &obs) {
+  /* throws for unknown ids, like the evaluation on the head node */
+  for (auto const id : obs.ids()) {
+    get_particle_node(id);
+  }
+
+  mpi_call(mpi_profile_histogram_local<Obs>, obs);
+  auto histogram = reduce_profile_histogram(obs);
+  return Obs::normalize(histogram);
+}
+} // namespace Observables
+
+#endif
@@ -33,9 +33,20 @@
 /** Fetch a group of particles.
  *
  *  @param ids particle identifiers
+ *  @param fields properties to fetch, cf. @ref ParticleField
  *  @return array of particle copies, with positions in the current box.
  */
-inline std::vector<Particle> fetch_particles(std::vector<int> const &ids) {
+inline std::vector<Particle> fetch_particles(std::vector<int> const &ids,
+                                             unsigned fields = FIELD_ALL) {
+  if (fields != FIELD_ALL) {
+    auto particles = mpi_get_particle_fields(ids, fields);
+    for (auto &p : particles) {
+      p.r.p += image_shift(p.l.i, box_geo.length());
+      p.l.i = {};
+    }
+    return particles;
+  }
+
   std::vector<Particle> particles;
   particles.reserve(ids.size());
 
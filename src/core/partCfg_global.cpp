@@ -23,3 +23,9 @@ PartCfg &partCfg() {
 
   return m_part_cfg;
 }
+
+PartCfg &partCfgKinematics() {
+  static PartCfg m_part_cfg(FIELD_KINEMATICS);
+
+  return m_part_cfg;
+}
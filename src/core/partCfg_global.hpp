@@ -29,4 +29,13 @@
  */
 PartCfg &partCfg();
 
+/**
+ * @brief Particles' current configuration, restricted to the
+ * properties in @ref FIELD_KINEMATICS.
+ *
+ * Cheaper to update than @ref partCfg, since neither the bonds nor
+ * the other particle properties are communicated.
+ */
+PartCfg &partCfgKinematics();
+
 #endif
@@ -45,14 +45,20 @@
 #include <boost/optional.hpp>
 #include <boost/range/algorithm.hpp>
 #include <boost/range/numeric.hpp>
+#include <boost/serialization/utility.hpp>
 #include <boost/serialization/variant.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/variant.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace {
 /**
@@ -375,6 +381,71 @@ void mpi_update_particle_property(int id, const T &value) {
   mpi_update_particle<ParticleProperties, &Particle::p, T, m>(id, value);
 }
 
+using UpdateMessages = std::vector<std::pair<int, UpdateMessage>>;
+
+void mpi_send_update_messages_local() {
+  UpdateMessages msgs;
+  boost::mpi::scatter(comm_cart, msgs, 0);
+  for (auto const &msg : msgs) {
+    boost::apply_visitor(UpdateVisitor{msg.first}, msg.second);
+  }
+
+  on_particle_change();
+}
+
+REGISTER_CALLBACK(mpi_send_update_messages_local)
+
+/**
+ * @brief Send update messages for many particles at once.
+ *
+ * Bulk version of @ref mpi_send_update_message: the messages are
+ * sorted by the node responsible for the particle, and every node
+ * receives all of its messages in a single scatter.
+ *
+ * @param msgs Pairs of particle id and message.
+ */
+void mpi_send_update_messages(UpdateMessages const &msgs) {
+  std::vector<UpdateMessages> node_msgs(comm_cart.size());
+  for (auto const &msg : msgs) {
+    node_msgs.at(get_particle_node(msg.first)).push_back(msg);
+  }
+
+  mpi_call(mpi_send_update_messages_local);
+
+  UpdateMessages local_msgs;
+  boost::mpi::scatter(comm_cart, node_msgs, local_msgs, 0);
+  for (auto const &msg : local_msgs) {
+    boost::apply_visitor(UpdateVisitor{msg.first}, msg.second);
+  }
+
+  on_particle_change();
+}
+
+template <typename S, S Particle::*s, typename T, T S::*m>
+void mpi_update_particles(std::vector<int> const &ids,
+                          std::vector<T> const &values) {
+  using MessageType = message_type_t<S, s>;
+  if (ids.size() != values.size()) {
+    throw std::invalid_argument("Got " + std::to_string(values.size()) +
+                                " values for " + std::to_string(ids.size()) +
+                                " particles.");
+  }
+
+  UpdateMessages msgs;
+  msgs.reserve(ids.size());
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    MessageType msg = UpdateParticle<S, s, T, m>{values[i]};
+    msgs.emplace_back(ids[i], msg);
+  }
+  mpi_send_update_messages(msgs);
+}
+
+template <typename T, T ParticleProperties::*m>
+void mpi_update_particles_property(std::vector<int> const &ids,
+                                   std::vector<T> const &values) {
+  mpi_update_particles<ParticleProperties, &Particle::p, T, m>(ids, values);
+}
+
 /************************************************
  * variables
  ************************************************/
@@ -602,6 +673,280 @@ void prefetch_particle_data(Utils::Span<const int> in_ids) {
   }
 }
 
+namespace {
+/** Apply @p f to the members of @p p selected by @p fields. */
+template <class F> void for_each_field(Particle &p, unsigned fields, F &&f) {
+  if (fields & FIELD_POSITION) {
+    f(p.r.p);
+    f(p.l.i);
+  }
+  if (fields & FIELD_VELOCITY)
+    f(p.m.v);
+  if (fields & FIELD_FORCE)
+    f(p.f.f);
+  if (fields & FIELD_TYPE)
+    f(p.p.type);
+#ifdef MASS
+  if (fields & FIELD_MASS)
+    f(p.p.mass);
+#endif
+#ifdef VIRTUAL_SITES
+  if (fields & FIELD_MASS)
+    f(p.p.is_virtual);
+#endif
+#ifdef ELECTROSTATICS
+  if (fields & FIELD_CHARGE)
+    f(p.p.q);
+#endif
+#ifdef ROTATION
+  if (fields & FIELD_ORIENTATION)
+    f(p.r.quat);
+  if (fields & FIELD_ANGULAR_VELOCITY)
+    f(p.m.omega);
+#endif
+#ifdef DIPOLES
+  if (fields & FIELD_ORIENTATION)
+    f(p.p.dipm);
+#endif
+}
+
+/** Size of the selected members of a particle in bytes. */
+std::size_t field_size(unsigned fields) {
+  Particle p;
+  std::size_t size = 0;
+  for_each_field(p, fields, [&size](auto const &m) { size += sizeof(m); });
+  return size;
+}
+
+/** The fields contained in a bitmask, one by one. */
+std::vector<unsigned> single_fields(unsigned fields) {
+  std::vector<unsigned> ret;
+  for (unsigned field = 1u; field <= FIELD_KINEMATICS; field <<= 1) {
+    if (fields & field)
+      ret.push_back(field);
+  }
+  return ret;
+}
+
+/** Pack the selected members of the particles, field by field
+ *  (structure of arrays).
+ */
+std::vector<char> pack_fields(std::vector<Particle *> const &parts,
+                              unsigned fields) {
+  std::vector<char> buf(parts.size() * field_size(fields));
+  auto out = buf.data();
+  for (auto const field : single_fields(fields)) {
+    for (auto p : parts) {
+      for_each_field(*p, field, [&out](auto const &m) {
+        std::memcpy(out, &m, sizeof(m));
+        out += sizeof(m);
+      });
+    }
+  }
+  return buf;
+}
+
+/** Inverse of @ref pack_fields. */
+void unpack_fields(char const *in, std::vector<Particle *> const &parts,
+                   unsigned fields) {
+  for (auto const field : single_fields(fields)) {
+    for (auto p : parts) {
+      for_each_field(*p, field, [&in](auto &m) {
+        std::memcpy(&m, in, sizeof(m));
+        in += sizeof(m);
+      });
+    }
+  }
+}
+
+std::vector<Particle *> local_particles(std::vector<int> const &ids) {
+  std::vector<Particle *> parts(ids.size());
+  std::transform(ids.begin(), ids.end(), parts.begin(), [](int id) {
+    assert(cell_structure.get_local_particle(id));
+    return cell_structure.get_local_particle(id);
+  });
+  return parts;
+}
+} // namespace
+
+void mpi_get_particle_fields_local(unsigned fields) {
+  std::vector<int> ids;
+  boost::mpi::scatter(comm_cart, ids, 0);
+
+  auto const buf = pack_fields(local_particles(ids), fields);
+  Utils::Mpi::gatherv(comm_cart, buf.data(), static_cast<int>(buf.size()), 0);
+}
+
+REGISTER_CALLBACK(mpi_get_particle_fields_local)
+
+std::vector<Particle> mpi_get_particle_fields(Utils::Span<const int> ids,
+                                              unsigned fields) {
+  std::vector<Particle> parts(ids.size());
+
+  /* Group ids per node, and remember where the particles go */
+  std::vector<std::vector<int>> node_ids(comm_cart.size());
+  std::vector<std::vector<Particle *>> node_parts(comm_cart.size());
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    auto const pnode = get_particle_node(ids[i]);
+    parts[i].p.identity = ids[i];
+    node_ids[pnode].push_back(ids[i]);
+    node_parts[pnode].push_back(&parts[i]);
+  }
+
+  mpi_call(mpi_get_particle_fields_local, fields);
+
+  {
+    std::vector<int> ignore;
+    boost::mpi::scatter(comm_cart, node_ids, ignore, 0);
+  }
+
+  auto const stride = field_size(fields);
+  auto const buf = pack_fields(local_particles(node_ids[this_node]), fields);
+
+  std::vector<int> sizes(comm_cart.size());
+  std::transform(node_ids.begin(), node_ids.end(), sizes.begin(),
+                 [stride](std::vector<int> const &ids) {
+                   return static_cast<int>(ids.size() * stride);
+                 });
+  std::vector<char> recv_buf(ids.size() * stride);
+  Utils::Mpi::gatherv(comm_cart, buf.data(), static_cast<int>(buf.size()),
+                      recv_buf.data(), sizes.data(), 0);
+
+  auto in = recv_buf.data();
+  for (int node = 0; node < comm_cart.size(); ++node) {
+    unpack_fields(in, node_parts[node], fields);
+    in += sizes[node];
+  }
+
+  return parts;
+}
+
+std::size_t property_dim(ParticleProperty property) {
+  switch (property) {
+  case PROPERTY_POS:
+  case PROPERTY_POS_FOLDED:
+  case PROPERTY_V:
+  case PROPERTY_F:
+    return 3;
+  default:
+    return 1;
+  }
+}
+
+namespace {
+/** Append the value of @p property of @p p to @p out. */
+void append_property(Particle const &p, ParticleProperty property,
+                     std::vector<double> &out) {
+  auto append = [&out](Utils::Vector3d const &v) {
+    out.insert(out.end(), v.begin(), v.end());
+  };
+
+  switch (property) {
+  case PROPERTY_POS:
+    append(unfolded_position(p.r.p, p.l.i, box_geo.length()));
+    break;
+  case PROPERTY_POS_FOLDED:
+    append(folded_position(p.r.p, box_geo));
+    break;
+  case PROPERTY_V:
+    append(p.m.v);
+    break;
+  case PROPERTY_F:
+    append(p.f.f);
+    break;
+  case PROPERTY_TYPE:
+    out.push_back(p.p.type);
+    break;
+  case PROPERTY_MOL_ID:
+    out.push_back(p.p.mol_id);
+    break;
+  case PROPERTY_Q:
+#ifdef ELECTROSTATICS
+    out.push_back(p.p.q);
+#else
+    out.push_back(0.);
+#endif
+    break;
+  case PROPERTY_MASS:
+#ifdef MASS
+    out.push_back(p.p.mass);
+#else
+    out.push_back(1.);
+#endif
+    break;
+  }
+}
+
+/** Values of @p property of the local particles @p ids, in that order. */
+std::vector<double> local_property(std::vector<int> const &ids,
+                                   ParticleProperty property) {
+  std::vector<double> values;
+  values.reserve(ids.size() * property_dim(property));
+  for (auto const p : local_particles(ids)) {
+    append_property(*p, property, values);
+  }
+  return values;
+}
+} // namespace
+
+void mpi_get_particles_property_local(int property) {
+  std::vector<int> ids;
+  boost::mpi::scatter(comm_cart, ids, 0);
+
+  auto const values =
+      local_property(ids, static_cast<ParticleProperty>(property));
+  Utils::Mpi::gatherv(comm_cart, values.data(),
+                      static_cast<int>(values.size()), 0);
+}
+
+REGISTER_CALLBACK(mpi_get_particles_property_local)
+
+void mpi_get_particles_property(Utils::Span<const int> ids,
+                                ParticleProperty property,
+                                Utils::Span<double> out) {
+  auto const dim = property_dim(property);
+  if (out.size() != ids.size() * dim) {
+    throw std::invalid_argument("Output buffer has the wrong size.");
+  }
+
+  /* Group ids per node, and remember their positions in the output */
+  std::vector<std::vector<int>> node_ids(comm_cart.size());
+  std::vector<std::vector<std::size_t>> node_index(comm_cart.size());
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    auto const pnode = get_particle_node(ids[i]);
+    node_ids[pnode].push_back(ids[i]);
+    node_index[pnode].push_back(i);
+  }
+
+  mpi_call(mpi_get_particles_property_local, static_cast<int>(property));
+
+  {
+    std::vector<int> ignore;
+    boost::mpi::scatter(comm_cart, node_ids, ignore, 0);
+  }
+
+  auto const values = local_property(node_ids[this_node], property);
+
+  std::vector<int> sizes(comm_cart.size());
+  std::transform(node_ids.begin(), node_ids.end(), sizes.begin(),
+                 [dim](std::vector<int> const &ids) {
+                   return static_cast<int>(ids.size() * dim);
+                 });
+  std::vector<double> recv_buf(out.size());
+  Utils::Mpi::gatherv(comm_cart, values.data(),
+                      static_cast<int>(values.size()), recv_buf.data(),
+                      sizes.data(), 0);
+
+  /* Scatter the values, which arrive grouped by node, to id order */
+  auto in = recv_buf.begin();
+  for (auto const &indices : node_index) {
+    for (auto const i : indices) {
+      std::copy_n(in, dim, out.begin() + i * dim);
+      in += dim;
+    }
+  }
+}
+
 /** Move a particle to a new position. If it does not exist, it is created.
  *  The position must be on the local node!
  *
@@ -686,6 +1031,79 @@ void mpi_place_particle(int node, int p_id, const Utils::Vector3d &pos) {
   on_particle_change();
 }
 
+using PositionList = std::vector<std::pair<int, Utils::Vector3d>>;
+
+void place_particles_local(PositionList const &created,
+                           PositionList const &moved) {
+  for (auto const &c : created) {
+    Particle p;
+    p.p.identity = c.first;
+    p.r.p = c.second;
+    fold_position(p.r.p, p.l.i, box_geo);
+    cell_structure.add_particle(std::move(p));
+  }
+  for (auto const &m : moved) {
+    local_place_particle(m.first, m.second, 0);
+  }
+
+  cell_structure.set_resort_particles(Cells::RESORT_GLOBAL);
+  on_particle_change();
+}
+
+void mpi_place_particles_local() {
+  PositionList created, moved;
+  boost::mpi::scatter(comm_cart, created, 0);
+  boost::mpi::scatter(comm_cart, moved, 0);
+  place_particles_local(created, moved);
+}
+
+REGISTER_CALLBACK(mpi_place_particles_local)
+
+void place_particles(std::vector<int> const &ids,
+                     std::vector<Utils::Vector3d> const &pos) {
+  if (ids.size() != pos.size()) {
+    throw std::invalid_argument("Got " + std::to_string(pos.size()) +
+                                " positions for " +
+                                std::to_string(ids.size()) + " particles.");
+  }
+
+  auto const n_nodes = static_cast<std::size_t>(comm_cart.size());
+  std::vector<PositionList> created(n_nodes), moved(n_nodes);
+  std::unordered_set<int> new_ids;
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    auto const p_id = ids[i];
+    if (p_id < 0) {
+      throw std::invalid_argument("Invalid particle id " +
+                                  std::to_string(p_id) + ".");
+    }
+    if (particle_exists(p_id)) {
+      moved[get_particle_node(p_id)].emplace_back(p_id, pos[i]);
+    } else if (new_ids.insert(p_id).second) {
+      /* New particles are sent to the node owning their position,
+       * so that the resort is local in the common case. */
+      auto const folded_pos = folded_position(pos[i], box_geo);
+      auto const node = map_position_node_array(folded_pos);
+      created[node].emplace_back(p_id, pos[i]);
+    } else {
+      throw std::invalid_argument("Particle id " + std::to_string(p_id) +
+                                  " is given more than once.");
+    }
+  }
+
+  mpi_call(mpi_place_particles_local);
+
+  PositionList local_created, local_moved;
+  boost::mpi::scatter(comm_cart, created, local_created, 0);
+  boost::mpi::scatter(comm_cart, moved, local_moved, 0);
+  place_particles_local(local_created, local_moved);
+
+  for (std::size_t node = 0; node < n_nodes; ++node) {
+    for (auto const &c : created[node]) {
+      particle_node[c.first] = static_cast<int>(node);
+    }
+  }
+}
+
 int place_particle(int p_id, const double *pos) {
   Utils::Vector3d p{pos[0], pos[1], pos[2]};
 
@@ -704,6 +1122,12 @@ void set_particle_v(int part, double *v) {
                       &ParticleMomentum::v>(part, Utils::Vector3d(v, v + 3));
 }
 
+void set_particles_v(std::vector<int> const &ids,
+                     std::vector<Utils::Vector3d> const &v) {
+  mpi_update_particles<ParticleMomentum, &Particle::m, Utils::Vector3d,
+                       &ParticleMomentum::v>(ids, v);
+}
+
 #ifdef ENGINE
 void set_particle_swimming(int part, ParticleParametersSwimming swim) {
   mpi_update_particle_property<ParticleParametersSwimming,
@@ -720,6 +1144,11 @@ void set_particle_f(int part, const Utils::Vector3d &F) {
 void set_particle_mass(int part, double mass) {
   mpi_update_particle_property<double, &ParticleProperties::mass>(part, mass);
 }
+
+void set_particles_mass(std::vector<int> const &ids,
+                        std::vector<double> const &mass) {
+  mpi_update_particles_property<double, &ParticleProperties::mass>(ids, mass);
+}
 #else
 const constexpr double ParticleProperties::mass;
 #endif
@@ -797,6 +1226,13 @@ void set_particle_q(int part, double q) {
 #endif
 }
 
+void set_particles_q(std::vector<int> const &ids,
+                     std::vector<double> const &q) {
+#ifdef ELECTROSTATICS
+  mpi_update_particles_property<double, &ParticleProperties::q>(ids, q);
+#endif
+}
+
 #ifndef ELECTROSTATICS
 const constexpr double ParticleProperties::q;
 #endif
@@ -831,10 +1267,34 @@ void set_particle_type(int p_id, int type) {
   mpi_update_particle_property<int, &ParticleProperties::type>(p_id, type);
 }
 
+void set_particles_type(std::vector<int> const &ids,
+                        std::vector<int> const &types) {
+  if (not types.empty()) {
+    make_particle_type_exist(*boost::max_element(types));
+  }
+
+  if (type_list_enable and ids.size() == types.size()) {
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      auto const prev_type = get_particle_data(ids[i]).p.type;
+      if (prev_type != types[i]) {
+        remove_id_from_map(ids[i], prev_type);
+      }
+      add_id_to_type_map(ids[i], types[i]);
+    }
+  }
+
+  mpi_update_particles_property<int, &ParticleProperties::type>(ids, types);
+}
+
 void set_particle_mol_id(int part, int mid) {
   mpi_update_particle_property<int, &ParticleProperties::mol_id>(part, mid);
 }
 
+void set_particles_mol_id(std::vector<int> const &ids,
+                          std::vector<int> const &mids) {
+  mpi_update_particles_property<int, &ParticleProperties::mol_id>(ids, mids);
+}
+
 #ifdef ROTATION
 void set_particle_quat(int part, double *quat) {
   mpi_update_particle<ParticlePosition, &Particle::r, Utils::Vector4d,
@@ -1154,7 +1614,7 @@ void init_type_map(int type) {
   if (particle_type_map.count(type) == 0)
     particle_type_map[type] = std::unordered_set<int>();
 
-  for (auto const &p : partCfg()) {
+  for (auto const &p : partCfgKinematics()) {
     if (p.p.type == type)
       particle_type_map.at(type).insert(p.p.identity);
   }
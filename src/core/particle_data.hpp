@@ -44,6 +44,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 /************************************************
  * defines
@@ -58,6 +59,54 @@ enum {
   ES_PART_CREATED = 1
 };
 
+/** Particle properties transferred by \ref mpi_get_particle_fields. */
+enum ParticleField : unsigned {
+  FIELD_NONE = 0u,
+  /** ParticlePosition::p and ParticleLocal::i */
+  FIELD_POSITION = 1u,
+  /** ParticleMomentum::v */
+  FIELD_VELOCITY = 2u,
+  /** ParticleForce::f */
+  FIELD_FORCE = 4u,
+  /** ParticleProperties::type */
+  FIELD_TYPE = 8u,
+  /** ParticleProperties::mass and ParticleProperties::is_virtual */
+  FIELD_MASS = 16u,
+  /** ParticleProperties::q */
+  FIELD_CHARGE = 32u,
+  /** ParticlePosition::quat and ParticleProperties::dipm */
+  FIELD_ORIENTATION = 64u,
+  /** ParticleMomentum::omega */
+  FIELD_ANGULAR_VELOCITY = 128u,
+  /** All of the above */
+  FIELD_KINEMATICS = 255u,
+  /** The complete particle, including the bonds */
+  FIELD_ALL = ~0u
+};
+
+/** Particle properties read by \ref mpi_get_particles_property. */
+enum ParticleProperty : int {
+  /** Unfolded position, 3 components */
+  PROPERTY_POS = 0,
+  /** Position folded into the box, 3 components */
+  PROPERTY_POS_FOLDED,
+  /** ParticleMomentum::v, 3 components */
+  PROPERTY_V,
+  /** ParticleForce::f, 3 components */
+  PROPERTY_F,
+  /** ParticleProperties::type */
+  PROPERTY_TYPE,
+  /** ParticleProperties::mol_id */
+  PROPERTY_MOL_ID,
+  /** ParticleProperties::q, zero without ELECTROSTATICS */
+  PROPERTY_Q,
+  /** ParticleProperties::mass, one without MASS */
+  PROPERTY_MASS
+};
+
+/** Number of components of a \ref ParticleProperty. */
+std::size_t property_dim(ParticleProperty property);
+
 /************************************************
  * Functions
  ************************************************/
@@ -76,6 +125,41 @@ void clear_particle_node();
  */
 const Particle &get_particle_data(int part);
 
+/**
+ * @brief Get selected properties of multiple particles at once.
+ *
+ * In contrast to \ref get_particle_data, only the requested properties
+ * are sent to the master node, packed field by field. All other
+ * members of the returned particles are default-initialized, except
+ * for the identity.
+ *
+ * @param ids    Ids of the particles, they have to exist.
+ * @param fields Bitmask of \ref ParticleField values.
+ * @return Particle copies, in the order of @p ids.
+ */
+std::vector<Particle> mpi_get_particle_fields(Utils::Span<const int> ids,
+                                              unsigned fields);
+
+/**
+ * @brief Read one property of multiple particles into a flat buffer.
+ *
+ * Every node extracts the values of its particles directly into a
+ * contiguous buffer of doubles, which is gathered on the master node,
+ * so that no particle copies are made. Integer properties are
+ * converted to double.
+ *
+ * @param ids      Ids of the particles, they have to exist.
+ * @param property The property to read.
+ * @param out      Output buffer of size
+ *                 <tt>ids.size() * property_dim(property)</tt>,
+ *                 filled in the order of @p ids with the components
+ *                 of a particle stored contiguously.
+ * @throws std::invalid_argument if the size of @p out does not match.
+ */
+void mpi_get_particles_property(Utils::Span<const int> ids,
+                                ParticleProperty property,
+                                Utils::Span<double> out);
+
 /**
  * @brief Fetch a range of particle into the fetch cache.
  *
@@ -109,12 +193,32 @@ size_t fetch_cache_max_size();
  */
 int place_particle(int part, const double *p);
 
+/** Call only on the master node: move or create many particles at once.
+ *  Bulk version of @ref place_particle, which sends the positions to
+ *  all nodes in a single scatter. New particles are sent to the node
+ *  owning their position.
+ *  @param ids the identities of the particles
+ *  @param pos their new positions
+ *  @throws std::invalid_argument if an id is negative or given twice,
+ *          or if the sizes do not match.
+ */
+void place_particles(std::vector<int> const &ids,
+                     std::vector<Utils::Vector3d> const &pos);
+
 /** Call only on the master node: set particle velocity.
  *  @param part the particle.
  *  @param v its new velocity.
  */
 void set_particle_v(int part, double *v);
 
+/** Call only on the master node: set the velocities of many particles
+ *  in a single scatter.
+ *  @param ids the particles.
+ *  @param v   their new velocities.
+ */
+void set_particles_v(std::vector<int> const &ids,
+                     std::vector<Utils::Vector3d> const &v);
+
 #ifdef ENGINE
 /** Call only on the master node: set particle velocity.
  *  @param part the particle.
@@ -135,6 +239,13 @@ void set_particle_f(int part, const Utils::Vector3d &F);
  */
 void set_particle_mass(int part, double mass);
 
+/** Call only on the master node: set the masses of many particles.
+ *  @param ids  the particles.
+ *  @param mass their new masses.
+ */
+void set_particles_mass(std::vector<int> const &ids,
+                        std::vector<double> const &mass);
+
 #ifdef ROTATIONAL_INERTIA
 /** Call only on the master node: set particle rotational inertia.
  *  @param part the particle.
@@ -165,6 +276,13 @@ void rotate_particle(int part, const Utils::Vector3d &axis, double angle);
  */
 void set_particle_q(int part, double q);
 
+/** Call only on the master node: set the charges of many particles.
+ *  @param ids the particles.
+ *  @param q   their new charges.
+ */
+void set_particles_q(std::vector<int> const &ids,
+                     std::vector<double> const &q);
+
 #ifdef LB_ELECTROHYDRODYNAMICS
 /** Call only on the master node: set particle electrophoretic mobility.
  *  @param part the particle.
@@ -180,12 +298,26 @@ void get_particle_mu_E(int part, Utils::Vector3d &mu_E);
  */
 void set_particle_type(int p_id, int type);
 
+/** Call only on the master node: set the types of many particles.
+ *  @param ids   the particles.
+ *  @param types their new types.
+ */
+void set_particles_type(std::vector<int> const &ids,
+                        std::vector<int> const &types);
+
 /** Call only on the master node: set particle's molecule id.
  *  @param part the particle.
  *  @param mid  its new mol id.
  */
 void set_particle_mol_id(int part, int mid);
 
+/** Call only on the master node: set the molecule ids of many particles.
+ *  @param ids  the particles.
+ *  @param mids their new mol ids.
+ */
+void set_particles_mol_id(std::vector<int> const &ids,
+                          std::vector<int> const &mids);
+
 #ifdef ROTATION
 /** Call only on the master node: set particle orientation using quaternions.
  *  @param part the particle.
@@ -70,6 +70,11 @@ nptiso_struct nptiso = {0.0,
 /** Pressure tensor of the system */
 Observable_stat obs_pressure{9};
 
+/** Whether @ref obs_pressure was accumulated by the last @ref force_calc
+ *  and describes the current state.
+ */
+static bool obs_pressure_fused = false;
+
 Observable_stat const &get_obs_pressure() { return obs_pressure; }
 
 /** Calculate long-range virials (P3M, ...). */
@@ -85,6 +90,26 @@ void calc_long_range_virials(const ParticleRange &particles) {
 #endif
 }
 
+/** Add the virtual sites contribution, rescale by the volume and collect
+ *  the pressure tensor on the head node.
+ */
+static void finalize_pressure(double volume) {
+#ifdef VIRTUAL_SITES
+  if (!obs_pressure.virtual_sites.empty()) {
+    auto const vs_pressure = virtual_sites()->pressure_tensor();
+    boost::copy(flatten(vs_pressure), obs_pressure.virtual_sites.begin());
+  }
+#endif
+
+  obs_pressure.rescale(volume);
+
+  /* gather data */
+  auto obs_pressure_res = reduce(comm_cart, obs_pressure);
+  if (obs_pressure_res) {
+    std::swap(obs_pressure, *obs_pressure_res);
+  }
+}
+
 void pressure_calc() {
   auto const volume = box_geo.volume();
 
@@ -123,22 +148,25 @@ void pressure_calc() {
 
   calc_long_range_virials(cell_structure.local_particles());
 
-#ifdef VIRTUAL_SITES
-  if (!obs_pressure.virtual_sites.empty()) {
-    auto const vs_pressure = virtual_sites()->pressure_tensor();
-    boost::copy(flatten(vs_pressure), obs_pressure.virtual_sites.begin());
-  }
-#endif
+  finalize_pressure(volume);
+}
 
-  obs_pressure.rescale(volume);
+Observable_stat *pressure_fused_begin() {
+  obs_pressure = Observable_stat{9};
+  return &obs_pressure;
+}
 
-  /* gather data */
-  auto obs_pressure_res = reduce(comm_cart, obs_pressure);
-  if (obs_pressure_res) {
-    std::swap(obs_pressure, *obs_pressure_res);
+void pressure_fused_end() {
+  for (auto const &p : cell_structure.local_particles()) {
+    add_kinetic_virials(p, obs_pressure);
   }
+
+  finalize_pressure(box_geo.volume());
+  obs_pressure_fused = true;
 }
 
+void pressure_fused_invalidate() { obs_pressure_fused = false; }
+
 void update_pressure_local(int, int) { pressure_calc(); }
 
 REGISTER_CALLBACK(update_pressure_local)
@@ -146,7 +174,8 @@ REGISTER_CALLBACK(update_pressure_local)
 void update_pressure() { mpi_call_all(update_pressure_local, -1, -1); }
 
 Utils::Vector9d observable_compute_pressure_tensor() {
-  update_pressure();
+  if (!obs_pressure_fused)
+    update_pressure();
   Utils::Vector9d pressure_tensor{};
   for (size_t j = 0; j < 9; j++) {
     pressure_tensor[j] = obs_pressure.accumulate(0, j);
@@ -35,6 +35,23 @@ void pressure_calc();
 /** Run @ref pressure_calc in parallel. */
 void update_pressure();
 
+/** Reset the pressure observable to accumulate it in @ref force_calc.
+ *  @return The pressure observable.
+ */
+Observable_stat *pressure_fused_begin();
+
+/** Complete the pressure tensor accumulated in @ref force_calc with the
+ *  kinetic part and collect it on the head node. It is returned by
+ *  @ref observable_compute_pressure_tensor until
+ *  @ref pressure_fused_invalidate is called.
+ */
+void pressure_fused_end();
+
+/** Recalculate the pressure in the next
+ *  @ref observable_compute_pressure_tensor.
+ */
+void pressure_fused_invalidate();
+
 /** Return the pressure observable. */
 Observable_stat const &get_obs_pressure();
 
@@ -92,7 +92,7 @@ inline void add_non_bonded_pair_virials(Particle const &p1, Particle const &p2,
 #endif /*ifdef DIPOLES */
 }
 
-boost::optional<Utils::Matrix<double, 3, 3>>
+inline boost::optional<Utils::Matrix<double, 3, 3>>
 calc_bonded_virial_pressure_tensor(Bonded_ia_parameters const &iaparams,
                                    Particle const &p1, Particle const &p2) {
   auto const dx = get_mi_vector(p1.r.p, p2.r.p, box_geo);
@@ -106,7 +106,7 @@ calc_bonded_virial_pressure_tensor(Bonded_ia_parameters const &iaparams,
   return {};
 }
 
-boost::optional<Utils::Matrix<double, 3, 3>>
+inline boost::optional<Utils::Matrix<double, 3, 3>>
 calc_bonded_three_body_pressure_tensor(Bonded_ia_parameters const &iaparams,
                                        Particle const &p1, Particle const &p2,
                                        Particle const &p3) {
@@ -39,8 +39,13 @@
 #include <utils/contains.hpp>
 #include <utils/math/sqr.hpp>
 
+#include <boost/mpi/collectives/reduce.hpp>
+
+#include <complex>
 #include <cstdlib>
+#include <functional>
 #include <limits>
+#include <vector>
 
 /****************************************************************************************
  *                                 basic observables calculation
@@ -263,14 +268,86 @@ void calc_part_distribution(PartCfg &partCfg, std::vector<int> const &p1_types,
     dist[i] /= (double)cnt;
 }
 
-std::vector<double> calc_structurefactor(PartCfg &partCfg,
-                                         std::vector<int> const &p_types,
+/** Partial sums of cos(q r) and sin(q r) over the local particles of the
+ *  requested types for all wave vectors q = 2PI/L (i, j, k) with
+ *  0 <= i <= order and -order <= j, k <= order, followed by the number
+ *  of contributing particles. The phase factors of the wave vectors are
+ *  obtained from those of the unit wave vectors by complex multiplication.
+ */
+static std::vector<double> structure_factor_sums_local(
+    std::vector<int> const &p_types, int order) {
+  using Complex = std::complex<double>;
+
+  auto const n_k = 2 * order + 1;
+  auto const n_q = (order + 1) * n_k * n_k;
+  std::vector<double> sums(2 * n_q + 1, 0.);
+
+  /* number of occurrences of each type in p_types */
+  std::vector<int> type_weight;
+  for (auto const t : p_types) {
+    if (t < 0)
+      continue;
+    if (t >= static_cast<int>(type_weight.size()))
+      type_weight.resize(t + 1, 0);
+    type_weight[t]++;
+  }
+
+  auto const twoPI_L = 2 * Utils::pi() / box_geo.length()[0];
+  std::vector<Complex> phase_x(order + 1), phase_y(n_k), phase_z(n_k);
+
+  auto fill_phases = [order](Complex const &e, Complex *out, bool negative) {
+    Complex c{1., 0.};
+    for (int n = 0; n <= order; n++) {
+      out[n] = c;
+      if (negative)
+        out[-n] = std::conj(c);
+      c *= e;
+    }
+  };
+
+  for (auto const &p : cell_structure.local_particles()) {
+    if (p.p.type < 0 or p.p.type >= static_cast<int>(type_weight.size()) or
+        type_weight[p.p.type] == 0)
+      continue;
+    auto const weight = static_cast<double>(type_weight[p.p.type]);
+    auto const pos = unfolded_position(p.r.p, p.l.i, box_geo.length());
+
+    fill_phases(std::polar(1., twoPI_L * pos[0]), phase_x.data(), false);
+    fill_phases(std::polar(1., twoPI_L * pos[1]), phase_y.data() + order,
+                true);
+    fill_phases(std::polar(1., twoPI_L * pos[2]), phase_z.data() + order,
+                true);
+
+    for (int i = 0; i <= order; i++) {
+      for (int j = 0; j < n_k; j++) {
+        auto const e_xy = phase_x[i] * phase_y[j];
+        auto *sum = sums.data() + 2 * ((i * n_k + j) * n_k);
+        for (int k = 0; k < n_k; k++) {
+          auto const e = e_xy * phase_z[k];
+          sum[2 * k] += weight * e.real();
+          sum[2 * k + 1] += weight * e.imag();
+        }
+      }
+    }
+    sums.back() += weight;
+  }
+
+  return sums;
+}
+
+static void mpi_structure_factor_sums_local(std::vector<int> const &p_types,
+                                            int order) {
+  auto const sums = structure_factor_sums_local(p_types, order);
+  boost::mpi::reduce(comm_cart, sums.data(), static_cast<int>(sums.size()),
+                     std::plus<double>(), 0);
+}
+
+REGISTER_CALLBACK(mpi_structure_factor_sums_local)
+
+std::vector<double> calc_structurefactor(std::vector<int> const &p_types,
                                          int order) {
   auto const order2 = order * order;
-  std::vector<double> ff;
-  ff.resize(2 * order2);
-  ff[2 * order2] = 0;
-  auto const twoPI_L = 2 * Utils::pi() / box_geo.length()[0];
+  std::vector<double> ff(2 * order2, 0.);
 
   if (order < 1) {
     fprintf(stderr,
@@ -278,38 +355,29 @@ std::vector<double> calc_structurefactor(PartCfg &partCfg,
     fflush(nullptr);
     errexit();
   } else {
-    for (int qi = 0; qi < 2 * order2; qi++) {
-      ff[qi] = 0.0;
-    }
+    mpi_call(mpi_structure_factor_sums_local, p_types, order);
+    auto const local_sums = structure_factor_sums_local(p_types, order);
+    std::vector<double> sums(local_sums.size());
+    boost::mpi::reduce(comm_cart, local_sums.data(),
+                       static_cast<int>(local_sums.size()), sums.data(),
+                       std::plus<double>(), 0);
+
+    auto const n_k = 2 * order + 1;
     for (int i = 0; i <= order; i++) {
       for (int j = -order; j <= order; j++) {
         for (int k = -order; k <= order; k++) {
           auto const n = i * i + j * j + k * k;
           if ((n <= order2) && (n >= 1)) {
-            double C_sum = 0.0, S_sum = 0.0;
-            for (auto const &p : partCfg) {
-              for (int t : p_types) {
-                if (p.p.type == t) {
-                  auto const qr =
-                      twoPI_L * (Utils::Vector3i{{i, j, k}} * p.r.p);
-                  C_sum += cos(qr);
-                  S_sum += sin(qr);
-                }
-              }
-            }
+            auto const q = (i * n_k + (j + order)) * n_k + (k + order);
+            auto const C_sum = sums[2 * q];
+            auto const S_sum = sums[2 * q + 1];
             ff[2 * n - 2] += C_sum * C_sum + S_sum * S_sum;
             ff[2 * n - 1]++;
           }
         }
       }
     }
-    int n = 0;
-    for (auto const &p : partCfg) {
-      for (int t : p_types) {
-        if (p.p.type == t)
-          n++;
-      }
-    }
+    auto const n = sums.back();
     for (int qi = 0; qi < order2; qi++)
       if (ff[2 * qi + 1] != 0)
         ff[2 * qi] /= n * ff[2 * qi + 1];
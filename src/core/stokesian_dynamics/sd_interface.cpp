@@ -21,24 +21,31 @@
 
 #ifdef STOKESIAN_DYNAMICS
 #include "sd_interface.hpp"
+#include "sd_rpy.hpp"
 
 #include "stokesian_dynamics/sd_cpu.hpp"
 
 #include "Particle.hpp"
 #include "ParticleRange.hpp"
+#include "random.hpp"
 #include "thermostat.hpp"
 
 #include <utils/Vector.hpp>
+#include <utils/mpi/all_gatherv.hpp>
 #include <utils/mpi/gather_buffer.hpp>
 #include <utils/mpi/scatter_buffer.hpp>
 
+#include <boost/mpi/collectives/all_gather.hpp>
+#include <boost/mpi/collectives/all_reduce.hpp>
 #include <boost/range/algorithm.hpp>
 #include <boost/serialization/is_bitwise_serializable.hpp>
 
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <functional>
 #include <iterator>
+#include <numeric>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -78,6 +85,98 @@ int sd_flags = 0;
  *  particles on each node, used for returning results. */
 std::vector<double> v_sd{};
 
+/** Relative tolerance of the Lanczos method for the Brownian velocities
+ *  with @ref SD_FLAG_RPY.
+ */
+constexpr double lanczos_tol = 1e-3;
+/** Maximal number of Lanczos iterations with @ref SD_FLAG_RPY. */
+constexpr std::size_t lanczos_max_iter = 100;
+
+/** Gather data with @p stride values per particle from all nodes, in the
+ *  order of the ranks.
+ */
+std::vector<double> all_gather_particle_data(
+    std::vector<double> const &local, std::vector<int> const &n_parts,
+    int stride, boost::mpi::communicator const &comm) {
+  std::vector<int> sizes(n_parts.size());
+  std::transform(n_parts.begin(), n_parts.end(), sizes.begin(),
+                 [stride](int n) { return stride * n; });
+  std::vector<double> global(std::accumulate(sizes.begin(), sizes.end(), 0));
+  Utils::Mpi::all_gatherv(comm, local.data(), static_cast<int>(local.size()),
+                          global.data(), sizes.data());
+  return global;
+}
+
+/** Distributed variant of @ref propagate_vel_pos_sd with the matrix-free
+ *  RPY mobility. Every node keeps the positions, radii, forces and
+ *  torques of all particles, i.e. O(N) memory, and computes the
+ *  velocities of its own particles.
+ */
+void propagate_vel_pos_sd_rpy(ParticleRange const &particles,
+                              boost::mpi::communicator const &comm,
+                              double time_step) {
+  using namespace StokesianDynamics;
+
+  std::vector<Particle *> parts;
+  std::vector<double> pos, radii, ft;
+  for (auto &p : particles) {
+    if (p.p.is_virtual)
+      continue;
+    parts.push_back(&p);
+    pos.insert(pos.end(), p.r.p.begin(), p.r.p.end());
+    radii.push_back(radius_dict[p.p.type]);
+    ft.insert(ft.end(), p.f.f.begin(), p.f.f.end());
+    ft.insert(ft.end(), p.f.torque.begin(), p.f.torque.end());
+  }
+
+  std::vector<int> n_parts;
+  boost::mpi::all_gather(comm, static_cast<int>(parts.size()), n_parts);
+  auto const first = static_cast<std::size_t>(std::accumulate(
+      n_parts.begin(), n_parts.begin() + comm.rank(), 0));
+  auto const all_pos = all_gather_particle_data(pos, n_parts, 3, comm);
+  auto const all_radii = all_gather_particle_data(radii, n_parts, 1, comm);
+
+  auto const self_mobility = (sd_flags & SD_FLAG_SELF_MOBILITY) != 0;
+  auto const pair_mobility = (sd_flags & SD_FLAG_PAIR_MOBILITY) != 0;
+  auto mat_vec = [&](std::vector<double> const &local) {
+    auto const all = all_gather_particle_data(local, n_parts, 6, comm);
+    return rpy_mobility_product(all_pos, all_radii, all, first, parts.size(),
+                                sd_viscosity, self_mobility, pair_mobility);
+  };
+
+  auto v = mat_vec(ft);
+
+  if (sd_kT > 0.) {
+    auto dot = [&comm](std::vector<double> const &a,
+                       std::vector<double> const &b) {
+      auto const local = std::inner_product(a.begin(), a.end(), b.begin(), 0.);
+      return boost::mpi::all_reduce(comm, local, std::plus<double>());
+    };
+
+    std::vector<double> z;
+    z.reserve(v.size());
+    for (auto const p : parts) {
+      for (int key2 : {0, 1}) {
+        auto const noise = Random::noise_gaussian<RNGSalt::STOKESIAN>(
+            stokesian.rng_counter(), stokesian.rng_seed(), p->identity(),
+            key2);
+        z.insert(z.end(), noise.begin(), noise.end());
+      }
+    }
+
+    auto const v_brown =
+        lanczos_sqrt(mat_vec, dot, z, lanczos_tol, lanczos_max_iter);
+    auto const prefactor = std::sqrt(2. * sd_kT / time_step);
+    for (std::size_t i = 0; i < v.size(); ++i)
+      v[i] += prefactor * v_brown[i];
+  }
+
+  for (std::size_t i = 0; i < parts.size(); ++i) {
+    std::copy_n(v.begin() + 6 * i, 3, parts[i]->m.v.begin());
+    std::copy_n(v.begin() + 6 * i + 3, 3, parts[i]->m.omega.begin());
+  }
+}
+
 } // namespace
 
 BOOST_IS_BITWISE_SERIALIZABLE(SD_particle_data)
@@ -153,6 +252,11 @@ int get_sd_flags() { return sd_flags; }
 void propagate_vel_pos_sd(const ParticleRange &particles,
                           const boost::mpi::communicator &comm,
                           const double time_step) {
+  if (sd_flags & SD_FLAG_RPY) {
+    propagate_vel_pos_sd_rpy(particles, comm, time_step);
+    return;
+  }
+
   static std::vector<SD_particle_data> parts_buffer{};
 
   parts_buffer.clear();
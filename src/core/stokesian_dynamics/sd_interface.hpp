@@ -34,6 +34,16 @@
 
 #include <unordered_map>
 
+/** Bits of @ref set_sd_flags which are evaluated in the core. */
+enum : int {
+  SD_FLAG_SELF_MOBILITY = 1 << 0,
+  SD_FLAG_PAIR_MOBILITY = 1 << 1,
+  /** Far-field mobility evaluated in parallel on all nodes without
+   *  storing the mobility matrix, see sd_rpy.hpp.
+   */
+  SD_FLAG_RPY = 1 << 4
+};
+
 void set_sd_viscosity(double eta);
 double get_sd_viscosity();
 
@@ -50,6 +60,10 @@ int get_sd_flags();
  *  velocities. Acts globally on particles on all nodes; i.e. particle data
  *  is gathered from all nodes and their velocities and angular velocities are
  *  set according to the Stokesian Dynamics method.
+ *
+ *  With @ref SD_FLAG_RPY, only the positions, radii, forces and torques
+ *  are shared between the nodes, and every node evaluates the mobility
+ *  of its own particles.
  */
 void propagate_vel_pos_sd(const ParticleRange &particles,
                           const boost::mpi::communicator &comm,
@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** @file
+ *  Matrix-free far-field mobility for Stokesian dynamics.
+ *
+ *  The mobility matrix is the Rotne-Prager-Yamakawa (RPY) tensor at the
+ *  force-torque level. It is never stored, instead its product with
+ *  the forces and torques is evaluated pair by pair, so that the rows
+ *  of the product can be computed independently on different nodes.
+ *  The translational coupling of overlapping spheres of different radii
+ *  is taken from @cite zuk14a, the rotational couplings of overlapping
+ *  spheres use the expressions for equal spheres @cite wajnryb13a with
+ *  the mean radius, which is exact for equal radii and continuous at
+ *  contact.
+ *
+ *  The Brownian displacements require the square root of the mobility
+ *  matrix, which is approximated by the Lanczos method @cite chow14a
+ *  using only matrix-vector products.
+ */
+
+#ifndef STOKESIAN_DYNAMICS_SD_RPY_HPP
+#define STOKESIAN_DYNAMICS_SD_RPY_HPP
+
+#include <utils/Span.hpp>
+#include <utils/Vector.hpp>
+#include <utils/constants.hpp>
+#include <utils/math/sqr.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace StokesianDynamics {
+
+/** Add the velocity @p u and angular velocity @p omega of sphere i caused
+ *  by the force @p f and the torque @p t on sphere j to the output.
+ *
+ *  @param r_ij  Distance vector from the center of j to the center of i.
+ *  @param a_i   Radius of sphere i.
+ *  @param a_j   Radius of sphere j.
+ *  @param eta   Dynamic viscosity.
+ *  @param f     Force on sphere j.
+ *  @param t     Torque on sphere j.
+ *  @param u     Velocity of sphere i.
+ *  @param omega Angular velocity of sphere i.
+ */
+inline void rpy_pair(Utils::Vector3d const &r_ij, double a_i, double a_j,
+                     double eta, Utils::Vector3d const &f,
+                     Utils::Vector3d const &t, Utils::Vector3d &u,
+                     Utils::Vector3d &omega) {
+  using Utils::sqr;
+  auto const pi_eta = Utils::pi() * eta;
+  auto const r = r_ij.norm();
+
+  if (r >= a_i + a_j) {
+    auto const e = r_ij / r;
+    auto const a2 = (sqr(a_i) + sqr(a_j)) / sqr(r);
+    auto const ef = e * f;
+    u += ((1. + a2 / 3.) * f + (1. - a2) * ef * e) / (8. * pi_eta * r);
+    u += vector_product(t, e) / (8. * pi_eta * sqr(r));
+    omega += vector_product(f, e) / (8. * pi_eta * sqr(r));
+    omega += (3. * (e * t) * e - t) / (16. * pi_eta * r * sqr(r));
+    return;
+  }
+
+  /* translation, overlapping spheres */
+  auto const a_max = std::max(a_i, a_j);
+  if (r <= std::abs(a_i - a_j)) {
+    u += f / (6. * pi_eta * a_max);
+  } else {
+    auto const e = r_ij / r;
+    auto const r3 = r * sqr(r);
+    auto const d2 = sqr(a_i - a_j);
+    auto const c_f = (16. * r3 * (a_i + a_j) - sqr(d2 + 3. * sqr(r))) / r3;
+    auto const c_e = 3. * sqr(d2 - sqr(r)) / r3;
+    u += (c_f * f + c_e * (e * f) * e) / (192. * pi_eta * a_i * a_j);
+  }
+
+  /* rotation, overlapping spheres of mean radius */
+  auto const a = 0.5 * (a_i + a_j);
+  auto const x = r / a;
+  auto const c_rt = (1. - 0.375 * x) / (16. * pi_eta * a * sqr(a));
+  u += c_rt * vector_product(t, r_ij);
+  omega += c_rt * vector_product(f, r_ij);
+  if (r > 0.) {
+    auto const e = r_ij / r;
+    auto const x3 = x * sqr(x);
+    omega += ((1. - 27. / 32. * x + 5. / 64. * x3) * t +
+              (9. / 32. * x - 3. / 64. * x3) * (e * t) * e) /
+             (8. * pi_eta * a * sqr(a));
+  } else {
+    omega += t / (8. * pi_eta * a * sqr(a));
+  }
+}
+
+/** Add the velocity and angular velocity of an isolated sphere of radius
+ *  @p a under the force @p f and the torque @p t to @p u and @p omega.
+ */
+inline void rpy_self(double a, double eta, Utils::Vector3d const &f,
+                     Utils::Vector3d const &t, Utils::Vector3d &u,
+                     Utils::Vector3d &omega) {
+  auto const pi_eta = Utils::pi() * eta;
+  u += f / (6. * pi_eta * a);
+  omega += t / (8. * pi_eta * a * Utils::sqr(a));
+}
+
+/** Rows @p first to <tt>first + count</tt> of the product of the RPY
+ *  mobility matrix with the forces and torques of all particles.
+ *
+ *  @param pos    Positions of all particles, 3 values per particle.
+ *  @param radii  Radii of all particles.
+ *  @param ft     Forces and torques of all particles, 6 values per
+ *                particle.
+ *  @param first  First particle for which the product is evaluated.
+ *  @param count  Number of particles for which the product is evaluated.
+ *  @param eta    Dynamic viscosity.
+ *  @param self_mobility  Include the mobility of the isolated spheres.
+ *  @param pair_mobility  Include the hydrodynamic interactions.
+ *  @return Velocities and angular velocities, 6 values per particle.
+ */
+inline std::vector<double>
+rpy_mobility_product(Utils::Span<const double> pos,
+                     Utils::Span<const double> radii,
+                     Utils::Span<const double> ft, std::size_t first,
+                     std::size_t count, double eta, bool self_mobility,
+                     bool pair_mobility) {
+  auto const n_part = radii.size();
+  assert(pos.size() == 3 * n_part);
+  assert(ft.size() == 6 * n_part);
+  assert(first + count <= n_part);
+
+  auto vec = [](Utils::Span<const double> v, std::size_t i) {
+    return Utils::Vector3d{v[i], v[i + 1], v[i + 2]};
+  };
+
+  std::vector<double> uw(6 * count);
+  for (std::size_t k = 0; k < count; ++k) {
+    auto const i = first + k;
+    auto const x_i = vec(pos, 3 * i);
+    Utils::Vector3d u{}, omega{};
+    for (std::size_t j = 0; j < n_part; ++j) {
+      auto const f = vec(ft, 6 * j);
+      auto const t = vec(ft, 6 * j + 3);
+      if (j == i) {
+        if (self_mobility)
+          rpy_self(radii[i], eta, f, t, u, omega);
+      } else if (pair_mobility) {
+        rpy_pair(x_i - vec(pos, 3 * j), radii[i], radii[j], eta, f, t, u,
+                 omega);
+      }
+    }
+    std::copy(u.begin(), u.end(), uw.begin() + 6 * k);
+    std::copy(omega.begin(), omega.end(), uw.begin() + 6 * k + 3);
+  }
+  return uw;
+}
+
+/** @c f(A) e_1 for a small symmetric matrix @c A, computed by the cyclic
+ *  Jacobi eigenvalue method.
+ *
+ *  @param a  Row-major @p n x @p n symmetric matrix, destroyed.
+ *  @param n  Size of the matrix.
+ *  @param f  Function of the eigenvalues.
+ */
+template <class F>
+std::vector<double> symmetric_function_e1(std::vector<double> a,
+                                          std::size_t n, F &&f) {
+  assert(a.size() == n * n);
+  std::vector<double> q(n * n, 0.);
+  for (std::size_t i = 0; i < n; ++i)
+    q[i * n + i] = 1.;
+
+  auto off_diagonal = [&]() {
+    double sum = 0., norm = 0.;
+    for (std::size_t i = 0; i < n; ++i)
+      for (std::size_t j = 0; j < n; ++j) {
+        norm += Utils::sqr(a[i * n + j]);
+        if (i != j)
+          sum += Utils::sqr(a[i * n + j]);
+      }
+    return std::make_pair(sum, norm);
+  };
+
+  for (int sweep = 0; sweep < 64; ++sweep) {
+    auto const off = off_diagonal();
+    if (off.first <= 1e-28 * off.second)
+      break;
+    for (std::size_t p = 0; p + 1 < n; ++p) {
+      for (std::size_t r = p + 1; r < n; ++r) {
+        auto const a_pr = a[p * n + r];
+        if (a_pr == 0.)
+          continue;
+        auto const theta = (a[r * n + r] - a[p * n + p]) / (2. * a_pr);
+        auto const t = std::copysign(1., theta) /
+                       (std::abs(theta) + std::sqrt(theta * theta + 1.));
+        auto const c = 1. / std::sqrt(t * t + 1.);
+        auto const s = t * c;
+        /* A <- J^T A J */
+        for (std::size_t k = 0; k < n; ++k) {
+          auto const a_kp = a[k * n + p], a_kr = a[k * n + r];
+          a[k * n + p] = c * a_kp - s * a_kr;
+          a[k * n + r] = s * a_kp + c * a_kr;
+        }
+        for (std::size_t k = 0; k < n; ++k) {
+          auto const a_pk = a[p * n + k], a_rk = a[r * n + k];
+          a[p * n + k] = c * a_pk - s * a_rk;
+          a[r * n + k] = s * a_pk + c * a_rk;
+        }
+        /* Q <- Q J */
+        for (std::size_t k = 0; k < n; ++k) {
+          auto const q_kp = q[k * n + p], q_kr = q[k * n + r];
+          q[k * n + p] = c * q_kp - s * q_kr;
+          q[k * n + r] = s * q_kp + c * q_kr;
+        }
+      }
+    }
+  }
+
+  /* f(A) e_1 = Q f(Lambda) Q^T e_1 */
+  std::vector<double> res(n, 0.);
+  for (std::size_t l = 0; l < n; ++l) {
+    auto const w = f(a[l * n + l]) * q[0 * n + l];
+    for (std::size_t k = 0; k < n; ++k)
+      res[k] += q[k * n + l] * w;
+  }
+  return res;
+}
+
+/** Approximate <tt>M^(1/2) z</tt> for a symmetric positive definite
+ *  matrix @c M by the Lanczos method.
+ *
+ *  The vectors can be distributed over several nodes, in which case
+ *  @p dot has to return the global scalar product.
+ *
+ *  @param mat_vec   Product of @c M with a vector.
+ *  @param dot       Scalar product of two vectors.
+ *  @param z         Input vector.
+ *  @param tol       Relative change of the result at which the iteration
+ *                   stops.
+ *  @param max_iter  Maximal number of iterations.
+ */
+template <class MatVec, class Dot>
+std::vector<double> lanczos_sqrt(MatVec &&mat_vec, Dot &&dot,
+                                 std::vector<double> const &z, double tol,
+                                 std::size_t max_iter) {
+  auto const z_norm = std::sqrt(dot(z, z));
+  std::vector<double> y(z.size(), 0.);
+  if (z_norm == 0.)
+    return y;
+
+  std::vector<std::vector<double>> basis;
+  std::vector<double> alpha, beta;
+  basis.emplace_back(z);
+  for (auto &v : basis.back())
+    v /= z_norm;
+
+  auto sqrt_positive = [](double lambda) {
+    return std::sqrt(std::max(lambda, 0.));
+  };
+
+  for (std::size_t m = 1; m <= max_iter; ++m) {
+    auto const &v = basis.back();
+    auto w = mat_vec(v);
+    if (m > 1) {
+      auto const &v_prev = basis[m - 2];
+      for (std::size_t k = 0; k < w.size(); ++k)
+        w[k] -= beta.back() * v_prev[k];
+    }
+    alpha.push_back(dot(w, v));
+    for (std::size_t k = 0; k < w.size(); ++k)
+      w[k] -= alpha.back() * v[k];
+
+    /* y_m = |z| V_m T_m^(1/2) e_1 */
+    std::vector<double> t(m * m, 0.);
+    for (std::size_t i = 0; i < m; ++i) {
+      t[i * m + i] = alpha[i];
+      if (i + 1 < m)
+        t[i * m + i + 1] = t[(i + 1) * m + i] = beta[i];
+    }
+    auto const c = symmetric_function_e1(std::move(t), m, sqrt_positive);
+    std::vector<double> y_new(z.size(), 0.);
+    for (std::size_t i = 0; i < m; ++i)
+      for (std::size_t k = 0; k < z.size(); ++k)
+        y_new[k] += z_norm * c[i] * basis[i][k];
+
+    std::vector<double> diff(z.size());
+    for (std::size_t k = 0; k < z.size(); ++k)
+      diff[k] = y_new[k] - y[k];
+    y = std::move(y_new);
+
+    auto const w_norm = std::sqrt(dot(w, w));
+    if (m > 1 and dot(diff, diff) <= Utils::sqr(tol) * dot(y, y))
+      break;
+    if (w_norm <= 1e-14 * z_norm)
+      break;
+
+    beta.push_back(w_norm);
+    for (auto &w_k : w)
+      w_k /= w_norm;
+    basis.emplace_back(std::move(w));
+  }
+
+  return y;
+}
+
+} // namespace StokesianDynamics
+
+#endif
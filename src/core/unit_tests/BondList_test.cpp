@@ -25,10 +25,12 @@
 
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
+#include <boost/range/algorithm/equal.hpp>
 
 #include <array>
 #include <iterator>
 #include <sstream>
+#include <utility>
 
 BOOST_AUTO_TEST_CASE(BondView_) {
   /* Dummy values */
@@ -165,6 +167,37 @@ BOOST_AUTO_TEST_CASE(erase_) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(copy_move_) {
+  auto const partners = std::array<int, 2>{4, 5};
+
+  /* The bonds fit into the inline storage, or they do not */
+  for (int n_bonds : {1, 5}) {
+    BondList bl;
+    for (int i = 0; i < n_bonds; i++) {
+      bl.insert(BondView{i, partners});
+    }
+
+    /* BondList can be copied */
+    auto copy = bl;
+    BOOST_CHECK(boost::equal(copy, bl));
+
+    /* BondList can be move-constructed */
+    auto moved = std::move(copy);
+    BOOST_CHECK(boost::equal(moved, bl));
+
+    /* BondList can be move-assigned */
+    BondList assigned;
+    assigned.insert(BondView{7, partners});
+    assigned = std::move(moved);
+    BOOST_CHECK(boost::equal(assigned, bl));
+
+    /* BondList can be swapped */
+    BondList other;
+    swap(other, assigned);
+    BOOST_CHECK(boost::equal(other, bl));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(clear_) {
   auto const partners = std::array<int, 3>{1, 2, 3};
   auto const bond1 = BondView{1, partners};
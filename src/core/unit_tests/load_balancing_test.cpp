@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Load balancing test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "grid.hpp"
+#include "load_balancing.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+using namespace LoadBalancing;
+
+BOOST_AUTO_TEST_CASE(planes_decomposition_test) {
+  auto const eps = std::numeric_limits<double>::epsilon();
+
+  BoxGeometry box;
+  box.set_length({10., 20., 30.});
+  Utils::Vector3i const node_grid{1, 2, 3};
+
+  /* regular planes reproduce the regular decomposition */
+  auto const planes = regular_planes(box, node_grid);
+  for (int i = 0; i < 3; i++) {
+    BOOST_REQUIRE_EQUAL(planes[i].size(), node_grid[i] + 1);
+    BOOST_CHECK_EQUAL(planes[i].back(), box.length()[i]);
+  }
+
+  Utils::Vector3i const node_pos{0, 1, 1};
+  auto const expected = regular_decomposition(box, node_pos, node_grid);
+  auto const result = planes_decomposition(planes, node_pos);
+  BOOST_CHECK_SMALL((result.my_left() - expected.my_left()).norm(), eps);
+  BOOST_CHECK_SMALL((result.length() - expected.length()).norm(), 10. * eps);
+  for (int i = 0; i < 6; i++)
+    BOOST_CHECK_EQUAL(result.boundary()[i], expected.boundary()[i]);
+
+  /* shifted planes */
+  auto shifted = planes;
+  shifted[2] = {0., 5., 12., 30.};
+  auto const local_box = planes_decomposition(shifted, {0, 1, 2});
+  BOOST_CHECK_EQUAL(local_box.my_left()[2], 12.);
+  BOOST_CHECK_EQUAL(local_box.length()[2], 18.);
+  BOOST_CHECK_EQUAL(local_box.boundary()[4], 0);
+  BOOST_CHECK_EQUAL(local_box.boundary()[5], -1);
+}
+
+BOOST_AUTO_TEST_CASE(shift_planes_test) {
+  auto const tol = 1e-12;
+  std::vector<double> const planes = {0., 2., 4., 6., 8.};
+
+  /* balanced load: nothing moves */
+  {
+    auto const result = shift_planes(planes, {1., 1., 1., 1.}, 0.5, 1.);
+    for (std::size_t k = 0; k < planes.size(); k++)
+      BOOST_CHECK_SMALL(result[k] - planes[k], tol);
+  }
+
+  /* undamped: the new planes split the load in equal parts */
+  {
+    std::vector<double> const load = {6., 1., 1., 0.};
+    auto const result = shift_planes(planes, load, 0.5, 1.);
+    BOOST_CHECK_EQUAL(result.front(), 0.);
+    BOOST_CHECK_EQUAL(result.back(), 8.);
+    BOOST_CHECK_SMALL(result[1] - 2. / 3., tol);
+    BOOST_CHECK_SMALL(result[2] - 4. / 3., tol);
+    BOOST_CHECK_SMALL(result[3] - 2., tol);
+  }
+
+  /* damped: half of the way */
+  {
+    std::vector<double> const load = {6., 1., 1., 0.};
+    auto const result = shift_planes(planes, load, 0.5, 0.5);
+    BOOST_CHECK_SMALL(result[1] - (2. + 2. / 3.) / 2., tol);
+    BOOST_CHECK_SMALL(result[2] - (4. + 4. / 3.) / 2., tol);
+    BOOST_CHECK_SMALL(result[3] - 4., tol);
+  }
+
+  /* minimal width */
+  {
+    std::vector<double> const load = {100., 0., 0., 0.};
+    auto const result = shift_planes(planes, load, 1.5, 1.);
+    for (std::size_t k = 1; k < planes.size(); k++)
+      BOOST_CHECK_GE(result[k] - result[k - 1], 1.5 - tol);
+  }
+
+  /* no load */
+  {
+    auto const result = shift_planes(planes, {0., 0., 0., 0.}, 0.5, 1.);
+    BOOST_CHECK(result == planes);
+  }
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Stokesian dynamics RPY mobility test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "stokesian_dynamics/sd_rpy.hpp"
+
+#include <utils/Vector.hpp>
+#include <utils/constants.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace StokesianDynamics;
+
+namespace {
+double dot(std::vector<double> const &a, std::vector<double> const &b) {
+  return std::inner_product(a.begin(), a.end(), b.begin(), 0.);
+}
+
+/* Dense 6N x 6N mobility matrix, row-major */
+std::vector<double> mobility_matrix(std::vector<double> const &pos,
+                                    std::vector<double> const &radii,
+                                    double eta) {
+  auto const n = 6 * radii.size();
+  std::vector<double> m(n * n);
+  for (std::size_t j = 0; j < n; ++j) {
+    std::vector<double> e(n, 0.);
+    e[j] = 1.;
+    auto const col = rpy_mobility_product(pos, radii, e, 0, radii.size(),
+                                          eta, true, true);
+    for (std::size_t i = 0; i < n; ++i)
+      m[i * n + j] = col[i];
+  }
+  return m;
+}
+
+/* Column k of f(A) */
+template <class F>
+std::vector<double> function_column(std::vector<double> const &a,
+                                    std::size_t n, std::size_t k, F f) {
+  /* swap index 0 and k */
+  auto perm = [k](std::size_t i) { return i == 0 ? k : (i == k ? 0 : i); };
+  std::vector<double> b(n * n);
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      b[i * n + j] = a[perm(i) * n + perm(j)];
+  auto const c = symmetric_function_e1(b, n, f);
+  std::vector<double> res(n);
+  for (std::size_t i = 0; i < n; ++i)
+    res[perm(i)] = c[i];
+  return res;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(self_mobility) {
+  auto const eta = 2.4, a = 1.5;
+  Utils::Vector3d u{}, omega{};
+  rpy_self(a, eta, {1., 0., 0.}, {0., 0., 2.}, u, omega);
+  BOOST_CHECK_CLOSE(u[0], 1. / (6. * Utils::pi() * eta * a), 1e-12);
+  BOOST_CHECK_CLOSE(omega[2], 2. / (8. * Utils::pi() * eta * a * a * a),
+                    1e-12);
+  BOOST_CHECK_EQUAL(u[1], 0.);
+  BOOST_CHECK_EQUAL(omega[0], 0.);
+}
+
+BOOST_AUTO_TEST_CASE(continuity_at_contact) {
+  auto const eta = 1.3, a_i = 0.7, a_j = 1.9;
+  Utils::Vector3d const f{0.3, -1.1, 0.5}, t{1.2, 0.4, -0.8};
+  Utils::Vector3d const e = Utils::Vector3d{1., 2., -2.} / 3.;
+
+  for (auto const r : {a_i + a_j, a_j - a_i}) {
+    Utils::Vector3d u_in{}, w_in{}, u_out{}, w_out{};
+    rpy_pair((r - 1e-9) * e, a_i, a_j, eta, f, t, u_in, w_in);
+    rpy_pair((r + 1e-9) * e, a_i, a_j, eta, f, t, u_out, w_out);
+    BOOST_CHECK_SMALL((u_in - u_out).norm(), 1e-7);
+    if (r == a_i + a_j) {
+      BOOST_CHECK_SMALL((w_in - w_out).norm(), 1e-7);
+    }
+  }
+
+  /* concentric spheres move with the larger one */
+  Utils::Vector3d u{}, w{};
+  rpy_pair(Utils::Vector3d{}, a_i, a_j, eta, f, {}, u, w);
+  BOOST_CHECK_SMALL((u - f / (6. * Utils::pi() * eta * a_j)).norm(), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(mobility_matrix_symmetric_positive_definite) {
+  /* includes an overlapping pair of equal spheres */
+  std::vector<double> const pos = {0., 0., 0., 2.5, 0.3, -0.2,
+                                   0.4, 1.5, 0.1, -3., 1., 2.};
+  std::vector<double> const radii = {1., 1.4, 1., 0.6};
+  auto const n = 6 * radii.size();
+  auto const m = mobility_matrix(pos, radii, 0.8);
+
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < i; ++j)
+      BOOST_CHECK_SMALL(m[i * n + j] - m[j * n + i], 1e-12);
+
+  /* Cholesky decomposition succeeds */
+  auto l = m;
+  for (std::size_t j = 0; j < n; ++j) {
+    for (std::size_t k = 0; k < j; ++k)
+      l[j * n + j] -= l[j * n + k] * l[j * n + k];
+    BOOST_REQUIRE_GT(l[j * n + j], 0.);
+    l[j * n + j] = std::sqrt(l[j * n + j]);
+    for (std::size_t i = j + 1; i < n; ++i) {
+      for (std::size_t k = 0; k < j; ++k)
+        l[i * n + j] -= l[i * n + k] * l[j * n + k];
+      l[i * n + j] /= l[j * n + j];
+    }
+  }
+
+  /* rows can be evaluated in blocks */
+  std::vector<double> ft(n);
+  std::iota(ft.begin(), ft.end(), -3.);
+  auto const all = rpy_mobility_product(pos, radii, ft, 0, 4, 0.8, true,
+                                        true);
+  auto const block = rpy_mobility_product(pos, radii, ft, 1, 2, 0.8, true,
+                                          true);
+  for (std::size_t i = 0; i < block.size(); ++i)
+    BOOST_CHECK_EQUAL(block[i], all[6 + i]);
+}
+
+BOOST_AUTO_TEST_CASE(jacobi) {
+  std::vector<double> const a = {4., 1., 0., 1., 3., 0.5, 0., 0.5, 2.};
+  auto const identity = [](double x) { return x; };
+  auto const square = [](double x) { return x * x; };
+
+  auto const c1 = symmetric_function_e1(a, 3, identity);
+  for (std::size_t i = 0; i < 3; ++i)
+    BOOST_CHECK_SMALL(c1[i] - a[i * 3], 1e-12);
+
+  auto const c2 = symmetric_function_e1(a, 3, square);
+  for (std::size_t i = 0; i < 3; ++i) {
+    auto const a2 = a[i * 3] * a[0] + a[i * 3 + 1] * a[1] + a[i * 3 + 2] * a[2];
+    BOOST_CHECK_SMALL(c2[i] - a2, 1e-12);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(lanczos) {
+  std::vector<double> const pos = {0., 0., 0., 2.5, 0.3, -0.2,
+                                   0.4, 2.5, 0.1, -3., 1., 2.};
+  std::vector<double> const radii = {1., 1.4, 1., 0.6};
+  auto const n = 6 * radii.size();
+  auto const m = mobility_matrix(pos, radii, 0.8);
+
+  std::mt19937 gen(42);
+  std::normal_distribution<double> normal;
+  std::vector<double> z(n);
+  for (auto &z_i : z)
+    z_i = normal(gen);
+
+  auto const mat_vec = [&](std::vector<double> const &v) {
+    return rpy_mobility_product(pos, radii, v, 0, radii.size(), 0.8, true,
+                                true);
+  };
+  auto const y = lanczos_sqrt(mat_vec, dot, z, 1e-10, n);
+
+  /* exact M^(1/2) z */
+  auto const sqrt = [](double x) { return std::sqrt(x); };
+  std::vector<double> y_ref(n, 0.);
+  for (std::size_t k = 0; k < n; ++k) {
+    auto const col = function_column(m, n, k, sqrt);
+    for (std::size_t i = 0; i < n; ++i)
+      y_ref[i] += col[i] * z[k];
+  }
+
+  for (std::size_t i = 0; i < n; ++i)
+    BOOST_CHECK_SMALL(y[i] - y_ref[i], 1e-8 * std::sqrt(dot(y_ref, y_ref)));
+  BOOST_CHECK_CLOSE(dot(y, y), dot(z, mat_vec(z)), 1e-6);
+
+  /* zero input */
+  auto const y0 = lanczos_sqrt(mat_vec, dot, std::vector<double>(n), 1e-10, n);
+  BOOST_CHECK_EQUAL(dot(y0, y0), 0.);
+}
@@ -45,8 +45,26 @@ public:
    * @brief Update positions and velocities of virtual sites.
    */
   virtual void update() const {}
+  /**
+   * @brief Update positions and velocities of virtual sites in the
+   * integration loop, after the real particles were propagated and
+   * before the ghosts are updated.
+   *
+   * The particles have not been resorted since the last force
+   * calculation.
+   */
+  virtual void update_after_propagation() const { update(); }
+  /**
+   * @brief Update positions and velocities of virtual sites in the
+   * integration loop, after the ghosts were updated.
+   */
+  virtual void update_after_ghosts_update() const {}
   /** Back-transfer forces (and torques) to non-virtual particles. */
   virtual void back_transfer_forces_and_torques() const {}
+  /** Back-transfer forces (and torques) to non-virtual particles,
+   *  after the ghost forces were reduced.
+   */
+  virtual void back_transfer_reduced_forces_and_torques() const {}
   /** @brief Called after force calculation (and before rattle/shake) */
   virtual void after_force_calc(){};
   virtual void after_lb_propagation(){};
@@ -23,17 +23,31 @@
 
 #include "Particle.hpp"
 #include "cells.hpp"
+#include "communication.hpp"
+#include "event.hpp"
 #include "forces.hpp"
 #include "grid.hpp"
 #include "integrate.hpp"
 #include "rotation.hpp"
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 #include <utils/math/quaternion.hpp>
+#include <utils/math/rotation_matrix.hpp>
 #include <utils/math/sqr.hpp>
 #include <utils/math/tensor_product.hpp>
+#include <utils/mpi/all_gatherv.hpp>
 
+#include <boost/mpi/collectives/all_gather.hpp>
+#include <boost/mpi/collectives/all_reduce.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace {
 /**
@@ -146,11 +160,171 @@ auto constraint_stress(
    * real particle, hence the virial stress is */
   return tensor_product(connection_vector(p_ref, vs_rel), -f);
 }
+
+/**
+ * @brief Connection vector of a virtual site in the body frame
+ *        of the reference particle.
+ */
+Utils::Vector3d body_frame_connection_vector(
+    const ParticleProperties::VirtualSitesRelativeParameters &vs_rel) {
+  return vs_rel.distance *
+         Utils::convert_quaternion_to_director(vs_rel.rel_orientation)
+             .normalize();
+}
+
+/**
+ * @brief Rotation from the body frame of a particle to the space frame.
+ */
+Utils::Matrix<double, 3, 3> body_to_space(Particle const &p) {
+  return Utils::rotation_matrix(p.r.quat / p.r.quat.norm());
+}
+
+/**
+ * @brief Place the virtual sites of a rigid body.
+ *
+ * @param p_ref Copy of the reference particle on this node.
+ * @param sites Sites of the body.
+ * @param offsets Connection vectors of the sites in the body frame.
+ * @param have_quaternion Whether to update the orientation of the sites.
+ */
+void place_sites(Particle const &p_ref, Utils::Span<Particle *const> sites,
+                 Utils::Span<const Utils::Vector3d> offsets,
+                 bool have_quaternion) {
+  auto const rotation = body_to_space(p_ref);
+  auto const omega_space_frame = rotation * p_ref.m.omega;
+
+  for (std::size_t i = 0; i < sites.size(); i++) {
+    auto &p = *sites[i];
+    auto const d = rotation * offsets[i];
+
+    p.r.p += get_mi_vector(p_ref.r.p + d, p.r.p, box_geo);
+    p.m.v = vector_product(omega_space_frame, d) + p_ref.m.v;
+
+    if (have_quaternion)
+      p.r.quat = orientation(&p_ref, p.p.vs_relative);
+
+    if (!p.l.ghost and (p.r.p - p.l.p_old).norm2() > Utils::sqr(0.5 * skin))
+      cell_structure.set_resort_particles(Cells::RESORT_LOCAL);
+  }
+}
+
+/**
+ * @brief Transfer the forces on the virtual sites of a rigid body
+ *        to the reference particle.
+ *
+ * @param p_ref Copy of the reference particle on this node.
+ * @param sites Sites of the body.
+ * @param offsets Connection vectors of the sites in the body frame.
+ */
+void transfer_forces(Particle &p_ref, Utils::Span<Particle *const> sites,
+                     Utils::Span<const Utils::Vector3d> offsets) {
+  auto const rotation = body_to_space(p_ref);
+  ParticleForce force = {};
+
+  for (std::size_t i = 0; i < sites.size(); i++) {
+    auto const &f = sites[i]->f;
+    auto const d = rotation * offsets[i];
+    force += {f.f, vector_product(d, f.f) + f.torque};
+  }
+
+  p_ref.f += force;
+}
 } // namespace
 
+void VirtualSitesRelative::update_bodies() const {
+  /* Particles can be added or removed on a single node */
+  auto const stale = not m_bodies_valid or
+                     m_bodies_generation != cell_structure.storage_generation();
+  if (not boost::mpi::all_reduce(comm_cart, stale, std::logical_or<bool>()))
+    return;
+
+  /* Reference particle and site */
+  using Site = std::pair<Particle *, Particle *>;
+  std::vector<Site> local_sites, straddling_sites;
+  std::vector<int> straddling_ids;
+  bool fallback = m_extra_ghost_communication;
+  for (auto &p : cell_structure.local_particles()) {
+    if (!p.p.is_virtual)
+      continue;
+
+    auto const p_ref =
+        cell_structure.get_local_particle(p.p.vs_relative.to_particle_id);
+    if (!p_ref) {
+      fallback = true;
+    } else if (p_ref->l.ghost) {
+      straddling_sites.emplace_back(p_ref, &p);
+      straddling_ids.push_back(p.identity());
+    } else {
+      local_sites.emplace_back(p_ref, &p);
+    }
+  }
+
+  /* The ghost copies of the sites of straddling bodies are placed from
+   * the copy of the reference particle on the same node. */
+  std::vector<int> n_ids;
+  boost::mpi::all_gather(comm_cart, static_cast<int>(straddling_ids.size()),
+                         n_ids);
+  std::vector<int> all_ids(std::accumulate(n_ids.begin(), n_ids.end(), 0));
+  m_straddling = not all_ids.empty();
+  if (m_straddling) {
+    Utils::Mpi::all_gatherv(comm_cart, straddling_ids.data(),
+                            static_cast<int>(straddling_ids.size()),
+                            all_ids.data(), n_ids.data());
+    std::sort(all_ids.begin(), all_ids.end());
+    for (auto &p : cell_structure.ghost_particles()) {
+      if (!p.p.is_virtual or
+          !std::binary_search(all_ids.begin(), all_ids.end(), p.identity()))
+        continue;
+
+      auto const p_ref =
+          cell_structure.get_local_particle(p.p.vs_relative.to_particle_id);
+      if (!p_ref) {
+        fallback = true;
+        continue;
+      }
+      straddling_sites.emplace_back(p_ref, &p);
+    }
+  }
+
+  m_fallback =
+      boost::mpi::all_reduce(comm_cart, fallback, std::logical_or<bool>());
+  m_bodies_generation = cell_structure.storage_generation();
+  m_bodies_valid = true;
+
+  m_local_bodies.clear();
+  m_straddling_bodies.clear();
+  m_sites.clear();
+  m_offsets.clear();
+  if (m_fallback)
+    return;
+
+  auto const add_bodies = [this](std::vector<Site> &sites,
+                                 std::vector<RigidBody> &bodies) {
+    std::stable_sort(sites.begin(), sites.end(),
+                     [](Site const &a, Site const &b) {
+                       return std::less<Particle *>()(a.first, b.first);
+                     });
+    for (auto const &site : sites) {
+      if (bodies.empty() or bodies.back().p_ref != site.first) {
+        bodies.push_back({site.first, m_sites.size(), m_sites.size()});
+      }
+      m_sites.push_back(site.second);
+      m_offsets.push_back(
+          body_frame_connection_vector(site.second->p.vs_relative));
+      bodies.back().end = m_sites.size();
+    }
+  };
+  m_sites.reserve(local_sites.size() + straddling_sites.size());
+  m_offsets.reserve(m_sites.capacity());
+  add_bodies(local_sites, m_local_bodies);
+  add_bodies(straddling_sites, m_straddling_bodies);
+}
+
 void VirtualSitesRelative::update() const {
-  cell_structure.ghosts_update(Cells::DATA_PART_POSITION |
-                               Cells::DATA_PART_MOMENTUM);
+  /* Resort first if needed: adding particles or changing the particle
+   * decomposition, e.g. in every step of the NpT integrator, leaves the
+   * ghosts to the next resort. */
+  cells_update_ghosts(global_ghost_flags() | Cells::DATA_PART_MOMENTUM);
 
   for (auto &p : cell_structure.local_particles()) {
     if (!p.p.is_virtual)
@@ -174,9 +348,65 @@ void VirtualSitesRelative::update() const {
   } // namespace
 }
 
+void VirtualSitesRelative::update_after_propagation() const {
+  update_bodies();
+  if (m_fallback) {
+    update();
+    return;
+  }
+
+  /* The reference particles of these sites are local, so the sites
+   * can be placed without updating the ghosts first. */
+  for (auto const &body : m_local_bodies) {
+    place_sites(*body.p_ref, sites(body), offsets(body), get_have_quaternion());
+  }
+  m_straddling_pending = m_straddling;
+}
+
+void VirtualSitesRelative::update_after_ghosts_update() const {
+  if (not m_straddling_pending)
+    return;
+  m_straddling_pending = false;
+
+  /* The ghost update resorted the particles before the sites of the
+   * straddling bodies were placed. Resorts are collective, so this is
+   * the same on all nodes. */
+  if (m_bodies_generation != cell_structure.storage_generation()) {
+    update();
+    cells_update_ghosts(global_ghost_flags());
+    return;
+  }
+
+  if (!(global_ghost_flags() & Cells::DATA_PART_MOMENTUM))
+    cell_structure.ghosts_update(Cells::DATA_PART_MOMENTUM);
+
+  for (auto const &body : m_straddling_bodies) {
+    place_sites(*body.p_ref, sites(body), offsets(body), get_have_quaternion());
+  }
+
+  /* The local sites moved after the ghost update */
+  if (boost::mpi::all_reduce(comm_cart,
+                             cell_structure.get_resort_particles() !=
+                                 Cells::RESORT_NONE,
+                             std::logical_or<bool>()))
+    cells_update_ghosts(global_ghost_flags());
+}
+
 // Distribute forces that have accumulated on virtual particles to the
 // associated real particles
 void VirtualSitesRelative::back_transfer_forces_and_torques() const {
+  update_bodies();
+  if (not m_fallback) {
+    /* Every copy of the sites of a straddling body has a copy of the
+     * reference particle on the same node, so their forces can be
+     * transferred before the reduction of the ghost forces adds up the
+     * contributions of all copies. */
+    for (auto const &body : m_straddling_bodies) {
+      transfer_forces(*body.p_ref, sites(body), offsets(body));
+    }
+    return;
+  }
+
   cell_structure.ghosts_reduce_forces();
 
   init_forces_ghosts(cell_structure.ghost_particles());
@@ -194,6 +424,17 @@ void VirtualSitesRelative::back_transfer_forces_and_torques() const {
   }
 }
 
+void VirtualSitesRelative::back_transfer_reduced_forces_and_torques() const {
+  if (m_fallback)
+    return;
+
+  /* The reduction of the ghost forces added the forces on the ghost
+   * copies to the local sites, whose reference particles are local. */
+  for (auto const &body : m_local_bodies) {
+    transfer_forces(*body.p_ref, sites(body), offsets(body));
+  }
+}
+
 // Rigid body contribution to scalar pressure and pressure tensor
 Utils::Matrix<double, 3, 3> VirtualSitesRelative::pressure_tensor() const {
   Utils::Matrix<double, 3, 3> pressure_tensor = {};
@@ -25,18 +25,107 @@
 
 #include "VirtualSites.hpp"
 
+#include "Particle.hpp"
+
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 
-/** @brief Virtual sites implementation for rigid bodies */
+#include <cstddef>
+#include <vector>
+
+/** @brief Virtual sites implementation for rigid bodies
+ *
+ *  Between two resorts, the virtual sites on each node are kept grouped
+ *  by their reference particle, together with their connection vectors
+ *  in the body frame. The sites are updated from these body arrays
+ *  without ghost communication of their own:
+ *  - local sites with a local reference particle are placed before the
+ *    regular ghost update, which carries them to the ghosts. Their
+ *    forces are transferred to the reference particle after the
+ *    reduction of the ghost forces.
+ *  - sites with a ghost reference particle belong to a body that
+ *    straddles a node boundary. All copies of these sites, local and
+ *    ghost, are placed after the regular ghost update from the copy of
+ *    the reference particle on the same node, and their forces are
+ *    transferred to that copy before the reduction of the ghost forces.
+ *
+ *  If a copy of a site of a straddling body has no copy of its
+ *  reference particle on the same node, i.e. the reference particle is
+ *  out of the ghost range, the sites are updated with an extra ghost
+ *  update and force reduction instead.
+ */
 class VirtualSitesRelative : public VirtualSites {
 public:
   VirtualSitesRelative() = default;
   /** @copydoc VirtualSites::update */
   void update() const override;
+  /** @copydoc VirtualSites::update_after_propagation */
+  void update_after_propagation() const override;
+  /** @copydoc VirtualSites::update_after_ghosts_update */
+  void update_after_ghosts_update() const override;
   /** @copydoc VirtualSites::back_transfer_forces_and_torques */
   void back_transfer_forces_and_torques() const override;
+  /** @copydoc VirtualSites::back_transfer_reduced_forces_and_torques */
+  void back_transfer_reduced_forces_and_torques() const override;
   /** @copydoc VirtualSites::pressure_tensor */
   Utils::Matrix<double, 3, 3> pressure_tensor() const override;
+  /** @brief Always update the sites with the extra ghost update and
+   *  force reduction. Meant for testing.
+   */
+  void set_extra_ghost_communication(bool value) {
+    m_extra_ghost_communication = value;
+    m_bodies_valid = false;
+  }
+  bool get_extra_ghost_communication() const {
+    return m_extra_ghost_communication;
+  }
+
+private:
+  /** Sites of one rigid body on this node, in [begin, end) of
+   *  @ref m_sites.
+   */
+  struct RigidBody {
+    Particle *p_ref;
+    std::size_t begin, end;
+  };
+
+  /** @brief Group the virtual sites by their reference particle,
+   *  if the particle storage changed on any node since the last call.
+   *
+   *  Has to be called on all nodes.
+   */
+  void update_bodies() const;
+
+  Utils::Span<Particle *const> sites(RigidBody const &body) const {
+    return Utils::make_const_span(m_sites.data() + body.begin,
+                                  body.end - body.begin);
+  }
+  Utils::Span<const Utils::Vector3d> offsets(RigidBody const &body) const {
+    return Utils::make_const_span(m_offsets.data() + body.begin,
+                                  body.end - body.begin);
+  }
+
+  /** Local sites with a local reference particle */
+  mutable std::vector<RigidBody> m_local_bodies;
+  /** Local and ghost sites with a ghost reference particle on the node
+   *  of the local site
+   */
+  mutable std::vector<RigidBody> m_straddling_bodies;
+  mutable std::vector<Particle *> m_sites;
+  /** Connection vectors of @ref m_sites in the body frame */
+  mutable std::vector<Utils::Vector3d> m_offsets;
+  /** @ref CellStructure::storage_generation of the body arrays */
+  mutable std::size_t m_bodies_generation = 0;
+  mutable bool m_bodies_valid = false;
+  /** Whether there are straddling bodies on any node */
+  mutable bool m_straddling = false;
+  /** Whether the extra ghost communication is needed, see above */
+  mutable bool m_fallback = true;
+  bool m_extra_ghost_communication = false;
+  /** Whether the sites of the straddling bodies still have to be placed
+   *  after the ghost update
+   */
+  mutable bool m_straddling_pending = false;
 };
 
 #endif
@@ -31,6 +31,7 @@ cdef class Actor:
                        MagnetostaticInteraction=False,
                        MagnetostaticExtension=False,
                        HydrodynamicInteraction=False,
+                       ElectrokineticInteraction=False,
                        Scafacos=False)
 
     # __getstate__ and __setstate__ define the pickle interaction
@@ -211,8 +212,8 @@ class Actors:
 
         """
         if actor not in Actors.active_actors:
-            self.active_actors.append(actor)
             actor._activate()
+            self.active_actors.append(actor)
         else:
             raise ThereCanOnlyBeOne(actor)
 
@@ -231,8 +232,11 @@ class Actors:
 
     def clear(self):
         """Remove all actors."""
-        for a in self.active_actors:
-            self.remove(a)
+        # remove the actors in the reverse order of their insertion, since
+        # some of them depend on the ones added before (e.g. electrokinetics
+        # on the lattice-Boltzmann fluid)
+        while self.active_actors:
+            self.remove(self.active_actors[-1])
 
     def __str__(self):
         return str(self.active_actors)
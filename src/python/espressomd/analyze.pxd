@@ -41,6 +41,7 @@ cdef extern from "PartCfg.hpp":
 
 cdef extern from "partCfg_global.hpp":
     PartCfg & partCfg()
+    PartCfg & partCfgKinematics()
 
 cdef extern from "particle_data.hpp":
     int max_seen_particle_type
@@ -61,7 +62,7 @@ cdef extern from "Observable_stat.hpp":
         size_t chunk_size()
 
 cdef extern from "statistics.hpp":
-    cdef vector[double] calc_structurefactor(PartCfg & , const vector[int] & p_types, int order)
+    cdef vector[double] calc_structurefactor(const vector[int] & p_types, int order)
     cdef vector[vector[double]] modify_stucturefactor(int order, double * sf)
     cdef double mindist(PartCfg & , const vector[int] & set1, const vector[int] & set2)
     cdef vector[int] nbhood(PartCfg & , const Vector3d & pos, double r_catch, const Vector3i & planedims)
@@ -235,7 +235,7 @@ class Analysis:
         """
 
         if p1 == 'default' and p2 == 'default':
-            return analyze.mindist(analyze.partCfg(), [], [])
+            return analyze.mindist(analyze.partCfgKinematics(), [], [])
         elif p1 == 'default' or p2 == 'default':
             raise ValueError("Both p1 and p2 have to be specified")
         else:
@@ -249,7 +249,7 @@ class Analysis:
                     raise TypeError(
                         f"Particle types in p2 have to be of type int, got: {repr(p2[i])}")
 
-            return analyze.mindist(analyze.partCfg(), p1, p2)
+            return analyze.mindist(analyze.partCfgKinematics(), p1, p2)
 
     #
     # Analyze Linear Momentum
@@ -307,7 +307,7 @@ class Analysis:
         if p_type < 0 or p_type >= analyze.max_seen_particle_type:
             raise ValueError(f"Particle type {p_type} does not exist!")
 
-        return analyze.centerofmass(analyze.partCfg(), p_type)
+        return analyze.centerofmass(analyze.partCfgKinematics(), p_type)
 
     def nbhood(self, pos=None, r_catch=None, plane='3d'):
         """
@@ -354,7 +354,7 @@ class Analysis:
         for i in range(3):
             c_pos[i] = pos[i]
 
-        return analyze.nbhood(analyze.partCfg(), c_pos, r_catch, planedims)
+        return analyze.nbhood(analyze.partCfgKinematics(), c_pos, r_catch, planedims)
 
     def pressure(self):
         """Calculate the instantaneous pressure (in parallel). This is only
@@ -633,8 +633,7 @@ class Analysis:
         check_type_or_throw_except(
             sf_order, 1, int, "sf_order has to be an int!")
 
-        sf = analyze.calc_structurefactor(
-            analyze.partCfg(), sf_types, sf_order)
+        sf = analyze.calc_structurefactor(sf_types, sf_order)
 
         return np.transpose(analyze.modify_stucturefactor(sf_order, sf.data()))
 
@@ -699,7 +698,7 @@ class Analysis:
         distribution.resize(r_bins)
 
         analyze.calc_part_distribution(
-            analyze.partCfg(), type_list_a, type_list_b,
+            analyze.partCfgKinematics(), type_list_a, type_list_b,
             r_min, r_max, r_bins, < bint > log_flag, & low, distribution.data())
 
         np_distribution = create_nparray_from_double_array(
@@ -750,7 +749,7 @@ class Analysis:
             p_type, 1, int, "p_type has to be an int")
 
         cdef int p1 = p_type
-        cdef Vector3d res = analyze.angularmomentum(analyze.partCfg(), p1)
+        cdef Vector3d res = analyze.angularmomentum(analyze.partCfgKinematics(), p1)
 
         return np.array([res[0], res[1], res[2]])
 
@@ -845,7 +844,7 @@ class Analysis:
             raise ValueError(f"Particle type {p_type} does not exist!")
 
         analyze.momentofinertiamatrix(
-            analyze.partCfg(), p_type, MofImatrix)
+            analyze.partCfgKinematics(), p_type, MofImatrix)
 
         MofImatrix_np = np.empty((9))
         for i in range(9):
@@ -41,6 +41,14 @@ cdef extern from "cells.hpp":
     vector[int] mpi_resort_particles(int global_flag)
     void mpi_bcast_cell_structure(int cs)
     void mpi_set_use_verlet_lists(bool use_verlet_lists)
+    void mpi_set_cell_subdivision(int subdivision)
+    int cell_subdivision()
+    void mpi_set_sfc_order(bool sfc_order)
+    bool sfc_order()
+
+cdef extern from "load_balancing.hpp":
+    void mpi_set_load_balancing_interval(int interval)
+    int load_balancing_interval()
 
 cdef extern from "tuning.hpp":
     cdef void c_tune_skin "tune_skin" (double min_skin, double max_skin, double tol, int int_steps, bool adjust_max_skin)
@@ -29,7 +29,10 @@ from .utils import is_valid_type
 from .utils cimport Vector3i
 
 cdef class CellSystem:
-    def set_domain_decomposition(self, use_verlet_lists=True):
+    def set_domain_decomposition(self, use_verlet_lists=True,
+                                 load_balancing_interval=0,
+                                 cell_subdivision=1,
+                                 space_filling_curve=False):
         """
         Activates domain decomposition cell system.
 
@@ -38,9 +41,30 @@ cdef class CellSystem:
         use_verlet_lists : :obj:`bool`, optional
             Activates or deactivates the usage of Verlet lists
             in the algorithm.
+        load_balancing_interval : :obj:`int`, optional
+            Number of integration steps between two adjustments of the
+            subdomain boundaries to the measured force calculation time
+            of the nodes. ``0`` (default) keeps subdomains of equal size.
+        cell_subdivision : :obj:`int`, optional
+            Number of cells per interaction range. Cells of a half or a
+            third of the interaction range reduce the number of distances
+            to check, at the cost of a larger neighbor stencil.
+        space_filling_curve : :obj:`bool`, optional
+            Traverses the cells and stores the particles within the cells
+            in Morton order, which improves the memory locality of the
+            force calculation.
 
         """
+        if not is_valid_type(load_balancing_interval, int) \
+                or load_balancing_interval < 0:
+            raise ValueError(
+                "load_balancing_interval must be a non-negative integer")
+        if not is_valid_type(cell_subdivision, int) or cell_subdivision < 1:
+            raise ValueError("cell_subdivision must be a positive integer")
         mpi_set_use_verlet_lists(use_verlet_lists)
+        mpi_set_load_balancing_interval(load_balancing_interval)
+        mpi_set_cell_subdivision(cell_subdivision)
+        mpi_set_sfc_order(space_filling_curve)
         mpi_bcast_cell_structure(CELL_STRUCTURE_DOMDEC)
 
         handle_errors("Error while initializing the cell system.")
@@ -72,6 +96,9 @@ cdef class CellSystem:
                 [dd.cell_grid[0], dd.cell_grid[1], dd.cell_grid[2]])
             s["cell_size"] = np.array(
                 [dd.cell_size[0], dd.cell_size[1], dd.cell_size[2]])
+            s["load_balancing_interval"] = load_balancing_interval()
+            s["cell_subdivision"] = cell_subdivision()
+            s["space_filling_curve"] = sfc_order()
 
         if cell_structure.decomposition_type() == CELL_STRUCTURE_NSQUARE:
             s["type"] = "nsquare"
@@ -87,6 +114,9 @@ cdef class CellSystem:
         s = {"use_verlet_list": cell_structure.use_verlet_list}
 
         if cell_structure.decomposition_type() == CELL_STRUCTURE_DOMDEC:
+            s["load_balancing_interval"] = load_balancing_interval()
+            s["cell_subdivision"] = cell_subdivision()
+            s["space_filling_curve"] = sfc_order()
             s["type"] = "domain_decomposition"
         if cell_structure.decomposition_type() == CELL_STRUCTURE_NSQUARE:
             s["type"] = "nsquare"
@@ -97,13 +127,25 @@ cdef class CellSystem:
 
     def __setstate__(self, d):
         use_verlet_lists = None
+        load_balancing_interval = 0
+        cell_subdivision = 1
+        space_filling_curve = False
         for key in d:
             if key == "use_verlet_list":
                 use_verlet_lists = d[key]
+            elif key == "load_balancing_interval":
+                load_balancing_interval = d[key]
+            elif key == "cell_subdivision":
+                cell_subdivision = d[key]
+            elif key == "space_filling_curve":
+                space_filling_curve = d[key]
             elif key == "type":
                 if d[key] == "domain_decomposition":
                     self.set_domain_decomposition(
-                        use_verlet_lists=use_verlet_lists)
+                        use_verlet_lists=use_verlet_lists,
+                        load_balancing_interval=load_balancing_interval,
+                        cell_subdivision=cell_subdivision,
+                        space_filling_curve=space_filling_curve)
                 elif d[key] == "nsquare":
                     self.set_n_square(use_verlet_lists=use_verlet_lists)
         self.skin = d['skin']
@@ -16,6 +16,8 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 include "myconfig.pxi"
 from libcpp cimport bool
+from libcpp.vector cimport vector
+from .utils cimport Vector3i, Vector3d
 
 IF ELECTROKINETICS and CUDA:
     cdef extern from "grid_based_algorithms/electrokinetics.hpp":
@@ -121,3 +123,25 @@ IF ELECTROKINETICS and CUDA:
 
         int ek_set_electrostatics_coupling(bool electrostatics_coupling)
         int ek_print_vtk_particle_potential(char * filename)
+
+cdef extern from "grid_based_algorithms/electrokinetics_cpu.hpp":
+    cppclass EKCPUSpecies:
+        double density
+        double D
+        double valency
+        Vector3d ext_force_density
+
+    cppclass EKCPUParameters:
+        double T
+        double prefactor
+        bool advection
+        bool fluidcoupling_ideal_contribution
+        vector[EKCPUSpecies] species
+
+    void ek_cpu_init(const EKCPUParameters & params) except +
+    void ek_cpu_set_parameters(const EKCPUParameters & params) except +
+    const EKCPUParameters & ek_cpu_get_parameters()
+    void ek_cpu_deactivate()
+    double ek_cpu_get_node_density(int species, const Vector3i & ind) except +
+    void ek_cpu_set_node_density(int species, const Vector3i & ind, double density) except +
+    double ek_cpu_get_node_potential(const Vector3i & ind) except +
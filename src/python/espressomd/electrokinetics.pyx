@@ -22,11 +22,13 @@ IF CUDA:
     from .lb cimport lb_lbnode_is_index_valid
     from .lb cimport lb_lbfluid_set_lattice_switch
     from .lb cimport GPU
+from .actors cimport Actor
 from . import utils
 import tempfile
 import shutil
 from .utils import is_valid_type
-from .utils cimport Vector3i, Vector6d, handle_errors
+from .utils cimport Vector3i, Vector3d, Vector6d, handle_errors
+from .utils cimport make_Vector3d
 import numpy as np
 
 IF ELECTROKINETICS:
@@ -573,3 +575,136 @@ IF ELECTROKINETICS:
                     raise Exception("Species has not been added to EK.")
 
                 return np.array(flux[0], flux[1], flux[2])
+
+
+cdef class ElectrokineticInteraction(Actor):
+    """Base class of the electrokinetic methods on the CPU."""
+    pass
+
+
+cdef class ElectrokineticsCPU(ElectrokineticInteraction):
+    """
+    Creates the electrokinetic method on the lattice of the CPU
+    lattice-Boltzmann fluid, which has to be active.
+
+    Parameters
+    ----------
+    T : :obj:`float`
+        Thermal energy of the ions.
+    prefactor : :obj:`float`
+        Electrostatic prefactor, i.e. Bjerrum length times ``T``.
+    advection : :obj:`bool`, optional
+        Whether the species are advected with the fluid.
+    fluid_coupling : :obj:`str`, optional
+        ``"friction"`` couples the species to the fluid with the friction
+        force of their fluxes, ``"estatics"`` with the electrostatic and
+        external force density.
+    species : :obj:`list` of :obj:`dict`
+        Parameters of the species, with the keys ``"density"``, ``"D"``,
+        ``"valency"`` and the optional ``"ext_force_density"``.
+
+    """
+
+    def __getitem__(self, key):
+        if isinstance(key, (tuple, list, np.ndarray)) and len(key) == 3:
+            return ElectrokineticsCPURoutines(np.array(key))
+        raise ValueError(
+            f"{key} is not a valid key. Should be a point on the nodegrid e.g. ek[0,0,0].")
+
+    def validate_params(self):
+        if self._params["fluid_coupling"] not in ["friction", "estatics"]:
+            raise ValueError(
+                "fluid_coupling has to be 'friction' or 'estatics'.")
+        for species in self._params["species"]:
+            for k in ["density", "D", "valency"]:
+                if k not in species:
+                    raise ValueError(f"Species parameter {k} missing.")
+
+    def valid_keys(self):
+        return ["T", "prefactor", "advection", "fluid_coupling", "species"]
+
+    def required_keys(self):
+        return ["T", "prefactor", "species"]
+
+    def default_params(self):
+        return {"T": -1.,
+                "prefactor": -1.,
+                "advection": True,
+                "fluid_coupling": "friction",
+                "species": []}
+
+    cdef EKCPUParameters _core_params(self):
+        cdef EKCPUParameters params
+        cdef EKCPUSpecies species
+        params.T = self._params["T"]
+        params.prefactor = self._params["prefactor"]
+        params.advection = self._params["advection"]
+        params.fluidcoupling_ideal_contribution = \
+            self._params["fluid_coupling"] == "friction"
+        for s in self._params["species"]:
+            species.density = s["density"]
+            species.D = s["D"]
+            species.valency = s["valency"]
+            species.ext_force_density = make_Vector3d(
+                s.get("ext_force_density", [0., 0., 0.]))
+            params.species.push_back(species)
+        return params
+
+    def _get_params_from_es_core(self):
+        cdef EKCPUParameters params = ek_cpu_get_parameters()
+        if params.fluidcoupling_ideal_contribution:
+            fluid_coupling = "friction"
+        else:
+            fluid_coupling = "estatics"
+        species = []
+        for s in params.species:
+            species.append({"density": s.density,
+                            "D": s.D,
+                            "valency": s.valency,
+                            "ext_force_density": [s.ext_force_density[0],
+                                                  s.ext_force_density[1],
+                                                  s.ext_force_density[2]]})
+        return {"T": params.T,
+                "prefactor": params.prefactor,
+                "advection": params.advection,
+                "fluid_coupling": fluid_coupling,
+                "species": species}
+
+    def _set_params_in_es_core(self):
+        ek_cpu_set_parameters(self._core_params())
+
+    def _activate_method(self):
+        ek_cpu_init(self._core_params())
+
+    def _deactivate_method(self):
+        ek_cpu_deactivate()
+
+
+cdef class ElectrokineticsCPURoutines:
+    cdef Vector3i node
+
+    def __init__(self, key):
+        self.node[0] = key[0]
+        self.node[1] = key[1]
+        self.node[2] = key[2]
+
+    property potential:
+        def __get__(self):
+            return ek_cpu_get_node_potential(self.node)
+
+        def __set__(self, value):
+            raise Exception("Potential can not be set.")
+
+    property density:
+        def __get__(self):
+            n_species = ek_cpu_get_parameters().species.size()
+            return np.array([ek_cpu_get_node_density(i, self.node)
+                             for i in range(n_species)])
+
+        def __set__(self, value):
+            n_species = ek_cpu_get_parameters().species.size()
+            if len(value) != n_species:
+                raise ValueError(
+                    f"density has to be an array of length {n_species}.")
+            for i in range(n_species):
+                ek_cpu_set_node_density(i, self.node, value[i])
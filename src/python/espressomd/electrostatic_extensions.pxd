@@ -54,6 +54,7 @@ IF ELECTROSTATICS and P3M:
             vector[Vector3d] normals
             Vector3d ext_field
             double relax
+            int mixing_depth
             int citeration
             int first_id
 
@@ -167,6 +167,10 @@ IF ELECTROSTATICS and P3M:
             change of any of the interface particle's charge.
         relaxation : :obj:`float`, optional
             SOR relaxation parameter.
+        mixing_depth : :obj:`int`, optional
+            Number of previous iterates used to accelerate the relaxation
+            by Anderson mixing. With the default value 0, the plain relaxed
+            iteration is used.
         ext_field : :obj:`float`, optional
             Homogeneous electric field added to the calculation of dielectric boundary forces.
         max_iterations : :obj:`int`, optional
@@ -202,6 +206,11 @@ IF ELECTROSTATICS and P3M:
             check_range_or_except(
                 self._params, "relaxation", 0, False, "inf", True)
 
+            check_type_or_throw_except(
+                self._params["mixing_depth"], 1, int, "")
+            check_range_or_except(
+                self._params, "mixing_depth", 0, True, "inf", True)
+
             check_type_or_throw_except(
                 self._params["ext_field"], 3, float, "")
 
@@ -245,9 +254,10 @@ IF ELECTROSTATICS and P3M:
                 self._params["epsilons"] = np.zeros(n_icc)
 
         def valid_keys(self):
-            return ["n_icc", "convergence", "relaxation", "ext_field",
-                    "max_iterations", "first_id", "eps_out", "normals",
-                    "areas", "sigmas", "epsilons", "check_neutrality"]
+            return ["n_icc", "convergence", "relaxation", "mixing_depth",
+                    "ext_field", "max_iterations", "first_id", "eps_out",
+                    "normals", "areas", "sigmas", "epsilons",
+                    "check_neutrality"]
 
         def required_keys(self):
             return ["n_icc", "normals", "areas"]
@@ -256,6 +266,7 @@ IF ELECTROSTATICS and P3M:
             return {"n_icc": 0,
                     "convergence": 1e-3,
                     "relaxation": 0.7,
+                    "mixing_depth": 0,
                     "ext_field": [0, 0, 0],
                     "max_iterations": 100,
                     "first_id": 0,
@@ -293,6 +304,7 @@ IF ELECTROSTATICS and P3M:
             params["max_iterations"] = iccp3m_cfg.num_iteration
             params["convergence"] = iccp3m_cfg.convergence
             params["relaxation"] = iccp3m_cfg.relax
+            params["mixing_depth"] = iccp3m_cfg.mixing_depth
             params["eps_out"] = iccp3m_cfg.eout
 
             return params
@@ -320,6 +332,7 @@ IF ELECTROSTATICS and P3M:
             iccp3m_cfg.num_iteration = self._params["max_iterations"]
             iccp3m_cfg.convergence = self._params["convergence"]
             iccp3m_cfg.relax = self._params["relaxation"]
+            iccp3m_cfg.mixing_depth = self._params["mixing_depth"]
             iccp3m_cfg.eout = self._params["eps_out"]
 
             # Broadcasts vars
@@ -188,6 +188,8 @@ IF ELECTROSTATICS:
         int MMM1D_set_params(double switch_rad, double maxPWerror)
         void MMM1D_init()
         int MMM1D_sanity_checks()
+        bool mmm1d_near_series_tabulated()
+        bool mmm1d_far_series_tabulated()
         int mmm1d_tune(char ** log)
 
     cdef inline pyMMM1D_tune():
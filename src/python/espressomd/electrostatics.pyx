@@ -27,7 +27,7 @@ IF SCAFACOS == 1:
 from .utils cimport handle_errors
 from .utils import is_valid_type, check_type_or_throw_except, to_str
 from . cimport checks
-from .analyze cimport partCfg, PartCfg
+from .analyze cimport partCfgKinematics, PartCfg
 from .particle_data cimport particle
 
 
@@ -35,7 +35,7 @@ IF ELECTROSTATICS == 1:
     def check_neutrality(_params):
         if "check_neutrality" in _params:
             if(_params["check_neutrality"]):
-                if not checks.check_charge_neutrality[PartCfg](partCfg()):
+                if not checks.check_charge_neutrality[PartCfg](partCfgKinematics()):
                     raise Exception("""
                     The system is not charge neutral. Please
                     neutralize the system before adding a new actor by adding
@@ -548,6 +548,22 @@ IF ELECTROSTATICS:
             MMM1D_set_params(
                 self._params["far_switch_radius"], self._params["maxPWerror"])
 
+        def tabulated_series(self):
+            """
+            Which series are interpolated from tables instead of being
+            summed directly. Tables that would exceed the maximal size for
+            the requested ``maxPWerror`` fall back to the direct summation.
+
+            Returns
+            -------
+            :obj:`dict`
+                Whether the series of the ``'near'`` and the ``'far'``
+                formula are tabulated.
+
+            """
+            return {"near": mmm1d_near_series_tabulated(),
+                    "far": mmm1d_far_series_tabulated()}
+
         def _tune(self):
             cdef int resp
             resp = pyMMM1D_tune()
@@ -26,7 +26,10 @@ cdef extern from "config.hpp":
     pass
 
 cdef extern from "integrate.hpp" nogil:
-    cdef int python_integrate(int n_steps, cbool recalc_forces, int reuse_forces)
+    cdef int python_integrate(int n_steps, cbool recalc_forces, int reuse_forces,
+                              int fused_observables)
+    int FUSED_OBSERVABLES_ENERGY
+    int FUSED_OBSERVABLES_PRESSURE
     cdef int mpi_steepest_descent(int max_steps)
     cdef void integrate_set_sd()
     cdef void integrate_set_nvt()
@@ -35,6 +38,12 @@ cdef extern from "integrate.hpp" nogil:
     cdef extern cbool skin_set
     cdef extern cbool set_py_interrupt
     cdef void integrate_set_bd()
+    cdef int integrate_set_respa(int n_inner, unsigned inner_force_groups)
+
+cdef extern from "forces.hpp":
+    unsigned FORCE_GROUP_BONDED
+    unsigned FORCE_GROUP_SHORT_RANGE
+    unsigned FORCE_GROUP_LONG_RANGE
 
 IF NPT:
     cdef extern from "integrate.hpp" nogil:
@@ -59,8 +68,11 @@ IF STOKESIAN_DYNAMICS:
         SELF_MOBILITY = 1 << 0,
         PAIR_MOBILITY = 1 << 1,
         LUBRICATION = 1 << 2,
-        FTS = 1 << 3
+        FTS = 1 << 3,
+        RPY = 1 << 4
 
-cdef inline int _integrate(int nSteps, cbool recalc_forces, int reuse_forces):
+cdef inline int _integrate(int nSteps, cbool recalc_forces, int reuse_forces,
+                           int fused_observables):
     with nogil:
-        return python_integrate(nSteps, recalc_forces, reuse_forces)
+        return python_integrate(nSteps, recalc_forces, reuse_forces,
+                                fused_observables)
@@ -98,6 +98,14 @@ cdef class IntegratorHandle:
         """
         self._integrator = BrownianDynamics()
 
+    def set_vv_respa(self, *args, **kwargs):
+        """
+        Set the integration method to the reversible multiple time step
+        velocity Verlet integrator (:class:`VelocityVerletRESPA`).
+
+        """
+        self._integrator = VelocityVerletRESPA(*args, **kwargs)
+
     def set_stokesian_dynamics(self, *args, **kwargs):
         """
         Set the integration method to Stokesian Dynamics (:class:`StokesianDynamics`).
@@ -176,7 +184,8 @@ cdef class Integrator:
         raise Exception(
             "Subclasses of Integrator must define the required_keys() method.")
 
-    def run(self, steps=1, recalc_forces=False, reuse_forces=False):
+    def run(self, steps=1, recalc_forces=False, reuse_forces=False,
+            fused_observables=()):
         """
         Run the integrator.
 
@@ -188,6 +197,11 @@ cdef class Integrator:
             Recalculate the forces regardless of whether they are reusable.
         reuse_forces : :obj:`bool`, optional
             Reuse the forces from previous time step.
+        fused_observables : :obj:`list` of :obj:`str`, optional
+            Observables to accumulate in the force calculation of the steps
+            on which the auto-update accumulators sample, instead of
+            recomputing them afterwards. Valid entries are ``'energy'``
+            and ``'pressure'``.
 
         """
         check_type_or_throw_except(steps, 1, int, "steps must be an int")
@@ -197,7 +211,16 @@ cdef class Integrator:
         check_type_or_throw_except(
             reuse_forces, 1, bool, "reuse_forces has to be a bool")
 
-        _integrate(steps, recalc_forces, reuse_forces)
+        fused_flags = {'energy': integrate.FUSED_OBSERVABLES_ENERGY,
+                       'pressure': integrate.FUSED_OBSERVABLES_PRESSURE}
+        cdef int fused = 0
+        for name in fused_observables:
+            if name not in fused_flags:
+                raise ValueError(
+                    "fused_observables must be 'energy' or 'pressure'")
+            fused |= fused_flags[name]
+
+        _integrate(steps, recalc_forces, reuse_forces, fused)
 
         if integrate.set_py_interrupt:
             PyErr_SetInterrupt()
@@ -315,6 +338,65 @@ cdef class VelocityVerlet(Integrator):
         integrate_set_nvt()
 
 
+cdef class VelocityVerletRESPA(Integrator):
+    """
+    Reversible multiple time step velocity Verlet integrator (RESPA).
+
+    The forces on the inner level are integrated with ``n_inner`` velocity
+    Verlet steps of ``time_step / n_inner`` per time step, the remaining
+    forces act once per :attr:`~espressomd.system.System.time_step`.
+    Thermostats, external forces, constraints and the lattice-Boltzmann
+    coupling are always on the outer level.
+
+    Parameters
+    ----------
+    n_inner : :obj:`int`
+        Number of inner steps per time step.
+    inner_forces : :obj:`list` of :obj:`str`, optional
+        Force groups on the inner level. Valid entries are ``'bonded'``,
+        ``'short_range'`` (non-bonded, including the real-space parts of
+        the long range methods) and ``'long_range'`` (k-space parts of the
+        long range methods). Defaults to ``['bonded', 'short_range']``.
+
+    """
+
+    def default_params(self):
+        return {"inner_forces": ["bonded", "short_range"]}
+
+    def valid_keys(self):
+        """All parameters that can be set.
+
+        """
+        return {"n_inner", "inner_forces"}
+
+    def required_keys(self):
+        """Parameters that have to be set.
+
+        """
+        return {"n_inner"}
+
+    def validate_params(self):
+        check_type_or_throw_except(
+            self._params["n_inner"], 1, int, "n_inner must be an int")
+        if self._params["n_inner"] < 1:
+            raise ValueError("n_inner must be positive")
+        for name in self._params["inner_forces"]:
+            if name not in ("bonded", "short_range", "long_range"):
+                raise ValueError(
+                    "inner_forces must be 'bonded', 'short_range' or 'long_range'")
+
+    def _set_params_in_es_core(self):
+        force_groups = {"bonded": integrate.FORCE_GROUP_BONDED,
+                        "short_range": integrate.FORCE_GROUP_SHORT_RANGE,
+                        "long_range": integrate.FORCE_GROUP_LONG_RANGE}
+        cdef unsigned inner = 0
+        for name in self._params["inner_forces"]:
+            inner |= force_groups[name]
+        if integrate_set_respa(self._params["n_inner"], inner):
+            handle_errors(
+                "Encountered errors setting up the RESPA integrator")
+
+
 IF NPT:
     cdef class VelocityVerletIsotropicNPT(Integrator):
         """
@@ -417,9 +499,13 @@ IF STOKESIAN_DYNAMICS:
             Bulk viscosity.
         radii : :obj:`dict`
             Dictionary that maps particle types to radii.
-        approximation_method : :obj:`str`, optional, \{'ft', 'fts'\}
+        approximation_method : :obj:`str`, optional, \{'ft', 'fts', 'rpy'\}
             Chooses the method of the mobility approximation.
-            ``'fts'`` is more accurate. Default is ``'fts'``.
+            ``'fts'`` is more accurate. ``'rpy'`` uses the far-field
+            mobility at the force-torque level, evaluated in parallel on
+            all MPI ranks without storing the mobility matrix, which is
+            suited for large systems. ``'rpy'`` cannot be combined with
+            ``lubrication``. Default is ``'fts'``.
         self_mobility : :obj:`bool`, optional
             Switches off or on the mobility terms for single particles. Default
             is ``True``.
@@ -456,16 +542,19 @@ IF STOKESIAN_DYNAMICS:
             check_type_or_throw_except(
                 self._params["lubrication"], 1, bool,
                 "lubrication must be a bool")
-            if self._params["lubrication"]:
-                raise NotImplementedError(
-                    "Stokesian Dynamics lubrication is not available yet")
             check_type_or_throw_except(
                 self._params["approximation_method"], 1, str,
                 "approximation_method must be a string")
             if self._params["approximation_method"].lower() not in {
-                    "ft", "fts"}:
+                    "ft", "fts", "rpy"}:
                 raise ValueError(
-                    "approximation_method must be either 'ft' or 'fts'")
+                    "approximation_method must be either 'ft', 'fts' or 'rpy'")
+            if self._params["lubrication"]:
+                if self._params["approximation_method"].lower() == "rpy":
+                    raise ValueError(
+                        "lubrication is not available with approximation_method 'rpy'")
+                raise NotImplementedError(
+                    "Stokesian Dynamics lubrication is not available yet")
             check_type_or_throw_except(
                 self._params["self_mobility"], 1, bool,
                 "self_mobility must be a bool")
@@ -482,6 +571,8 @@ IF STOKESIAN_DYNAMICS:
                 fl = fl | flags.LUBRICATION
             if self._params["approximation_method"].lower() == "fts":
                 fl = fl | flags.FTS
+            elif self._params["approximation_method"].lower() == "rpy":
+                fl = fl | flags.RPY
             if self._params["self_mobility"]:
                 fl = fl | flags.SELF_MOBILITY
             if self._params["pair_mobility"]:
@@ -99,5 +99,63 @@ class Mpiio:
         self._instance.call_method(
             "read", prefix=prefix, pos=positions, vel=velocities, typ=types, bond=bonds)
 
+    def write_checkpoint(self, prefix=None, accumulators=()):
+        """Write a parallel checkpoint of the simulation state.
+
+        All MPI ranks collectively write the particles with all their
+        properties and bonds, the CPU LB fluid populations, the simulation
+        time, the RNG counters of the thermostats and the state of the
+        given accumulators to the following files:
+
+        - chk: Header with the global state and the accumulators,
+        - chk.part: Particle data in chunks of up to 4096 particles,
+        - chk.lb: LB populations (if a CPU LB fluid is active).
+
+        Interactions, constraints, the box geometry and the parameters of
+        the thermostats and actors are not part of the checkpoint, they can
+        be stored with :mod:`espressomd.checkpointing`. Existing files are
+        overwritten.
+
+        .. note::
+            Do not read the files on a machine with a different architecture!
+
+        Parameters
+        ----------
+        prefix : :obj:`str`
+            Common prefix for the filenames.
+        accumulators : list of accumulators, optional
+            Accumulators whose state is stored.
+
+        """
+        if prefix is None:
+            raise ValueError(
+                "Need to supply output prefix via the 'prefix' argument.")
+        self._instance.call_method(
+            "write_checkpoint", prefix=prefix, accumulators=list(accumulators))
+
+    def read_checkpoint(self, prefix=None, accumulators=()):
+        """Read a checkpoint written by :meth:`write_checkpoint`.
+
+        All existing particles are removed. The number of MPI ranks may
+        differ from the one at the time of writing. If the checkpoint
+        contains an LB fluid, a CPU LB fluid with the same grid has to be
+        active. The particle type maps used by the reaction methods are
+        not updated, call :meth:`espressomd.system.System.setup_type_map`
+        again if needed.
+
+        Parameters
+        ----------
+        prefix : :obj:`str`
+            Common prefix for the filenames.
+        accumulators : list of accumulators, optional
+            Accumulators to restore, in the same order as on writing.
+
+        """
+        if prefix is None:
+            raise ValueError(
+                "Need to supply output prefix via the 'prefix' argument.")
+        self._instance.call_method(
+            "read_checkpoint", prefix=prefix, accumulators=list(accumulators))
+
 
 mpiio = Mpiio()
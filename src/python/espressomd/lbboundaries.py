@@ -69,6 +69,38 @@ if any(has_features(i) for i in ["LB_BOUNDARIES", "LB_BOUNDARIES_GPU"]):
 
             self.call_method("clear")
 
+        def save_flags(self, filename):
+            """
+            Write the boundary flags of the lattice nodes to a file.
+
+            The flag of a node is the index of its boundary plus one,
+            or zero for fluid nodes.
+
+            Parameters
+            ----------
+            filename : :obj:`str`
+                Name of the file.
+
+            """
+            self.call_method("save_flags", filename=filename)
+
+        def load_flags(self, filename):
+            """
+            Read boundary flags written by :meth:`save_flags`.
+
+            The flags are used instead of the shapes of the boundaries
+            until a boundary is added or removed, or the lattice changes.
+            The boundaries have to be added in the same order as for
+            :meth:`save_flags`.
+
+            Parameters
+            ----------
+            filename : :obj:`str`
+                Name of the file.
+
+            """
+            self.call_method("load_flags", filename=filename)
+
         def size(self):
             return self.call_method("size")
 
@@ -28,7 +28,8 @@ IF DIPOLES == 1:
             DIPOLAR_ALL_WITH_ALL_AND_NO_REPLICA,
             DIPOLAR_DS,
             DIPOLAR_MDLC_DS,
-            DIPOLAR_SCAFACOS
+            DIPOLAR_SCAFACOS,
+            DIPOLAR_BH_CPU
 
         ctypedef struct Dipole_parameters:
             double prefactor
@@ -44,6 +45,8 @@ IF DIPOLES == 1:
         int dawaanr_set_params()
         int mdds_set_params(int n_cut)
         int Ncut_off_magnetic_dipolar_direct_sum
+        int bh_cpu_set_params(double theta)
+        double bh_cpu_theta
 
     IF(CUDA == 1) and (ROTATION == 1):
         cdef extern from "actor/DipolarDirectSum.hpp":
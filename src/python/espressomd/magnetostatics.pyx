@@ -312,6 +312,52 @@ IF DIPOLES == 1:
             handle_errors("Could not activate magnetostatics method "
                           + self.__class__.__name__)
 
+    cdef class DipolarBarnesHutCpu(MagnetostaticInteraction):
+        """
+        Calculate magnetostatic interactions with the Barnes-Hut octree
+        approximation. See :ref:`Barnes-Hut octree sum on CPU` for more
+        details.
+
+        The system must not be periodic.
+
+        Parameters
+        ----------
+        prefactor : :obj:`float`
+            Magnetostatics prefactor (:math:`\\mu_0/(4\\pi)`)
+        theta : :obj:`float`, optional
+            Opening angle. A cell of the octree is treated as a single
+            dipole if the ratio of its size to its distance from a
+            particle is smaller than ``theta``. ``theta=0`` yields the
+            exact direct sum. Default is 0.5.
+
+        """
+
+        def default_params(self):
+            return {"theta": 0.5}
+
+        def required_keys(self):
+            return ()
+
+        def valid_keys(self):
+            return ("prefactor", "theta")
+
+        def validate_params(self):
+            super().validate_params()
+            if not self._params["theta"] >= 0:
+                raise ValueError("theta should be a non-negative float")
+
+        def _get_params_from_es_core(self):
+            return {"prefactor": dipole.prefactor, "theta": bh_cpu_theta}
+
+        def _activate_method(self):
+            self._set_params_in_es_core()
+
+        def _set_params_in_es_core(self):
+            self.set_magnetostatics_prefactor()
+            bh_cpu_set_params(self._params["theta"])
+            handle_errors("Could not activate magnetostatics method "
+                          + self.__class__.__name__)
+
     IF SCAFACOS_DIPOLES == 1:
         class Scafacos(ScafacosConnector, MagnetostaticInteraction):
 
@@ -81,9 +81,24 @@ cdef extern from "particle_data.hpp":
     # Setter/getter/modifier functions functions
     void prefetch_particle_data(vector[int] ids)
 
+    cdef enum ParticleProperty:
+        PROPERTY_POS, \
+            PROPERTY_POS_FOLDED, \
+            PROPERTY_V, \
+            PROPERTY_F, \
+            PROPERTY_TYPE, \
+            PROPERTY_MOL_ID, \
+            PROPERTY_Q, \
+            PROPERTY_MASS
+
+    size_t property_dim(ParticleProperty property)
+    void mpi_get_particles_property(Span[const int] ids, ParticleProperty property, Span[double] out) except +
+
     int place_particle(int part, double p[3])
+    void place_particles(const vector[int] & ids, const vector[Vector3d] & pos) except +
 
     void set_particle_v(int part, double v[3])
+    void set_particles_v(const vector[int] & ids, const vector[Vector3d] & v) except +
 
     void set_particle_f(int part, const Vector3d & F)
 
@@ -92,6 +107,7 @@ cdef extern from "particle_data.hpp":
 
     IF MASS:
         void set_particle_mass(int part, double mass)
+        void set_particles_mass(const vector[int] & ids, const vector[double] & mass) except +
 
     IF ROTATIONAL_INERTIA:
         void set_particle_rotational_inertia(int part, double rinertia[3])
@@ -101,14 +117,17 @@ cdef extern from "particle_data.hpp":
         void set_particle_rotation(int part, int rot)
 
     void set_particle_q(int part, double q)
+    void set_particles_q(const vector[int] & ids, const vector[double] & q) except +
 
     IF LB_ELECTROHYDRODYNAMICS:
         void set_particle_mu_E(int part, const Vector3d & mu_E)
         void get_particle_mu_E(int part, Vector3d & mu_E)
 
     void set_particle_type(int part, int type)
+    void set_particles_type(const vector[int] & ids, const vector[int] & types) except +
 
     void set_particle_mol_id(int part, int mid)
+    void set_particles_mol_id(const vector[int] & ids, const vector[int] & mids) except +
 
     IF ROTATION:
         void set_particle_quat(int part, double quat[4])
@@ -30,7 +30,7 @@ import collections
 import functools
 from .utils import nesting_level, array_locked, is_valid_type
 from .utils cimport make_array_locked, make_const_span, check_type_or_throw_except
-from .utils cimport Vector3i, Vector3d, Vector4d
+from .utils cimport Vector3i, Vector3d, Vector4d, Span
 from .grid cimport box_geo, folded_position, unfolded_position
 
 
@@ -1597,11 +1597,7 @@ cdef class _ParticleSliceImpl:
         """
 
         def __get__(self):
-            pos_array = np.zeros((len(self.id_selection), 3))
-            for i in range(len(self.id_selection)):
-                pos_array[i, :] = ParticleHandle(
-                    self.id_selection[i]).pos_folded
-            return pos_array
+            return _get_particles_bulk(self.id_selection, "pos_folded")
 
     IF EXCLUSIONS:
         def add_exclusion(self, _partner):
@@ -1800,15 +1796,7 @@ cdef class ParticleList:
         else:
             return self._place_new_particle(P)
 
-    def _place_new_particle(self, P):
-        # Handling of particle id
-        if "id" not in P:
-            # Generate particle id
-            P["id"] = get_maximal_particle_id() + 1
-        else:
-            if particle_exists(P["id"]):
-                raise Exception(f"Particle {P['id']} already exists.")
-
+    def _check_contradicting_attributes(self, P):
         # Prevent setting of contradicting attributes
         IF DIPOLES:
             if 'dip' in P and 'dipm' in P:
@@ -1820,6 +1808,17 @@ dip is sufficient as the length of the vector defines the scalar dipole moment."
 Setting dip overwrites the rotation of the particle around the dipole axis. \
 Set quat and scalar dipole moment (dipm) instead.")
 
+    def _place_new_particle(self, P):
+        # Handling of particle id
+        if "id" not in P:
+            # Generate particle id
+            P["id"] = get_maximal_particle_id() + 1
+        else:
+            if particle_exists(P["id"]):
+                raise Exception(f"Particle {P['id']} already exists.")
+
+        self._check_contradicting_attributes(P)
+
         # The ParticleList[]-getter ist not valid yet, as the particle
         # doesn't yet exist. Hence, the setting of position has to be
         # done here. the code is from the pos:property of ParticleHandle
@@ -1854,12 +1853,23 @@ Set quat and scalar dipole moment (dipm) instead.")
             first_id = get_maximal_particle_id() + 1
             Ps["id"] = range(first_id, first_id + n_parts)
 
-        # Place the particles
-        for i in range(n_parts):
-            P = {}
-            for k in Ps:
-                P[k] = Ps[k][i]
-            self._place_new_particle(P)
+        for pid in Ps["id"]:
+            if particle_exists(pid):
+                raise Exception(f"Particle {pid} already exists.")
+        self._check_contradicting_attributes(Ps)
+
+        # Place the particles and set the properties which support it
+        # in bulk, the remaining ones particle by particle
+        ids = list(Ps["id"])
+        _set_particles_bulk(ids, "pos", Ps["pos"])
+        for k in Ps:
+            if k in ("id", "pos"):
+                continue
+            if k in _bulk_properties:
+                _set_particles_bulk(ids, k, Ps[k])
+            else:
+                for i, pid in enumerate(ids):
+                    setattr(ParticleHandle(pid), k, Ps[k][i])
 
         # Return slice of added particles
         return self[Ps["id"]]
@@ -2052,12 +2062,119 @@ Set quat and scalar dipole moment (dipm) instead.")
                 "select() takes either selection function as positional argument or a set of keyword arguments.")
 
 
+# Properties which can be set for many particles in a single scatter
+_bulk_properties = ["pos", "v", "type", "mol_id"]
+IF ELECTROSTATICS:
+    _bulk_properties.append("q")
+IF MASS:
+    _bulk_properties.append("mass")
+
+
+def _set_particles_bulk(ids, attribute, values):
+    """
+    Set a property from ``_bulk_properties`` for several particles at once,
+    with one value per particle. Particles which do not exist yet are
+    created when setting ``pos``.
+
+    """
+    cdef vector[int] c_ids = ids
+    cdef vector[Vector3d] c_vectors
+    cdef vector[double] c_doubles
+    cdef vector[int] c_ints
+    cdef size_t n = c_ids.size()
+    cdef size_t i
+    cdef int j
+
+    if attribute in ("pos", "v"):
+        values = np.asarray(values, dtype=float)
+        if values.shape != (n, 3):
+            raise ValueError(f"Expected {n} vectors of 3 floats for "
+                             f"{attribute}, got shape {values.shape}")
+        if attribute == "pos" and not np.isfinite(values).all():
+            raise ValueError("invalid particle position")
+        c_vectors.resize(n)
+        for i in range(n):
+            for j in range(3):
+                c_vectors[i][j] = values[i, j]
+        if attribute == "pos":
+            place_particles(c_ids, c_vectors)
+        else:
+            set_particles_v(c_ids, c_vectors)
+    elif attribute in ("type", "mol_id"):
+        values = np.asarray(values)
+        if values.shape != (n,) or (
+                n > 0 and (not np.issubdtype(values.dtype, np.integer)
+                           or (values < 0).any())):
+            raise ValueError(f"{attribute} must be an integer >= 0")
+        c_ints = values
+        if attribute == "type":
+            set_particles_type(c_ids, c_ints)
+        else:
+            set_particles_mol_id(c_ids, c_ints)
+    else:
+        values = np.asarray(values, dtype=float)
+        if values.shape != (n,):
+            raise ValueError(f"Expected {n} floats for {attribute}, got "
+                             f"shape {values.shape}")
+        c_doubles = values
+        IF ELECTROSTATICS:
+            if attribute == "q":
+                set_particles_q(c_ids, c_doubles)
+        IF MASS:
+            if attribute == "mass":
+                set_particles_mass(c_ids, c_doubles)
+
+
+# Properties which can be read for many particles in a single gather
+_bulk_getters = {"pos": PROPERTY_POS, "pos_folded": PROPERTY_POS_FOLDED,
+                 "v": PROPERTY_V, "f": PROPERTY_F, "type": PROPERTY_TYPE,
+                 "mol_id": PROPERTY_MOL_ID}
+IF ELECTROSTATICS:
+    _bulk_getters["q"] = PROPERTY_Q
+IF MASS:
+    _bulk_getters["mass"] = PROPERTY_MASS
+
+
+def _get_particles_bulk(ids, attribute):
+    """
+    Read a property from ``_bulk_getters`` for several particles at once.
+    The values are written by the core directly into the returned array,
+    in the order of ``ids``, with shape ``(len(ids), 3)`` for vectors and
+    ``(len(ids),)`` for scalars.
+
+    """
+    cdef np.ndarray[int, ndim=1] c_ids = np.ascontiguousarray(
+        ids, dtype=np.intc)
+    cdef ParticleProperty prop = <ParticleProperty > _bulk_getters[attribute]
+    cdef size_t n = c_ids.shape[0]
+    cdef size_t dim = property_dim(prop)
+    cdef np.ndarray[double, ndim=1] values = np.empty(n * dim)
+
+    if n > 0:
+        mpi_get_particles_property(make_const_span[int](& c_ids[0], n), prop,
+                                   Span[double](& values[0], n * dim))
+
+    if attribute in ("type", "mol_id"):
+        return values.astype(int)
+    if dim == 1:
+        return values
+    return values.reshape((n, dim))
+
+
 def set_slice_one_for_all(particle_slice, attribute, values):
+    if attribute in _bulk_properties:
+        n = len(particle_slice.id_selection)
+        _set_particles_bulk(particle_slice.id_selection, attribute,
+                            [values] * n)
+        return
     for i in particle_slice.id_selection:
         setattr(ParticleHandle(i), attribute, values)
 
 
 def set_slice_one_for_each(particle_slice, attribute, values):
+    if attribute in _bulk_properties:
+        _set_particles_bulk(particle_slice.id_selection, attribute, values)
+        return
     for i, v in zip(particle_slice.id_selection, values):
         setattr(ParticleHandle(i), attribute, v)
 
@@ -2158,6 +2275,9 @@ def _add_particle_slice_properties():
         if N == 0:
             return np.empty(0, dtype=type(None))
 
+        if attribute in _bulk_getters:
+            return _get_particles_bulk(particle_slice.id_selection, attribute)
+
         # get first slice member to determine its type
         target = getattr(ParticleHandle(
             particle_slice.id_selection[0]), attribute)
@@ -149,7 +149,7 @@ def linear_polymer_positions(**kwargs):
                 make_Vector3d(params["start_positions"][i]))
 
     data = draw_polymer_positions(
-        partCfg(),
+        partCfgKinematics(),
         params["n_polymers"],
         params["beads_per_chain"],
         params["bond_length"],
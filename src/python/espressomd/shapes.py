@@ -248,6 +248,39 @@ class HollowConicalFrustum(Shape, ScriptInterfaceHelper):
     _so_name = "Shapes::HollowConicalFrustum"
 
 
+@script_interface_register
+class SampledShape(Shape, ScriptInterfaceHelper):
+    """
+    A shape interpolated from a precomputed distance grid.
+
+    The distance and the distance vector of ``shape`` are sampled once on
+    a regular grid between ``lower`` and ``upper``, and trilinearly
+    interpolated inside of that box. Outside of the box, ``shape`` is
+    evaluated directly. Later changes of ``shape`` are not taken into
+    account.
+
+    Parameters
+    ----------
+    shape : :class:`espressomd.shapes.Shape`
+        Shape to sample.
+    lower : (3,) array_like of :obj:`float`
+        Lower corner of the sampled box.
+    upper : (3,) array_like of :obj:`float`
+        Upper corner of the sampled box.
+    spacing : :obj:`float`
+        Maximal grid spacing.
+    tolerance : :obj:`float`, optional
+        If given, raise an error if the interpolation error estimated
+        by :meth:`max_error` is larger. Negative values disable the check,
+        which is the default.
+
+    The parameters are read-only after the construction.
+
+    """
+    _so_name = "Shapes::SampledShape"
+    _so_bind_methods = ("max_error",)
+
+
 @script_interface_register
 class Union(Shape, ScriptObjectRegistry):
     """A union of shapes.
@@ -58,5 +58,13 @@ if has_features("VIRTUAL_SITES_RELATIVE"):
         """Virtual sites implementation placing virtual sites relative to other
         particles. See :ref:`Rigid arrangements of particles` for details.
 
+        Attributes
+        ----------
+        have_quaternion : :obj:`bool`
+            Whether the quaternion of the virtual sites is updated.
+        extra_ghost_communication : :obj:`bool`
+            Always update the virtual sites with an extra ghost update
+            and ghost force reduction. Meant for testing.
+
         """
         _so_name = "VirtualSites::VirtualSitesRelative"
@@ -33,6 +33,20 @@ struct Exception : public std::exception {
 private:
   std::string message;
 };
+
+/**
+ * @brief Call a core function that throws on all ranks.
+ *
+ * Errors thrown on all ranks are only recoverable on the worker nodes
+ * for @ref Exception, so runtime errors of @p f are rethrown as such.
+ */
+template <class F> auto collective_call(F &&f) -> decltype(f()) {
+  try {
+    return f();
+  } catch (std::runtime_error const &e) {
+    throw Exception(e.what());
+  }
+}
 } // namespace ScriptInterface
 
 #endif // ESPRESSO_EXCEPTIONS_HPP
@@ -137,7 +137,8 @@ public:
     }
   }
 
-  void do_set_parameter(const std::string &name, const Variant &value) final {
+  void do_set_parameter(const std::string &name,
+                        const Variant &value) override {
     try {
       m_parameters.at(name).set(value);
     } catch (AutoParameter::WriteError const &e) {
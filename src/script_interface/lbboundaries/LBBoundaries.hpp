@@ -24,14 +24,39 @@
 #include "LBBoundary.hpp"
 
 #include "core/grid_based_algorithms/lb_boundaries.hpp"
+#include "script_interface/Exception.hpp"
 #include "script_interface/ObjectList.hpp"
 #include "script_interface/ScriptInterface.hpp"
 
 #include <memory>
+#include <string>
 
 namespace ScriptInterface {
 namespace LBBoundaries {
 class LBBoundaries : public ObjectList<LBBoundary> {
+public:
+  Variant do_call_method(std::string const &method,
+                         VariantMap const &parameters) override {
+#if defined(LB_BOUNDARIES) || defined(LB_BOUNDARIES_GPU)
+    if (method == "save_flags") {
+      collective_call([&parameters]() {
+        ::LBBoundaries::save_boundary_flags(
+            get_value<std::string>(parameters, "filename"));
+      });
+      return none;
+    }
+    if (method == "load_flags") {
+      collective_call([&parameters]() {
+        ::LBBoundaries::load_boundary_flags(
+            get_value<std::string>(parameters, "filename"));
+      });
+      return none;
+    }
+#endif
+    return ObjectList<LBBoundary>::do_call_method(method, parameters);
+  }
+
+private:
   void add_in_core(std::shared_ptr<LBBoundary> const &obj_ptr) override {
 #if defined(LB_BOUNDARIES) || defined(LB_BOUNDARIES_GPU)
     ::LBBoundaries::add(obj_ptr->lbboundary());
@@ -51,7 +51,7 @@ public:
             };
           },
           [this]() { return m_shape; }}});
-#ifdef EK_BOUNDARIES
+#if defined(EK_BOUNDARIES) || defined(LB_BOUNDARIES)
     add_parameters({{"charge_density",
                      [this](Variant const &value) {
                        m_lbboundary->set_charge_density(
@@ -23,12 +23,18 @@
 #define ESPRESSO_SCRIPTINTERFACE_MPIIO_HPP
 
 #include "config.hpp"
+#include "io/mpiio/checkpoint.hpp"
 #include "io/mpiio/mpiio.hpp"
+#include "script_interface/Exception.hpp"
 #include "script_interface/ScriptInterface.hpp"
+#include "script_interface/accumulators/AccumulatorBase.hpp"
 #include "script_interface/auto_parameters/AutoParameters.hpp"
 #include "script_interface/get_value.hpp"
 #include <core/cells.hpp>
 
+#include <string>
+#include <vector>
+
 #define field_value(use, v) ((use) ? (v) : 0u)
 
 namespace ScriptInterface {
@@ -41,6 +47,24 @@ public:
   Variant do_call_method(const std::string &name,
                          const VariantMap &parameters) override {
 
+    if (name == "write_checkpoint" or name == "read_checkpoint") {
+      auto const prefix = get_value<std::string>(parameters.at("prefix"));
+      Mpiio::AccumulatorList accumulators;
+      for (auto const &v :
+           get_value<std::vector<Variant>>(parameters.at("accumulators"))) {
+        accumulators.emplace_back(
+            get_value<std::shared_ptr<Accumulators::AccumulatorBase>>(v)
+                ->accumulator());
+      }
+      collective_call([&]() {
+        if (name == "write_checkpoint")
+          Mpiio::mpi_mpiio_checkpoint_write(prefix, accumulators);
+        else
+          Mpiio::mpi_mpiio_checkpoint_read(prefix, accumulators);
+      });
+      return {};
+    }
+
     auto pref = get_value<std::string>(parameters.at("prefix"));
     auto pos = get_value<bool>(parameters.at("pos"));
     auto vel = get_value<bool>(parameters.at("vel"));
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCRIPT_INTERFACE_SHAPES_SAMPLED_SHAPE_HPP
+#define SCRIPT_INTERFACE_SHAPES_SAMPLED_SHAPE_HPP
+
+#include "Shape.hpp"
+
+#include <shapes/SampledShape.hpp>
+
+#include <utils/Vector.hpp>
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace ScriptInterface {
+namespace Shapes {
+
+class SampledShape : public Shape {
+public:
+  SampledShape() {
+    add_parameters(
+        {{"shape", AutoParameter::read_only, [this]() { return m_shape; }},
+         {"lower", AutoParameter::read_only, [this]() { return m_lower; }},
+         {"upper", AutoParameter::read_only, [this]() { return m_upper; }},
+         {"spacing", AutoParameter::read_only, [this]() { return m_spacing; }},
+         {"tolerance", AutoParameter::read_only,
+          [this]() { return m_tolerance; }}});
+  }
+
+  void do_construct(VariantMap const &params) override {
+    m_shape = get_value<std::shared_ptr<Shape>>(params, "shape");
+    m_lower = get_value<Utils::Vector3d>(params, "lower");
+    m_upper = get_value<Utils::Vector3d>(params, "upper");
+    m_spacing = get_value<double>(params, "spacing");
+    m_tolerance = get_value_or<double>(params, "tolerance", -1.);
+    m_sampled_shape = std::make_shared<::Shapes::SampledShape>(
+        m_shape->shape(), m_lower, m_upper, m_spacing);
+
+    if (m_tolerance >= 0.) {
+      auto const error = m_sampled_shape->max_error();
+      if (error > m_tolerance) {
+        std::stringstream msg;
+        msg << "Interpolation error " << error << " exceeds the tolerance "
+            << m_tolerance << ", decrease the grid spacing.";
+        throw std::runtime_error(msg.str());
+      }
+    }
+  }
+
+  Variant do_call_method(std::string const &name,
+                         VariantMap const &params) override {
+    if (name == "max_error") {
+      return m_sampled_shape->max_error();
+    }
+    return Shape::do_call_method(name, params);
+  }
+
+  std::shared_ptr<::Shapes::Shape> shape() const override {
+    return m_sampled_shape;
+  }
+
+private:
+  std::shared_ptr<Shape> m_shape;
+  Utils::Vector3d m_lower;
+  Utils::Vector3d m_upper;
+  double m_spacing;
+  double m_tolerance;
+  std::shared_ptr<::Shapes::SampledShape> m_sampled_shape;
+};
+
+} /* namespace Shapes */
+} /* namespace ScriptInterface */
+
+#endif
@@ -53,6 +53,13 @@ public:
 
     return {};
   }
+
+protected:
+  void do_set_parameter(const std::string &name,
+                        const Variant &value) override {
+    AutoParameters<Shape>::do_set_parameter(name, value);
+    ::Shapes::notify_parameter_change();
+  }
 };
 
 } /* namespace Shapes */
@@ -22,6 +22,7 @@
 #include "HollowConicalFrustum.hpp"
 #include "NoWhere.hpp"
 #include "Rhomboid.hpp"
+#include "SampledShape.hpp"
 #include "SimplePore.hpp"
 #include "Slitpore.hpp"
 #include "Sphere.hpp"
@@ -47,6 +48,7 @@ void initialize(Utils::Factory<ObjectHandle> *f) {
   f->register_new<Slitpore>("Shapes::Slitpore");
   f->register_new<SimplePore>("Shapes::SimplePore");
   f->register_new<Torus>("Shapes::Torus");
+  f->register_new<SampledShape>("Shapes::SampledShape");
 }
 } /* namespace Shapes */
 } /* namespace ScriptInterface */
@@ -32,7 +32,16 @@ namespace VirtualSites {
 
 class VirtualSitesRelative : public VirtualSites {
 public:
-  VirtualSitesRelative() : m_virtual_sites(new ::VirtualSitesRelative()){};
+  VirtualSitesRelative() : m_virtual_sites(new ::VirtualSitesRelative()) {
+    add_parameters({{"extra_ghost_communication",
+                     [this](const Variant &v) {
+                       m_virtual_sites->set_extra_ghost_communication(
+                           get_value<bool>(v));
+                     },
+                     [this]() {
+                       return m_virtual_sites->get_extra_ghost_communication();
+                     }}});
+  };
   /** Vs implementation we are wrapping */
   std::shared_ptr<::VirtualSites> virtual_sites() override {
     return m_virtual_sites;
@@ -26,6 +26,8 @@
 
 #include <utils/Vector.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 namespace Shapes {
@@ -104,6 +106,17 @@ public:
 
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
+
+  std::pair<Utils::Vector3d, Utils::Vector3d> bounding_box() const override {
+    if (m_direction < 0)
+      return Shape::bounding_box();
+    Utils::Vector3d extent;
+    for (int i = 0; i < 3; ++i) {
+      extent[i] = m_half_length * std::abs(e_z[i]) +
+                  m_rad * std::sqrt(std::max(0., 1. - e_z[i] * e_z[i]));
+    }
+    return {m_center - extent, m_center + extent};
+  }
 };
 } // namespace Shapes
 #endif
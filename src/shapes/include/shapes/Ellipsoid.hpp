@@ -26,6 +26,8 @@
 #include <utils/Array.hpp>
 #include <utils/Vector.hpp>
 
+#include <utility>
+
 namespace Shapes {
 class Ellipsoid : public Shape {
 public:
@@ -36,6 +38,12 @@ public:
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
 
+  std::pair<Utils::Vector3d, Utils::Vector3d> bounding_box() const override {
+    if (m_direction < 0)
+      return Shape::bounding_box();
+    return {m_center - m_semiaxes, m_center + m_semiaxes};
+  }
+
   void set_semiaxis_a(const double &value) { m_semiaxes[0] = value; }
   void set_semiaxis_b(const double &value) {
     m_semiaxes[1] = value;
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHAPES_SAMPLED_SHAPE_HPP
+#define SHAPES_SAMPLED_SHAPE_HPP
+
+#include "Shape.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Shapes {
+/**
+ * @brief Shape interpolated from a precomputed distance grid.
+ *
+ * The signed distance and the distance vector of another shape are
+ * sampled once on a regular grid covering a box, and trilinearly
+ * interpolated inside of that box. Outside of the box, the sampled
+ * shape is evaluated directly. Changes of the sampled shape after the
+ * construction are not taken into account.
+ */
+class SampledShape : public Shape {
+public:
+  /**
+   * @param shape   Shape to sample.
+   * @param lower   Lower corner of the sampled box.
+   * @param upper   Upper corner of the sampled box.
+   * @param spacing Maximal grid spacing. The spacing is reduced
+   *                such that the grid fits the box.
+   */
+  SampledShape(std::shared_ptr<Shape> shape, Utils::Vector3d const &lower,
+               Utils::Vector3d const &upper, double spacing);
+
+  void calculate_dist(Utils::Vector3d const &pos, double &dist,
+                      Utils::Vector3d &vec) const override;
+
+  /* Interpolated distances mix in the distances of the grid nodes of a
+   * cell, which can be closer to the shape by up to the cell diagonal. */
+  std::pair<Utils::Vector3d, Utils::Vector3d> bounding_box() const override {
+    auto box = m_shape->bounding_box();
+    box.first -= Utils::Vector3d::broadcast(m_spacing.norm());
+    box.second += Utils::Vector3d::broadcast(m_spacing.norm());
+    return box;
+  }
+
+  /**
+   * @brief Largest deviation of the interpolated distance from the
+   * sampled shape, estimated at the centers of the grid cells.
+   */
+  double max_error() const;
+
+  Shape const &shape() const { return *m_shape; }
+  Utils::Vector3i const &grid_size() const { return m_grid_size; }
+  Utils::Vector3d const &spacing() const { return m_spacing; }
+
+private:
+  std::shared_ptr<Shape> m_shape;
+  Utils::Vector3d m_lower;
+  Utils::Vector3d m_spacing;
+  /** Number of grid nodes per direction. */
+  Utils::Vector3i m_grid_size;
+  /** Distance and distance vector per node. */
+  std::vector<double> m_data;
+};
+} // namespace Shapes
+
+#endif
@@ -24,6 +24,9 @@
 
 #include <utils/Vector.hpp>
 
+#include <limits>
+#include <utility>
+
 namespace Shapes {
 
 class Shape {
@@ -36,9 +39,34 @@ public:
     calculate_dist(pos, dist, vec);
     return dist > 0.0;
   }
+  /**
+   * @brief Axis-aligned box containing the shape.
+   *
+   * All points outside of the box have a positive distance to the
+   * shape, which is at least the distance to the box. Shapes for
+   * which no such box exists (e.g. walls or shapes with inverted
+   * direction) return an infinite box.
+   *
+   * @return Lower and upper corner of the box.
+   */
+  virtual std::pair<Utils::Vector3d, Utils::Vector3d> bounding_box() const {
+    auto const inf = std::numeric_limits<double>::infinity();
+    return {Utils::Vector3d::broadcast(-inf), Utils::Vector3d::broadcast(inf)};
+  }
   virtual ~Shape() = default;
 };
 
+/**
+ * @brief Signal that the parameters of a shape changed.
+ *
+ * Shapes which cache properties of other shapes, such as the bounding
+ * volume hierarchy of @ref Union, check them before their next use.
+ */
+void notify_parameter_change();
+
+/** @brief Number of calls of @ref notify_parameter_change. */
+unsigned long parameter_change_count();
+
 } /* namespace Shapes */
 
 #endif
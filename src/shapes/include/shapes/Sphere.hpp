@@ -25,6 +25,8 @@
 #include "Shape.hpp"
 #include <utils/Vector.hpp>
 
+#include <utility>
+
 namespace Shapes {
 class Sphere : public Shape {
 public:
@@ -33,6 +35,13 @@ public:
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
 
+  std::pair<Utils::Vector3d, Utils::Vector3d> bounding_box() const override {
+    if (m_direction < 0)
+      return Shape::bounding_box();
+    auto const extent = Utils::Vector3d::broadcast(m_rad);
+    return {m_pos - extent, m_pos + extent};
+  }
+
   Utils::Vector3d &pos() { return m_pos; }
   double &rad() { return m_rad; }
   double &direction() { return m_direction; }
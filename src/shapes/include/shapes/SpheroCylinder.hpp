@@ -25,6 +25,9 @@
 #include "Shape.hpp"
 #include <utils/Vector.hpp>
 
+#include <cmath>
+#include <utility>
+
 namespace Shapes {
 class SpheroCylinder : public Shape {
 public:
@@ -96,6 +99,16 @@ public:
 
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
+
+  std::pair<Utils::Vector3d, Utils::Vector3d> bounding_box() const override {
+    if (m_direction < 0)
+      return Shape::bounding_box();
+    Utils::Vector3d extent;
+    for (int i = 0; i < 3; ++i) {
+      extent[i] = m_half_length * std::abs(e_z[i]) + m_rad;
+    }
+    return {m_center - extent, m_center + extent};
+  }
 };
 } // namespace Shapes
 
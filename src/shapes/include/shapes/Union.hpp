@@ -22,50 +22,64 @@
 
 #include <boost/algorithm/cxx11/all_of.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "Shape.hpp"
 
 namespace Shapes {
 
+/**
+ * @brief Union of shapes.
+ *
+ * The members with a finite bounding box are organized in a bounding
+ * volume hierarchy, which is built from their boxes whenever a shape is
+ * added or removed. After a call of @ref notify_parameter_change, the
+ * boxes are compared before the next distance calculation, and the
+ * hierarchy is rebuilt if a member changed.
+ */
 class Union : public Shape {
 public:
   void add(std::shared_ptr<Shapes::Shape> const &s) {
     m_shapes.emplace_back(s);
+    build_bvh();
   }
 
   void remove(std::shared_ptr<Shapes::Shape> const &s) {
     m_shapes.erase(std::remove(m_shapes.begin(), m_shapes.end(), s),
                    m_shapes.end());
+    build_bvh();
   }
 
   /**
    * @brief Calculates the minimum of all distances and the corresponding
    * distance vector for a given position and any contained shape.
+   *
+   * Subtrees of the bounding volume hierarchy which are farther away
+   * than the closest shape found so far are skipped.
+   *
    * @param[in] pos Position for which to calculate the distance.
    * @param[out] dist Minimum distance between pos and any contained shape.
    * @param[out] vec Distance vector.
    */
   void calculate_dist(Utils::Vector3d const &pos, double &dist,
-                      Utils::Vector3d &vec) const override {
-    auto dist_compare = [&pos](std::pair<double, Utils::Vector3d> const &res,
-                               std::shared_ptr<Shapes::Shape> const &s) {
-      double d;
-      Utils::Vector3d vec;
-      (*s).calculate_dist(pos, d, vec);
-      if (d < 0.0)
-        throw std::domain_error(
-            "Distance to Union not well-defined for given position!");
-      if (d < res.first) {
-        return std::make_pair(d, vec);
+                      Utils::Vector3d &vec) const override;
+
+  std::pair<Utils::Vector3d, Utils::Vector3d> bounding_box() const override {
+    auto const inf = std::numeric_limits<double>::infinity();
+    auto lower = Utils::Vector3d::broadcast(inf);
+    auto upper = Utils::Vector3d::broadcast(-inf);
+    for (auto const &s : m_shapes) {
+      auto const box = s->bounding_box();
+      for (int i = 0; i < 3; ++i) {
+        lower[i] = std::min(lower[i], box.first[i]);
+        upper[i] = std::max(upper[i], box.second[i]);
       }
-      return res;
-    };
-    std::tie(dist, vec) =
-        std::accumulate(m_shapes.begin(), m_shapes.end(),
-                        std::make_pair(std::numeric_limits<double>::infinity(),
-                                       Utils::Vector3d{}),
-                        dist_compare);
+    }
+    return {lower, upper};
   }
 
   bool is_inside(Utils::Vector3d const &pos) const override {
@@ -74,7 +88,38 @@ public:
   }
 
 private:
+  using box_type = std::pair<Utils::Vector3d, Utils::Vector3d>;
+
+  struct BVHNode {
+    box_type box;
+    /** Range of @ref m_bvh_shapes in this subtree. */
+    int begin;
+    int end;
+    /** Child nodes, -1 for leaves. */
+    int left = -1;
+    int right = -1;
+  };
+
+  /** Maximal number of shapes in a leaf of the hierarchy. */
+  static constexpr int bvh_leaf_size = 4;
+
+  void build_bvh() const;
+  int build_bvh_node(int begin, int end) const;
+  /** Rebuild the hierarchy if a member changed since the last build. */
+  void update_bvh() const;
+
   std::vector<std::shared_ptr<Shapes::Shape>> m_shapes;
+  /* The hierarchy is a cache, which is updated in the const queries. */
+  /** Value of @ref parameter_change_count at the last check. */
+  mutable unsigned long m_change_count = 0;
+  /** Bounding boxes of the shapes, at the time of the last build. */
+  mutable std::vector<box_type> m_boxes;
+  /** Indices of the shapes without a finite bounding box. */
+  mutable std::vector<int> m_unbounded;
+  /** Indices of the shapes in the hierarchy, ordered by subtree. */
+  mutable std::vector<int> m_bvh_shapes;
+  /** Nodes of the hierarchy, the root is the first node. */
+  mutable std::vector<BVHNode> m_bvh_nodes;
 };
 
 } // namespace Shapes
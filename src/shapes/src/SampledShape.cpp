@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <shapes/SampledShape.hpp>
+
+#include <utils/Vector.hpp>
+#include <utils/index.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace Shapes {
+SampledShape::SampledShape(std::shared_ptr<Shape> shape,
+                           Utils::Vector3d const &lower,
+                           Utils::Vector3d const &upper, double spacing)
+    : m_shape(std::move(shape)), m_lower(lower) {
+  if (not m_shape)
+    throw std::invalid_argument("No shape to sample.");
+  if (not(spacing > 0.))
+    throw std::invalid_argument("The grid spacing has to be positive.");
+
+  for (int i = 0; i < 3; ++i) {
+    auto const length = upper[i] - lower[i];
+    if (not(length > 0.))
+      throw std::invalid_argument("The sampled box has to be non-empty.");
+    auto const n_cells = std::max(1, static_cast<int>(std::ceil(
+                                         length / spacing - 1e-12)));
+    m_grid_size[i] = n_cells + 1;
+    m_spacing[i] = length / n_cells;
+  }
+
+  m_data.resize(4ul * m_grid_size[0] * m_grid_size[1] * m_grid_size[2]);
+  for (int z = 0; z < m_grid_size[2]; ++z)
+    for (int y = 0; y < m_grid_size[1]; ++y)
+      for (int x = 0; x < m_grid_size[0]; ++x) {
+        auto const node = Utils::Vector3i{x, y, z};
+        auto const pos = m_lower + Utils::hadamard_product(node, m_spacing);
+        double dist;
+        Utils::Vector3d vec;
+        m_shape->calculate_dist(pos, dist, vec);
+
+        auto data =
+            m_data.begin() + 4 * Utils::get_linear_index(node, m_grid_size);
+        *data++ = dist;
+        std::copy(vec.begin(), vec.end(), data);
+      }
+}
+
+void SampledShape::calculate_dist(Utils::Vector3d const &pos, double &dist,
+                                  Utils::Vector3d &vec) const {
+  Utils::Vector3i cell;
+  Utils::Vector3d frac;
+  for (int i = 0; i < 3; ++i) {
+    auto const x = (pos[i] - m_lower[i]) / m_spacing[i];
+    if (not(x >= 0. and x <= m_grid_size[i] - 1)) {
+      m_shape->calculate_dist(pos, dist, vec);
+      return;
+    }
+    cell[i] = std::min(static_cast<int>(x), m_grid_size[i] - 2);
+    frac[i] = x - cell[i];
+  }
+
+  double d = 0.;
+  Utils::Vector3d v{};
+  for (int corner = 0; corner < 8; ++corner) {
+    auto node = cell;
+    double weight = 1.;
+    for (int i = 0; i < 3; ++i) {
+      if (corner & (1 << i)) {
+        node[i] += 1;
+        weight *= frac[i];
+      } else {
+        weight *= 1. - frac[i];
+      }
+    }
+
+    auto const data =
+        m_data.data() + 4 * Utils::get_linear_index(node, m_grid_size);
+    d += weight * data[0];
+    v += weight * Utils::Vector3d{data[1], data[2], data[3]};
+  }
+
+  dist = d;
+  vec = v;
+}
+
+double SampledShape::max_error() const {
+  double error = 0.;
+  for (int z = 0; z < m_grid_size[2] - 1; ++z)
+    for (int y = 0; y < m_grid_size[1] - 1; ++y)
+      for (int x = 0; x < m_grid_size[0] - 1; ++x) {
+        auto const pos =
+            m_lower + Utils::hadamard_product(
+                          Utils::Vector3d{x + 0.5, y + 0.5, z + 0.5}, m_spacing);
+        double dist, exact_dist;
+        Utils::Vector3d vec, exact_vec;
+        calculate_dist(pos, dist, vec);
+        m_shape->calculate_dist(pos, exact_dist, exact_vec);
+        error = std::max(error, std::abs(dist - exact_dist));
+      }
+  return error;
+}
+} // namespace Shapes
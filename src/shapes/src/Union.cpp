@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <shapes/Union.hpp>
+
+#include <utils/Vector.hpp>
+#include <utils/math/sqr.hpp>
+
+#include <boost/container/static_vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Shapes {
+namespace {
+bool is_finite(std::pair<Utils::Vector3d, Utils::Vector3d> const &box) {
+  for (int i = 0; i < 3; ++i) {
+    if (not(std::isfinite(box.first[i]) and std::isfinite(box.second[i])))
+      return false;
+  }
+  return true;
+}
+
+double box_distance(std::pair<Utils::Vector3d, Utils::Vector3d> const &box,
+                    Utils::Vector3d const &pos) {
+  double dist2 = 0.;
+  for (int i = 0; i < 3; ++i) {
+    dist2 += Utils::sqr(std::max({box.first[i] - pos[i], 0.,
+                                  pos[i] - box.second[i]}));
+  }
+  return std::sqrt(dist2);
+}
+} // namespace
+
+void Union::build_bvh() const {
+  m_change_count = parameter_change_count();
+  m_boxes.clear();
+  m_unbounded.clear();
+  m_bvh_shapes.clear();
+  m_bvh_nodes.clear();
+
+  for (int i = 0; i < static_cast<int>(m_shapes.size()); ++i) {
+    m_boxes.emplace_back(m_shapes[i]->bounding_box());
+    if (is_finite(m_boxes.back())) {
+      m_bvh_shapes.push_back(i);
+    } else {
+      m_unbounded.push_back(i);
+    }
+  }
+
+  if (not m_bvh_shapes.empty()) {
+    build_bvh_node(0, static_cast<int>(m_bvh_shapes.size()));
+  }
+}
+
+void Union::update_bvh() const {
+  if (m_change_count == parameter_change_count())
+    return;
+
+  m_change_count = parameter_change_count();
+  for (std::size_t i = 0; i < m_shapes.size(); ++i) {
+    if (m_shapes[i]->bounding_box() != m_boxes[i]) {
+      build_bvh();
+      return;
+    }
+  }
+}
+
+int Union::build_bvh_node(int begin, int end) const {
+  auto const inf = std::numeric_limits<double>::infinity();
+  auto box = box_type{Utils::Vector3d::broadcast(inf),
+                      Utils::Vector3d::broadcast(-inf)};
+  auto centers = box;
+  for (int k = begin; k < end; ++k) {
+    auto const &shape_box = m_boxes[m_bvh_shapes[k]];
+    auto const center = 0.5 * (shape_box.first + shape_box.second);
+    for (int i = 0; i < 3; ++i) {
+      box.first[i] = std::min(box.first[i], shape_box.first[i]);
+      box.second[i] = std::max(box.second[i], shape_box.second[i]);
+      centers.first[i] = std::min(centers.first[i], center[i]);
+      centers.second[i] = std::max(centers.second[i], center[i]);
+    }
+  }
+
+  auto const index = static_cast<int>(m_bvh_nodes.size());
+  m_bvh_nodes.push_back(BVHNode{box, begin, end});
+  if (end - begin <= bvh_leaf_size) {
+    return index;
+  }
+
+  /* Split at the median of the box centers along the longest extent. */
+  auto const extent = centers.second - centers.first;
+  auto const axis = static_cast<int>(
+      std::distance(extent.begin(), std::max_element(extent.begin(),
+                                                     extent.end())));
+  auto const mid = begin + (end - begin) / 2;
+  std::nth_element(m_bvh_shapes.begin() + begin, m_bvh_shapes.begin() + mid,
+                   m_bvh_shapes.begin() + end, [this, axis](int a, int b) {
+                     return m_boxes[a].first[axis] + m_boxes[a].second[axis] <
+                            m_boxes[b].first[axis] + m_boxes[b].second[axis];
+                   });
+
+  auto const left = build_bvh_node(begin, mid);
+  auto const right = build_bvh_node(mid, end);
+  m_bvh_nodes[index].left = left;
+  m_bvh_nodes[index].right = right;
+  return index;
+}
+
+void Union::calculate_dist(Utils::Vector3d const &pos, double &dist,
+                           Utils::Vector3d &vec) const {
+  update_bvh();
+
+  dist = std::numeric_limits<double>::infinity();
+  vec = Utils::Vector3d{};
+  auto closest = static_cast<int>(m_shapes.size());
+
+  /* Ties are resolved in favor of the shape added first. */
+  auto const visit = [&](int i) {
+    double d;
+    Utils::Vector3d v;
+    m_shapes[i]->calculate_dist(pos, d, v);
+    if (d < 0.0)
+      throw std::domain_error(
+          "Distance to Union not well-defined for given position!");
+    if (d < dist or (d == dist and i < closest)) {
+      dist = d;
+      vec = v;
+      closest = i;
+    }
+  };
+
+  for (auto const i : m_unbounded) {
+    visit(i);
+  }
+
+  if (m_bvh_nodes.empty())
+    return;
+
+  boost::container::static_vector<int, 64> stack{0};
+  while (not stack.empty()) {
+    auto const &node = m_bvh_nodes[stack.back()];
+    stack.pop_back();
+
+    if (box_distance(node.box, pos) > dist)
+      continue;
+
+    if (node.left < 0) {
+      for (int k = node.begin; k < node.end; ++k) {
+        visit(m_bvh_shapes[k]);
+      }
+      continue;
+    }
+
+    /* Descend into the closer child first. */
+    auto const &left = m_bvh_nodes[node.left];
+    auto const &right = m_bvh_nodes[node.right];
+    if (box_distance(left.box, pos) < box_distance(right.box, pos)) {
+      stack.push_back(node.right);
+      stack.push_back(node.left);
+    } else {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+    }
+  }
+}
+} // namespace Shapes
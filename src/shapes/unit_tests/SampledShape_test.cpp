@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE SampledShape test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <shapes/SampledShape.hpp>
+#include <shapes/Sphere.hpp>
+
+#include <utils/Vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+BOOST_AUTO_TEST_CASE(interpolation) {
+  auto sphere = std::make_shared<Shapes::Sphere>();
+  sphere->pos() = Utils::Vector3d{5., 5., 5.};
+  sphere->rad() = 2.;
+
+  auto const sampled = Shapes::SampledShape(
+      sphere, Utils::Vector3d{1., 1., 1.}, Utils::Vector3d{9., 9., 9.}, 0.3);
+  BOOST_CHECK((sampled.grid_size() == Utils::Vector3i{28, 28, 28}));
+  BOOST_CHECK_CLOSE(sampled.spacing()[0], 8. / 27., 1e-12);
+
+  auto check = [&](Utils::Vector3d const &pos, double tol) {
+    double dist, exact_dist;
+    Utils::Vector3d vec, exact_vec;
+    sampled.calculate_dist(pos, dist, vec);
+    sphere->calculate_dist(pos, exact_dist, exact_vec);
+    BOOST_CHECK_SMALL(dist - exact_dist, tol);
+    BOOST_CHECK_SMALL((vec - exact_vec).norm(), tol);
+  };
+
+  // Grid nodes are exact.
+  check(Utils::Vector3d{1., 1., 1.}, 1e-12);
+  check(Utils::Vector3d{9., 9., 9.}, 1e-12);
+  // Outside of the grid the sphere is evaluated directly.
+  check(Utils::Vector3d{12., 0., 5.}, 1e-12);
+  // In between, the interpolation error is of second order.
+  check(Utils::Vector3d{7.1, 5.3, 4.2}, 1e-2);
+  // The distance function is not smooth at the center of the sphere,
+  // there the error is of first order.
+  BOOST_CHECK_LE(sampled.max_error(), sampled.spacing().norm());
+  BOOST_CHECK_GE(sampled.max_error(), 0.1);
+  auto const cap = Shapes::SampledShape(
+      sphere, Utils::Vector3d{1., 1., 7.5}, Utils::Vector3d{9., 9., 9.}, 0.3);
+  BOOST_CHECK_SMALL(cap.max_error(), 2e-2);
+
+}
+
+BOOST_AUTO_TEST_CASE(bounding_box) {
+  auto sphere = std::make_shared<Shapes::Sphere>();
+  sphere->pos() = Utils::Vector3d{5., 5., 5.};
+  sphere->rad() = 2.;
+
+  auto const sampled = Shapes::SampledShape(
+      sphere, Utils::Vector3d{0., 0., 0.}, Utils::Vector3d{10., 10., 10.}, 1.);
+  auto const box = sampled.bounding_box();
+  BOOST_CHECK_CLOSE(box.first[0], 3. - std::sqrt(3.), 1e-12);
+  BOOST_CHECK_CLOSE(box.second[2], 7. + std::sqrt(3.), 1e-12);
+
+  // The interpolated distance of points outside of the box is at least
+  // the distance to the box.
+  for (double x = 0.05; x < 10.; x += 0.1) {
+    for (double y = 0.05; y < 10.; y += 0.1) {
+      for (double z = 0.05; z < 10.; z += 0.1) {
+        auto const pos = Utils::Vector3d{x, y, z};
+        Utils::Vector3d box_dist_vec;
+        for (int i = 0; i < 3; i++) {
+          box_dist_vec[i] = std::max({box.first[i] - pos[i], 0.,
+                                      pos[i] - box.second[i]});
+        }
+        if (box_dist_vec == Utils::Vector3d{}) {
+          continue;
+        }
+        double dist;
+        Utils::Vector3d vec;
+        sampled.calculate_dist(pos, dist, vec);
+        BOOST_REQUIRE_GE(dist, box_dist_vec.norm());
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(invalid_arguments) {
+  auto sphere = std::make_shared<Shapes::Sphere>();
+  auto const lower = Utils::Vector3d{0., 0., 0.};
+  auto const upper = Utils::Vector3d{1., 1., 1.};
+  BOOST_CHECK_THROW(Shapes::SampledShape(nullptr, lower, upper, 0.1),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(Shapes::SampledShape(sphere, lower, upper, 0.),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(Shapes::SampledShape(sphere, upper, lower, 0.1),
+                    std::invalid_argument);
+}
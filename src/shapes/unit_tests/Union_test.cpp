@@ -23,13 +23,20 @@
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+#include <shapes/Sphere.hpp>
 #include <shapes/Union.hpp>
 #include <shapes/Wall.hpp>
 
 #include <utils/Vector.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
 #include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
 
 BOOST_AUTO_TEST_CASE(dist_function) {
   {
@@ -66,3 +73,130 @@ BOOST_AUTO_TEST_CASE(dist_function) {
     check_union({1.2, 2.3, 5.5});
   }
 }
+
+BOOST_AUTO_TEST_CASE(bounding_box) {
+  auto sphere1 = std::make_shared<Shapes::Sphere>();
+  sphere1->pos() = Utils::Vector3d{1., 2., 3.};
+  sphere1->rad() = 1.;
+  auto sphere2 = std::make_shared<Shapes::Sphere>();
+  sphere2->pos() = Utils::Vector3d{4., 2., 3.};
+  sphere2->rad() = 0.5;
+
+  Shapes::Union uni;
+  uni.add(sphere1);
+  uni.add(sphere2);
+  {
+    auto const box = uni.bounding_box();
+    BOOST_CHECK((box.first == Utils::Vector3d{0., 1., 2.}));
+    BOOST_CHECK((box.second == Utils::Vector3d{4.5, 3., 4.}));
+  }
+
+  // An unbounded member makes the union unbounded.
+  auto wall = std::make_shared<Shapes::Wall>();
+  wall->set_normal(Utils::Vector3d{0., 0., 1.});
+  uni.add(wall);
+  {
+    auto const box = uni.bounding_box();
+    for (int i = 0; i < 3; i++) {
+      BOOST_CHECK(std::isinf(box.first[i]) and box.first[i] < 0.);
+      BOOST_CHECK(std::isinf(box.second[i]) and box.second[i] > 0.);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(bvh) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> coord(0., 20.);
+  std::uniform_real_distribution<double> radius(0.1, 1.);
+
+  std::vector<std::shared_ptr<Shapes::Shape>> shapes;
+  Shapes::Union uni;
+  for (int i = 0; i < 200; i++) {
+    auto sphere = std::make_shared<Shapes::Sphere>();
+    sphere->pos() = Utils::Vector3d{coord(rng), coord(rng), coord(rng)};
+    sphere->rad() = radius(rng);
+    shapes.push_back(sphere);
+    uni.add(sphere);
+  }
+  // Unbounded members are always evaluated.
+  auto wall = std::make_shared<Shapes::Wall>();
+  wall->set_normal(Utils::Vector3d{0., 0., 1.});
+  wall->d() = -5.;
+  shapes.push_back(wall);
+  uni.add(wall);
+
+  // The hierarchy finds the same closest shape as the linear search.
+  for (int i = 0; i < 1000; i++) {
+    auto const pos = Utils::Vector3d{coord(rng), coord(rng), coord(rng)};
+    double ref_dist = std::numeric_limits<double>::infinity();
+    Utils::Vector3d ref_vec{};
+    bool inside = false;
+    for (auto const &s : shapes) {
+      double d;
+      Utils::Vector3d v;
+      s->calculate_dist(pos, d, v);
+      inside |= d < 0.;
+      if (d < ref_dist) {
+        ref_dist = d;
+        ref_vec = v;
+      }
+    }
+
+    if (inside) {
+      double d;
+      Utils::Vector3d v;
+      BOOST_CHECK_THROW(uni.calculate_dist(pos, d, v), std::domain_error);
+    } else {
+      double d;
+      Utils::Vector3d v;
+      uni.calculate_dist(pos, d, v);
+      BOOST_CHECK_EQUAL(d, ref_dist);
+      BOOST_CHECK((v == ref_vec));
+    }
+  }
+
+  // Removing shapes updates the hierarchy.
+  for (std::size_t i = 0; i < shapes.size(); i += 2) {
+    uni.remove(shapes[i]);
+  }
+  auto const pos = Utils::Vector3d{10., 10., 30.};
+  double ref_dist = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 1; i < shapes.size(); i += 2) {
+    double d;
+    Utils::Vector3d v;
+    shapes[i]->calculate_dist(pos, d, v);
+    ref_dist = std::min(ref_dist, d);
+  }
+  double d;
+  Utils::Vector3d v;
+  uni.calculate_dist(pos, d, v);
+  BOOST_CHECK_EQUAL(d, ref_dist);
+}
+
+BOOST_AUTO_TEST_CASE(modified_member) {
+  Shapes::Union uni;
+  std::vector<std::shared_ptr<Shapes::Sphere>> spheres;
+  for (int i = 0; i < 20; i++) {
+    auto sphere = std::make_shared<Shapes::Sphere>();
+    sphere->pos() = Utils::Vector3d{3. * i, 0., 0.};
+    sphere->rad() = 1.;
+    spheres.push_back(sphere);
+    uni.add(sphere);
+  }
+
+  auto const distance = [&uni](Utils::Vector3d const &pos) {
+    double d;
+    Utils::Vector3d v;
+    uni.calculate_dist(pos, d, v);
+    return d;
+  };
+  auto const pos = Utils::Vector3d{30., 10., 0.};
+  BOOST_CHECK_CLOSE(distance(pos), 9., 1e-10);
+
+  // A member which moves far away from its box is found after the
+  // change is signaled.
+  spheres[0]->pos() = Utils::Vector3d{30., 14., 0.};
+  spheres[0]->rad() = 2.;
+  Shapes::notify_parameter_change();
+  BOOST_CHECK_CLOSE(distance(pos), 2., 1e-10);
+}
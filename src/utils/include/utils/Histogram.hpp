@@ -86,6 +86,7 @@ public:
   std::array<T, Dims> get_bin_sizes() const;
   void update(Span<const T> data);
   void update(Span<const T> data, Span<const T> weights);
+  void add(Span<const T> hist, Span<const size_t> tot_count);
   void normalize();
 
 private:
@@ -172,6 +173,22 @@ void Histogram<T, Dims>::update(Span<const T> data, Span<const T> weights) {
   }
 }
 
+/**
+ * \brief Add the data of a histogram with the same binning, e.g.
+ *        a partial histogram accumulated on another node.
+ * \param hist  flat histogram data, cf. \ref get_histogram.
+ * \param tot_count  hits per bin entry, cf. \ref get_tot_count.
+ */
+template <typename T, size_t Dims>
+void Histogram<T, Dims>::add(Span<const T> hist, Span<const size_t> tot_count) {
+  if (hist.size() != m_hist.size() or tot_count.size() != m_tot_count.size())
+    throw std::invalid_argument("Wrong dimensions of given histogram data!");
+  std::transform(m_hist.begin(), m_hist.end(), hist.begin(), m_hist.begin(),
+                 std::plus<T>());
+  std::transform(m_tot_count.begin(), m_tot_count.end(), tot_count.begin(),
+                 m_tot_count.begin(), std::plus<size_t>());
+}
+
 /**
  * \brief Get the bin sizes.
  */
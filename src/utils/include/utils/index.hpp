@@ -19,7 +19,9 @@
 #ifndef UTILS_INDEX_HPP
 #define UTILS_INDEX_HPP
 
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <numeric>
 #include <stdexcept>
@@ -116,6 +118,31 @@ get_linear_index(const Vector3i &ind, const Vector3i &adim,
   return get_linear_index(ind[0], ind[1], ind[2], adim, memory_order);
 }
 
+/**
+ * @brief Index of a position on the Morton (Z-order) curve.
+ *
+ * The bits of the coordinates are interleaved, so that positions which
+ * are close in space are mostly close on the curve.
+ *
+ * @param ind Position in a 3D grid, every coordinate in [0, 2^21).
+ * @return Index on the curve
+ */
+inline uint64_t morton_index(const Vector3i &ind) {
+  auto const spread = [](uint64_t x) {
+    assert(x < (uint64_t{1} << 21));
+    x = (x | (x << 32)) & 0x1f00000000ffffULL;
+    x = (x | (x << 16)) & 0x1f0000ff0000ffULL;
+    x = (x | (x << 8)) & 0x100f00f00f00f00fULL;
+    x = (x | (x << 4)) & 0x10c30c30c30c30c3ULL;
+    x = (x | (x << 2)) & 0x1249249249249249ULL;
+    return x;
+  };
+
+  return spread(static_cast<uint64_t>(ind[0])) |
+         (spread(static_cast<uint64_t>(ind[1])) << 1) |
+         (spread(static_cast<uint64_t>(ind[2])) << 2);
+}
+
 /**
  * @brief Linear index into an upper triangular matrix.
  *
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UTILS_MATH_ANDERSON_MIXING_HPP
+#define UTILS_MATH_ANDERSON_MIXING_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace Utils {
+/**
+ * @brief Anderson mixing for fixed-point iterations <tt>x = g(x)</tt>.
+ *
+ * Instead of the simple relaxed update <tt>x += beta * (g(x) - x)</tt>,
+ * the new iterate is extrapolated from the last @c depth iterates by
+ * minimizing the linear combination of the residuals in the least-squares
+ * sense (type-II Anderson mixing, see e.g. Walker and Ni, SIAM J. Numer.
+ * Anal. 49 (2011)). With @c depth 0 the simple relaxed iteration is
+ * recovered.
+ *
+ * The unknowns can be distributed over several processes. In that case,
+ * every process holds its own slice of @c x, and the scalar products are
+ * summed up by the user-provided reduction, which has to be called
+ * collectively. All processes have to call @ref update the same number of
+ * times, even if their slice is empty.
+ */
+class AndersonMixing {
+  int m_depth;
+  double m_beta;
+
+  bool m_has_prev = false;
+  std::vector<double> m_x_prev;
+  std::vector<double> m_f_prev;
+  /** History of the differences of consecutive iterates. */
+  std::deque<std::vector<double>> m_dx;
+  /** History of the differences of consecutive residuals. */
+  std::deque<std::vector<double>> m_df;
+
+  /**
+   * @brief Solve the dense symmetric system A x = b in place by
+   * Gaussian elimination with partial pivoting.
+   *
+   * @return false if the system is (numerically) singular.
+   */
+  static bool solve(std::vector<double> &a, std::vector<double> &b) {
+    auto const n = b.size();
+    for (std::size_t k = 0; k < n; ++k) {
+      auto pivot = k;
+      for (auto i = k + 1; i < n; ++i) {
+        if (std::abs(a[i * n + k]) > std::abs(a[pivot * n + k]))
+          pivot = i;
+      }
+      if (a[pivot * n + k] == 0.)
+        return false;
+      if (pivot != k) {
+        for (std::size_t j = 0; j < n; ++j)
+          std::swap(a[k * n + j], a[pivot * n + j]);
+        std::swap(b[k], b[pivot]);
+      }
+      for (auto i = k + 1; i < n; ++i) {
+        auto const c = a[i * n + k] / a[k * n + k];
+        for (auto j = k; j < n; ++j)
+          a[i * n + j] -= c * a[k * n + j];
+        b[i] -= c * b[k];
+      }
+    }
+    for (auto k = n; k-- > 0;) {
+      for (auto j = k + 1; j < n; ++j)
+        b[k] -= a[k * n + j] * b[j];
+      b[k] /= a[k * n + k];
+    }
+    return std::all_of(b.begin(), b.end(),
+                       [](double v) { return std::isfinite(v); });
+  }
+
+public:
+  /**
+   * @param depth Number of previous iterates used for the extrapolation.
+   * @param beta  Relaxation (damping) parameter of the residual.
+   */
+  AndersonMixing(int depth, double beta) : m_depth(depth), m_beta(beta) {}
+
+  int depth() const { return m_depth; }
+  double beta() const { return m_beta; }
+
+  /** @brief Number of stored history entries. */
+  std::size_t history_size() const { return m_dx.size(); }
+
+  /** @brief Forget the iteration history, e.g. if the unknowns change. */
+  void reset() {
+    m_has_prev = false;
+    m_dx.clear();
+    m_df.clear();
+  }
+
+  /**
+   * @brief Compute the next iterate.
+   *
+   * @param[in,out] x   Current iterate, replaced by the next one.
+   * @param[in]     gx  Value of the fixed-point map at @p x.
+   * @param reduce      Callable summing a <tt>std::vector<double></tt>
+   *                    element-wise in place over all processes.
+   */
+  template <class Reduce>
+  void update(std::vector<double> &x, std::vector<double> const &gx,
+              Reduce &&reduce) {
+    assert(x.size() == gx.size());
+    auto const n = x.size();
+
+    std::vector<double> f(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      f[i] = gx[i] - x[i];
+    }
+
+    if (m_depth > 0 and m_has_prev and m_x_prev.size() == n) {
+      std::vector<double> dx(n), df(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        dx[i] = x[i] - m_x_prev[i];
+        df[i] = f[i] - m_f_prev[i];
+      }
+      m_dx.emplace_back(std::move(dx));
+      m_df.emplace_back(std::move(df));
+      if (m_dx.size() > static_cast<std::size_t>(m_depth)) {
+        m_dx.pop_front();
+        m_df.pop_front();
+      }
+    }
+    m_x_prev = x;
+    m_f_prev = f;
+    m_has_prev = true;
+
+    auto const m = m_dx.size();
+    if (m == 0) {
+      for (std::size_t i = 0; i < n; ++i) {
+        x[i] += m_beta * f[i];
+      }
+      return;
+    }
+
+    /* Normal equations of the least-squares problem, the upper m x m
+     * block is the Gram matrix of the residual differences, the last
+     * m entries are their projections onto the current residual. */
+    std::vector<double> buf(m * m + m, 0.);
+    for (std::size_t j = 0; j < m; ++j) {
+      for (std::size_t k = j; k < m; ++k) {
+        double s = 0.;
+        for (std::size_t i = 0; i < n; ++i)
+          s += m_df[j][i] * m_df[k][i];
+        buf[j * m + k] = s;
+      }
+      double s = 0.;
+      for (std::size_t i = 0; i < n; ++i)
+        s += m_df[j][i] * f[i];
+      buf[m * m + j] = s;
+    }
+
+    reduce(buf);
+
+    std::vector<double> a(m * m);
+    std::vector<double> gamma(buf.begin() + m * m, buf.end());
+    double trace = 0.;
+    for (std::size_t j = 0; j < m; ++j) {
+      trace += buf[j * m + j];
+      for (std::size_t k = j; k < m; ++k) {
+        a[j * m + k] = a[k * m + j] = buf[j * m + k];
+      }
+    }
+    /* Tikhonov regularization against nearly collinear residuals. */
+    for (std::size_t j = 0; j < m; ++j) {
+      a[j * m + j] += 1e-12 * trace / static_cast<double>(m);
+    }
+
+    if (trace <= 0. or not solve(a, gamma)) {
+      /* Degenerate history, restart with a simple relaxed step. */
+      m_dx.clear();
+      m_df.clear();
+      for (std::size_t i = 0; i < n; ++i) {
+        x[i] += m_beta * f[i];
+      }
+      return;
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+      double correction = 0.;
+      for (std::size_t j = 0; j < m; ++j)
+        correction += gamma[j] * (m_dx[j][i] + m_beta * m_df[j][i]);
+      x[i] += m_beta * f[i] - correction;
+    }
+  }
+};
+} // namespace Utils
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Utils::AndersonMixing test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "utils/math/anderson_mixing.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using Utils::AndersonMixing;
+
+namespace {
+auto const no_reduction = [](std::vector<double> &) {};
+
+/* Linear contraction g(x) = A x + b with a slowly decaying mode. */
+std::vector<double> g(std::vector<double> const &x) {
+  auto const n = x.size();
+  std::vector<double> res(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    res[i] = 1. + 0.95 * x[i] - 0.02 * x[(i + 1) % n];
+  }
+  return res;
+}
+
+double residual(std::vector<double> const &x) {
+  auto const gx = g(x);
+  double r = 0.;
+  for (std::size_t i = 0; i < x.size(); ++i)
+    r = std::max(r, std::abs(gx[i] - x[i]));
+  return r;
+}
+
+int iterations_to_converge(int depth, double tol) {
+  std::vector<double> x(10, 0.);
+  AndersonMixing mixer(depth, 0.7);
+  for (int it = 0; it < 10000; ++it) {
+    if (residual(x) < tol)
+      return it;
+    mixer.update(x, g(x), no_reduction);
+  }
+  return 10000;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(depth_zero_is_relaxation) {
+  std::vector<double> x = {1., 2., 3.};
+  std::vector<double> const gx = {2., 2., 1.};
+  AndersonMixing mixer(0, 0.5);
+  mixer.update(x, gx, no_reduction);
+  BOOST_CHECK_EQUAL(mixer.history_size(), 0);
+  BOOST_CHECK_CLOSE(x[0], 1.5, 1e-12);
+  BOOST_CHECK_CLOSE(x[1], 2.0, 1e-12);
+  BOOST_CHECK_CLOSE(x[2], 2.0, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(history) {
+  std::vector<double> x(4, 0.);
+  AndersonMixing mixer(3, 0.7);
+  for (int it = 0; it < 6; ++it) {
+    mixer.update(x, g(x), no_reduction);
+    BOOST_CHECK_EQUAL(mixer.history_size(), std::min(it, 3));
+  }
+  mixer.reset();
+  BOOST_CHECK_EQUAL(mixer.history_size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(acceleration) {
+  auto const tol = 1e-10;
+  auto const n_plain = iterations_to_converge(0, tol);
+  auto const n_anderson = iterations_to_converge(5, tol);
+
+  BOOST_CHECK(n_anderson < 10000);
+  BOOST_CHECK(5 * n_anderson < n_plain);
+}
+
+BOOST_AUTO_TEST_CASE(distributed_reduction) {
+  /* Splitting the unknowns into two slices with a summing reduction
+   * has to reproduce the result of the undivided problem. */
+  std::vector<double> x(6, 0.);
+  std::vector<double> x_lo(3, 0.), x_hi(3, 0.);
+  AndersonMixing mixer(4, 0.7), mixer_lo(4, 0.7), mixer_hi(4, 0.7);
+
+  for (int it = 0; it < 8; ++it) {
+    auto const gx = g(x);
+    mixer.update(x, gx, no_reduction);
+
+    std::vector<double> x_split(x_lo);
+    x_split.insert(x_split.end(), x_hi.begin(), x_hi.end());
+    auto const gx_split = g(x_split);
+    std::vector<double> const gx_lo(gx_split.begin(), gx_split.begin() + 3);
+    std::vector<double> const gx_hi(gx_split.begin() + 3, gx_split.end());
+
+    std::vector<double> partial;
+    auto deferred = [&partial](std::vector<double> &buf) { partial = buf; };
+    auto sum = [&partial](std::vector<double> &buf) {
+      for (std::size_t i = 0; i < buf.size(); ++i)
+        buf[i] += partial[i];
+      partial = buf;
+    };
+    auto copy = [&partial](std::vector<double> &buf) { buf = partial; };
+
+    /* Emulate a collective call: the first slice is run on a copy of its
+     * state to obtain its local contribution, which is then added to the
+     * contribution of the second slice and handed back to the first. */
+    auto probe = mixer_lo;
+    auto x_probe = x_lo;
+    probe.update(x_probe, gx_lo, deferred);
+    mixer_hi.update(x_hi, gx_hi, sum);
+    mixer_lo.update(x_lo, gx_lo, copy);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+      BOOST_CHECK_CLOSE(x_lo[i], x[i], 1e-8);
+      BOOST_CHECK_CLOSE(x_hi[i], x[i + 3], 1e-8);
+    }
+  }
+}
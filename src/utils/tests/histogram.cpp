@@ -59,3 +59,19 @@ BOOST_AUTO_TEST_CASE(histogram) {
   BOOST_CHECK_THROW(hist.update(std::vector<double>{{1.0, 5.0, 3.0}}),
                     std::invalid_argument);
 }
+
+BOOST_AUTO_TEST_CASE(histogram_add) {
+  std::array<size_t, 1> n_bins{{4}};
+  std::array<std::pair<double, double>, 1> limits{{std::make_pair(0.0, 4.0)}};
+  auto hist1 = Utils::Histogram<double, 1>(n_bins, 1, limits);
+  auto hist2 = Utils::Histogram<double, 1>(n_bins, 1, limits);
+  hist1.update(std::vector<double>{{0.5}});
+  hist2.update(std::vector<double>{{0.5}}, std::vector<double>{{2.0}});
+  hist2.update(std::vector<double>{{3.5}});
+  // Adding the partial histograms is the same as binning all data at once.
+  hist1.add(hist2.get_histogram(), hist2.get_tot_count());
+  BOOST_CHECK((hist1.get_histogram() == std::vector<double>{{3., 0., 0., 1.}}));
+  BOOST_CHECK((hist1.get_tot_count() == std::vector<size_t>{{2, 0, 0, 1}}));
+  BOOST_CHECK_THROW(hist1.add(std::vector<double>(3), std::vector<size_t>(4)),
+                    std::invalid_argument);
+}
@@ -27,6 +27,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 
 BOOST_AUTO_TEST_CASE(ravel_index_test) {
   const std::array<std::size_t, 4> unravelled_indices{{12, 23, 5, 51}};
@@ -72,6 +73,33 @@ BOOST_AUTO_TEST_CASE(get_linear_index) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(morton_index_test) {
+  using Utils::morton_index;
+
+  /* reference: interleave the bits one by one */
+  auto const interleave = [](Utils::Vector3i const &ind) {
+    uint64_t ret = 0;
+    for (int bit = 0; bit < 21; bit++) {
+      for (int i = 0; i < 3; i++) {
+        ret |= static_cast<uint64_t>((ind[i] >> bit) & 1) << (3 * bit + i);
+      }
+    }
+    return ret;
+  };
+
+  BOOST_CHECK_EQUAL(morton_index({0, 0, 0}), 0u);
+  BOOST_CHECK_EQUAL(morton_index({1, 0, 0}), 1u);
+  BOOST_CHECK_EQUAL(morton_index({0, 1, 0}), 2u);
+  BOOST_CHECK_EQUAL(morton_index({0, 0, 1}), 4u);
+  BOOST_CHECK_EQUAL(morton_index({1, 1, 1}), 7u);
+  BOOST_CHECK_EQUAL(morton_index({2, 0, 0}), 8u);
+
+  for (auto const &ind : {Utils::Vector3i{5, 4, 2}, Utils::Vector3i{17, 0, 99},
+                          Utils::Vector3i{(1 << 21) - 1, 12345, 1 << 20}}) {
+    BOOST_CHECK_EQUAL(morton_index(ind), interleave(ind));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(upper_triangular_test) {
   // clang-format off
   const Utils::VectorXi<2> A[] =
@@ -102,6 +102,43 @@ class CorrelatorTest(ut.TestCase):
         for i in range(corr.shape[0]):
             np.testing.assert_array_almost_equal(corr[i], [v**2 * tau[i]**2])
 
+    def test_finalize(self):
+        s = self.system
+        v = np.array([1, 2, 3])
+        s.part.add(id=0, pos=(0, 0, 0), v=v)
+
+        obs = espressomd.observables.ParticlePositions(ids=(0,))
+        acc = espressomd.accumulators.Correlator(
+            obs1=obs, tau_lin=10, tau_max=10, delta_N=1,
+            corr_operation="square_distance_componentwise")
+
+        s.auto_update_accumulators.add(acc)
+        s.integrator.run(1234)
+        sizes = acc.sample_sizes()
+
+        # the values compressed by finalize() enter the largest lag times
+        acc.finalize()
+        corr = acc.result()
+        tau = acc.lag_times()
+        self.assertGreater(np.sum(acc.sample_sizes()), np.sum(sizes))
+        for i in np.flatnonzero(acc.sample_sizes()):
+            np.testing.assert_allclose(corr[i], [v**2 * tau[i]**2],
+                                       rtol=1e-10)
+
+    def test_observable_size_change(self):
+        s = self.system
+        s.part.add(id=0, pos=(0, 0, 0))
+        s.part.add(id=1, pos=(1, 0, 0))
+
+        obs = espressomd.observables.ParticlePositions(ids=(0,))
+        acc = espressomd.accumulators.Correlator(
+            obs1=obs, tau_lin=10, tau_max=2, delta_N=1,
+            corr_operation="scalar_product")
+        acc.update()
+        obs.ids = (0, 1)
+        with self.assertRaisesRegex(RuntimeError, "size of the first observable changed"):
+            acc.update()
+
     def test_tensor_product(self):
         s = self.system
         v = np.array([1, 2, 3])
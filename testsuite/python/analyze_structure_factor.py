@@ -0,0 +1,65 @@
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import unittest as ut
+import numpy as np
+import espressomd
+
+BOX_L = 10.
+
+
+class AnalyzeStructureFactor(ut.TestCase):
+    system = espressomd.System(box_l=3 * [BOX_L])
+    np.random.seed(42)
+
+    def setUp(self):
+        self.system.part.add(pos=np.random.random((200, 3)) * BOX_L,
+                             type=np.random.randint(3, size=200))
+
+    def tearDown(self):
+        self.system.part.clear()
+
+    # python version of the espresso core function
+    def structure_factor(self, sf_types, order):
+        pos = self.system.part.select(
+            lambda p: p.type in sf_types).pos
+        sf = np.zeros(order**2)
+        n_vectors = np.zeros(order**2)
+        for i in range(order + 1):
+            for j in range(-order, order + 1):
+                for k in range(-order, order + 1):
+                    n = i**2 + j**2 + k**2
+                    if 1 <= n <= order**2:
+                        qr = 2. * np.pi / BOX_L * np.dot(pos, [i, j, k])
+                        sf[n - 1] += np.sum(np.cos(qr))**2 + \
+                            np.sum(np.sin(qr))**2
+                        n_vectors[n - 1] += 1
+        mask = n_vectors > 0
+        q = 2. * np.pi / BOX_L * np.sqrt(np.arange(1, order**2 + 1))
+        return q[mask], sf[mask] / (len(pos) * n_vectors[mask])
+
+    def test_structure_factor(self):
+        order = 5
+        for sf_types in ([0], [1, 2]):
+            q, sf = self.system.analysis.structure_factor(
+                sf_types=sf_types, sf_order=order)
+            q_ref, sf_ref = self.structure_factor(sf_types, order)
+            np.testing.assert_allclose(q, q_ref, rtol=1e-12)
+            np.testing.assert_allclose(sf, sf_ref, rtol=1e-8)
+
+
+if __name__ == "__main__":
+    ut.main()
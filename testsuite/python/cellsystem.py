@@ -17,7 +17,9 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
 import unittest as ut
+import unittest_decorators as utx
 import espressomd
+import espressomd.lb
 import numpy as np
 
 
@@ -25,6 +27,38 @@ class CellSystem(ut.TestCase):
     system = espressomd.System(box_l=[5.0, 5.0, 5.0])
     system.cell_system.skin = 0.0
 
+    def tearDown(self):
+        system = self.system
+        system.actors.clear()
+        system.part.clear()
+        if espressomd.has_features("LENNARD_JONES"):
+            system.non_bonded_inter[0, 0].lennard_jones.set_params(
+                epsilon=0., sigma=0., cutoff=0., shift=0.)
+        system.cell_system.set_domain_decomposition()
+        system.box_l = [5., 5., 5.]
+        system.cell_system.skin = 0.
+
+    def setup_lj(self, box_l):
+        system = self.system
+        system.box_l = box_l
+        system.time_step = 0.005
+        system.cell_system.skin = 0.2
+        system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=0.5, cutoff=1., shift="auto")
+
+    def run_lj(self, pos, vel, steps, **kwargs):
+        """
+        Integrate the LJ particles from the given state in a domain
+        decomposition with the given parameters.
+
+        """
+        system = self.system
+        system.part.clear()
+        system.part.add(pos=pos, v=vel)
+        system.cell_system.set_domain_decomposition(**kwargs)
+        system.integrator.run(steps)
+        return np.copy(system.part[:].pos)
+
     def test_cell_system(self):
         self.system.cell_system.set_n_square(use_verlet_lists=False)
         s = self.system.cell_system.get_state()
@@ -44,6 +78,88 @@ class CellSystem(ut.TestCase):
         np.testing.assert_array_equal(
             s['node_grid'], [n_nodes, 1, 1])
 
+    @utx.skipIfMissingFeatures("LENNARD_JONES")
+    def test_load_balancing(self):
+        system = self.system
+        with self.assertRaises(ValueError):
+            system.cell_system.set_domain_decomposition(
+                load_balancing_interval=-1)
+        n_nodes = system.cell_system.get_state()['n_nodes']
+        if n_nodes == 1:
+            return
+
+        self.setup_lj([6. * n_nodes, 5., 5.])
+        system.cell_system.node_grid = [n_nodes, 1, 1]
+
+        # dense lattice on the first node, dilute gas on the others
+        dense = np.mgrid[0:5.:0.625, 0:5.:0.625, 0:5.:0.625].reshape(3, -1).T
+        dilute = np.mgrid[6.:6. * n_nodes:1.5, 0:5.:1.25, 0:5.:1.25]
+        pos = np.vstack((dense, dilute.reshape(3, -1).T))
+        np.random.seed(42)
+        vel = np.random.uniform(-1., 1., pos.shape)
+
+        ref_pos = self.run_lj(pos, vel, 200, load_balancing_interval=0)
+        ref_n_part = system.cell_system.resort()
+        pos_balanced = self.run_lj(pos, vel, 200, load_balancing_interval=10)
+        n_part = system.cell_system.resort()
+        self.assertEqual(
+            system.cell_system.get_state()['load_balancing_interval'], 10)
+
+        # same trajectory, but less particles on the busiest node
+        np.testing.assert_allclose(pos_balanced, ref_pos, atol=1e-6)
+        self.assertLess(max(n_part), max(ref_n_part))
+
+    @utx.skipIfMissingFeatures("LENNARD_JONES")
+    def test_load_balancing_lb(self):
+        system = self.system
+        n_nodes = system.cell_system.get_state()['n_nodes']
+        if n_nodes == 1:
+            return
+
+        self.setup_lj([6. * n_nodes, 5., 5.])
+        system.cell_system.node_grid = [n_nodes, 1, 1]
+
+        dense = np.mgrid[0:5.:0.625, 0:5.:0.625, 0:5.:0.625].reshape(3, -1).T
+        dilute = np.mgrid[6.:6. * n_nodes:1.5, 0:5.:1.25, 0:5.:1.25]
+        pos = np.vstack((dense, dilute.reshape(3, -1).T))
+        np.random.seed(42)
+        vel = np.random.uniform(-1., 1., pos.shape)
+
+        def regular_n_part():
+            x = system.part[:].pos_folded[:, 0]
+            return np.histogram(x, bins=n_nodes, range=(0., 6. * n_nodes))[0]
+
+        self.run_lj(pos, vel, 200, load_balancing_interval=10)
+        self.assertLess(max(system.cell_system.resort()),
+                        max(regular_n_part()))
+
+        # the CPU LB does not support shifted slabs, every node has to own
+        # the particles of its regular slab again
+        system.actors.add(espressomd.lb.LBFluid(
+            agrid=1., dens=1., visc=1., tau=system.time_step))
+        np.testing.assert_array_equal(
+            system.cell_system.resort(), regular_n_part())
+        system.integrator.run(50)
+        np.testing.assert_array_equal(
+            system.cell_system.resort(), regular_n_part())
+
+    @utx.skipIfMissingFeatures("LENNARD_JONES")
+    def test_space_filling_curve(self):
+        system = self.system
+        self.setup_lj([8., 8., 8.])
+
+        pos = np.mgrid[0:8.:0.8, 0:8.:0.8, 0:8.:0.8].reshape(3, -1).T
+        np.random.seed(42)
+        vel = np.random.uniform(-1., 1., pos.shape)
+
+        ref_pos = self.run_lj(pos, vel, 100, space_filling_curve=False)
+        sfc_pos = self.run_lj(pos, vel, 100, space_filling_curve=True)
+        self.assertTrue(
+            system.cell_system.get_state()['space_filling_curve'])
+
+        # the order of the particles in memory only changes the order of
+        # the force summation, i.e. the trajectory up to round-off
+        np.testing.assert_allclose(sfc_pos, ref_pos, atol=1e-6)
 
 if __name__ == "__main__":
     ut.main()
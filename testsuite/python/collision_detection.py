@@ -143,7 +143,7 @@ class CollisionDetection(ut.TestCase):
         self.assertEqual(len(self.s.part), expected_np)
 
         # At the end of test, this list should be empty
-        parts_not_accounted_for = list(range(expected_np))
+        parts_not_accounted_for = [p.id for p in self.s.part]
 
         # We traverse particles. We look for a vs with a bond to find the other vs.
         # From the two vs we find the two non-virtual particles
@@ -365,7 +365,7 @@ class CollisionDetection(ut.TestCase):
         self.assertEqual(len(self.s.part), expected_np)
 
         # At the end of test, this list should be empty
-        parts_not_accounted_for = list(range(expected_np))
+        parts_not_accounted_for = [p.id for p in self.s.part]
 
         # We traverse particles. We look for a vs, get base particle from there
         # and partner particle via bonds
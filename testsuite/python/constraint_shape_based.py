@@ -870,6 +870,81 @@ class ShapeBasedConstraintTest(ut.TestCase):
         system.non_bonded_inter[0, 1].lennard_jones.set_params(
             epsilon=0.0, sigma=0.0, cutoff=0.0, shift=0)
 
+    def check_culling(self, shape, penetrable, lower, upper):
+        """Compare the constraint forces and energy of particles placed
+        randomly between ``lower`` and ``upper`` with the ones calculated
+        from the distance function of ``shape``, i.e. without culling the
+        constraint by its interaction region.
+
+        """
+        system = self.system
+        system.time_step = 0.01
+        system.cell_system.skin = 0.4
+        cutoff = 2.5
+        system.non_bonded_inter[0, 1].generic_lennard_jones.set_params(
+            epsilon=1., sigma=1., cutoff=cutoff, shift=0., offset=0.,
+            e1=12, e2=6, b1=4., b2=4.)
+        system.constraints.add(
+            shape=shape, particle_type=1, penetrable=penetrable)
+
+        # keep clear of the singularity of the potential at the surface
+        np.random.seed(42)
+        pos = np.random.uniform(lower, upper, (500, 3))
+        dist = np.array([shape.calc_distance(position=x)[0]
+                         for x in pos % self.box_l])
+        pos = pos[(np.abs(dist) if penetrable else dist) > 0.8]
+        system.part.add(pos=pos, type=len(pos) * [0])
+        system.integrator.run(0, recalc_forces=True)
+
+        ref_forces = np.zeros(pos.shape)
+        ref_energy = 0.
+        for i, x in enumerate(system.part[:].pos_folded):
+            d, vec = shape.calc_distance(position=x)
+            r = abs(d)
+            if r < cutoff:
+                ref_forces[i] = 4. * (12. * r**-14 - 6. * r**-8) * \
+                    np.array(vec)
+                ref_energy += 4. * (r**-12 - r**-6)
+
+        np.testing.assert_allclose(
+            np.copy(system.part[:].f), ref_forces, rtol=1e-8, atol=1e-10)
+        np.testing.assert_allclose(
+            system.analysis.energy()["total"], ref_energy, rtol=1e-8)
+
+        system.part.clear()
+        system.constraints.clear()
+        system.non_bonded_inter[0, 1].generic_lennard_jones.set_params(
+            epsilon=0., sigma=0., cutoff=0., shift=0., offset=0., e1=0, e2=0,
+            b1=0., b2=0.)
+
+    def test_culling(self):
+        """Check that the constraints are only skipped for particles
+        outside of their interaction region.
+
+        """
+        center = np.array(3 * [self.box_l / 2.])
+        sphere = espressomd.shapes.Sphere(center=center, radius=2.)
+        self.check_culling(sphere, False, center - 5.5, center + 5.5)
+        self.check_culling(sphere, True, center - 5.5, center + 5.5)
+
+        # the interaction region extends over the periodic boundaries
+        edge = np.array([0.5, 0.5, self.box_l / 2.])
+        sphere = espressomd.shapes.Sphere(center=edge, radius=2.)
+        self.check_culling(sphere, False, edge - 5.5, edge + 5.5)
+
+        # on a coarse grid the interpolated distance differs noticeably
+        # from the one of the sampled shape
+        sampled = espressomd.shapes.SampledShape(
+            shape=espressomd.shapes.Sphere(center=center, radius=2.),
+            lower=center - 5., upper=center + 5., spacing=1.)
+        self.check_culling(sampled, False, center - 5.5, center + 5.5)
+        self.check_culling(sampled, True, center - 5.5, center + 5.5)
+
+        # inverted shapes act everywhere
+        sphere = espressomd.shapes.Sphere(
+            center=center, radius=6., direction=-1)
+        self.check_culling(sphere, False, center - 5.5, center + 5.5)
+
 
 if __name__ == "__main__":
     ut.main()
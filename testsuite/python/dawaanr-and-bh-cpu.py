@@ -0,0 +1,90 @@
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import unittest as ut
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+
+import espressomd
+import espressomd.magnetostatics
+
+
+@utx.skipIfMissingFeatures(["DIPOLES", "ROTATION"])
+class BarnesHutCpuTest(ut.TestCase):
+    system = espressomd.System(box_l=[1, 1, 1])
+    np.random.seed(71)
+
+    def setUp(self):
+        l = 15
+        n = 300
+        self.system.box_l = [l, l, l]
+        self.system.periodicity = [0, 0, 0]
+        self.system.time_step = 0.01
+        self.system.cell_system.skin = 0.0
+        # a spherical droplet of dipoles
+        pos = np.random.normal(0.5 * l, 0.15 * l, (n, 3))
+        pos = np.clip(pos, 0.05 * l, 0.95 * l)
+        dip = np.random.normal(0, 1, (n, 3))
+        dip = 1.3 * dip / np.linalg.norm(dip, axis=1)[:, np.newaxis]
+        self.system.part.add(pos=pos, dip=dip, rotation=n * [(1, 1, 1)])
+
+    def tearDown(self):
+        self.system.actors.clear()
+        self.system.part.clear()
+
+    def forces_torques_energy(self, actor):
+        self.system.actors.add(actor)
+        self.system.integrator.run(steps=0, recalc_forces=True)
+        f = np.copy(self.system.part[:].f)
+        t = np.copy(self.system.part[:].torque_lab)
+        e = self.system.analysis.energy()["dipolar"]
+        self.system.actors.remove(actor)
+        return f, t, e
+
+    def test_exact_and_approximated(self):
+        dawaanr = espressomd.magnetostatics.DipolarDirectSumCpu(prefactor=2.3)
+        f_ref, t_ref, e_ref = self.forces_torques_energy(dawaanr)
+
+        bh = espressomd.magnetostatics.DipolarBarnesHutCpu(
+            prefactor=2.3, theta=0.)
+        f, t, e = self.forces_torques_energy(bh)
+        np.testing.assert_allclose(f, f_ref, rtol=1e-10, atol=1e-10)
+        np.testing.assert_allclose(t, t_ref, rtol=1e-10, atol=1e-10)
+        self.assertAlmostEqual(e, e_ref, delta=1e-10 * abs(e_ref))
+
+        bh = espressomd.magnetostatics.DipolarBarnesHutCpu(
+            prefactor=2.3, theta=0.4)
+        self.assertEqual(bh.get_params()["theta"], 0.4)
+        f, t, e = self.forces_torques_energy(bh)
+        for ref, val in ((f_ref, f), (t_ref, t)):
+            rel = np.linalg.norm(val - ref) / np.linalg.norm(ref)
+            self.assertLess(rel, 2e-2)
+        self.assertAlmostEqual(e, e_ref, delta=2e-2 * abs(e_ref))
+
+    def test_exceptions(self):
+        with self.assertRaises(ValueError):
+            espressomd.magnetostatics.DipolarBarnesHutCpu(
+                prefactor=1., theta=-0.1)
+        self.system.periodicity = [1, 0, 0]
+        bh = espressomd.magnetostatics.DipolarBarnesHutCpu(prefactor=1.)
+        with self.assertRaises(Exception):
+            self.system.actors.add(bh)
+            self.system.integrator.run(steps=0, recalc_forces=True)
+
+
+if __name__ == '__main__':
+    ut.main()
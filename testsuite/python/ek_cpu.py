@@ -0,0 +1,191 @@
+#
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+
+import espressomd
+import espressomd.lb
+import espressomd.lbboundaries
+import espressomd.shapes
+from espressomd import electrokinetics
+from espressomd.highlander import ThereCanOnlyBeOne
+import ek_common
+
+
+class ElectrokineticsCPU(ut.TestCase):
+
+    """Check the CPU electrokinetics against the analytic solutions of
+    the lattice equations, for a sine wave along x."""
+
+    n_x = 16
+    n_yz = 4
+    tau = 0.1
+    system = espressomd.System(box_l=[n_x, n_yz, n_yz])
+    system.time_step = tau
+    system.cell_system.skin = 0.1
+    k = 2. * np.pi / n_x
+
+    def setUp(self):
+        self.lbf = espressomd.lb.LBFluid(
+            agrid=1., dens=1., visc=1., tau=self.tau)
+        self.system.actors.add(self.lbf)
+
+    def tearDown(self):
+        self.system.actors.clear()
+        if espressomd.has_features("LB_BOUNDARIES"):
+            self.system.lbboundaries.clear()
+
+    def nodes(self):
+        return np.ndindex(self.n_x, self.n_yz, self.n_yz)
+
+    def total_density(self, ek):
+        return sum(ek[node].density for node in self.nodes())
+
+    def test_potential(self):
+        species = [{"density": 0.5, "D": 0., "valency": 1.},
+                   {"density": 0.5, "D": 0., "valency": -1.}]
+        ek = electrokinetics.ElectrokineticsCPU(
+            T=1., prefactor=0.7, advection=False, species=species)
+        self.system.actors.add(ek)
+        for node in self.nodes():
+            ek[node].density = [0.5 + 0.1 * np.sin(self.k * node[0]), 0.5]
+
+        # inverse of the 7-point Laplacian of the charge density
+        laplacian = 2. - 2. * np.cos(self.k)
+        for x in range(self.n_x):
+            ref = 4. * np.pi * 0.7 * 0.1 * np.sin(self.k * x) / laplacian
+            self.assertAlmostEqual(ek[x, 1, 2].potential, ref, delta=1e-8)
+
+    def test_diffusion(self):
+        D = 0.3
+        species = [{"density": 0.5, "D": D, "valency": 0.}]
+        ek = electrokinetics.ElectrokineticsCPU(
+            T=1., prefactor=1., advection=False, species=species)
+        self.system.actors.add(ek)
+        for node in self.nodes():
+            ek[node].density = [0.5 + 0.1 * np.sin(self.k * node[0])]
+        mass = self.total_density(ek)
+
+        steps = 100
+        self.system.integrator.run(steps)
+
+        # a mode along x only sees the face links and the edge links with
+        # an x component, which add up to the diffusion coefficient
+        decay = (1. - D * self.tau * (2. - 2. * np.cos(self.k)))**steps
+        amplitude = (ek[4, 0, 0].density[0] - ek[12, 0, 0].density[0]) / 2.
+        self.assertAlmostEqual(amplitude, 0.1 * decay, delta=1e-10)
+        np.testing.assert_allclose(self.total_density(ek), mass, rtol=1e-12)
+
+    @utx.skipIfMissingFeatures(["LB_BOUNDARIES"])
+    def test_charged_boundaries(self):
+        # counterions between two walls of positive charge
+        n_fluid = (self.n_x - 2) * self.n_yz**2
+        wall_charge = self.n_yz**2
+        species = [{"density": 0., "D": 0.3, "valency": 1.},
+                   {"density": 2. * wall_charge / n_fluid, "D": 0.3,
+                    "valency": -1.}]
+        ek = electrokinetics.ElectrokineticsCPU(
+            T=1., prefactor=0.5, advection=True, species=species)
+        self.system.actors.add(ek)
+        walls = [espressomd.lbboundaries.LBBoundary(
+            shape=espressomd.shapes.Wall(normal=[1, 0, 0], dist=1.),
+            charge_density=1.),
+            espressomd.lbboundaries.LBBoundary(
+            shape=espressomd.shapes.Wall(
+                normal=[-1, 0, 0], dist=-(self.n_x - 1.)),
+            charge_density=1.)]
+        for wall in walls:
+            self.system.lbboundaries.add(wall)
+        for wall in walls:
+            self.assertAlmostEqual(wall.net_charge, wall_charge, delta=1e-5)
+        mass = self.total_density(ek)
+
+        self.system.integrator.run(200)
+
+        np.testing.assert_allclose(self.total_density(ek), mass, rtol=1e-10)
+        for x in [0, self.n_x - 1]:
+            np.testing.assert_allclose(ek[x, 1, 1].density, [1., 0.])
+        # the counterions gather at the walls, symmetrically
+        profile = [ek[x, 2, 3].density[1] for x in range(self.n_x)]
+        np.testing.assert_allclose(profile, profile[::-1], rtol=1e-8)
+        self.assertGreater(profile[1], profile[2])
+        self.assertGreater(profile[2], profile[self.n_x // 2])
+
+    @utx.skipIfMissingFeatures(["LB_BOUNDARIES"])
+    def test_eof(self):
+        # electroosmotic flow of the counterions of two charged walls,
+        # cf. ek_eof_one_species_base.py
+        padding = 2.
+        width = self.n_x - 2. * padding
+        sigma = -0.04
+        bjerrum_length = 0.8
+        T = 1.1
+        force = 0.07
+        species = [{"density": -2. * sigma / width, "D": 1., "valency": 1.,
+                    "ext_force_density": [0., force, 0.]}]
+        ek = electrokinetics.ElectrokineticsCPU(
+            T=T, prefactor=bjerrum_length * T, species=species)
+        self.system.actors.add(ek)
+        for shape in [espressomd.shapes.Wall(normal=[1, 0, 0], dist=padding),
+                      espressomd.shapes.Wall(normal=[-1, 0, 0],
+                                             dist=-(padding + width))]:
+            self.system.lbboundaries.add(espressomd.lbboundaries.LBBoundary(
+                shape=shape, charge_density=sigma / padding))
+
+        self.system.integrator.run(1000)
+
+        # bisection of the root in (0, pi / width)
+        xi_lower, xi_upper = 0., np.pi / width
+        while xi_upper - xi_lower > 1e-10:
+            xi = (xi_lower + xi_upper) / 2.
+            if ek_common.solve(xi, width, bjerrum_length, sigma, 1.) < 0.:
+                xi_lower = xi
+            else:
+                xi_upper = xi
+
+        density_difference = 0.
+        velocity_difference = 0.
+        for i in range(int(padding), int(padding + width)):
+            position = i - padding - width / 2. + 0.5
+            density_difference += abs(
+                ek[i, 2, 2].density[0] -
+                ek_common.density(position, xi, bjerrum_length))
+            velocity_difference += abs(
+                self.lbf[i, 2, 2].velocity[1] -
+                ek_common.velocity(position, xi, width, bjerrum_length,
+                                   force, 1., 1.))
+        self.assertLess(density_difference / width, 1e-4)
+        self.assertLess(velocity_difference / width, 1e-4)
+
+    def test_single_instance(self):
+        species = [{"density": 0.5, "D": 0.3, "valency": 0.}]
+        ek = electrokinetics.ElectrokineticsCPU(
+            T=1., prefactor=1., species=species)
+        self.system.actors.add(ek)
+        with self.assertRaises(ThereCanOnlyBeOne):
+            self.system.actors.add(electrokinetics.ElectrokineticsCPU(
+                T=1., prefactor=1., species=species))
+        self.assertEqual(len(self.system.actors), 2)
+        # the active instance is not affected
+        np.testing.assert_allclose(ek[3, 1, 2].density, [0.5])
+
+
+if __name__ == "__main__":
+    ut.main()
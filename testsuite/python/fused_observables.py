@@ -0,0 +1,126 @@
+#
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+
+import espressomd
+import espressomd.accumulators
+import espressomd.interactions
+import espressomd.observables
+
+
+@utx.skipIfMissingFeatures(["LENNARD_JONES"])
+class FusedObservables(ut.TestCase):
+
+    """
+    Check that the energy and pressure accumulated during the force
+    calculation of the sampling steps agree with a separate evaluation.
+
+    """
+    system = espressomd.System(box_l=[8.0, 8.0, 8.0])
+    system.cell_system.skin = 0.4
+    system.time_step = 0.005
+    np.random.seed(42)
+
+    def setUp(self):
+        system = self.system
+        system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=1., cutoff=2.5, shift="auto")
+        harmonic = espressomd.interactions.HarmonicBond(k=20., r_0=1.)
+        system.bonded_inter.add(harmonic)
+        grid = np.mgrid[0:4, 0:4, 0:4].reshape(3, -1).T * 2.
+        for pos in grid:
+            p1 = system.part.add(pos=pos, v=np.random.random(3) - 0.5)
+            p2 = system.part.add(pos=pos + [1., 0., 0.],
+                                 v=np.random.random(3) - 0.5)
+            p1.add_bond((harmonic, p2))
+        self.pos = np.copy(system.part[:].pos)
+        self.v = np.copy(system.part[:].v)
+
+    def tearDown(self):
+        self.system.part.clear()
+        self.system.auto_update_accumulators.clear()
+        self.system.integrator.set_vv()
+        self.system.thermostat.turn_off()
+        self.system.periodicity = [1, 1, 1]
+
+    def sample(self, **kwargs):
+        system = self.system
+        system.part[:].pos = self.pos
+        system.part[:].v = self.v
+        system.auto_update_accumulators.clear()
+        energy = espressomd.accumulators.TimeSeries(
+            obs=espressomd.observables.Energy(), delta_N=7)
+        pressure = espressomd.accumulators.TimeSeries(
+            obs=espressomd.observables.PressureTensor(), delta_N=5)
+        system.auto_update_accumulators.add(energy)
+        system.auto_update_accumulators.add(pressure)
+        system.integrator.run(100, **kwargs)
+        return energy.time_series(), pressure.time_series()
+
+    def test_fused(self):
+        energy_ref, pressure_ref = self.sample()
+        energy, pressure = self.sample(
+            fused_observables=['energy', 'pressure'])
+        self.assertEqual(len(energy), 14)
+        self.assertEqual(len(pressure), 20)
+        np.testing.assert_allclose(energy, energy_ref, rtol=1e-10)
+        np.testing.assert_allclose(pressure, pressure_ref, rtol=1e-10,
+                                   atol=1e-12)
+
+        energy, pressure = self.sample(fused_observables=['pressure'])
+        np.testing.assert_allclose(energy, energy_ref, rtol=1e-10)
+        np.testing.assert_allclose(pressure, pressure_ref, rtol=1e-10,
+                                   atol=1e-12)
+
+        with self.assertRaises(ValueError):
+            self.system.integrator.run(1, fused_observables=['virial'])
+
+    def check_fresh_energy(self):
+        """
+        Integrators that move the particles after the force calculation
+        must sample the energy of the final positions.
+
+        """
+        system = self.system
+        energy = espressomd.accumulators.TimeSeries(
+            obs=espressomd.observables.Energy(), delta_N=10)
+        system.auto_update_accumulators.add(energy)
+        system.integrator.run(10, fused_observables=['energy'])
+        self.assertEqual(len(energy.time_series()), 1)
+        np.testing.assert_allclose(energy.time_series()[-1],
+                                   system.analysis.energy()['total'],
+                                   rtol=1e-10)
+
+    def test_brownian(self):
+        self.system.thermostat.set_brownian(kT=0., gamma=1., seed=42)
+        self.system.integrator.set_brownian_dynamics()
+        self.check_fresh_energy()
+
+    @utx.skipIfMissingFeatures(["STOKESIAN_DYNAMICS"])
+    def test_stokesian(self):
+        self.system.periodicity = [0, 0, 0]
+        self.system.integrator.set_stokesian_dynamics(
+            viscosity=1., radii={0: 0.5}, approximation_method='ft')
+        self.check_fresh_energy()
+
+
+if __name__ == "__main__":
+    ut.main()
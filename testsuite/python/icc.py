@@ -16,17 +16,25 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 import unittest as ut
 import unittest_decorators as utx
+import numpy as np
 import espressomd
 
 
 @utx.skipIfMissingFeatures(["P3M", "EXTERNAL_FORCES"])
 class test_icc(ut.TestCase):
 
-    def runTest(self):
+    S = espressomd.System(box_l=[1.0, 1.0, 1.0])
+
+    def tearDown(self):
+        for actor in reversed(list(self.S.actors.active_actors)):
+            self.S.actors.remove(actor)
+        self.S.part.clear()
+
+    def setup_dipole_between_electrodes(self, **icc_params):
         from espressomd.electrostatics import P3M
         from espressomd.electrostatic_extensions import ICC
 
-        S = espressomd.System(box_l=[1.0, 1.0, 1.0])
+        S = self.S
         # Parameters
         box_l = 20.0
         nicc = 10
@@ -82,7 +90,8 @@ class test_icc(ut.TestCase):
             normals=iccNormals,
             areas=iccAreas,
             sigmas=iccSigmas,
-            epsilons=iccEpsilons)
+            epsilons=iccEpsilons,
+            **icc_params)
 
         S.actors.add(p3m)
         S.actors.add(icc)
@@ -90,6 +99,13 @@ class test_icc(ut.TestCase):
         # Run
         S.integrator.run(0)
 
+        return icc, nicc_per_electrode, nicc_tot, box_l, q_test, q_dist
+
+    def test_induced_dipole(self):
+        S = self.S
+        icc, nicc_per_electrode, nicc_tot, box_l, q_test, q_dist = \
+            self.setup_dipole_between_electrodes()
+
         # Analyze
         QL = sum(S.part[:nicc_per_electrode].q)
         QR = sum(S.part[nicc_per_electrode:nicc_tot].q)
@@ -110,6 +126,21 @@ class test_icc(ut.TestCase):
         self.assertNotAlmostEqual(enegry_pre_change, enegry_post_change)
         self.assertNotAlmostEqual(pressure_pre_change, pressure_post_change)
 
+    def test_anderson_mixing(self):
+        S = self.S
+        icc = self.setup_dipole_between_electrodes()[0]
+        q_relaxed = np.copy(S.part[:].q)
+        n_relaxed = icc.last_iterations()
+        self.tearDown()
+
+        icc = self.setup_dipole_between_electrodes(mixing_depth=5)[0]
+        q_mixed = np.copy(S.part[:].q)
+        n_mixed = icc.last_iterations()
+
+        self.assertEqual(icc.get_params()["mixing_depth"], 5)
+        np.testing.assert_allclose(q_mixed, q_relaxed, rtol=1e-4, atol=1e-7)
+        self.assertLess(n_mixed, n_relaxed)
+
 
 if __name__ == "__main__":
     ut.main()
@@ -64,6 +64,12 @@ class Integrator_test(ut.TestCase):
         with self.assertRaisesRegex(Exception, self.msg + 'The SD integrator requires the SD thermostat'):
             self.system.integrator.run(0)
 
+    def test_respa_integrator(self):
+        self.system.thermostat.set_brownian(kT=1.0, gamma=1.0, seed=42)
+        self.system.integrator.set_vv_respa(n_inner=2)
+        with self.assertRaisesRegex(Exception, self.msg + 'The RESPA integrator is incompatible with the currently active combination of thermostats'):
+            self.system.integrator.run(0)
+
     def test_steepest_descent_integrator(self):
         self.system.thermostat.set_langevin(kT=1.0, gamma=1.0, seed=42)
         self.system.integrator.set_steepest_descent(
@@ -0,0 +1,209 @@
+#
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+
+import espressomd
+import espressomd.electrostatics
+import espressomd.interactions
+
+
+@utx.skipIfMissingFeatures(["LENNARD_JONES"])
+class IntegratorRESPA(ut.TestCase):
+
+    """Compare the multiple time step integrator to velocity Verlet,
+    for a Lennard-Jones fluid of harmonic dimers."""
+
+    system = espressomd.System(box_l=[6.] * 3)
+    system.cell_system.skin = 0.3
+    n_dimers = 40
+
+    def setUp(self):
+        np.random.seed(42)
+        self.system.time_step = 0.004
+        self.system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=1., cutoff=2**(1. / 6.), shift="auto")
+        bond = espressomd.interactions.HarmonicBond(k=200., r_0=1.)
+        self.system.bonded_inter.add(bond)
+        lattice = np.array(list(np.ndindex(4, 4, 3)))[:self.n_dimers]
+        for pos in lattice * [1.5, 1.5, 2.]:
+            p1 = self.system.part.add(pos=pos, v=np.random.normal(size=3))
+            p2 = self.system.part.add(pos=pos + [0., 0., 1.],
+                                      v=np.random.normal(size=3))
+            p1.add_bond((bond, p2))
+
+    def tearDown(self):
+        self.system.actors.clear()
+        self.system.thermostat.turn_off()
+        self.system.part.clear()
+        self.system.bonded_inter.clear()
+        self.system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=0., sigma=0., cutoff=0., shift=0.)
+        self.system.integrator.set_vv()
+
+    def total_energy(self):
+        return self.system.analysis.energy()["total"]
+
+    def energy_drift(self, n_steps):
+        energy = self.total_energy()
+        drift = 0.
+        for _ in range(n_steps // 10):
+            self.system.integrator.run(10)
+            drift = max(drift, abs(self.total_energy() / energy - 1.))
+        return drift
+
+    def test_single_inner_step(self):
+        # with one inner step, RESPA is velocity Verlet
+        self.system.integrator.set_vv()
+        self.system.integrator.run(50)
+        pos = np.copy(self.system.part[:].pos)
+        vel = np.copy(self.system.part[:].v)
+        f = np.copy(self.system.part[:].f)
+        self.system.integrator.run(50)
+        pos_ref = np.copy(self.system.part[:].pos)
+        vel_ref = np.copy(self.system.part[:].v)
+
+        self.system.part[:].pos = pos
+        self.system.part[:].v = vel
+        self.system.integrator.set_vv_respa(n_inner=1)
+        self.system.integrator.run(0)
+        np.testing.assert_allclose(np.copy(self.system.part[:].f), f,
+                                   atol=1e-10)
+        for _ in range(5):
+            self.system.integrator.run(10)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].pos), pos_ref, atol=1e-8)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].v), vel_ref, atol=1e-8)
+
+    def test_total_force(self):
+        # after integration, the forces are the total forces
+        self.system.integrator.set_vv_respa(
+            n_inner=4, inner_forces=["bonded"])
+        self.system.integrator.run(20)
+        f = np.copy(self.system.part[:].f)
+        self.system.integrator.set_vv()
+        self.system.integrator.run(0, recalc_forces=True)
+        np.testing.assert_allclose(np.copy(self.system.part[:].f), f,
+                                   atol=1e-10)
+
+    def test_split_run(self):
+        # the forces of both levels are kept between runs, so a run does
+        # not depend on how it is split
+        self.system.integrator.set_vv_respa(
+            n_inner=4, inner_forces=["bonded"])
+        self.system.thermostat.set_langevin(kT=1., gamma=1., seed=42)
+        self.system.integrator.run(0)
+        pos = np.copy(self.system.part[:].pos)
+        vel = np.copy(self.system.part[:].v)
+        thermostat_state = self.system.thermostat.__getstate__()
+        self.system.integrator.run(20)
+        pos_ref = np.copy(self.system.part[:].pos)
+        vel_ref = np.copy(self.system.part[:].v)
+        f_ref = np.copy(self.system.part[:].f)
+
+        self.system.part[:].pos = pos
+        self.system.part[:].v = vel
+        self.system.thermostat.__setstate__(thermostat_state)
+        self.system.integrator.run(0)
+        for _ in range(20):
+            self.system.integrator.run(1)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].pos), pos_ref, atol=1e-10)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].v), vel_ref, atol=1e-10)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].f), f_ref, atol=1e-8)
+
+    def test_early_exit(self):
+        # an integration stopped by a runtime error leaves the total forces
+        self.system.bonded_inter[0] = espressomd.interactions.HarmonicBond(
+            k=200., r_0=1., r_cut=1.1)
+        self.system.part[1].v = [0., 0., 20.]
+        self.system.integrator.set_vv_respa(
+            n_inner=4, inner_forces=["short_range"])
+        self.system.integrator.run(0)
+        with self.assertRaisesRegex(Exception, "bond broken"):
+            self.system.integrator.run(10)
+        f = np.copy(self.system.part[2:].f)
+        self.system.bonded_inter[0] = espressomd.interactions.HarmonicBond(
+            k=200., r_0=1.)
+        self.system.integrator.set_vv()
+        self.system.integrator.run(0, recalc_forces=True)
+        # the broken bond only acts on the first dimer
+        np.testing.assert_allclose(np.copy(self.system.part[2:].f), f,
+                                   atol=1e-10)
+
+    @utx.skipIfMissingFeatures(["P3M"])
+    def test_p3m(self):
+        # the k-space forces on the outer level, all others on the inner one
+        self.system.part[:].q = np.tile([0.5, -0.5], self.n_dimers)
+        p3m = espressomd.electrostatics.P3M(
+            prefactor=1., accuracy=1e-4, r_cut=1.5, mesh=32, cao=6,
+            alpha=2.5, tune=False)
+        self.system.actors.add(p3m)
+        pos = np.copy(self.system.part[:].pos)
+        vel = np.copy(self.system.part[:].v)
+        self.system.integrator.set_vv()
+        self.system.integrator.run(0)
+        drift_ref = self.energy_drift(200)
+
+        self.system.part[:].pos = pos
+        self.system.part[:].v = vel
+        self.system.integrator.set_vv_respa(
+            n_inner=4, inner_forces=["bonded", "short_range"])
+        self.system.integrator.run(0)
+        drift = self.energy_drift(200)
+        self.assertLess(drift, drift_ref)
+
+        f = np.copy(self.system.part[:].f)
+        self.system.integrator.set_vv()
+        self.system.integrator.run(0, recalc_forces=True)
+        np.testing.assert_allclose(np.copy(self.system.part[:].f), f,
+                                   atol=1e-8)
+
+    def test_energy_conservation(self):
+        # the time step is too large for stiff bonds, the inner one is not
+        self.system.bonded_inter[0] = espressomd.interactions.HarmonicBond(
+            k=2000., r_0=1.)
+        self.system.time_step = 0.01
+        self.system.integrator.set_vv_respa(
+            n_inner=5, inner_forces=["bonded"])
+        self.system.integrator.run(0)
+        energy = self.total_energy()
+        for _ in range(40):
+            self.system.integrator.run(10)
+            self.assertAlmostEqual(self.total_energy() / energy, 1.,
+                                   delta=0.005)
+
+    def test_parameters(self):
+        self.system.integrator.set_vv_respa(n_inner=3)
+        params = self.system.integrator.get_state().get_params()
+        self.assertEqual(params["n_inner"], 3)
+        self.assertEqual(params["inner_forces"], ["bonded", "short_range"])
+        with self.assertRaises(ValueError):
+            self.system.integrator.set_vv_respa(n_inner=0)
+        with self.assertRaises(ValueError):
+            self.system.integrator.set_vv_respa(
+                n_inner=2, inner_forces=["thermostat"])
+
+
+if __name__ == "__main__":
+    ut.main()
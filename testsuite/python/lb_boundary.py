@@ -21,6 +21,8 @@ import espressomd.lb
 import espressomd.shapes
 import espressomd.lbboundaries
 from itertools import product
+import os
+import tempfile
 
 
 class LBBoundariesBase:
@@ -107,6 +109,24 @@ class LBBoundariesBase:
             espressomd.lbboundaries.LBBoundary(shape=union))
         self.check_boundary_flags([1, 0, 1])
 
+    def test_save_load_flags(self):
+        lbb = self.system.lbboundaries
+        lbb.add(espressomd.lbboundaries.LBBoundary(shape=self.wall_shape1))
+        lbb.add(espressomd.lbboundaries.LBBoundary(shape=self.wall_shape2))
+
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            filename = os.path.join(tmp_dir, "flags.dat")
+            lbb.save_flags(filename)
+
+            # the loaded flags replace the ones from the shapes
+            lbb.clear()
+            lbb.add(espressomd.lbboundaries.LBBoundary(shape=self.wall_shape2))
+            with self.assertRaises(Exception):
+                lbb.load_flags(filename)
+            lbb.add(espressomd.lbboundaries.LBBoundary(shape=self.wall_shape1))
+            lbb.load_flags(filename)
+            self.check_boundary_flags([1, 0, 2])
+
 
 @utx.skipIfMissingFeatures(["LB_BOUNDARIES"])
 class LBBoundariesCPU(ut.TestCase, LBBoundariesBase):
@@ -119,6 +119,25 @@ class MMM1D_GPU_Test(ElectrostaticInteractionsTests, ut.TestCase):
 class MMM1D_Test(ElectrostaticInteractionsTests, ut.TestCase):
     from espressomd.electrostatics import MMM1D
 
+    def test_tabulated_series(self):
+        # the tables for the reference accuracy would be too large,
+        # moderate accuracy uses the interpolation tables of the series
+        self.assertEqual(self.mmm1d.tabulated_series(),
+                         {"near": False, "far": False})
+        self.system.actors.clear()
+        mmm1d = self.MMM1D(prefactor=1.0, maxPWerror=1e-6)
+        self.system.actors.add(mmm1d)
+        self.assertEqual(mmm1d.tabulated_series(),
+                         {"near": True, "far": True})
+        self.system.integrator.run(steps=0)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].f), self.vec_f_target,
+            atol=self.allowed_error)
+        measured_el_energy = self.system.analysis.energy()["total"] \
+            - self.system.analysis.energy()["kinetic"]
+        self.assertAlmostEqual(
+            measured_el_energy, self.energy_target, delta=self.allowed_error)
+
 
 if __name__ == "__main__":
     ut.main()
@@ -22,7 +22,10 @@ Testmodule for MPI-IO.
 """
 
 import espressomd
+import espressomd.accumulators
 import espressomd.io
+import espressomd.lb
+import espressomd.observables
 from espressomd.interactions import AngleHarmonic
 import numpy
 import unittest as ut
@@ -38,6 +41,7 @@ nbonds = 100
 filename = "testdata.mpiio"
 exts = ["head", "pref", "id", "type", "pos", "vel", "boff", "bond"]
 filenames = [filename + "." + ext for ext in exts]
+filenames += [filename + ".chk", filename + ".chk.part", filename + ".chk.lb"]
 
 
 def clean_files():
@@ -75,6 +79,12 @@ def random_particles():
     return parts
 
 
+def lb_population(node, scale):
+    """Returns the populations of an LB node for the checkpoint tests."""
+    return scale * (1. + 0.1 * numpy.dot(node, [1, 2, 3])) * \
+        numpy.arange(1, 20) / 190.
+
+
 class MPIIOTest(ut.TestCase):
 
     """
@@ -100,6 +110,10 @@ class MPIIOTest(ut.TestCase):
 
     def tearDown(self):
         clean_files()
+        self.s.actors.clear()
+        self.s.thermostat.turn_off()
+        self.s.part.clear()
+        self.s.box_l = [1, 1, 1]
 
     def check_files_exist(self):
         """Checks if all necessary files have been written."""
@@ -134,6 +148,70 @@ class MPIIOTest(ut.TestCase):
 
         self.check_sample_system()
 
+    def test_checkpoint(self):
+        obs = espressomd.observables.ParticlePositions(ids=range(npart))
+        acc = espressomd.accumulators.MeanVarianceCalculator(obs=obs)
+        acc.update()
+        ref_mean = numpy.copy(acc.mean())
+        self.s.time = 1.25
+
+        espressomd.io.mpiio.mpiio.write_checkpoint(
+            filename, accumulators=[acc])
+        self.assertTrue(os.path.isfile(filename + ".chk"))
+        self.assertTrue(os.path.isfile(filename + ".chk.part"))
+
+        self.s.part[0].pos = self.s.part[0].pos + 1.
+        acc.update()
+        self.s.part.clear()
+        self.s.time = 0.
+        espressomd.io.mpiio.mpiio.read_checkpoint(
+            filename, accumulators=[acc])
+
+        self.check_sample_system()
+        self.assertEqual(self.s.time, 1.25)
+        numpy.testing.assert_array_equal(acc.mean(), ref_mean)
+        # the number of accumulators has to match
+        with self.assertRaises(Exception):
+            espressomd.io.mpiio.mpiio.read_checkpoint(filename)
+
+    def set_lb_populations(self, lbf, scale):
+        for node in numpy.ndindex(*lbf.shape):
+            lbf[node].population = lb_population(node, scale)
+
+    def test_checkpoint_lb(self):
+        system = self.s
+        system.box_l = [4, 4, 4]
+        system.time_step = 0.01
+        lbf = espressomd.lb.LBFluid(
+            agrid=1., dens=1., visc=1., tau=0.01, kT=1., seed=17)
+        system.actors.add(lbf)
+        system.thermostat.set_lb(LB_fluid=lbf, seed=23, gamma=1.)
+        self.set_lb_populations(lbf, 1.)
+
+        espressomd.io.mpiio.mpiio.write_checkpoint(filename)
+        self.assertTrue(os.path.isfile(filename + ".chk.lb"))
+
+        self.set_lb_populations(lbf, 2.)
+        lbf.seed = 5
+        system.thermostat.set_lb(LB_fluid=lbf, seed=7, gamma=1.)
+        system.part.clear()
+        espressomd.io.mpiio.mpiio.read_checkpoint(filename)
+
+        self.check_sample_system()
+        for node in numpy.ndindex(*lbf.shape):
+            numpy.testing.assert_array_equal(
+                numpy.copy(lbf[node].population), lb_population(node, 1.))
+        # the random number generators continue where they were
+        self.assertEqual(lbf.seed, 17)
+        self.assertEqual(
+            system.thermostat.get_state()[0]["rng_counter_fluid"], 23)
+
+        # the fluid has to match the one of the checkpoint
+        system.actors.clear()
+        system.thermostat.turn_off()
+        with self.assertRaises(Exception):
+            espressomd.io.mpiio.mpiio.read_checkpoint(filename)
+
 
 if __name__ == '__main__':
     ut.main()
@@ -90,6 +90,17 @@ class ProfileObservablesTest(ut.TestCase):
         self.assertEqual(obs_data[0, 0, 1, 2], 2.0 / self.bin_volume)
         self.assertEqual(np.sum(np.abs(obs_data)), 2.0 / self.bin_volume)
 
+    def test_invalid_ids(self):
+        for obs_class in (espressomd.observables.DensityProfile,
+                          espressomd.observables.FluxDensityProfile):
+            for ids in ([0, 42], [-1]):
+                kwargs = dict(self.kwargs, ids=ids)
+                with self.assertRaisesRegex(RuntimeError, "id"):
+                    obs_class(**kwargs).calculate()
+        # the nodes are still in sync after the error
+        obs = espressomd.observables.DensityProfile(**self.kwargs)
+        self.assertEqual(np.sum(obs.calculate()) * self.bin_volume, 2.)
+
     def test_pid_profile_interface(self):
         # test setters and getters
         params = {'ids': [0, 1],
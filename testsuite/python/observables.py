@@ -203,6 +203,19 @@ class Observables(ut.TestCase):
         np.testing.assert_array_almost_equal(
             obs_data, part_data, err_msg="Data did not agree for observable 'DipoleMoment'", decimal=9)
 
+    def test_unknown_particle(self):
+        # ids on all ranks, in an order unrelated to the domains
+        id_list = list(self.system.part[:].id[::-7])
+        observable = espressomd.observables.ParticlePositions(
+            ids=id_list + [1])
+        with self.assertRaises(Exception):
+            observable.calculate()
+        # the workers did not wait for the failed readout
+        observable.ids = id_list
+        np.testing.assert_array_almost_equal(
+            observable.calculate(), self.system.part[id_list].pos,
+            decimal=11)
+
     def test_com_force(self):
         id_list = sorted(
             np.random.choice(
@@ -373,6 +373,58 @@ class ParticleSliceTest(ut.TestCase):
         self.assertEqual(self.system.part[0].type, 0)
         self.assertEqual(self.system.part[1].type, 1)
 
+    def test_multiadd_bulk(self):
+        self.system.part.clear()
+        n_part = 50
+        ids = 2 * np.arange(n_part) + 10
+        pos = np.random.random((n_part, 3)) * self.system.box_l
+        v = np.random.random((n_part, 3))
+        types = np.arange(n_part) % 3
+        self.system.part.add(id=ids, pos=pos, v=v, type=types)
+        np.testing.assert_allclose(np.copy(self.system.part[ids].pos), pos)
+        np.testing.assert_allclose(np.copy(self.system.part[ids].v), v)
+        np.testing.assert_array_equal(self.system.part[ids].type, types)
+
+        # update existing particles
+        self.system.part[ids].type = types[::-1]
+        self.system.part[ids].pos = pos[::-1]
+        np.testing.assert_array_equal(self.system.part[ids].type, types[::-1])
+        np.testing.assert_allclose(
+            np.copy(self.system.part[ids].pos), pos[::-1])
+        if has_features(["ELECTROSTATICS"]):
+            self.system.part[ids].q = np.linspace(-1., 1., n_part)
+            np.testing.assert_allclose(
+                self.system.part[ids].q, np.linspace(-1., 1., n_part))
+
+        # duplicate or existing ids are rejected
+        with self.assertRaises(Exception):
+            self.system.part.add(id=[0, 0], pos=[[1, 1, 1], [2, 2, 2]])
+        with self.assertRaises(Exception):
+            self.system.part.add(id=[1, 10], pos=[[1, 1, 1], [2, 2, 2]])
+        with self.assertRaises(ValueError):
+            self.system.part[ids].type = -1
+        self.assertEqual(len(self.system.part), n_part)
+
+    def test_bulk_readout(self):
+        self.system.part.clear()
+        n_part = 40
+        ids = np.random.permutation(n_part) + 5
+        pos = np.random.random((n_part, 3)) * 3. * self.system.box_l
+        self.system.part.add(id=ids, pos=pos, mol_id=ids % 4)
+        # compare in an order different from the insertion order
+        sel = ids[::-3]
+        parts = [self.system.part[i] for i in sel]
+        np.testing.assert_allclose(
+            self.system.part[sel].pos, [p.pos for p in parts])
+        np.testing.assert_allclose(
+            self.system.part[sel].pos_folded, [p.pos_folded for p in parts])
+        np.testing.assert_allclose(
+            self.system.part[sel].f, [p.f for p in parts])
+        np.testing.assert_array_equal(self.system.part[sel].mol_id, sel % 4)
+        self.assertEqual(self.system.part[sel].type.dtype, int)
+        self.assertEqual(self.system.part[sel].v.shape, (len(sel), 3))
+        self.assertEqual(self.system.part[sel[:1]].pos.shape, (1, 3))
+
     def test_empty(self):
         np.testing.assert_array_equal(self.system.part[0:0].pos, np.empty(0))
 
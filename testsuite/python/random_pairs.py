@@ -79,8 +79,10 @@ class RandomPairTest(ut.TestCase):
         self.assertEqual(n2_pairs ^ set(cs_pairs), set())
 
     def check_dd(self, n2_pairs):
-        self.system.cell_system.set_domain_decomposition()
-        self.check_pairs(n2_pairs)
+        for subdivision, sfc in itertools.product([1, 2, 3], [False, True]):
+            self.system.cell_system.set_domain_decomposition(
+                cell_subdivision=subdivision, space_filling_curve=sfc)
+            self.check_pairs(n2_pairs)
 
     def check_n_squared(self, n2_pairs):
         self.system.cell_system.set_n_square()
@@ -104,6 +104,76 @@ class RdfTest(ut.TestCase):
 
         np.testing.assert_allclose(rdf10, rdf01)
 
+    def test_distributed_histogram(self):
+        s = self.s
+        np.random.seed(42)
+        s.part.add(pos=np.random.random((200, 3)) * s.box_l,
+                   type=np.random.randint(2, size=200))
+        ids0 = s.part.select(type=0).id
+        ids1 = s.part.select(type=1).id
+
+        def calculate(**kwargs):
+            obs = espressomd.observables.RDF(min_r=0.5, max_r=3.,
+                                             n_r_bins=10, **kwargs)
+            return obs.calculate()
+
+        # particles are fetched to the head node
+        s.cell_system.set_domain_decomposition()
+        rdf_ref = calculate(ids1=ids0)
+        rdf_ref01 = calculate(ids1=ids0, ids2=ids1)
+        # histogram is computed by the cell system
+        s.cell_system.set_n_square()
+        rdf = calculate(ids1=ids0)
+        rdf01 = calculate(ids1=ids0, ids2=ids1)
+        s.cell_system.set_domain_decomposition()
+
+        np.testing.assert_allclose(rdf, rdf_ref, rtol=1e-12)
+        np.testing.assert_allclose(rdf01, rdf_ref01, rtol=1e-12)
+
+    def rdf_reference(self, ids1, ids2, min_r, max_r, n_r_bins):
+        # ordered pairs of distinct particles, minimum image convention
+        pos1 = self.s.part[ids1].pos
+        pos2 = self.s.part[ids2].pos
+        d = pos1[:, np.newaxis, :] - pos2[np.newaxis, :, :]
+        d -= np.rint(d / self.s.box_l) * self.s.box_l
+        dist = np.linalg.norm(d, axis=2)
+        distinct = np.not_equal.outer(ids1, ids2)
+        hist = np.histogram(dist[distinct], bins=n_r_bins,
+                            range=(min_r, max_r))[0]
+        edges = np.linspace(min_r, max_r, n_r_bins + 1)
+        bin_volumes = 4. / 3. * np.pi * (edges[1:]**3 - edges[:-1]**3)
+        return hist * np.prod(self.s.box_l) / (bin_volumes * np.sum(distinct))
+
+    def test_overlapping_ids(self):
+        s = self.s
+        np.random.seed(42)
+        s.part.add(pos=np.random.random((100, 3)) * s.box_l)
+        ids1 = s.part[:].id[:60]
+        ids2 = s.part[:].id[40:]
+        params = dict(ids1=ids1, ids2=ids2, min_r=0.5, max_r=2., n_r_bins=6)
+        rdf_ref = self.rdf_reference(ids1, ids2, 0.5, 2., 6)
+
+        def calculate():
+            return espressomd.observables.RDF(**params).calculate()
+
+        # particles are fetched to the head node
+        s.cell_system.set_domain_decomposition()
+        np.testing.assert_allclose(calculate(), rdf_ref, rtol=1e-12)
+        # histogram is computed by the domain decomposition
+        min_global_cut = s.min_global_cut
+        s.min_global_cut = 2.
+        np.testing.assert_allclose(calculate(), rdf_ref, rtol=1e-12)
+        s.min_global_cut = min_global_cut
+        # histogram is computed by the n-square cell system
+        s.cell_system.set_n_square()
+        np.testing.assert_allclose(calculate(), rdf_ref, rtol=1e-12)
+        s.cell_system.set_domain_decomposition()
+
+        # a particle is not paired with itself
+        params.update(ids1=ids1[:3], ids2=ids1[:3], max_r=10.)
+        rdf_ref = self.rdf_reference(ids1[:3], ids1[:3], 0.5, 10., 6)
+        np.testing.assert_allclose(calculate(), rdf_ref, rtol=1e-12)
+
     def test_rdf_interface(self):
         # test setters and getters
         s = self.s
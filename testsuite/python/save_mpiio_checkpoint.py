@@ -0,0 +1,60 @@
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import unittest as ut
+import numpy as np
+import os
+
+import espressomd
+import espressomd.io
+import espressomd.lb
+
+# The checkpoint is read by test_mpiio_checkpoint.py on a different number
+# of MPI ranks.
+prefix = "@CMAKE_CURRENT_BINARY_DIR@/mpiio_checkpoint"
+
+system = espressomd.System(box_l=[6., 6., 6.])
+system.time_step = 0.01
+system.cell_system.skin = 0.4
+system.time = 1.25
+
+lbf = espressomd.lb.LBFluid(
+    agrid=1., dens=1., visc=1., tau=0.01, kT=1., seed=17)
+system.actors.add(lbf)
+system.thermostat.set_lb(LB_fluid=lbf, seed=23, gamma=1.)
+for node in np.ndindex(*lbf.shape):
+    lbf[node].population = (1. + 0.1 * np.dot(node, [1, 2, 3])) * \
+        np.arange(1, 20) / 190.
+
+n_part = 50
+np.random.seed(42)
+system.part.add(pos=np.random.random((n_part, 3)) * system.box_l,
+                v=np.random.random((n_part, 3)) - 0.5,
+                type=[i % 6 for i in range(n_part)])
+
+espressomd.io.mpiio.mpiio.write_checkpoint(prefix)
+
+
+class TestMPIIOCheckpoint(ut.TestCase):
+
+    def test_files(self):
+        for ext in (".chk", ".chk.part", ".chk.lb"):
+            self.assertTrue(os.path.isfile(prefix + ext),
+                            "checkpoint file " + prefix + ext + " not created")
+
+
+if __name__ == '__main__':
+    ut.main()
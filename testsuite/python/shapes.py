@@ -18,6 +18,7 @@
 #
 import unittest as ut
 import numpy as np
+import pickle
 
 import espressomd.shapes
 
@@ -49,6 +50,29 @@ class ShapeTests(ut.TestCase):
         self.assertAlmostEqual(union.calc_distance(
             position=[1, 2, 6.5])[0], 6.5)
 
+        # the union is updated when a member changes
+        sphere = espressomd.shapes.Sphere(center=[5, 5, 8.5], radius=0.5)
+        union.add(sphere)
+        self.assertAlmostEqual(union.calc_distance(
+            position=[5, 5, 3])[0], 3.0)
+        sphere.center = [5, 5, 4.5]
+        self.assertAlmostEqual(union.calc_distance(
+            position=[5, 5, 3])[0], 1.0)
+
+    def test_SampledShape(self):
+        sphere = espressomd.shapes.Sphere(center=[5, 5, 5], radius=2)
+        sampled = espressomd.shapes.SampledShape(
+            shape=sphere, lower=[0, 0, 0], upper=[10, 10, 10], spacing=0.25,
+            tolerance=0.1)
+        sampled_unpickled = pickle.loads(pickle.dumps(sampled))
+        for name in ("lower", "upper", "spacing", "tolerance"):
+            np.testing.assert_array_equal(
+                getattr(sampled_unpickled, name), getattr(sampled, name))
+        for pos in ([1, 2, 3], [5, 5, 8.3], [9.9, 0.1, 5]):
+            np.testing.assert_allclose(
+                sampled_unpickled.calc_distance(position=pos)[0],
+                sampled.calc_distance(position=pos)[0], rtol=1e-12)
+
 
 if __name__ == "__main__":
     ut.main()
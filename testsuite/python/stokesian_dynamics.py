@@ -105,6 +105,15 @@ class StokesianDynamicsTest(ut.TestCase):
     def test_default_ft(self):
         self.falling_spheres(1.0, 1.0, 1.0, 'ft')
 
+    def test_default_rpy(self):
+        self.falling_spheres(1.0, 1.0, 1.0, 'rpy')
+
+    def test_rpy_lubrication(self):
+        with self.assertRaisesRegex(ValueError, "approximation_method 'rpy'"):
+            self.system.integrator.set_stokesian_dynamics(
+                viscosity=1.0, radii={0: 1.0}, approximation_method='rpy',
+                lubrication=True)
+
 
 @utx.skipIfMissingFeatures(["STOKESIAN_DYNAMICS"])
 class StokesianDiffusionTest(ut.TestCase):
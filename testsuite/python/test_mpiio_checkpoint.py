@@ -0,0 +1,75 @@
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import unittest as ut
+import numpy as np
+
+import espressomd
+import espressomd.io
+import espressomd.lb
+
+prefix = "@CMAKE_CURRENT_BINARY_DIR@/mpiio_checkpoint"
+
+
+class MPIIOCheckpointTest(ut.TestCase):
+
+    """
+    Read the checkpoint of save_mpiio_checkpoint.py, which was written
+    on a different number of MPI ranks.
+    """
+
+    system = espressomd.System(box_l=[6., 6., 6.])
+    system.time_step = 0.01
+    system.cell_system.skin = 0.4
+
+    lbf = espressomd.lb.LBFluid(
+        agrid=1., dens=1., visc=1., tau=0.01, kT=1., seed=5)
+    system.actors.add(lbf)
+    system.thermostat.set_lb(LB_fluid=lbf, seed=7, gamma=1.)
+
+    espressomd.io.mpiio.mpiio.read_checkpoint(prefix)
+
+    def test_checkpoint(self):
+        system = self.system
+        n_part = 50
+        np.random.seed(42)
+        ref_pos = np.random.random((n_part, 3)) * system.box_l
+        ref_vel = np.random.random((n_part, 3)) - 0.5
+
+        self.assertEqual(len(system.part), n_part)
+        np.testing.assert_array_equal(system.part[:].id, range(n_part))
+        np.testing.assert_array_equal(np.copy(system.part[:].pos), ref_pos)
+        np.testing.assert_array_equal(np.copy(system.part[:].v), ref_vel)
+        np.testing.assert_array_equal(
+            system.part[:].type, [i % 6 for i in range(n_part)])
+        self.assertEqual(system.time, 1.25)
+
+        for node in np.ndindex(*self.lbf.shape):
+            np.testing.assert_array_equal(
+                np.copy(self.lbf[node].population),
+                (1. + 0.1 * np.dot(node, [1, 2, 3])) * np.arange(1, 20) / 190.)
+        # the random number generators continue where they were
+        self.assertEqual(self.lbf.seed, 17)
+        self.assertEqual(
+            system.thermostat.get_state()[0]["rng_counter_fluid"], 23)
+
+        # the interactions of the restored types exist on all ranks
+        self.assertEqual(system.part.n_part_types, 6)
+        system.integrator.run(10)
+
+
+if __name__ == '__main__':
+    ut.main()
@@ -304,6 +304,119 @@ class VirtualSites(ut.TestCase):
         system.cell_system.set_domain_decomposition(use_verlet_lists=False)
         self.run_test_lj()
 
+    @utx.skipIfMissingFeatures(["LENNARD_JONES", "EXTERNAL_FORCES"])
+    def test_straddling_bodies(self):
+        """Rigid bodies that straddle the boundaries between the nodes are
+        updated without ghost communication of their own. Check that they
+        follow the same trajectory as with the extra ghost communication.
+
+        """
+        system = self.system
+        box_l = np.copy(system.box_l)
+        node_grid = np.copy(system.cell_system.node_grid)
+        min_global_cut = system.min_global_cut
+        system.box_l = [6., 6., 6.]
+        system.cell_system.skin = 0.1
+        system.cell_system.set_domain_decomposition(use_verlet_lists=True)
+        n_nodes = system.cell_system.get_state()['n_nodes']
+        system.cell_system.node_grid = [n_nodes, 1, 1]
+        system.min_global_cut = 1.
+        system.time_step = 0.01
+        system.thermostat.turn_off()
+        system.non_bonded_inter[1, 2].lennard_jones.set_params(
+            epsilon=0.5, sigma=0.4, cutoff=0.5, shift=0.)
+
+        def run(extra_ghost_communication):
+            system.virtual_sites = VirtualSitesRelative(
+                extra_ghost_communication=extra_ghost_communication)
+            system.part.clear()
+            # bodies across the node boundaries at x = 0 and x = 3
+            for x in (0., 3.):
+                ref = system.part.add(pos=[x - 0.1, 0.9, 3.],
+                                      v=[0.2, 0.1, -0.3], rotation=[1, 1, 1],
+                                      omega_lab=[0.5, -1., 2.])
+                for i, offset in enumerate(
+                        ([0.3, -0.8, 0.], [-0.6, 0.3, 0.2], [0.1, 0.4, -0.5])):
+                    p = system.part.add(pos=ref.pos + offset, type=1,
+                                        ext_force=[0.1 * i, -0.2, 0.3])
+                    p.vs_auto_relate_to(ref.id)
+                # interacts with a site on the other node
+                system.part.add(pos=ref.pos + [-0.14, -0.8, 0.], v=ref.v,
+                                type=2)
+            system.integrator.run(50)
+            parts = system.part[:]
+            return (np.copy(parts.pos), np.copy(parts.v), np.copy(parts.f),
+                    np.copy(parts.torque_lab))
+
+        ref_state = run(True)
+        for value, ref_value in zip(run(False), ref_state):
+            np.testing.assert_allclose(value, ref_value, atol=1e-10)
+
+        system.part.clear()
+        system.virtual_sites = VirtualSitesRelative()
+        system.non_bonded_inter[1, 2].lennard_jones.set_params(
+            epsilon=0., sigma=0., cutoff=0., shift=0.)
+        system.cell_system.node_grid = node_grid
+        system.min_global_cut = min_global_cut
+        system.box_l = box_l
+
+    @utx.skipIfMissingFeatures(["NPT", "LENNARD_JONES"])
+    def test_npt(self):
+        """The NpT integrator rebuilds the cell system in every step, which
+        moves the particles in memory. Check that the rigid bodies follow
+        the same trajectory as with the extra ghost communication.
+
+        """
+        system = self.system
+        box_l = np.copy(system.box_l)
+        min_global_cut = system.min_global_cut
+        system.cell_system.skin = 0.2
+        system.cell_system.set_domain_decomposition(use_verlet_lists=True)
+        system.min_global_cut = 1.
+        system.time_step = 0.01
+        system.non_bonded_inter[1, 2].lennard_jones.set_params(
+            epsilon=1., sigma=0.5, cutoff=0.5 * 2**(1. / 6.), shift="auto")
+
+        def run(extra_ghost_communication):
+            system.virtual_sites = VirtualSitesRelative(
+                extra_ghost_communication=extra_ghost_communication)
+            system.part.clear()
+            system.box_l = [6., 6., 6.]
+            np.random.seed(42)
+            lattice = np.array(list(np.ndindex(2, 2, 2))) * 3.
+            for pos in lattice + [0.1, 1.2, 2.9]:
+                ref = system.part.add(pos=pos, v=np.random.uniform(-1., 1., 3),
+                                      rotation=[1, 1, 1],
+                                      omega_lab=np.random.uniform(-1., 1., 3))
+                for offset in np.identity(3) * 0.4:
+                    p = system.part.add(pos=pos + offset, type=1)
+                    p.vs_auto_relate_to(ref.id)
+                # collides with the first site
+                system.part.add(pos=pos + [0.85, 0., 0.], v=ref.v, type=2)
+            system.thermostat.set_npt(kT=0., gamma0=0., gammav=0., seed=42)
+            system.integrator.set_isotropic_npt(ext_pressure=2., piston=1.)
+            system.integrator.run(100)
+            for p in system.part:
+                if p.virtual:
+                    self.verify_vs(p)
+            parts = system.part[:]
+            return (np.copy(system.box_l), np.copy(parts.pos),
+                    np.copy(parts.v), np.copy(parts.f))
+
+        ref_state = run(True)
+        self.assertLess(ref_state[0][0], 6.)
+        for value, ref_value in zip(run(False), ref_state):
+            np.testing.assert_allclose(value, ref_value, atol=1e-10)
+
+        system.integrator.set_vv()
+        system.thermostat.turn_off()
+        system.part.clear()
+        system.virtual_sites = VirtualSitesRelative()
+        system.non_bonded_inter[1, 2].lennard_jones.set_params(
+            epsilon=0., sigma=0., cutoff=0., shift=0.)
+        system.min_global_cut = min_global_cut
+        system.box_l = box_l
+
     @utx.skipIfMissingFeatures("EXTERNAL_FORCES")
     def test_zz_pressure_tensor(self):
         system = self.system